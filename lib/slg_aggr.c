@@ -0,0 +1,334 @@
+/***************************************************************************************************
+ *
+ * file     : slg_aggr.c
+ *
+ * function : senslog project c-library - multi-year aggregation functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "slg_aggr.h"
+#include "slg_date.h"
+#include "slg_values.h"
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+#include "slg_hist.h"
+
+
+
+/* private functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* thread function of build: reads dayfiles of a job and fills year partials of job
+ *
+ * parameters:
+ *   *arg:  build job (slg_aggrjob)
+ *
+ ****************************************************************************************/
+static void *slg_agr_job (void *arg)
+{
+  slg_aggrjob *job;
+  slg_daydata daydata;
+  slg_dtemper dtemper;
+  slg_date    date;
+  uint32_t    i, res, y0;
+  char        fname[300], temp[20];
+
+  job = (slg_aggrjob *) arg;
+  slg_date_copy (&date, &job->date);
+  y0 = date.y;
+  job->fnum = 0;
+
+  for (i = 0; i < job->num; i++) {
+    strcpy (fname, job->pathname);
+    slg_date_to_fstring (temp, &date);
+    strcat (fname, temp);
+    strcat (fname, ".txt");
+
+    res = slg_readdayfile (&daydata, fname, job->hmode);
+    if ((res == 0) && (daydata.locid == job->aggr->locid) && (daydata.tmode == job->aggr->tmode)) {
+      job->fnum++;
+      if (slg_dtemper_read (&dtemper, &daydata, job->aggr->colid) == 0) {
+        slg_aggr_add_dtemper (&job->part[date.y - y0], &dtemper, &date);
+      }
+    }
+
+    slg_date_inc (&date);
+  }
+
+  return (NULL);
+}
+
+
+
+/* partial functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* clears a partial aggregate
+ *
+ * parameters:
+ *   *part:  partial aggregate
+ *
+ ****************************************************************************************/
+void slg_aggr_clear (slg_aggrpart *part)
+{
+  memset (part, 0, sizeof(slg_aggrpart));
+  part->min = CNERR;
+  part->max = CNERR;
+}
+
+
+/* adds all valid values of a day to a partial aggregate
+ * - days have to be added in order of time (newest min. and max. values win)
+ *
+ * parameters:
+ *   *part   :  partial aggregate
+ *   *dtemper:  day temperature object
+ *   *date   :  date of day
+ *
+ * return value:
+ *         0 :  valid values exist
+ *         1 :  no valid values found
+ *
+ ****************************************************************************************/
+uint32_t slg_aggr_add_dtemper (slg_aggrpart *part, slg_dtemper *dtemper, slg_date *date)
+{
+  slg_dstats dstats;
+  uint32_t   i;
+
+  if (slg_dtemper_stats (dtemper, &dstats) != 0) return (1);
+
+  /* histogram of values which are not flagged */
+  for (i = 0; i < dtemper->tlen; i++) {
+    if (dtemper->val[i] == CNERR) continue;
+    if ((dtemper->qflag[i / 32] >> (i % 32)) & 1) continue;
+
+    part->hist.bin[slg_hist_bin (dtemper->val[i])]++;
+    part->hist.count++;
+  }
+
+  if ((part->count == 0) || (dstats.min <= part->min)) {
+    part->min = dstats.min;
+    part->imin = dstats.indmin;
+    slg_date_copy (&part->dmin, date);
+  }
+  if ((part->count == 0) || (dstats.max >= part->max)) {
+    part->max = dstats.max;
+    part->imax = dstats.indmax;
+    slg_date_copy (&part->dmax, date);
+  }
+
+  part->dnum++;
+  part->dsum += slg_dstats_average (&dstats);
+  part->count += dstats.count;
+  part->sum += dstats.sum;
+
+  return (0);
+}
+
+
+/* merges a partial aggregate of a later period into another one
+ * - merging all partials in order of time gives the same result as adding all days
+ *   to one partial
+ *
+ * parameters:
+ *   *part :  target partial aggregate
+ *   *parti:  partial aggregate of later period to add
+ *
+ ****************************************************************************************/
+void slg_aggr_merge (slg_aggrpart *part, slg_aggrpart *parti)
+{
+  if (parti->count == 0) return;
+
+  if ((part->count == 0) || (parti->min <= part->min)) {
+    part->min = parti->min;
+    part->imin = parti->imin;
+    slg_date_copy (&part->dmin, &parti->dmin);
+  }
+  if ((part->count == 0) || (parti->max >= part->max)) {
+    part->max = parti->max;
+    part->imax = parti->imax;
+    slg_date_copy (&part->dmax, &parti->dmax);
+  }
+
+  part->dnum += parti->dnum;
+  part->dsum += parti->dsum;
+  part->count += parti->count;
+  part->sum += parti->sum;
+  slg_hist_merge (&part->hist, &parti->hist);
+}
+
+
+/* calculates average of all valid values of a partial aggregate
+ *
+ * parameters:
+ *   *part:  partial aggregate
+ *
+ * return value:
+ *   CNERR :  no valid values
+ *   other :  average (T*10)
+ *
+ ****************************************************************************************/
+int32_t slg_aggr_average (slg_aggrpart *part)
+{
+  if (part->count == 0) return (CNERR);
+
+  return ((int32_t) (part->sum / (int64_t) part->count));
+}
+
+
+/* calculates average of day averages of a partial aggregate
+ *
+ * parameters:
+ *   *part:  partial aggregate
+ *
+ * return value:
+ *   CNERR :  no valid days
+ *   other :  average (T*10)
+ *
+ ****************************************************************************************/
+int32_t slg_aggr_daverage (slg_aggrpart *part)
+{
+  if (part->dnum == 0) return (CNERR);
+
+  return ((int32_t) (part->dsum / (int64_t) part->dnum));
+}
+
+
+
+/* aggregation functions **************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* aggregates a temperature column of all dayfiles of a range of years
+ * - location and time mode are taken from a template dayfile, dayfiles with other
+ *   location or time mode are skipped
+ * - dayfiles are read in parallel, results are identical for all numbers of threads
+ *
+ * parameters:
+ *   *aggr    :  aggregation object
+ *   *daydata :  template daydata object
+ *   *pathname:  path name of dayfiles (incl. '/') or empty string
+ *   colid    :  temperature column id
+ *   yfirst   :  first year
+ *   ylast    :  last year (max. AGR_MAX_YEARS years)
+ *   hmode    :  header mode of dayfiles (see slg_readdayfile())
+ *   tnum     :  number of threads (1..AGR_MAX_THREADS)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid parameter
+ *    2 :  error: out of memory or thread creation failed
+ *
+ ****************************************************************************************/
+uint32_t slg_aggr_build (slg_aggr *aggr, slg_daydata *daydata, char *pathname, uint32_t colid,
+                         uint32_t yfirst, uint32_t ylast, uint32_t hmode, uint32_t tnum)
+{
+  slg_aggrjob  job[AGR_MAX_THREADS];
+  pthread_t    thread[AGR_MAX_THREADS];
+  slg_date     date, date_e;
+  uint32_t     num, chunk, t, n, i, ret;
+
+  if ((tnum < 1) || (tnum > AGR_MAX_THREADS)) return (1);
+  if (strlen(pathname) > 280) return (1);
+  if (slg_date_set_int (&date, 1, 1, yfirst) == 0) return (1);
+  if (slg_date_set_int (&date_e, 31, 12, ylast) == 0) return (1);
+  if ((yfirst > ylast) || (ylast - yfirst >= AGR_MAX_YEARS)) return (1);
+  if (slg_colexist (daydata, DF_TEMP, colid) == 0) return (1);
+
+  aggr->locid = daydata->locid;
+  aggr->tmode = daydata->tmode;
+  aggr->colid = colid;
+  aggr->yfirst = yfirst;
+  aggr->ylast = ylast;
+  aggr->fnum = 0;
+  for (i = 0; i < AGR_MAX_YEARS; i++) slg_aggr_clear (&aggr->year[i]);
+  slg_aggr_clear (&aggr->total);
+
+  num = (uint32_t) slg_date_sub (&date_e, &date) + 1;
+  if (tnum > num) tnum = num;
+
+  /* split range into jobs of neighboured days, each job gets partials of its years */
+  chunk = (num + tnum - 1) / tnum;
+  tnum = (num + chunk - 1) / chunk;
+  ret = 0;
+  for (t = 0; t < tnum; t++) {
+    job[t].aggr = aggr;
+    job[t].pathname = pathname;
+    slg_date_copy (&job[t].date, &date);
+    job[t].num = ((t + 1) * chunk <= num) ? chunk : num - t * chunk;
+    job[t].hmode = hmode;
+    job[t].fnum = 0;
+
+    slg_date_add (&date, (int32_t) job[t].num - 1);
+    job[t].ynum = date.y - job[t].date.y + 1;
+    slg_date_inc (&date);
+
+    job[t].part = (slg_aggrpart *) malloc (job[t].ynum * sizeof(slg_aggrpart));
+    if (job[t].part == NULL) {
+      ret = 2;
+      continue;
+    }
+    for (i = 0; i < job[t].ynum; i++) slg_aggr_clear (&job[t].part[i]);
+  }
+
+  /* read dayfiles in parallel */
+  n = 0;
+  if (ret == 0) {
+    for (n = 0; n < tnum; n++) {
+      if (pthread_create (&thread[n], NULL, slg_agr_job, &job[n]) != 0) {
+        ret = 2;
+        break;
+      }
+    }
+  }
+  for (t = 0; t < n; t++) pthread_join (thread[t], NULL);
+
+  /* merge partials in order of time (jobs are sorted by date) */
+  for (t = 0; t < tnum; t++) {
+    if (ret == 0) {
+      for (i = 0; i < job[t].ynum; i++) {
+        slg_aggr_merge (&aggr->year[job[t].date.y + i - yfirst], &job[t].part[i]);
+      }
+      aggr->fnum += job[t].fnum;
+    }
+    free (job[t].part);
+  }
+  if (ret != 0) return (ret);
+
+  for (i = 0; i <= ylast - yfirst; i++) slg_aggr_merge (&aggr->total, &aggr->year[i]);
+
+  return (0);
+}
+
+
+/* gets partial aggregate of a year
+ *
+ * parameters:
+ *   *aggr:  aggregation object
+ *   year :  year
+ *
+ * return value:
+ *    NULL :  year is not in aggregation
+ *   other :  pointer to partial aggregate
+ *
+ ****************************************************************************************/
+slg_aggrpart *slg_aggr_year (slg_aggr *aggr, uint32_t year)
+{
+  if ((year < aggr->yfirst) || (year > aggr->ylast)) return (NULL);
+
+  return (&aggr->year[year - aggr->yfirst]);
+}
+
@@ -0,0 +1,196 @@
+/***************************************************************************************************
+ *
+ * file     : slg_aggr.h
+ *
+ * function : senslog project c-library - multi-year aggregation functions
+ *            - aggregates one temperature column of all dayfiles of a range of years to
+ *              year partials (count, sum, min., max., day averages and histogram)
+ *            - the range of days is split into neighboured parts which are read in parallel,
+ *              each thread fills its own partials of the years it touches
+ *            - partials are merged in order of time after all threads are finished, sums are
+ *              integer, so results do not depend on the number of threads
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_date.h"
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+#include "slg_hist.h"
+
+
+#ifndef _slg_aggr_h
+#define _slg_aggr_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define AGR_MAX_YEARS    200        /* max. number of years of an aggregation */
+# define AGR_MAX_THREADS  16         /* max. number of threads of build */
+
+
+/* partial aggregate of a period (values are invalid if count is 0) */
+typedef struct {
+  uint32_t  dnum;         /* number of days with valid values */
+  int64_t   dsum;         /* sum of day averages (see slg_dstats_average()) */
+  uint32_t  count;        /* number of valid values */
+  int64_t   sum;          /* sum of valid values */
+  int32_t   min;          /* min. value (CNERR if no valid value exists) */
+  int32_t   max;          /* max. value (CNERR if no valid value exists) */
+  slg_date  dmin;         /* date of min. value (newest one) */
+  slg_date  dmax;         /* date of max. value (newest one) */
+  uint32_t  imin;         /* time index of min. value */
+  uint32_t  imax;         /* time index of max. value */
+  slg_hist  hist;         /* histogram of valid values */
+} slg_aggrpart;
+
+
+/* aggregation of a range of years */
+typedef struct {
+  uint32_t      locid;                  /* location id */
+  uint32_t      tmode;                  /* time_mode */
+  uint32_t      colid;                  /* temperature column id */
+  uint32_t      yfirst;                 /* first year */
+  uint32_t      ylast;                  /* last year */
+  uint32_t      fnum;                   /* number of dayfiles read */
+  slg_aggrpart  year[AGR_MAX_YEARS];    /* year partials (index: year - yfirst) */
+  slg_aggrpart  total;                  /* partial of all years */
+} slg_aggr;
+
+
+/* build job of a thread (a part of the range of days) */
+typedef struct {
+  slg_aggr      *aggr;                  /* aggregation object (read only in thread) */
+  char          *pathname;              /* path name of dayfiles */
+  slg_date      date;                   /* first date of job */
+  uint32_t      num;                    /* number of days of job */
+  uint32_t      hmode;                  /* header mode of dayfiles */
+  uint32_t      fnum;                   /* number of dayfiles read by job */
+  uint32_t      ynum;                   /* number of years touched by job */
+  slg_aggrpart  *part;                  /* year partials of job (ynum entries, first one: year of date) */
+} slg_aggrjob;
+
+
+
+/* partial functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* clears a partial aggregate
+ *
+ * parameters:
+ *   *part:  partial aggregate
+ *
+ ****************************************************************************************/
+void slg_aggr_clear (slg_aggrpart *part);
+
+
+/* adds all valid values of a day to a partial aggregate
+ * - days have to be added in order of time (newest min. and max. values win)
+ *
+ * parameters:
+ *   *part   :  partial aggregate
+ *   *dtemper:  day temperature object
+ *   *date   :  date of day
+ *
+ * return value:
+ *         0 :  valid values exist
+ *         1 :  no valid values found
+ *
+ ****************************************************************************************/
+uint32_t slg_aggr_add_dtemper (slg_aggrpart *part, slg_dtemper *dtemper, slg_date *date);
+
+
+/* merges a partial aggregate of a later period into another one
+ * - merging all partials in order of time gives the same result as adding all days
+ *   to one partial
+ *
+ * parameters:
+ *   *part :  target partial aggregate
+ *   *parti:  partial aggregate of later period to add
+ *
+ ****************************************************************************************/
+void slg_aggr_merge (slg_aggrpart *part, slg_aggrpart *parti);
+
+
+/* calculates average of all valid values of a partial aggregate
+ *
+ * parameters:
+ *   *part:  partial aggregate
+ *
+ * return value:
+ *   CNERR :  no valid values
+ *   other :  average (T*10)
+ *
+ ****************************************************************************************/
+int32_t slg_aggr_average (slg_aggrpart *part);
+
+
+/* calculates average of day averages of a partial aggregate
+ *
+ * parameters:
+ *   *part:  partial aggregate
+ *
+ * return value:
+ *   CNERR :  no valid days
+ *   other :  average (T*10)
+ *
+ ****************************************************************************************/
+int32_t slg_aggr_daverage (slg_aggrpart *part);
+
+
+
+/* aggregation functions **************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* aggregates a temperature column of all dayfiles of a range of years
+ * - location and time mode are taken from a template dayfile, dayfiles with other
+ *   location or time mode are skipped
+ * - dayfiles are read in parallel, results are identical for all numbers of threads
+ *
+ * parameters:
+ *   *aggr    :  aggregation object
+ *   *daydata :  template daydata object
+ *   *pathname:  path name of dayfiles (incl. '/') or empty string
+ *   colid    :  temperature column id
+ *   yfirst   :  first year
+ *   ylast    :  last year (max. AGR_MAX_YEARS years)
+ *   hmode    :  header mode of dayfiles (see slg_readdayfile())
+ *   tnum     :  number of threads (1..AGR_MAX_THREADS)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid parameter
+ *    2 :  error: out of memory or thread creation failed
+ *
+ ****************************************************************************************/
+uint32_t slg_aggr_build (slg_aggr *aggr, slg_daydata *daydata, char *pathname, uint32_t colid,
+                         uint32_t yfirst, uint32_t ylast, uint32_t hmode, uint32_t tnum);
+
+
+/* gets partial aggregate of a year
+ *
+ * parameters:
+ *   *aggr:  aggregation object
+ *   year :  year
+ *
+ * return value:
+ *    NULL :  year is not in aggregation
+ *   other :  pointer to partial aggregate
+ *
+ ****************************************************************************************/
+slg_aggrpart *slg_aggr_year (slg_aggr *aggr, uint32_t year);
+
+
+
+#endif
+
@@ -0,0 +1,370 @@
+/***************************************************************************************************
+ *
+ * file     : slg_cache.c
+ *
+ * function : senslog project c-library - query result cache functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "slg_cache.h"
+#include "slg_date.h"
+
+
+
+/* private functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* extends a FNV-1a hash value by a data block
+ *
+ * parameters:
+ *   h    :  hash value (CCH_FNV_BASIS for a new hash)
+ *   *data:  data block
+ *   len  :  length of data block in bytes
+ *
+ * return value:
+ *   extended hash value
+ *
+ ****************************************************************************************/
+static uint64_t slg_cch_hash (uint64_t h, void *data, uint32_t len)
+{
+  uint8_t  *p;
+  uint32_t i;
+
+  p = (uint8_t *) data;
+  for (i = 0; i < len; i++) {
+    h ^= p[i];
+    h *= CCH_FNV_PRIME;
+  }
+
+  return (h);
+}
+
+
+/* calculates check sum of a cache entry (never 0, 0 marks an empty entry)
+ *
+ * parameters:
+ *   *ent:  cache entry
+ *
+ * return value:
+ *   check sum
+ *
+ ****************************************************************************************/
+static uint64_t slg_cch_check (slg_cchent *ent)
+{
+  uint64_t h;
+
+  h = slg_cch_hash (CCH_FNV_BASIS, &ent->key, sizeof(slg_cchkey));
+  h = slg_cch_hash (h, &ent->fp, sizeof(uint64_t));
+  h = slg_cch_hash (h, &ent->res, sizeof(slg_cchres));
+  if (h == 0) h = 1;
+
+  return (h);
+}
+
+
+/* gets file offset of a cache file entry of the set of a key (set selected by hash of key)
+ * - the hash is folded, the low bits of FNV-1a alone are not distributed well enough
+ *
+ * parameters:
+ *   *key:  key
+ *   way :  entry of set (0..CCH_WAYNUM-1)
+ *
+ * return value:
+ *   file offset of entry
+ *
+ ****************************************************************************************/
+static off_t slg_cch_offset (slg_cchkey *key, uint32_t way)
+{
+  uint64_t h;
+
+  h = slg_cch_hash (CCH_FNV_BASIS, key, sizeof(slg_cchkey));
+  h ^= h >> 32;
+  h = (h % (CCH_FILENUM / CCH_WAYNUM)) * CCH_WAYNUM + way;
+
+  return ((off_t) sizeof(slg_cchhead) + (off_t) h * (off_t) sizeof(slg_cchent));
+}
+
+
+/* reads a cache file entry and checks it (damaged or partly written entries fail the
+ * check sum)
+ *
+ * parameters:
+ *   *cache:  cache object
+ *   *ent  :  resulting cache entry
+ *   off   :  file offset of entry
+ *
+ * return value:
+ *    0 :  valid entry
+ *    1 :  empty, damaged or unreadable entry
+ *
+ ****************************************************************************************/
+static uint32_t slg_cch_read (slg_cache *cache, slg_cchent *ent, off_t off)
+{
+  if ((pread (cache->fd, ent, sizeof(slg_cchent), off) == sizeof(slg_cchent)) &&
+      (ent->check != 0) && (ent->check == slg_cch_check (ent))) return (0);
+
+  return (1);
+}
+
+
+/* stores a result in the in-memory table
+ * - an entry with same key is replaced, otherwise an empty or the least recently used
+ *   entry
+ *
+ * parameters:
+ *   *cache:  cache object
+ *   *key  :  key
+ *   fp    :  fingerprint of dayfiles of range
+ *   *res  :  result
+ *
+ ****************************************************************************************/
+static void slg_cch_memput (slg_cache *cache, slg_cchkey *key, uint64_t fp, slg_cchres *res)
+{
+  uint32_t i, k;
+
+  k = 0;
+  for (i = 0; i < CCH_MEMNUM; i++) {
+    if ((cache->used[i] != 0) && (memcmp (&cache->ent[i].key, key, sizeof(slg_cchkey)) == 0)) {
+      k = i;
+      break;
+    }
+    if (cache->used[i] < cache->used[k]) k = i;
+  }
+
+  cache->tick++;
+  cache->used[k] = cache->tick;
+  memcpy (&cache->ent[k].key, key, sizeof(slg_cchkey));
+  cache->ent[k].fp = fp;
+  memcpy (&cache->ent[k].res, res, sizeof(slg_cchres));
+  cache->ent[k].check = slg_cch_check (&cache->ent[k]);
+}
+
+
+
+/* cache functions ********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* opens a cache (a missing cache file is created)
+ *
+ * parameters:
+ *   *cache   :  cache object
+ *   *filename:  path/filename of cache file or empty string (memory only)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: file can not be opened or created (cache is memory only)
+ *    2 :  error: invalid file (magic, version or size), cache is memory only
+ *
+ ****************************************************************************************/
+uint32_t slg_cache_open (slg_cache *cache, char *filename)
+{
+  slg_cchhead head;
+  struct stat st;
+  off_t       fsize;
+
+  memset (cache, 0, sizeof(slg_cache));
+  cache->fd = -1;
+
+  if (filename[0] == 0) return (0);
+
+  cache->fd = open (filename, O_RDWR | O_CREAT, 0644);
+  if (cache->fd < 0) {
+    cache->fd = -1;
+    return (1);
+  }
+
+  if (fstat (cache->fd, &st) != 0) {
+    slg_cache_close (cache);
+    return (1);
+  }
+
+  fsize = (off_t) sizeof(slg_cchhead) + (off_t) CCH_FILENUM * (off_t) sizeof(slg_cchent);
+
+  /* new file: write header, all entries are empty (zero) */
+  if (st.st_size == 0) {
+    memset (&head, 0, sizeof(slg_cchhead));
+    strcpy (head.magic, CCH_MAGIC);
+    head.version = CCH_VERSION;
+    head.num = CCH_FILENUM;
+
+    if ((pwrite (cache->fd, &head, sizeof(slg_cchhead), 0) != sizeof(slg_cchhead)) ||
+        (ftruncate (cache->fd, fsize) != 0)) {
+      slg_cache_close (cache);
+      return (1);
+    }
+    return (0);
+  }
+
+  /* existing file: check header and size */
+  if ((st.st_size != fsize) ||
+      (pread (cache->fd, &head, sizeof(slg_cchhead), 0) != sizeof(slg_cchhead)) ||
+      (memcmp (head.magic, CCH_MAGIC, strlen (CCH_MAGIC) + 1) != 0) ||
+      (head.version != CCH_VERSION) || (head.num != CCH_FILENUM)) {
+    slg_cache_close (cache);
+    return (2);
+  }
+
+  return (0);
+}
+
+
+/* closes a cache
+ *
+ * parameters:
+ *   *cache:  cache object
+ *
+ ****************************************************************************************/
+void slg_cache_close (slg_cache *cache)
+{
+  if (cache->fd >= 0) close (cache->fd);
+  cache->fd = -1;
+}
+
+
+/* calculates fingerprint of all dayfiles of a date range from mtime and size
+ * - missing dayfiles are part of the fingerprint, so adding a dayfile changes it
+ *
+ * parameters:
+ *   *pathname:  path name of dayfiles (incl. '/') or empty string
+ *   *date_b  :  first date of range
+ *   *date_e  :  last date of range
+ *
+ * return value:
+ *   fingerprint (0: invalid date range)
+ *
+ ****************************************************************************************/
+uint64_t slg_cache_fingerprint (char *pathname, slg_date *date_b, slg_date *date_e)
+{
+  char        fname[300], temp[20];
+  slg_date    date;
+  struct stat st;
+  int64_t     m[2];
+  uint64_t    h;
+
+  if ((slg_date_compare (date_e, date_b) == 0) || (slg_date_compare (date_e, date_b) == 2)) return (0);
+  if (strlen (pathname) > 280) return (0);
+
+  h = slg_cch_hash (CCH_FNV_BASIS, pathname, strlen (pathname));
+
+  slg_date_copy (&date, date_b);
+  while (slg_date_compare (&date, date_e) < 3) {
+    strcpy (fname, pathname);
+    slg_date_to_fstring (temp, &date);
+    strcat (fname, temp);
+    strcat (fname, ".txt");
+
+    if (stat (fname, &st) == 0) {
+      m[0] = (int64_t) st.st_mtime;
+      m[1] = (int64_t) st.st_size;
+    }
+    else {
+      m[0] = -1;
+      m[1] = -1;
+    }
+    h = slg_cch_hash (h, m, sizeof(m));
+
+    if (slg_date_inc (&date) == 0) break;
+  }
+
+  if (h == 0) h = 1;
+
+  return (h);
+}
+
+
+/* looks up a result (in-memory entries first, then cache file)
+ *
+ * parameters:
+ *   *cache:  cache object
+ *   *key  :  key
+ *   fp    :  fingerprint of dayfiles of range (see slg_cache_fingerprint())
+ *   *res  :  resulting result (unchanged if not found)
+ *
+ * return value:
+ *    0 :  hit
+ *    1 :  miss (not cached or fingerprint has changed)
+ *
+ ****************************************************************************************/
+uint32_t slg_cache_get (slg_cache *cache, slg_cchkey *key, uint64_t fp, slg_cchres *res)
+{
+  slg_cchent ent;
+  uint32_t   i, w;
+
+  /* in-memory entries */
+  for (i = 0; i < CCH_MEMNUM; i++) {
+    if ((cache->used[i] != 0) && (cache->ent[i].fp == fp) &&
+        (memcmp (&cache->ent[i].key, key, sizeof(slg_cchkey)) == 0)) {
+      cache->tick++;
+      cache->used[i] = cache->tick;
+      memcpy (res, &cache->ent[i].res, sizeof(slg_cchres));
+      cache->nhit++;
+      return (0);
+    }
+  }
+
+  /* cache file entries of set of key */
+  if (cache->fd >= 0) {
+    for (w = 0; w < CCH_WAYNUM; w++) {
+      if ((slg_cch_read (cache, &ent, slg_cch_offset (key, w)) == 0) && (ent.fp == fp) &&
+          (memcmp (&ent.key, key, sizeof(slg_cchkey)) == 0)) {
+        slg_cch_memput (cache, key, fp, &ent.res);
+        memcpy (res, &ent.res, sizeof(slg_cchres));
+        cache->nhit++;
+        return (0);
+      }
+    }
+  }
+
+  cache->nmiss++;
+  return (1);
+}
+
+
+/* stores a result (least recently used in-memory entry is replaced, in the cache file
+ * an entry with same key, an empty entry or the last entry of the set is replaced)
+ *
+ * parameters:
+ *   *cache:  cache object
+ *   *key  :  key
+ *   fp    :  fingerprint of dayfiles of range
+ *   *res  :  result
+ *
+ ****************************************************************************************/
+void slg_cache_put (slg_cache *cache, slg_cchkey *key, uint64_t fp, slg_cchres *res)
+{
+  slg_cchent ent;
+  uint32_t   w;
+
+  slg_cch_memput (cache, key, fp, res);
+
+  if (cache->fd >= 0) {
+    /* entry with same key or empty entry of set, otherwise last entry of set */
+    for (w = 0; w < CCH_WAYNUM - 1; w++) {
+      if ((slg_cch_read (cache, &ent, slg_cch_offset (key, w)) != 0) ||
+          (memcmp (&ent.key, key, sizeof(slg_cchkey)) == 0)) break;
+    }
+
+    memcpy (&ent.key, key, sizeof(slg_cchkey));
+    ent.fp = fp;
+    memcpy (&ent.res, res, sizeof(slg_cchres));
+    ent.check = slg_cch_check (&ent);
+
+    /* a failed write leaves a damaged entry, which is detected by its check sum */
+    if (pwrite (cache->fd, &ent, sizeof(slg_cchent), slg_cch_offset (key, w)) != sizeof(slg_cchent)) return;
+  }
+}
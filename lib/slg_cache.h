@@ -0,0 +1,174 @@
+/***************************************************************************************************
+ *
+ * file     : slg_cache.h
+ *
+ * function : senslog project c-library - query result cache functions
+ *            - results of range queries are cached by key (location, column, date range,
+ *              operation) and fingerprint of the contributing dayfiles
+ *            - the fingerprint is built from mtime and size of all dayfiles of the range
+ *              (like the rollup index), a changed, added or removed dayfile invalidates
+ *              all results of ranges containing it
+ *            - a small in-memory table with LRU replacement is backed by an optional cache
+ *              file with a fixed number of 2-way set associative entries, so results are
+ *              shared between tools and runs
+ *            - entries are protected by a check sum, damaged or partly written entries
+ *              are treated as missing
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_date.h"
+
+
+#ifndef _slg_cache_h
+#define _slg_cache_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define CCH_MAGIC     "SLGCCH"   /* file magic (8 bytes incl. zero padding) */
+# define CCH_VERSION   1          /* file format version */
+
+# define CCH_MEMNUM    64         /* number of in-memory entries */
+# define CCH_FILENUM   65536      /* number of entries of cache file (8 MByte) */
+# define CCH_VALNUM    8          /* number of result values of an entry */
+# define CCH_WAYNUM    2          /* number of cache file entries a key can be stored in */
+
+# define CCH_FNV_BASIS 14695981039346656037ULL   /* FNV-1a 64 bit offset basis (hash function) */
+# define CCH_FNV_PRIME 1099511628211ULL          /* FNV-1a 64 bit prime */
+
+# define CCH_OP_USER   100        /* first operation number (operations are defined by the
+                                     callers, e.g. NRM_CCH_OP) */
+
+
+/* cache key (all fields are compared, unused fields have to be zero) */
+typedef struct {
+  uint32_t  locid;        /* location id */
+  uint32_t  typ;          /* column type (DF_TEMP, DF_RAIN, DF_EVNT) */
+  uint32_t  colid;        /* column id */
+  uint32_t  op;           /* operation (CCH_OP_...) */
+  slg_date  date_b;       /* first date of range */
+  slg_date  date_e;       /* last date of range */
+  int32_t   param;        /* parameter of operation (defined by caller) */
+  uint32_t  reserved;     /* reserved, zero */
+} slg_cchkey;
+
+
+/* cached result */
+typedef struct {
+  int64_t   val[CCH_VALNUM];  /* result values (meaning depends on operation) */
+} slg_cchres;
+
+
+/* cache entry (stored 1:1 in cache file) */
+typedef struct {
+  slg_cchkey  key;        /* key */
+  uint64_t    fp;         /* fingerprint of dayfiles of range */
+  slg_cchres  res;        /* result */
+  uint64_t    check;      /* check sum of key, fingerprint and result (0: empty entry) */
+} slg_cchent;
+
+
+/* cache file header */
+typedef struct {
+  char      magic[8];     /* CCH_MAGIC */
+  uint32_t  version;      /* CCH_VERSION */
+  uint32_t  num;          /* number of entries (CCH_FILENUM) */
+} slg_cchhead;
+
+
+/* cache object */
+typedef struct {
+  int         fd;                     /* file descriptor of cache file (-1: memory only) */
+  uint64_t    tick;                   /* access counter (LRU) */
+  uint64_t    used[CCH_MEMNUM];       /* last access of in-memory entries (0: empty) */
+  slg_cchent  ent[CCH_MEMNUM];        /* in-memory entries */
+  uint32_t    nhit;                   /* number of hits */
+  uint32_t    nmiss;                  /* number of misses */
+} slg_cache;
+
+
+
+/* cache functions ********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* opens a cache (a missing cache file is created)
+ *
+ * parameters:
+ *   *cache   :  cache object
+ *   *filename:  path/filename of cache file or empty string (memory only)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: file can not be opened or created (cache is memory only)
+ *    2 :  error: invalid file (magic, version or size), cache is memory only
+ *
+ ****************************************************************************************/
+uint32_t slg_cache_open (slg_cache *cache, char *filename);
+
+
+/* closes a cache
+ *
+ * parameters:
+ *   *cache:  cache object
+ *
+ ****************************************************************************************/
+void slg_cache_close (slg_cache *cache);
+
+
+/* calculates fingerprint of all dayfiles of a date range from mtime and size
+ * - missing dayfiles are part of the fingerprint, so adding a dayfile changes it
+ *
+ * parameters:
+ *   *pathname:  path name of dayfiles (incl. '/') or empty string
+ *   *date_b  :  first date of range
+ *   *date_e  :  last date of range
+ *
+ * return value:
+ *   fingerprint (0: invalid date range)
+ *
+ ****************************************************************************************/
+uint64_t slg_cache_fingerprint (char *pathname, slg_date *date_b, slg_date *date_e);
+
+
+/* looks up a result (in-memory entries first, then cache file)
+ *
+ * parameters:
+ *   *cache:  cache object
+ *   *key  :  key
+ *   fp    :  fingerprint of dayfiles of range (see slg_cache_fingerprint())
+ *   *res  :  resulting result (unchanged if not found)
+ *
+ * return value:
+ *    0 :  hit
+ *    1 :  miss (not cached or fingerprint has changed)
+ *
+ ****************************************************************************************/
+uint32_t slg_cache_get (slg_cache *cache, slg_cchkey *key, uint64_t fp, slg_cchres *res);
+
+
+/* stores a result (least recently used in-memory entry is replaced, in the cache file
+ * an entry with same key, an empty entry or the last entry of the set is replaced)
+ *
+ * parameters:
+ *   *cache:  cache object
+ *   *key  :  key
+ *   fp    :  fingerprint of dayfiles of range
+ *   *res  :  result
+ *
+ ****************************************************************************************/
+void slg_cache_put (slg_cache *cache, slg_cchkey *key, uint64_t fp, slg_cchres *res);
+
+
+
+#endif
+
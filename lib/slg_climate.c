@@ -0,0 +1,284 @@
+/***************************************************************************************************
+ *
+ * file     : slg_climate.c
+ *
+ * function : senslog project c-library - climatological functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "slg_climate.h"
+#include "slg_values.h"
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+#include "slg_rain.h"
+
+
+
+/* day type functions *****************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* classifies a day of a column by its day statistics
+ *
+ * parameters:
+ *   typ    :  column typ (DF_TEMP or DF_RAIN, other types have no day types)
+ *   *dstats:  day statistics of column
+ *
+ * return value:
+ *   bit mask of day types (bit CLM_...: day is of this type, 0: no valid values)
+ *
+ ****************************************************************************************/
+uint32_t slg_climate_daytype (uint32_t typ, slg_dstats *dstats)
+{
+  uint32_t dtype;
+
+  if (dstats->count == 0) return (0);
+
+  dtype = 0;
+
+  if (typ == DF_TEMP) {
+    dtype |= (uint32_t) (dstats->min < CLM_TFROST) << CLM_FROST;
+    dtype |= (uint32_t) (dstats->max < CLM_TFROST) << CLM_ICE;
+    dtype |= (uint32_t) (dstats->max >= CLM_TSUMMER) << CLM_SUMMER;
+    dtype |= (uint32_t) (dstats->max >= CLM_THOT) << CLM_HOT;
+  }
+
+  if (typ == DF_RAIN) {
+    dtype |= (uint32_t) (dstats->sum >= CLM_RRAIN) << CLM_RAIN;
+  }
+
+  return (dtype);
+}
+
+
+/* adds a day type bit mask to day type counters
+ *
+ * parameters:
+ *   *cnt :  array of CLM_NUM counters
+ *   dtype:  bit mask of day types (see slg_climate_daytype())
+ *
+ ****************************************************************************************/
+void slg_climate_count (uint32_t *cnt, uint32_t dtype)
+{
+  uint32_t i;
+
+  for (i = 0; i < CLM_NUM; i++) {
+    cnt[i] += (dtype >> i) & 1;
+  }
+}
+
+
+/* counts day types of all valid days of a month (uses day statistics of month object)
+ *
+ * parameters:
+ *   *mtemper:  month temperature object
+ *   *cnt    :  resulting array of CLM_NUM counters
+ *
+ ****************************************************************************************/
+void slg_climate_mtemper (slg_mtemper *mtemper, uint32_t *cnt)
+{
+  uint32_t i;
+
+  for (i = 0; i < CLM_NUM; i++) cnt[i] = 0;
+
+  for (i = 0; i < 31; i++) {
+    if (mtemper->dvalid[i]) slg_climate_count (cnt, slg_climate_daytype (DF_TEMP, &mtemper->dstats[i]));
+  }
+}
+
+
+/* counts rain days of all valid days of a month
+ *
+ * parameters:
+ *   *mrain:  month rain object
+ *   *cnt  :  resulting array of CLM_NUM counters
+ *
+ ****************************************************************************************/
+void slg_climate_mrain (slg_mrain *mrain, uint32_t *cnt)
+{
+  uint32_t   i, k;
+  slg_dstats dstats;
+
+  for (i = 0; i < CLM_NUM; i++) cnt[i] = 0;
+
+  for (i = 0; i < 31; i++) {
+    if (mrain->dvalid[i] == 0) continue;
+
+    dstats.count = 0;
+    dstats.sum = 0;
+    for (k = 0; k < mrain->drain[i].tlen; k++) {
+      if (mrain->drain[i].val[k] != CNERR) {
+        dstats.count++;
+        dstats.sum += (int32_t) mrain->drain[i].val[k];
+      }
+    }
+
+    slg_climate_count (cnt, slg_climate_daytype (DF_RAIN, &dstats));
+  }
+}
+
+
+
+/* degree day functions ***************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* calculates heating and cooling degree days of a day from its day statistics
+ * (method CLM_DD_MEAN)
+ * - hdd = max(0, base - average), cdd = max(0, average - base)
+ *
+ * parameters:
+ *   *dstats:  day statistics
+ *   base   :  base temperature (T*10)
+ *   *hdd   :  resulting heating degree days (T*10 * days)
+ *   *cdd   :  resulting cooling degree days (T*10 * days)
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  no valid values (hdd and cdd are 0)
+ *
+ ****************************************************************************************/
+uint32_t slg_climate_dd_dstats (slg_dstats *dstats, int32_t base, int32_t *hdd, int32_t *cdd)
+{
+  int32_t avg;
+
+  *hdd = 0;
+  *cdd = 0;
+
+  if (dstats->count == 0) return (1);
+
+  avg = slg_dstats_average (dstats);
+  if (avg < base) *hdd = base - avg;
+  if (avg > base) *cdd = avg - base;
+
+  return (0);
+}
+
+
+/* calculates heating and cooling degree days of a day from its values
+ * - CLM_DD_MEAN: see slg_climate_dd_dstats()
+ * - CLM_DD_SLOT: hdd = average of max(0, base - value), cdd = average of max(0, value - base)
+ *   over all valid values (rounded)
+ *
+ * parameters:
+ *   *val  :  array of temperatures T*10 (CNERR: invalid value)
+ *   len   :  array length
+ *   base  :  base temperature (T*10)
+ *   method:  CLM_DD_MEAN or CLM_DD_SLOT
+ *   *hdd  :  resulting heating degree days (T*10 * days)
+ *   *cdd  :  resulting cooling degree days (T*10 * days)
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  no valid values (hdd and cdd are 0)
+ *         2 :  error: invalid method
+ *
+ ****************************************************************************************/
+uint32_t slg_climate_dd (int32_t *val, uint32_t len, int32_t base, uint32_t method, int32_t *hdd, int32_t *cdd)
+{
+  slg_dstats dstats;
+  uint32_t   i, count;
+  int32_t    hsum, csum;
+
+  *hdd = 0;
+  *cdd = 0;
+
+  if (method == CLM_DD_MEAN) {
+    slg_dstats_calc (&dstats, val, len);
+    return (slg_climate_dd_dstats (&dstats, base, hdd, cdd));
+  }
+
+  if (method != CLM_DD_SLOT) return (2);
+
+  count = 0;
+  hsum = 0;
+  csum = 0;
+
+  for (i = 0; i < len; i++) {
+    if (val[i] == CNERR) continue;
+    count++;
+    if (val[i] < base) hsum += base - val[i];
+    if (val[i] > base) csum += val[i] - base;
+  }
+
+  if (count == 0) return (1);
+
+  *hdd = (hsum + (int32_t) count / 2) / (int32_t) count;
+  *cdd = (csum + (int32_t) count / 2) / (int32_t) count;
+
+  return (0);
+}
+
+
+/* calculates heating and cooling degree days of a day (see slg_climate_dd())
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *   base    :  base temperature (T*10)
+ *   method  :  CLM_DD_MEAN or CLM_DD_SLOT
+ *   *hdd    :  resulting heating degree days (T*10 * days)
+ *   *cdd    :  resulting cooling degree days (T*10 * days)
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  no valid values (hdd and cdd are 0)
+ *         2 :  error: invalid method
+ *
+ ****************************************************************************************/
+uint32_t slg_climate_dtemper_dd (slg_dtemper *dtemper, int32_t base, uint32_t method, int32_t *hdd, int32_t *cdd)
+{
+  return (slg_climate_dd (dtemper->val, dtemper->tlen, base, method, hdd, cdd));
+}
+
+
+/* calculates heating and cooling degree day sums of all valid days of a month
+ * (CLM_DD_MEAN uses day statistics of month object only)
+ *
+ * parameters:
+ *   *mtemper:  month temperature object
+ *   base    :  base temperature (T*10)
+ *   method  :  CLM_DD_MEAN or CLM_DD_SLOT
+ *   *hdd    :  resulting heating degree days (T*10 * days)
+ *   *cdd    :  resulting cooling degree days (T*10 * days)
+ *
+ * return value:
+ *     0..31 :  number of days with valid values
+ *     CNERR :  error: invalid method
+ *
+ ****************************************************************************************/
+uint32_t slg_climate_mtemper_dd (slg_mtemper *mtemper, int32_t base, uint32_t method, int32_t *hdd, int32_t *cdd)
+{
+  uint32_t i, res, dnum;
+  int32_t  h, c;
+
+  *hdd = 0;
+  *cdd = 0;
+
+  if ((method != CLM_DD_MEAN) && (method != CLM_DD_SLOT)) return (CNERR);
+
+  dnum = 0;
+  for (i = 0; i < 31; i++) {
+    if (mtemper->dvalid[i] == 0) continue;
+
+    if (method == CLM_DD_MEAN) res = slg_climate_dd_dstats (&mtemper->dstats[i], base, &h, &c);
+    else res = slg_climate_dtemper_dd (&mtemper->dtemper[i], base, method, &h, &c);
+
+    if (res == 0) {
+      *hdd += h;
+      *cdd += c;
+      dnum++;
+    }
+  }
+
+  return (dnum);
+}
@@ -0,0 +1,179 @@
+/***************************************************************************************************
+ *
+ * file     : slg_climate.h
+ *
+ * function : senslog project c-library - climatological functions
+ *            - classification of days into climatological day types (frost, ice, summer,
+ *              hot and rain day) from day statistics
+ *            - heating and cooling degree days (daily mean or slot integrated method)
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+#include "slg_rain.h"
+
+
+#ifndef _slg_climate_h
+#define _slg_climate_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define CLM_FROST     0     /* day type: frost day (min. < 0.0 degree) */
+# define CLM_ICE       1     /* day type: ice day (max. < 0.0 degree) */
+# define CLM_SUMMER    2     /* day type: summer day (max. >= 25.0 degree) */
+# define CLM_HOT       3     /* day type: hot day (max. >= 30.0 degree) */
+# define CLM_RAIN      4     /* day type: rain day (sum >= 0.1 mm) */
+# define CLM_NUM       5     /* number of day types */
+
+# define CLM_TFROST    0     /* threshold of frost and ice days (T*10) */
+# define CLM_TSUMMER 250     /* threshold of summer days (T*10) */
+# define CLM_THOT    300     /* threshold of hot days (T*10) */
+# define CLM_RRAIN    10     /* threshold of rain days (rain*100) */
+
+# define CLM_DD_MEAN   0     /* degree day method: difference of day average to base temperature */
+# define CLM_DD_SLOT   1     /* degree day method: average of slot differences to base temperature */
+
+
+
+/* day type functions *****************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* classifies a day of a column by its day statistics
+ *
+ * parameters:
+ *   typ    :  column typ (DF_TEMP or DF_RAIN, other types have no day types)
+ *   *dstats:  day statistics of column
+ *
+ * return value:
+ *   bit mask of day types (bit CLM_...: day is of this type, 0: no valid values)
+ *
+ ****************************************************************************************/
+uint32_t slg_climate_daytype (uint32_t typ, slg_dstats *dstats);
+
+
+/* adds a day type bit mask to day type counters
+ *
+ * parameters:
+ *   *cnt :  array of CLM_NUM counters
+ *   dtype:  bit mask of day types (see slg_climate_daytype())
+ *
+ ****************************************************************************************/
+void slg_climate_count (uint32_t *cnt, uint32_t dtype);
+
+
+/* counts day types of all valid days of a month (uses day statistics of month object)
+ *
+ * parameters:
+ *   *mtemper:  month temperature object
+ *   *cnt    :  resulting array of CLM_NUM counters
+ *
+ ****************************************************************************************/
+void slg_climate_mtemper (slg_mtemper *mtemper, uint32_t *cnt);
+
+
+/* counts rain days of all valid days of a month
+ *
+ * parameters:
+ *   *mrain:  month rain object
+ *   *cnt  :  resulting array of CLM_NUM counters
+ *
+ ****************************************************************************************/
+void slg_climate_mrain (slg_mrain *mrain, uint32_t *cnt);
+
+
+
+/* degree day functions ***************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* calculates heating and cooling degree days of a day from its day statistics
+ * (method CLM_DD_MEAN)
+ * - hdd = max(0, base - average), cdd = max(0, average - base)
+ *
+ * parameters:
+ *   *dstats:  day statistics
+ *   base   :  base temperature (T*10)
+ *   *hdd   :  resulting heating degree days (T*10 * days)
+ *   *cdd   :  resulting cooling degree days (T*10 * days)
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  no valid values (hdd and cdd are 0)
+ *
+ ****************************************************************************************/
+uint32_t slg_climate_dd_dstats (slg_dstats *dstats, int32_t base, int32_t *hdd, int32_t *cdd);
+
+
+/* calculates heating and cooling degree days of a day from its values
+ * - CLM_DD_MEAN: see slg_climate_dd_dstats()
+ * - CLM_DD_SLOT: hdd = average of max(0, base - value), cdd = average of max(0, value - base)
+ *   over all valid values (rounded)
+ *
+ * parameters:
+ *   *val  :  array of temperatures T*10 (CNERR: invalid value)
+ *   len   :  array length
+ *   base  :  base temperature (T*10)
+ *   method:  CLM_DD_MEAN or CLM_DD_SLOT
+ *   *hdd  :  resulting heating degree days (T*10 * days)
+ *   *cdd  :  resulting cooling degree days (T*10 * days)
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  no valid values (hdd and cdd are 0)
+ *         2 :  error: invalid method
+ *
+ ****************************************************************************************/
+uint32_t slg_climate_dd (int32_t *val, uint32_t len, int32_t base, uint32_t method, int32_t *hdd, int32_t *cdd);
+
+
+/* calculates heating and cooling degree days of a day (see slg_climate_dd())
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *   base    :  base temperature (T*10)
+ *   method  :  CLM_DD_MEAN or CLM_DD_SLOT
+ *   *hdd    :  resulting heating degree days (T*10 * days)
+ *   *cdd    :  resulting cooling degree days (T*10 * days)
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  no valid values (hdd and cdd are 0)
+ *         2 :  error: invalid method
+ *
+ ****************************************************************************************/
+uint32_t slg_climate_dtemper_dd (slg_dtemper *dtemper, int32_t base, uint32_t method, int32_t *hdd, int32_t *cdd);
+
+
+/* calculates heating and cooling degree day sums of all valid days of a month
+ * (CLM_DD_MEAN uses day statistics of month object only)
+ *
+ * parameters:
+ *   *mtemper:  month temperature object
+ *   base    :  base temperature (T*10)
+ *   method  :  CLM_DD_MEAN or CLM_DD_SLOT
+ *   *hdd    :  resulting heating degree days (T*10 * days)
+ *   *cdd    :  resulting cooling degree days (T*10 * days)
+ *
+ * return value:
+ *     0..31 :  number of days with valid values
+ *     CNERR :  error: invalid method
+ *
+ ****************************************************************************************/
+uint32_t slg_climate_mtemper_dd (slg_mtemper *mtemper, int32_t base, uint32_t method, int32_t *hdd, int32_t *cdd);
+
+
+
+#endif
+
@@ -0,0 +1,247 @@
+/***************************************************************************************************
+ *
+ * file     : slg_correl.c
+ *
+ * function : senslog project c-library - cross sensor correlation functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "slg_correl.h"
+#include "slg_values.h"
+#include "slg_temper.h"
+
+
+
+/* correlation functions **************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* calculates difference series of two series
+ *
+ * parameters:
+ *   *a   :  value array a (CNERR: invalid value)
+ *   *b   :  value array b (CNERR: invalid value)
+ *   len  :  array length
+ *   *diff:  resulting array a - b (len entries, CNERR if a or b is invalid)
+ *
+ * return value:
+ *   number of valid differences
+ *
+ ****************************************************************************************/
+uint32_t slg_correl_diff (int32_t *a, int32_t *b, uint32_t len, int32_t *diff)
+{
+  uint32_t i, valid, count;
+
+  count = 0;
+
+  /* branch free loop body */
+  for (i = 0; i < len; i++) {
+    valid = (a[i] != CNERR) & (b[i] != CNERR);
+    diff[i] = valid ? a[i] - b[i] : CNERR;
+    count += valid;
+  }
+
+  return (count);
+}
+
+
+/* clears correlation sums
+ *
+ * parameters:
+ *   *acc:  correlation sums
+ *
+ ****************************************************************************************/
+void slg_correl_clear (slg_corracc *acc)
+{
+  memset (acc, 0, sizeof(slg_corracc));
+}
+
+
+/* adds all valid pairs a[i], b[i+lag] of two series to correlation sums
+ *
+ * parameters:
+ *   *acc:  correlation sums
+ *   *a  :  value array a (CNERR: invalid value)
+ *   *b  :  value array b (CNERR: invalid value)
+ *   len :  array length
+ *   lag :  lag of b (0: same index, > 0: b later than a)
+ *
+ ****************************************************************************************/
+void slg_correl_add (slg_corracc *acc, int32_t *a, int32_t *b, uint32_t len, int32_t lag)
+{
+  uint32_t i, ib, ie, valid;
+  int64_t  va, vb, n, sa, sb, saa, sbb, sab;
+
+  /* index range of a with b[i+lag] in array */
+  ib = (lag < 0) ? (uint32_t) (- lag) : 0;
+  ie = (lag > 0) ? ((len > (uint32_t) lag) ? len - (uint32_t) lag : 0) : len;
+
+  n = 0;
+  sa = 0;
+  sb = 0;
+  saa = 0;
+  sbb = 0;
+  sab = 0;
+
+  /* masked sums: invalid pairs add zeros */
+  for (i = ib; i < ie; i++) {
+    valid = (a[i] != CNERR) & (b[(int32_t) i + lag] != CNERR);
+    va = valid ? a[i] : 0;
+    vb = valid ? b[(int32_t) i + lag] : 0;
+
+    n += valid;
+    sa += va;
+    sb += vb;
+    saa += va * va;
+    sbb += vb * vb;
+    sab += va * vb;
+  }
+
+  acc->n += n;
+  acc->sa += sa;
+  acc->sb += sb;
+  acc->saa += saa;
+  acc->sbb += sbb;
+  acc->sab += sab;
+}
+
+
+/* merges correlation sums (acc += acc2)
+ *
+ * parameters:
+ *   *acc :  correlation sums
+ *   *acc2:  correlation sums to add
+ *
+ ****************************************************************************************/
+void slg_correl_merge (slg_corracc *acc, slg_corracc *acc2)
+{
+  acc->n += acc2->n;
+  acc->sa += acc2->sa;
+  acc->sb += acc2->sb;
+  acc->saa += acc2->saa;
+  acc->sbb += acc2->sbb;
+  acc->sab += acc2->sab;
+}
+
+
+/* calculates pearson correlation coefficient from correlation sums
+ *
+ * parameters:
+ *   *acc:  correlation sums
+ *
+ * return value:
+ *   CNERR :  undefined (less than 2 pairs or a series is constant)
+ *   other :  correlation coefficient in permille (-1000..1000)
+ *
+ ****************************************************************************************/
+int32_t slg_correl_coeff (slg_corracc *acc)
+{
+  int64_t  cov, vara, varb;
+  uint32_t q, r;
+  double   d;
+
+  if (acc->n < 2) return (CNERR);
+
+  cov = acc->n * acc->sab - acc->sa * acc->sb;
+  vara = acc->n * acc->saa - acc->sa * acc->sa;
+  varb = acc->n * acc->sbb - acc->sb * acc->sb;
+  if ((vara <= 0) || (varb <= 0)) return (CNERR);
+
+  /* r^2 * 10^6, square root by integer search (no libm) */
+  d = ((double) cov * (double) cov * 1000000.0) / ((double) vara * (double) varb);
+  q = (d >= 1000000.0) ? 1000000 : (uint32_t) (d + 0.5);
+
+  r = 0;
+  while ((r + 1) * (r + 1) <= q) r++;
+  if (q - r * r > r) r++;
+
+  return ((cov < 0) ? - (int32_t) r : (int32_t) r);
+}
+
+
+/* calculates difference statistics, correlation and best lag of two series
+ *
+ * parameters:
+ *   *a     :  value array a (CNERR: invalid value)
+ *   *b     :  value array b (CNERR: invalid value)
+ *   len    :  array length
+ *   maxlag :  lags -maxlag..maxlag are searched (0..COR_MAX_LAG)
+ *   *correl:  resulting correlation object
+ *
+ * return value:
+ *    0 :  successfull
+ *    1 :  error: invalid max. lag
+ *
+ ****************************************************************************************/
+uint32_t slg_correl_series (int32_t *a, int32_t *b, uint32_t len, uint32_t maxlag, slg_correl *correl)
+{
+  slg_corracc acc;
+  int32_t     l, s, r;
+  uint32_t    i, valid;
+  int32_t     v, sum, min, max;
+
+  if (maxlag > COR_MAX_LAG) return (1);
+
+  /* statistics of difference series (single pass, no array needed) */
+  correl->diff.count = 0;
+  sum = 0;
+  min = CNERR;
+  max = - CNERR;
+  correl->diff.indmin = 0;
+  correl->diff.indmax = 0;
+  for (i = 0; i < len; i++) {
+    valid = (a[i] != CNERR) & (b[i] != CNERR);
+    if (valid == 0) continue;
+
+    v = a[i] - b[i];
+    correl->diff.count++;
+    sum += v;
+    if (v <= min) {
+      min = v;
+      correl->diff.indmin = i;
+    }
+    if (v >= max) {
+      max = v;
+      correl->diff.indmax = i;
+    }
+  }
+  correl->diff.sum = sum;
+  correl->diff.min = (correl->diff.count) ? min : CNERR;
+  correl->diff.max = (correl->diff.count) ? max : CNERR;
+
+  /* lag 0 */
+  slg_correl_clear (&acc);
+  slg_correl_add (&acc, a, b, len, 0);
+  correl->count = (uint32_t) acc.n;
+  correl->r = slg_correl_coeff (&acc);
+  correl->lag = 0;
+  correl->rlag = correl->r;
+
+  /* lag search from 0 outwards, first highest coefficient wins (smallest lag) */
+  for (l = 1; l <= (int32_t) maxlag; l++) {
+    for (s = -1; s <= 1; s += 2) {
+      slg_correl_clear (&acc);
+      slg_correl_add (&acc, a, b, len, s * l);
+      r = slg_correl_coeff (&acc);
+      if (r == CNERR) continue;
+
+      if ((correl->rlag == CNERR) || (r > correl->rlag)) {
+        correl->rlag = r;
+        correl->lag = s * l;
+      }
+    }
+  }
+
+  return (0);
+}
+
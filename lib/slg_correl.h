@@ -0,0 +1,140 @@
+/***************************************************************************************************
+ *
+ * file     : slg_correl.h
+ *
+ * function : senslog project c-library - cross sensor correlation functions
+ *            - difference series of two value series (e.g. two temperature columns)
+ *            - pearson correlation coefficient of two series in permille, only pairs with
+ *              two valid values are used
+ *            - correlation over time lags to find the delay between two sensors
+ *            - sums are mergeable, so day sums can be added to month and year sums
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_temper.h"
+
+
+#ifndef _slg_correl_h
+#define _slg_correl_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define COR_MAX_LAG   (4 * MAX_MLN_NUM)   /* max. lag of lag search (time indices) */
+
+
+/* correlation sums of a pair of series */
+typedef struct {
+  int64_t   n;            /* number of valid pairs */
+  int64_t   sa;           /* sum of a */
+  int64_t   sb;           /* sum of b */
+  int64_t   saa;          /* sum of a*a */
+  int64_t   sbb;          /* sum of b*b */
+  int64_t   sab;          /* sum of a*b */
+} slg_corracc;
+
+
+/* correlation result of a pair of series */
+typedef struct {
+  uint32_t    count;      /* number of valid pairs (lag 0) */
+  int32_t     r;          /* correlation coefficient of lag 0 (permille, CNERR: undefined) */
+  int32_t     lag;        /* lag with highest correlation coefficient (b[i+lag] to a[i]) */
+  int32_t     rlag;       /* correlation coefficient of lag (permille, CNERR: undefined) */
+  slg_dstats  diff;       /* statistics of difference series a - b */
+} slg_correl;
+
+
+
+/* correlation functions **************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* calculates difference series of two series
+ *
+ * parameters:
+ *   *a   :  value array a (CNERR: invalid value)
+ *   *b   :  value array b (CNERR: invalid value)
+ *   len  :  array length
+ *   *diff:  resulting array a - b (len entries, CNERR if a or b is invalid)
+ *
+ * return value:
+ *   number of valid differences
+ *
+ ****************************************************************************************/
+uint32_t slg_correl_diff (int32_t *a, int32_t *b, uint32_t len, int32_t *diff);
+
+
+/* clears correlation sums
+ *
+ * parameters:
+ *   *acc:  correlation sums
+ *
+ ****************************************************************************************/
+void slg_correl_clear (slg_corracc *acc);
+
+
+/* adds all valid pairs a[i], b[i+lag] of two series to correlation sums
+ *
+ * parameters:
+ *   *acc:  correlation sums
+ *   *a  :  value array a (CNERR: invalid value)
+ *   *b  :  value array b (CNERR: invalid value)
+ *   len :  array length
+ *   lag :  lag of b (0: same index, > 0: b later than a)
+ *
+ ****************************************************************************************/
+void slg_correl_add (slg_corracc *acc, int32_t *a, int32_t *b, uint32_t len, int32_t lag);
+
+
+/* merges correlation sums (acc += acc2)
+ *
+ * parameters:
+ *   *acc :  correlation sums
+ *   *acc2:  correlation sums to add
+ *
+ ****************************************************************************************/
+void slg_correl_merge (slg_corracc *acc, slg_corracc *acc2);
+
+
+/* calculates pearson correlation coefficient from correlation sums
+ *
+ * parameters:
+ *   *acc:  correlation sums
+ *
+ * return value:
+ *   CNERR :  undefined (less than 2 pairs or a series is constant)
+ *   other :  correlation coefficient in permille (-1000..1000)
+ *
+ ****************************************************************************************/
+int32_t slg_correl_coeff (slg_corracc *acc);
+
+
+/* calculates difference statistics, correlation and best lag of two series
+ *
+ * parameters:
+ *   *a     :  value array a (CNERR: invalid value)
+ *   *b     :  value array b (CNERR: invalid value)
+ *   len    :  array length
+ *   maxlag :  lags -maxlag..maxlag are searched (0..COR_MAX_LAG)
+ *   *correl:  resulting correlation object
+ *
+ * return value:
+ *    0 :  successfull
+ *    1 :  error: invalid max. lag
+ *
+ ****************************************************************************************/
+uint32_t slg_correl_series (int32_t *a, int32_t *b, uint32_t len, uint32_t maxlag, slg_correl *correl);
+
+
+
+#endif
+
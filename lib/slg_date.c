@@ -7,7 +7,7 @@
  * author   : Jochen Ertel
  *
  * created  : 07.01.2020
- * updated  : 06.01.2022
+ * updated  : 18.10.2026
  *
  **************************************************************************************************/
 
@@ -72,6 +72,37 @@ uint32_t slg_date_is_valid (slg_date *date)
 
 
 
+/* converts a number of days since 01.01.1970 into a date (civil calendar in O(1))
+ * - no range check, any 32 bit day count can be converted
+ * - years are counted from 01.03., so the leap day is the last day of a year and
+ *   month lengths follow a fixed pattern (153 days per 5 months)
+ *
+ * parameters:
+ *   *date:  pointer to date variable for result
+ *   days :  number of days since 01.01.1970 (0: 01.01.1970)
+ *
+ * return value:
+ *   -
+ *
+ ****************************************************************************************/
+static void slg_date_civil (slg_date *date, uint32_t days)
+{
+  uint32_t z, era, doe, yoe, doy, mp;
+
+  z = days + 719468;                                              /* days since 01.03.0000 */
+  era = z / 146097;                                               /* 400 year era */
+  doe = z - era * 146097;                                         /* day of era (0..146096) */
+  yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;    /* year of era (0..399) */
+  doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                  /* day of year from 01.03. (0..365) */
+  mp = (5 * doy + 2) / 153;                                       /* month from March (0..11) */
+
+  date->d = doy - (153 * mp + 2) / 5 + 1;
+  date->m = (mp < 10) ? mp + 3 : mp - 9;
+  date->y = era * 400 + yoe + ((date->m <= 2) ? 1 : 0);
+}
+
+
+
 /* calculates unix-time of a date and checks correct date value:
  * - calculates unix-time-value of 12 o'clock (noon) MEZ of the date
  * - example: 01.01.1970 -> 11 * 3600 seconds = 39.600
@@ -87,23 +118,14 @@ uint32_t slg_date_is_valid (slg_date *date)
  ****************************************************************************************/
 uint32_t slg_date_to_unix (slg_date *date)
 {
-  uint32_t days_acc[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
-  uint32_t num_leap_years, num_days, num_seconds;
-
-  /* at first check if date is a valid one */
-  if (! slg_date_is_valid (date)) return (0);
-
-  /* number of leap years since 1970 */
-  num_leap_years = ((date->y-1)-1968)/4 - ((date->y-1)-1900)/100 + ((date->y-1)-1600)/400;
+  uint32_t dnum;
 
-  /* number of days since 01.01.1970 */
-  num_days = (date->y-1970)*365 + num_leap_years + days_acc[date->m-1] + date->d-1;
-  if ((date->m > 2) && (slg_year_is_leap(date->y))) num_days += 1;
+  /* convert date to day number and check it inherently */
+  dnum = slg_date_to_dnum (date);
+  if (dnum == 0) return (0);
 
   /* unix-time of date at 12:00 o'clock MEZ (11:00 o'clock UTC) */
-  num_seconds = 86400 * num_days + 39600;
-
-  return (num_seconds);
+  return (86400 * (dnum - DATE_DNUM_MIN) + 39600);
 }
 
 
@@ -122,43 +144,14 @@ uint32_t slg_date_to_unix (slg_date *date)
  ****************************************************************************************/
 void slg_unix_to_date (slg_date *date, uint32_t unix_time)
 {
-  /* this array contains day-numbers of 31.12. of all leap years */
-  uint32_t leap_days[33] = {1095, 2556, 4017, 5478, 6939, 8400, 9861, 11322, 12783, 14244,
-                            15705, 17166, 18627, 20088, 21549, 23010, 24471, 25932, 27393,
-                            28854, 30315, 31776, 33237, 34698, 36159, 37620, 39081, 40542,
-                            42003, 43464, 44925, 46386, 49307};
-  uint32_t dpm[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-  uint32_t mez, num_days, num_leap_years, num_days_year, i;
+  uint32_t mez;
 
   /* add time shift between MEZ and UTC */
   mez = unix_time + 3600;
   if (mez < 3600) mez = 0xffffffff;   /* handle overflow */
 
-  /* number of days since 01.01.1970 */
-  num_days = mez / 86400;
-
-  /* look for number of leap years occured before, except current year */
-  i = 0;
-  while ((leap_days[i] < num_days) && (i < 33)) i++;
-  num_leap_years = i;
-
-  /* calculate year */
-  date->y = ((num_days - num_leap_years) / 365) + 1970;
-  if (num_leap_years < 33) {
-    if (leap_days[num_leap_years] == num_days) date->y -= 1;
-  }
-
-  /* calculate month and day */
-  num_days_year = num_days - num_leap_years - (date->y - 1970) * 365;
-  if (slg_year_is_leap(date->y)) dpm[1] = 29;
-
-  i = 0;
-  while (dpm[i] <= num_days_year) {
-    num_days_year -= dpm[i];
-    i++;
-  }
-  date->m = i + 1;
-  date->d = num_days_year + 1;
+  /* convert number of days since 01.01.1970 */
+  slg_date_civil (date, mez / 86400);
 }
 
 
@@ -288,39 +281,108 @@ void slg_date_copy (slg_date *date_d, slg_date *date_s)
 
 
 
-/* increases a date by one day
- * - maximum date value supported is 31.12.2105
+/* converts a date into its day number (O(1))
+ * - day numbers are counted serially from 01.01.1970 (DATE_DNUM_MIN) to 31.12.2105
+ *   (DATE_DNUM_MAX), so the difference of two day numbers is the number of days between
+ *   the dates
  *
  * parameters:
- *   *date:      pointer to date to be increased
+ *   *date:  pointer to date
  *
  * return value:
- *   0 :  in error case (date is invalid or date overflow)
+ *   0   :  in error case (date is invalid)
+ *   > 0 :  day number
+ *
+ ****************************************************************************************/
+uint32_t slg_date_to_dnum (slg_date *date)
+{
+  uint32_t y, era, yoe, doy, mp;
+
+  if (! slg_date_is_valid (date)) return (0);
+
+  /* count years from 01.03. (leap day is last day of year) */
+  y = date->y - ((date->m <= 2) ? 1 : 0);
+  era = y / 400;                                                  /* 400 year era */
+  yoe = y - era * 400;                                            /* year of era (0..399) */
+  mp = (date->m + 9) % 12;                                        /* month from March (0..11) */
+  doy = (153 * mp + 2) / 5 + date->d - 1;                         /* day of year from 01.03. (0..365) */
+
+  /* days since 01.03.0000 minus days from 01.03.0000 to 01.01.1970 */
+  return (era * 146097 + yoe * 365 + yoe / 4 - yoe / 100 + doy - 719468 + DATE_DNUM_MIN);
+}
+
+
+
+/* sets a date from a day number (O(1))
+ *
+ * parameters:
+ *   *date:  pointer to result date (unchanged in error case)
+ *   dnum :  day number (DATE_DNUM_MIN .. DATE_DNUM_MAX, see slg_date_to_dnum())
+ *
+ * return value:
+ *   0 :  in error case (day number out of range)
  *   1 :  ok
  *
  ****************************************************************************************/
-uint32_t slg_date_inc (slg_date *date)
+uint32_t slg_date_from_dnum (slg_date *date, uint32_t dnum)
 {
-  uint32_t udate;
+  if ((dnum < DATE_DNUM_MIN) || (dnum > DATE_DNUM_MAX)) return (0);
 
-  /* convert date to unix time and check it inherently */
-  udate = slg_date_to_unix (date);
-  if (udate == 0) return (0);
+  slg_date_civil (date, dnum - DATE_DNUM_MIN);
 
-  /* check for date overflow */
-  if ((date->y == 2105) && (date->m == 12) && (date->d == 31)) return (0);
+  return (1);
+}
 
-  /* increase by one day */
-  udate += 86400;
 
-  /* reconvert to date */
-  slg_unix_to_date (date, udate);
+
+/* adds a number of days to a date (O(1))
+ * - supported date range is 01.01.1970 .. 31.12.2105
+ *
+ * parameters:
+ *   *date:  pointer to date to be changed (unchanged in error case)
+ *   n    :  number of days (negative: date is decreased)
+ *
+ * return value:
+ *   0 :  in error case (date is invalid or result is out of range)
+ *   1 :  ok
+ *
+ ****************************************************************************************/
+uint32_t slg_date_add (slg_date *date, int32_t n)
+{
+  int64_t dnum;
+
+  /* convert date to day number and check it inherently */
+  dnum = (int64_t) slg_date_to_dnum (date);
+  if (dnum == 0) return (0);
+
+  dnum += n;
+  if ((dnum < DATE_DNUM_MIN) || (dnum > DATE_DNUM_MAX)) return (0);
+
+  slg_date_civil (date, (uint32_t) dnum - DATE_DNUM_MIN);
 
   return (1);
 }
 
 
 
+/* increases a date by one day
+ * - maximum date value supported is 31.12.2105
+ *
+ * parameters:
+ *   *date:      pointer to date to be increased
+ *
+ * return value:
+ *   0 :  in error case (date is invalid or date overflow)
+ *   1 :  ok
+ *
+ ****************************************************************************************/
+uint32_t slg_date_inc (slg_date *date)
+{
+  return (slg_date_add (date, 1));
+}
+
+
+
 /* decreases a date by one day
  * - minimum date value supported is 01.01.1970
  *
@@ -334,22 +396,7 @@ uint32_t slg_date_inc (slg_date *date)
  ****************************************************************************************/
 uint32_t slg_date_dec (slg_date *date)
 {
-  uint32_t udate;
-
-  /* convert date to unix time and check it inherently */
-  udate = slg_date_to_unix (date);
-  if (udate == 0) return (0);
-
-  /* check for date underflow */
-  if ((date->y == 1970) && (date->m == 1) && (date->d == 1)) return (0);
-
-  /* decrease by one day */
-  udate -= 86400;
-
-  /* reconvert to date */
-  slg_unix_to_date (date, udate);
-
-  return (1);
+  return (slg_date_add (date, -1));
 }
 
 
@@ -366,20 +413,15 @@ uint32_t slg_date_dec (slg_date *date)
  ****************************************************************************************/
 int32_t slg_date_sub (slg_date *date_a, slg_date *date_b)
 {
-  uint32_t udate_a, udate_b;
-  int32_t  nda, ndb;
+  uint32_t dnum_a, dnum_b;
 
-  /* convert dates to unix time and check them inherently */
-  udate_a = slg_date_to_unix (date_a);
-  if (udate_a == 0) return (0);
-  udate_b = slg_date_to_unix (date_b);
-  if (udate_b == 0) return (0);
+  /* convert dates to day numbers and check them inherently */
+  dnum_a = slg_date_to_dnum (date_a);
+  if (dnum_a == 0) return (0);
+  dnum_b = slg_date_to_dnum (date_b);
+  if (dnum_b == 0) return (0);
 
-  /* convert unix time in day offset */
-  nda = (int32_t) ((udate_a - 39600) / 86400);
-  ndb = (int32_t) ((udate_b - 39600) / 86400);
-
-  return (nda - ndb);
+  return ((int32_t) dnum_a - (int32_t) dnum_b);
 }
 
 
@@ -397,17 +439,14 @@ int32_t slg_date_sub (slg_date *date_a, slg_date *date_b)
  ****************************************************************************************/
 uint32_t slg_date_dow (char *dowstr, slg_date *date)
 {
-  uint32_t udate, dow;
-
-  /* convert date to unix time and check it inherently */
-  udate = slg_date_to_unix (date);
-  if (udate == 0) return (0);
+  uint32_t dnum, dow;
 
-  /* calculate day number */
-  udate = udate / 86400;
+  /* convert date to day number and check it inherently */
+  dnum = slg_date_to_dnum (date);
+  if (dnum == 0) return (0);
 
   /* calculate day of week (1.1.1970 was Donnerstag) */
-  dow = ((udate + 3) % 7) + 1;
+  dow = ((dnum + 2) % 7) + 1;
 
   /* print string */
   if (dowstr != NULL) {
@@ -437,34 +476,28 @@ uint32_t slg_date_dow (char *dowstr, slg_date *date)
  ****************************************************************************************/
 uint32_t slg_date_is_summertime (slg_date *date)
 {
-  slg_date date_first, date_last;
-  uint32_t udate, udate_first, udate_last;
-
-  /* convert date to unix time and check it inherently */
-  udate = slg_date_to_unix (date);
-  if (udate == 0) return (0);
-
-  /* get first date of summertime in target year (last Sonntag in March) */
-  date_first.y = date->y;
-  date_first.m = 3;
-  date_first.d = 25; /* the earliest summertime day of year possible */
-  while ((slg_date_dow (NULL, &date_first)) != 7) {
-    slg_date_inc (&date_first);
-  }
-  udate_first = slg_date_to_unix (&date_first);
-
-  /* get last date of summertime in target year (last Sonntag in October) */
-  date_last.y = date->y;
-  date_last.m = 10;
-  date_last.d = 25; /* the earliest normaltime day in autumn possible */
-  while ((slg_date_dow (NULL, &date_last)) != 7) {
-    slg_date_inc (&date_last);
-  }
-  slg_date_dec (&date_last);
-  udate_last = slg_date_to_unix (&date_last);
+  slg_date date_t;
+  uint32_t dnum, dnum_first, dnum_last;
+
+  /* convert date to day number and check it inherently */
+  dnum = slg_date_to_dnum (date);
+  if (dnum == 0) return (0);
+
+  /* get first date of summertime in target year (last Sonntag in March),
+   * (dnum + 3) % 7 is the number of days since the last Sonntag */
+  date_t.y = date->y;
+  date_t.m = 3;
+  date_t.d = 31;
+  dnum_first = slg_date_to_dnum (&date_t);
+  dnum_first -= (dnum_first + 3) % 7;
+
+  /* get first date of normaltime in target year (last Sonntag in October) */
+  date_t.m = 10;
+  dnum_last = slg_date_to_dnum (&date_t);
+  dnum_last -= (dnum_last + 3) % 7;
 
   /* check for summertime */
-  if ((udate >= udate_first) && (udate <= udate_last)) {
+  if ((dnum >= dnum_first) && (dnum < dnum_last)) {
     return (1);
   }
 
@@ -488,18 +521,18 @@ uint32_t slg_date_is_summertime (slg_date *date)
  ****************************************************************************************/
 uint32_t slg_date_compare (slg_date *date_a, slg_date *date_b)
 {
-  uint32_t udate_a, udate_b;
+  uint32_t dnum_a, dnum_b;
 
-  /* convert dates to unix time and check them inherently */
-  udate_a = slg_date_to_unix (date_a);
-  if (udate_a == 0) return (0);
-  udate_b = slg_date_to_unix (date_b);
-  if (udate_b == 0) return (0);
+  /* convert dates to day numbers and check them inherently */
+  dnum_a = slg_date_to_dnum (date_a);
+  if (dnum_a == 0) return (0);
+  dnum_b = slg_date_to_dnum (date_b);
+  if (dnum_b == 0) return (0);
 
   /* compare the dates */
-  if (udate_a == udate_b) return (1);
-  if (udate_a < udate_b)  return (2);
-  if (udate_a > udate_b)  return (3);
+  if (dnum_a == dnum_b) return (1);
+  if (dnum_a < dnum_b)  return (2);
+  if (dnum_a > dnum_b)  return (3);
 
   return (0);
 }
@@ -522,7 +555,7 @@ uint32_t slg_date_number_days_in_month (slg_date *date)
   uint32_t result;
 
   /* check date */
-  if (slg_date_to_unix (date) == 0) return (0);
+  if (! slg_date_is_valid (date)) return (0);
 
   /* calculate number of days */
   result = dpm[date->m -1];
@@ -548,7 +581,7 @@ uint32_t slg_date_number_days_in_year (slg_date *date)
   uint32_t result;
 
   /* check date */
-  if (slg_date_to_unix (date) == 0) return (0);
+  if (! slg_date_is_valid (date)) return (0);
 
   /* calculate number of days */
   result = 365;
@@ -573,30 +606,20 @@ uint32_t slg_date_number_days_in_year (slg_date *date)
 uint32_t slg_date_to_string (char *str, slg_date *date)
 {
   /* check date */
-  if (slg_date_to_unix (date) == 0) return (0);
-
-  /* make string */
-  if (date->d < 10) {
-    str[0] = '0';
-    sprintf (&str[1], "%lu", (unsigned long) date->d);
-  }
-  else {
-    sprintf (&str[0], "%lu", (unsigned long) date->d);
-  }
+  if (! slg_date_is_valid (date)) return (0);
 
+  /* make string (day and month with 2 digits, year with 4 digits) */
+  str[0] = (char) ('0' + date->d / 10);
+  str[1] = (char) ('0' + date->d % 10);
   str[2] = '.';
-
-  if (date->m < 10) {
-    str[3] = '0';
-    sprintf (&str[4], "%lu", (unsigned long) date->m);
-  }
-  else {
-    sprintf (&str[3], "%lu", (unsigned long) date->m);
-  }
-
+  str[3] = (char) ('0' + date->m / 10);
+  str[4] = (char) ('0' + date->m % 10);
   str[5] = '.';
-
-  sprintf (&str[6], "%lu", (unsigned long) date->y);
+  str[6] = (char) ('0' + date->y / 1000);
+  str[7] = (char) ('0' + (date->y / 100) % 10);
+  str[8] = (char) ('0' + (date->y / 10) % 10);
+  str[9] = (char) ('0' + date->y % 10);
+  str[10] = 0x00;
 
   return (1);
 }
@@ -617,30 +640,20 @@ uint32_t slg_date_to_string (char *str, slg_date *date)
 uint32_t slg_date_to_fstring (char *str, slg_date *date)
 {
   /* check date */
-  if (slg_date_to_unix (date) == 0) return (0);
-
-  /* make string */
-  sprintf (&str[0], "%lu", (unsigned long) date->y);
+  if (! slg_date_is_valid (date)) return (0);
 
+  /* make string (year with 4 digits, month and day with 2 digits) */
+  str[0] = (char) ('0' + date->y / 1000);
+  str[1] = (char) ('0' + (date->y / 100) % 10);
+  str[2] = (char) ('0' + (date->y / 10) % 10);
+  str[3] = (char) ('0' + date->y % 10);
   str[4] = '-';
-
-  if (date->m < 10) {
-    str[5] = '0';
-    sprintf (&str[6], "%lu", (unsigned long) date->m);
-  }
-  else {
-    sprintf (&str[5], "%lu", (unsigned long) date->m);
-  }
-
+  str[5] = (char) ('0' + date->m / 10);
+  str[6] = (char) ('0' + date->m % 10);
   str[7] = '-';
-
-  if (date->d < 10) {
-    str[8] = '0';
-    sprintf (&str[9], "%lu", (unsigned long) date->d);
-  }
-  else {
-    sprintf (&str[8], "%lu", (unsigned long) date->d);
-  }
+  str[8] = (char) ('0' + date->d / 10);
+  str[9] = (char) ('0' + date->d % 10);
+  str[10] = 0x00;
 
   return (1);
 }
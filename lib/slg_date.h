@@ -3,15 +3,17 @@
  * file     : slg_date.h
  *
  * function : senslog project c-library - date functions
- *            - all calculations base on unix-time in 32 bit unsigned integer format
- *            - so, these functions here support a date range from 1970 to 2105
+ *            - all calculations base on serial day numbers (01.01.1970 -> day number 1),
+ *              which are converted from and to dates in O(1)
+ *            - the date range from 1970 to 2105 is kept from unix-time in 32 bit unsigned
+ *              integer format
  *            - date and time are related to MEZ only (unix-time 0 -> 01.01.1970 01:00 o'clock)
  *            - for output strings German language is supported only
  *
  * author   : Jochen Ertel
  *
  * created  : 07.01.2020
- * updated  : 06.01.2022
+ * updated  : 18.10.2026
  *
  **************************************************************************************************/
 
@@ -22,10 +24,14 @@
 #define _slg_date_h
 
 
-/* structures *************************************************************************************/
+/* defines and structures *************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
 
+# define DATE_DNUM_MIN  1        /* day number of 01.01.1970 */
+# define DATE_DNUM_MAX  49673    /* day number of 31.12.2105 */
+
+
 /* date structure (is empty if all values are zero) */
 typedef struct {
   uint32_t y;    /* year */
@@ -98,6 +104,51 @@ void slg_date_set_today (slg_date *date);
 void slg_date_copy (slg_date *date_d, slg_date *date_s);
 
 
+/* converts a date into its day number (O(1))
+ * - day numbers are counted serially from 01.01.1970 (DATE_DNUM_MIN) to 31.12.2105
+ *   (DATE_DNUM_MAX), so the difference of two day numbers is the number of days between
+ *   the dates
+ *
+ * parameters:
+ *   *date:  pointer to date
+ *
+ * return value:
+ *   0   :  in error case (date is invalid)
+ *   > 0 :  day number
+ *
+ ****************************************************************************************/
+uint32_t slg_date_to_dnum (slg_date *date);
+
+
+/* sets a date from a day number (O(1))
+ *
+ * parameters:
+ *   *date:  pointer to result date (unchanged in error case)
+ *   dnum :  day number (DATE_DNUM_MIN .. DATE_DNUM_MAX, see slg_date_to_dnum())
+ *
+ * return value:
+ *   0 :  in error case (day number out of range)
+ *   1 :  ok
+ *
+ ****************************************************************************************/
+uint32_t slg_date_from_dnum (slg_date *date, uint32_t dnum);
+
+
+/* adds a number of days to a date (O(1))
+ * - supported date range is 01.01.1970 .. 31.12.2105
+ *
+ * parameters:
+ *   *date:  pointer to date to be changed (unchanged in error case)
+ *   n    :  number of days (negative: date is decreased)
+ *
+ * return value:
+ *   0 :  in error case (date is invalid or result is out of range)
+ *   1 :  ok
+ *
+ ****************************************************************************************/
+uint32_t slg_date_add (slg_date *date, int32_t n);
+
+
 /* increases a date by one day
  * - maximum date value supported is 31.12.2105
  *
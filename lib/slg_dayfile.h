@@ -7,7 +7,7 @@
  * author   : Jochen Ertel
  *
  * created  : 26.06.2021
- * updated  : 21.08.2024
+ * updated  : 18.10.2026
  *
  **************************************************************************************************/
 
@@ -28,6 +28,7 @@
 # define MAX_MLN_NUM    96    /* max. number of measurement lines */
 # define MAX_MLN_VALS   16    /* max. number of measurement lines */
 # define MAX_MLN_LEN   150    /* max. line length of measurement lines +1 */
+# define MAX_MLN_BMW   ((MAX_MLN_NUM + 31) / 32)   /* number of 32 bit words of a line bitmap */
 
 # define DF_TEMP 1
 # define DF_RAIN 2
@@ -119,6 +120,40 @@ uint32_t slg_writedayfile (char *filename, slg_daydata *daydata, uint32_t mode);
 
 
 
+/* measurement line functions *********************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+
+/* counts number of values in a measurement value line (separated by spaces)
+ *
+ * parameters:
+ *   *line:  pointer to line
+ *
+ * return value:
+ *    <num> :  number of values
+ *
+ ****************************************************************************************/
+uint32_t slg_mlnumval (char *line);
+
+
+/* cuts a value string from a measurement value line (separated by spaces)
+ *
+ * parameters:
+ *   *value:  pointer for resulting value string (12 bytes must be allocated)
+ *   *line :  pointer to line string
+ *   k     :  value number (0, 1, 2, ...)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: value string to long (longer than 11 chars)
+ *    2 :  error: line does contain lower than (k+1) values
+ *
+ ****************************************************************************************/
+uint32_t slg_mlgetval (char *value, char *line, uint32_t k);
+
+
+
 /* dayfile checker functions **********************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
@@ -0,0 +1,248 @@
+/***************************************************************************************************
+ *
+ * file     : slg_downsample.c
+ *
+ * function : senslog project c-library - downsampling functions for charts
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "slg_downsample.h"
+#include "slg_values.h"
+
+
+
+/* private functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* calculates min. and max. index of valid values of a bucket
+ *
+ * parameters:
+ *   *val :  array of values (CNERR: invalid value)
+ *   ib   :  first index of bucket
+ *   ie   :  last index of bucket + 1
+ *   *imin:  resulting index of min. value (newest one)
+ *   *imax:  resulting index of max. value (newest one)
+ *
+ * return value:
+ *    0 :  successfull
+ *    1 :  no valid values in bucket
+ *
+ ****************************************************************************************/
+static uint32_t slg_dsmp_bucket (int32_t *val, uint32_t ib, uint32_t ie, uint32_t *imin, uint32_t *imax)
+{
+  uint32_t i, found;
+
+  found = 0;
+  for (i = ib; i < ie; i++) {
+    if (val[i] == CNERR) continue;
+
+    if ((found == 0) || (val[i] <= val[*imin])) *imin = i;
+    if ((found == 0) || (val[i] >= val[*imax])) *imax = i;
+    found = 1;
+  }
+
+  return (found ? 0 : 1);
+}
+
+
+
+/* downsampling functions *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* calculates min./max. envelope of a series
+ * - series is split into bnum buckets of (almost) equal length, bucket b holds the
+ *   indices len*b/bnum .. len*(b+1)/bnum-1
+ *
+ * parameters:
+ *   *val :  array of values (CNERR: invalid value)
+ *   len  :  array length
+ *   bnum :  number of buckets (1..len)
+ *   *emin:  resulting array of bnum bucket min. values (CNERR: no valid value in bucket)
+ *   *emax:  resulting array of bnum bucket max. values (CNERR: no valid value in bucket)
+ *
+ * return value:
+ *   CNERR :  error: invalid number of buckets
+ *   other :  number of buckets with valid values
+ *
+ ****************************************************************************************/
+uint32_t slg_downsample_envelope (int32_t *val, uint32_t len, uint32_t bnum, int32_t *emin, int32_t *emax)
+{
+  uint32_t b, ib, ie, imin, imax, num;
+
+  if ((bnum == 0) || (bnum > len)) return (CNERR);
+
+  num = 0;
+  for (b = 0; b < bnum; b++) {
+    ib = (uint32_t) (((uint64_t) len * b) / bnum);
+    ie = (uint32_t) (((uint64_t) len * (b + 1)) / bnum);
+
+    if (slg_dsmp_bucket (val, ib, ie, &imin, &imax) == 0) {
+      emin[b] = val[imin];
+      emax[b] = val[imax];
+      num++;
+    }
+    else {
+      emin[b] = CNERR;
+      emax[b] = CNERR;
+    }
+  }
+
+  return (num);
+}
+
+
+/* downsamples a series to min./max. points of bnum buckets
+ * - each bucket with valid values gives its min. and max. point in order of index
+ *   (one point if both are the same), so at most 2*bnum points result
+ *
+ * parameters:
+ *   *val :  array of values (CNERR: invalid value)
+ *   len  :  array length
+ *   bnum :  number of buckets (1..len)
+ *   *pt  :  resulting array of points (2*bnum entries needed)
+ *
+ * return value:
+ *   CNERR :  error: invalid number of buckets
+ *   other :  number of points
+ *
+ ****************************************************************************************/
+uint32_t slg_downsample_minmax (int32_t *val, uint32_t len, uint32_t bnum, slg_dpoint *pt)
+{
+  uint32_t b, ib, ie, i1, i2, num;
+
+  if ((bnum == 0) || (bnum > len)) return (CNERR);
+
+  num = 0;
+  for (b = 0; b < bnum; b++) {
+    ib = (uint32_t) (((uint64_t) len * b) / bnum);
+    ie = (uint32_t) (((uint64_t) len * (b + 1)) / bnum);
+
+    if (slg_dsmp_bucket (val, ib, ie, &i1, &i2) != 0) continue;
+
+    /* keep order of index */
+    if (i1 > i2) {
+      ib = i1;
+      i1 = i2;
+      i2 = ib;
+    }
+
+    pt[num].x = i1;
+    pt[num].y = val[i1];
+    num++;
+
+    if (i2 != i1) {
+      pt[num].x = i2;
+      pt[num].y = val[i2];
+      num++;
+    }
+  }
+
+  return (num);
+}
+
+
+/* downsamples a series with largest triangle three buckets algorithm
+ * - first and last valid value are kept, the valid values between are split into pnum-2
+ *   buckets, of each bucket the point with largest triangle area to the previous selected
+ *   point and the average of the next bucket is selected
+ * - if the series has not more than pnum valid values, all valid values are returned
+ *
+ * parameters:
+ *   *val:  array of values (CNERR: invalid value)
+ *   len :  array length
+ *   pnum:  number of points (>= 3)
+ *   *pt :  resulting array of points (pnum entries needed)
+ *
+ * return value:
+ *   CNERR :  error: invalid number of points or out of memory
+ *   other :  number of points
+ *
+ ****************************************************************************************/
+uint32_t slg_downsample_lttb (int32_t *val, uint32_t len, uint32_t pnum, slg_dpoint *pt)
+{
+  uint32_t *ind;
+  uint32_t i, n, b, nb, ib, ie, nie, k, sel, num;
+  int64_t  ax, ay, sx, sy, cnt, area, amax;
+
+  if (pnum < 3) return (CNERR);
+
+  /* list of indices of valid values */
+  ind = (uint32_t *) malloc ((len + 1) * sizeof(uint32_t));
+  if (ind == NULL) return (CNERR);
+
+  n = 0;
+  for (i = 0; i < len; i++) {
+    if (val[i] != CNERR) ind[n++] = i;
+  }
+
+  if (n <= pnum) {
+    for (i = 0; i < n; i++) {
+      pt[i].x = ind[i];
+      pt[i].y = val[ind[i]];
+    }
+    free (ind);
+    return (n);
+  }
+
+  /* first point */
+  pt[0].x = ind[0];
+  pt[0].y = val[ind[0]];
+  num = 1;
+
+  /* buckets of inner points: bucket b holds list entries 1+(n-2)*b/nb .. 1+(n-2)*(b+1)/nb-1 */
+  nb = pnum - 2;
+  for (b = 0; b < nb; b++) {
+    ib = 1 + (uint32_t) (((uint64_t) (n - 2) * b) / nb);
+    ie = 1 + (uint32_t) (((uint64_t) (n - 2) * (b + 1)) / nb);
+
+    /* sums of next bucket (last point for last bucket) */
+    nie = (b + 1 < nb) ? 1 + (uint32_t) (((uint64_t) (n - 2) * (b + 2)) / nb) : n;
+    sx = 0;
+    sy = 0;
+    for (k = ie; k < nie; k++) {
+      sx += ind[k];
+      sy += val[ind[k]];
+    }
+    cnt = (int64_t) (nie - ie);
+
+    /* point with largest triangle area (doubled and scaled by cnt, integer only) */
+    ax = pt[num - 1].x;
+    ay = pt[num - 1].y;
+    sel = ib;
+    amax = -1;
+    for (k = ib; k < ie; k++) {
+      area = (ax * cnt - sx) * ((int64_t) val[ind[k]] - ay) - (ax - (int64_t) ind[k]) * (sy - ay * cnt);
+      if (area < 0) area = -area;
+      if (area > amax) {
+        amax = area;
+        sel = k;
+      }
+    }
+
+    pt[num].x = ind[sel];
+    pt[num].y = val[ind[sel]];
+    num++;
+  }
+
+  /* last point */
+  pt[num].x = ind[n - 1];
+  pt[num].y = val[ind[n - 1]];
+  num++;
+
+  free (ind);
+
+  return (num);
+}
+
@@ -0,0 +1,101 @@
+/***************************************************************************************************
+ *
+ * file     : slg_downsample.h
+ *
+ * function : senslog project c-library - downsampling functions for charts
+ *            - long series (e.g. a year with 96 slots per day) are reduced to a fixed number
+ *              of points independent from range length
+ *            - min./max. envelope: one min. and one max. per pixel bucket, peaks are kept
+ *            - largest triangle three buckets (LTTB): one point per bucket, shape is kept
+ *            - invalid values (CNERR) are skipped, x values are indices of original series
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+
+#ifndef _slg_downsample_h
+#define _slg_downsample_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* point of a downsampled series */
+typedef struct {
+  uint32_t  x;            /* index in original series */
+  int32_t   y;            /* value */
+} slg_dpoint;
+
+
+
+/* downsampling functions *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* calculates min./max. envelope of a series
+ * - series is split into bnum buckets of (almost) equal length, bucket b holds the
+ *   indices len*b/bnum .. len*(b+1)/bnum-1
+ *
+ * parameters:
+ *   *val :  array of values (CNERR: invalid value)
+ *   len  :  array length
+ *   bnum :  number of buckets (1..len)
+ *   *emin:  resulting array of bnum bucket min. values (CNERR: no valid value in bucket)
+ *   *emax:  resulting array of bnum bucket max. values (CNERR: no valid value in bucket)
+ *
+ * return value:
+ *   CNERR :  error: invalid number of buckets
+ *   other :  number of buckets with valid values
+ *
+ ****************************************************************************************/
+uint32_t slg_downsample_envelope (int32_t *val, uint32_t len, uint32_t bnum, int32_t *emin, int32_t *emax);
+
+
+/* downsamples a series to min./max. points of bnum buckets
+ * - each bucket with valid values gives its min. and max. point in order of index
+ *   (one point if both are the same), so at most 2*bnum points result
+ *
+ * parameters:
+ *   *val :  array of values (CNERR: invalid value)
+ *   len  :  array length
+ *   bnum :  number of buckets (1..len)
+ *   *pt  :  resulting array of points (2*bnum entries needed)
+ *
+ * return value:
+ *   CNERR :  error: invalid number of buckets
+ *   other :  number of points
+ *
+ ****************************************************************************************/
+uint32_t slg_downsample_minmax (int32_t *val, uint32_t len, uint32_t bnum, slg_dpoint *pt);
+
+
+/* downsamples a series with largest triangle three buckets algorithm
+ * - first and last valid value are kept, the valid values between are split into pnum-2
+ *   buckets, of each bucket the point with largest triangle area to the previous selected
+ *   point and the average of the next bucket is selected
+ * - if the series has not more than pnum valid values, all valid values are returned
+ *
+ * parameters:
+ *   *val:  array of values (CNERR: invalid value)
+ *   len :  array length
+ *   pnum:  number of points (>= 3)
+ *   *pt :  resulting array of points (pnum entries needed)
+ *
+ * return value:
+ *   CNERR :  error: invalid number of points or out of memory
+ *   other :  number of points
+ *
+ ****************************************************************************************/
+uint32_t slg_downsample_lttb (int32_t *val, uint32_t len, uint32_t pnum, slg_dpoint *pt);
+
+
+
+#endif
+
@@ -0,0 +1,347 @@
+/***************************************************************************************************
+ *
+ * file     : slg_event.c
+ *
+ * function : senslog project c-library - event processing functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "slg_event.h"
+#include "slg_date.h"
+#include "slg_values.h"
+#include "slg_dayfile.h"
+
+
+
+/* day related functions **************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* read all event values of a column from dayfile
+ *
+ * parameters:
+ *   *devent :  day event object
+ *   *daydata:  daydata object
+ *   id      :  event column id in daydata
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  error, invalid id or id is not event
+ *
+ ****************************************************************************************/
+uint32_t slg_devent_read (slg_devent *devent, slg_daydata *daydata, uint32_t id)
+{
+  uint32_t c, i, v;
+
+  c = slg_colexist (daydata, DF_EVNT, id);
+  if (c == 0) return (1);
+
+  devent->tmode = daydata->tmode;
+  devent->tlen = slg_timeindexnum (daydata->tmode);
+  devent->last = slg_lastmline (daydata);
+  strcpy (devent->name, daydata->colstr[c-2]);
+
+  for (i = 0; i < MAX_MLN_BMW; i++) {
+    devent->on[i] = 0;
+    devent->valid[i] = 0;
+  }
+
+  for (i = 0; i < devent->tlen; i++) {
+    v = slg_geteventval (daydata, c, i);
+    if (v != CNERR) {
+      devent->valid[i / 32] |= 1u << (i % 32);
+      devent->on[i / 32] |= v << (i % 32);
+    }
+  }
+
+  return (0);
+}
+
+
+/* gets event value of a time index
+ *
+ * parameters:
+ *   *devent:  day event object
+ *   k      :  time index
+ *
+ * return value:
+ *   CNERR :  invalid value or time index
+ *   event :  0 or 1
+ *
+ ****************************************************************************************/
+uint32_t slg_devent_get (slg_devent *devent, uint32_t k)
+{
+  if (k >= devent->tlen) return (CNERR);
+  if (((devent->valid[k / 32] >> (k % 32)) & 1) == 0) return (CNERR);
+
+  return ((devent->on[k / 32] >> (k % 32)) & 1);
+}
+
+
+/* calculates on time of a day (number of valid time indices with event on)
+ *
+ * parameters:
+ *   *devent:  day event object
+ *
+ * return value:
+ *   number of time indices
+ *
+ ****************************************************************************************/
+uint32_t slg_devent_ontime (slg_devent *devent)
+{
+  uint32_t i, res;
+
+  res = 0;
+  for (i = 0; i < MAX_MLN_BMW; i++) {
+    res += __builtin_popcount (devent->on[i] & devent->valid[i]);
+  }
+
+  return (res);
+}
+
+
+/* calculates number of valid time indices of a day
+ *
+ * parameters:
+ *   *devent:  day event object
+ *
+ * return value:
+ *   number of time indices
+ *
+ ****************************************************************************************/
+uint32_t slg_devent_validtime (slg_devent *devent)
+{
+  uint32_t i, res;
+
+  res = 0;
+  for (i = 0; i < MAX_MLN_BMW; i++) {
+    res += __builtin_popcount (devent->valid[i]);
+  }
+
+  return (res);
+}
+
+
+/* calculates number of switches from off to on of a day (between two valid neighbours)
+ *
+ * parameters:
+ *   *devent:  day event object
+ *
+ * return value:
+ *   number of switches
+ *
+ ****************************************************************************************/
+uint32_t slg_devent_swon (slg_devent *devent)
+{
+  uint32_t i, res, on, valid, pon, pvalid;
+
+  res = 0;
+  pon = 0;
+  pvalid = 0;
+
+  for (i = 0; i < MAX_MLN_BMW; i++) {
+    on = devent->on[i] & devent->valid[i];
+    valid = devent->valid[i];
+
+    /* bit k of pon/pvalid: state of time index k - 1 */
+    pon = (on << 1) | (pon >> 31);
+    pvalid = (valid << 1) | (pvalid >> 31);
+
+    res += __builtin_popcount (on & ~pon & valid & pvalid);
+
+    pon = on;
+    pvalid = valid;
+  }
+
+  return (res);
+}
+
+
+/* extracts intervals of equal states (on, off or invalid) of a day
+ * - intervals are found by scanning bitmap words for changed bits
+ *
+ * parameters:
+ *   *devent:  day event object
+ *   *evtrun:  array of intervals (MAX_MLN_NUM entries are always sufficient)
+ *   maxnum :  number of array entries
+ *
+ * return value:
+ *   number of intervals (not more than maxnum)
+ *
+ ****************************************************************************************/
+uint32_t slg_devent_runs (slg_devent *devent, slg_evtrun *evtrun, uint32_t maxnum)
+{
+  uint32_t i, j, w, num, state, onpat, validpat, diff;
+
+  num = 0;
+  i = 0;
+
+  while ((i < devent->tlen) && (num < maxnum)) {
+    /* state of interval beginning at i */
+    if (((devent->valid[i / 32] >> (i % 32)) & 1) == 0) state = EVT_INV;
+    else state = (devent->on[i / 32] >> (i % 32)) & 1;
+
+    onpat = (state == EVT_ON) ? 0xffffffff : 0;
+    validpat = (state == EVT_INV) ? 0 : 0xffffffff;
+
+    /* find first time index with other state */
+    j = devent->tlen;
+    for (w = i / 32; w < MAX_MLN_BMW; w++) {
+      diff = ((devent->on[w] & devent->valid[w]) ^ onpat) | (devent->valid[w] ^ validpat);
+      if (w == i / 32) diff &= 0xffffffff << (i % 32);
+      if (diff != 0) {
+        j = w * 32 + __builtin_ctz (diff);
+        break;
+      }
+    }
+    if (j > devent->tlen) j = devent->tlen;
+
+    evtrun[num].state = state;
+    evtrun[num].ib = i;
+    evtrun[num].ie = j - 1;
+    num++;
+
+    i = j;
+  }
+
+  return (num);
+}
+
+
+
+/* month related functions ************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* read all event values of an id from all valid days of a month
+ *
+ * parameters:
+ *   *mevent   :  month event object
+ *   *monthdata:  monthdata object
+ *   id        :  event column id in daydata files
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  error, invalid id or id is not event
+ *
+ ****************************************************************************************/
+uint32_t slg_mevent_read (slg_mevent *mevent, slg_monthdata *monthdata, uint32_t id)
+{
+  uint32_t i, res;
+
+  for (i = 0; i < 31; i++) {
+    if (monthdata->dvalid[i]) {
+      res = slg_devent_read (&mevent->devent[i], &monthdata->daydata[i], id);
+      if (res == 1) return (1);
+      mevent->dvalid[i] = 1;
+    }
+    else {
+      mevent->dvalid[i] = 0;
+    }
+  }
+
+  return (0);
+}
+
+
+
+/* aggregation functions **************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* initialises an empty aggregation
+ *
+ * parameters:
+ *   *evtagg:  aggregation object
+ *
+ ****************************************************************************************/
+void slg_evtagg_init (slg_evtagg *evtagg)
+{
+  uint32_t i;
+
+  evtagg->dnum = 0;
+  evtagg->ontime = 0;
+  evtagg->validtime = 0;
+  evtagg->swon = 0;
+
+  for (i = 0; i < MAX_MLN_BMW; i++) {
+    evtagg->anyon[i] = 0;
+    evtagg->allon[i] = 0;
+  }
+}
+
+
+/* adds a day to an aggregation
+ *
+ * parameters:
+ *   *evtagg:  aggregation object
+ *   *devent:  day event object
+ *
+ ****************************************************************************************/
+void slg_evtagg_add_day (slg_evtagg *evtagg, slg_devent *devent)
+{
+  uint32_t i, on;
+
+  for (i = 0; i < MAX_MLN_BMW; i++) {
+    on = devent->on[i] & devent->valid[i];
+    evtagg->anyon[i] |= on;
+    evtagg->allon[i] = (evtagg->dnum == 0) ? on : (evtagg->allon[i] & on);
+  }
+
+  evtagg->dnum++;
+  evtagg->ontime += slg_devent_ontime (devent);
+  evtagg->validtime += slg_devent_validtime (devent);
+  evtagg->swon += slg_devent_swon (devent);
+}
+
+
+/* adds all valid days of a month to an aggregation
+ *
+ * parameters:
+ *   *evtagg:  aggregation object
+ *   *mevent:  month event object
+ *
+ ****************************************************************************************/
+void slg_evtagg_add_month (slg_evtagg *evtagg, slg_mevent *mevent)
+{
+  uint32_t i;
+
+  for (i = 0; i < 31; i++) {
+    if (mevent->dvalid[i]) slg_evtagg_add_day (evtagg, &mevent->devent[i]);
+  }
+}
+
+
+/* merges an aggregation into another one (e.g. months into a year)
+ *
+ * parameters:
+ *   *evtagg :  target aggregation object
+ *   *evtaggi:  aggregation object to add
+ *
+ ****************************************************************************************/
+void slg_evtagg_merge (slg_evtagg *evtagg, slg_evtagg *evtaggi)
+{
+  uint32_t i;
+
+  if (evtaggi->dnum == 0) return;
+
+  for (i = 0; i < MAX_MLN_BMW; i++) {
+    evtagg->anyon[i] |= evtaggi->anyon[i];
+    evtagg->allon[i] = (evtagg->dnum == 0) ? evtaggi->allon[i] : (evtagg->allon[i] & evtaggi->allon[i]);
+  }
+
+  evtagg->dnum += evtaggi->dnum;
+  evtagg->ontime += evtaggi->ontime;
+  evtagg->validtime += evtaggi->validtime;
+  evtagg->swon += evtaggi->swon;
+}
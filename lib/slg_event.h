@@ -0,0 +1,225 @@
+/***************************************************************************************************
+ *
+ * file     : slg_event.h
+ *
+ * function : senslog project c-library - event processing functions
+ *            - event columns (heater, pump, door contact, ...) are stored as bitmaps
+ *              (one bit per time index for state and one for validity)
+ *            - on times are counted via popcount, on/off intervals are extracted by
+ *              scanning for changed bits, days are aggregated via bitwise and/or
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_date.h"
+#include "slg_dayfile.h"
+
+
+#ifndef _slg_event_h
+#define _slg_event_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define EVT_OFF    0    /* interval state: event is off */
+# define EVT_ON     1    /* interval state: event is on */
+# define EVT_INV    2    /* interval state: values are invalid */
+
+
+/* day event bitmaps */
+typedef struct {
+  uint32_t  tmode;               /* time_mode */
+  uint32_t  tlen;                /* number of time indices, dependent from tmode only */
+  uint32_t  last;                /* last index (last mline in related dayfile) */
+  char      name[50];            /* name of event */
+  uint32_t  on[MAX_MLN_BMW];     /* bit i: event is on at time index i */
+  uint32_t  valid[MAX_MLN_BMW];  /* bit i: value of time index i is valid */
+} slg_devent;
+
+
+/* month event array */
+typedef struct {
+  uint32_t    dvalid[31];  /* 0: day does not exist, 1: day exists */
+  slg_devent  devent[31];  /* array of day event objects */
+} slg_mevent;
+
+
+/* interval of equal event states */
+typedef struct {
+  uint32_t  state;         /* EVT_OFF, EVT_ON or EVT_INV */
+  uint32_t  ib;            /* first time index of interval */
+  uint32_t  ie;            /* last time index of interval */
+} slg_evtrun;
+
+
+/* aggregation of event days (e.g. month or year) */
+typedef struct {
+  uint32_t  dnum;                /* number of aggregated days */
+  uint32_t  ontime;              /* number of valid time indices with event on */
+  uint32_t  validtime;           /* number of valid time indices */
+  uint32_t  swon;                /* number of switches from off to on (inside days) */
+  uint32_t  anyon[MAX_MLN_BMW];  /* bit i: event was on at time index i on at least one day */
+  uint32_t  allon[MAX_MLN_BMW];  /* bit i: event was on at time index i on all days */
+} slg_evtagg;
+
+
+
+/* day related functions **************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* read all event values of a column from dayfile
+ *
+ * parameters:
+ *   *devent :  day event object
+ *   *daydata:  daydata object
+ *   id      :  event column id in daydata
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  error, invalid id or id is not event
+ *
+ ****************************************************************************************/
+uint32_t slg_devent_read (slg_devent *devent, slg_daydata *daydata, uint32_t id);
+
+
+/* gets event value of a time index
+ *
+ * parameters:
+ *   *devent:  day event object
+ *   k      :  time index
+ *
+ * return value:
+ *   CNERR :  invalid value or time index
+ *   event :  0 or 1
+ *
+ ****************************************************************************************/
+uint32_t slg_devent_get (slg_devent *devent, uint32_t k);
+
+
+/* calculates on time of a day (number of valid time indices with event on)
+ *
+ * parameters:
+ *   *devent:  day event object
+ *
+ * return value:
+ *   number of time indices
+ *
+ ****************************************************************************************/
+uint32_t slg_devent_ontime (slg_devent *devent);
+
+
+/* calculates number of valid time indices of a day
+ *
+ * parameters:
+ *   *devent:  day event object
+ *
+ * return value:
+ *   number of time indices
+ *
+ ****************************************************************************************/
+uint32_t slg_devent_validtime (slg_devent *devent);
+
+
+/* calculates number of switches from off to on of a day (between two valid neighbours)
+ *
+ * parameters:
+ *   *devent:  day event object
+ *
+ * return value:
+ *   number of switches
+ *
+ ****************************************************************************************/
+uint32_t slg_devent_swon (slg_devent *devent);
+
+
+/* extracts intervals of equal states (on, off or invalid) of a day
+ * - intervals are found by scanning bitmap words for changed bits
+ *
+ * parameters:
+ *   *devent:  day event object
+ *   *evtrun:  array of intervals (MAX_MLN_NUM entries are always sufficient)
+ *   maxnum :  number of array entries
+ *
+ * return value:
+ *   number of intervals (not more than maxnum)
+ *
+ ****************************************************************************************/
+uint32_t slg_devent_runs (slg_devent *devent, slg_evtrun *evtrun, uint32_t maxnum);
+
+
+
+/* month related functions ************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* read all event values of an id from all valid days of a month
+ *
+ * parameters:
+ *   *mevent   :  month event object
+ *   *monthdata:  monthdata object
+ *   id        :  event column id in daydata files
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  error, invalid id or id is not event
+ *
+ ****************************************************************************************/
+uint32_t slg_mevent_read (slg_mevent *mevent, slg_monthdata *monthdata, uint32_t id);
+
+
+
+/* aggregation functions **************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* initialises an empty aggregation
+ *
+ * parameters:
+ *   *evtagg:  aggregation object
+ *
+ ****************************************************************************************/
+void slg_evtagg_init (slg_evtagg *evtagg);
+
+
+/* adds a day to an aggregation
+ *
+ * parameters:
+ *   *evtagg:  aggregation object
+ *   *devent:  day event object
+ *
+ ****************************************************************************************/
+void slg_evtagg_add_day (slg_evtagg *evtagg, slg_devent *devent);
+
+
+/* adds all valid days of a month to an aggregation
+ *
+ * parameters:
+ *   *evtagg:  aggregation object
+ *   *mevent:  month event object
+ *
+ ****************************************************************************************/
+void slg_evtagg_add_month (slg_evtagg *evtagg, slg_mevent *mevent);
+
+
+/* merges an aggregation into another one (e.g. months into a year)
+ *
+ * parameters:
+ *   *evtagg :  target aggregation object
+ *   *evtaggi:  aggregation object to add
+ *
+ ****************************************************************************************/
+void slg_evtagg_merge (slg_evtagg *evtagg, slg_evtagg *evtaggi);
+
+
+
+#endif
+
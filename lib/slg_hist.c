@@ -0,0 +1,159 @@
+/***************************************************************************************************
+ *
+ * file     : slg_hist.c
+ *
+ * function : senslog project c-library - temperature histogram functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "slg_hist.h"
+#include "slg_values.h"
+#include "slg_temper.h"
+
+
+
+/* histogram functions ****************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* clears a histogram
+ *
+ * parameters:
+ *   *hist:  histogram object
+ *
+ ****************************************************************************************/
+void slg_hist_clear (slg_hist *hist)
+{
+  memset (hist, 0, sizeof(slg_hist));
+}
+
+
+/* gets bucket index of a temperature value
+ *
+ * parameters:
+ *   val:  temperature T*10 (no CNERR)
+ *
+ * return value:
+ *   bucket index (0..HST_BINS-1)
+ *
+ ****************************************************************************************/
+uint32_t slg_hist_bin (int32_t val)
+{
+  if (val < HST_TMIN) return (0);
+  if (val > HST_TMAX) return (HST_BINS - 1);
+
+  return ((uint32_t) (val - HST_TMIN + 1));
+}
+
+
+/* adds values of an array to a histogram (CNERR values are skipped)
+ *
+ * parameters:
+ *   *hist:  histogram object
+ *   *val :  array of temperatures T*10
+ *   len  :  array length
+ *
+ ****************************************************************************************/
+void slg_hist_add (slg_hist *hist, int32_t *val, uint32_t len)
+{
+  uint32_t i;
+
+  for (i = 0; i < len; i++) {
+    if (val[i] != CNERR) {
+      hist->bin[slg_hist_bin (val[i])]++;
+      hist->count++;
+    }
+  }
+}
+
+
+/* adds all valid values of a day to a histogram
+ *
+ * parameters:
+ *   *hist   :  histogram object
+ *   *dtemper:  day temperature object
+ *
+ ****************************************************************************************/
+void slg_hist_add_dtemper (slg_hist *hist, slg_dtemper *dtemper)
+{
+  slg_hist_add (hist, dtemper->val, dtemper->tlen);
+}
+
+
+/* adds all valid values of all valid days of a month to a histogram
+ *
+ * parameters:
+ *   *hist   :  histogram object
+ *   *mtemper:  month temperature object
+ *
+ ****************************************************************************************/
+void slg_hist_add_mtemper (slg_hist *hist, slg_mtemper *mtemper)
+{
+  uint32_t i;
+
+  for (i = 0; i < 31; i++) {
+    if (mtemper->dvalid[i]) slg_hist_add_dtemper (hist, &mtemper->dtemper[i]);
+  }
+}
+
+
+/* merges a histogram into another one (e.g. months into a year)
+ *
+ * parameters:
+ *   *hist :  target histogram object
+ *   *histi:  histogram object to add
+ *
+ ****************************************************************************************/
+void slg_hist_merge (slg_hist *hist, slg_hist *histi)
+{
+  uint32_t i;
+
+  for (i = 0; i < HST_BINS; i++) {
+    hist->bin[i] += histi->bin[i];
+  }
+  hist->count += histi->count;
+}
+
+
+/* calculates an exact percentile (nearest rank method)
+ * - value of rank ceil(pm * count / 1000) in ascending order (rank 1 if pm is 0)
+ *
+ * parameters:
+ *   *hist:  histogram object
+ *   pm   :  percentile in permille (0..1000, e.g. 50: P5, 500: median, 950: P95)
+ *
+ * return value:
+ *   CNERR :  empty histogram, invalid percentile or value is in under- or overflow bucket
+ *   temper:  temperature T*10
+ *
+ ****************************************************************************************/
+int32_t slg_hist_percentile (slg_hist *hist, uint32_t pm)
+{
+  uint64_t rank;
+  uint32_t i, sum;
+
+  if ((hist->count == 0) || (pm > 1000)) return (CNERR);
+
+  rank = ((uint64_t) pm * hist->count + 999) / 1000;
+  if (rank == 0) rank = 1;
+
+  sum = 0;
+  for (i = 0; i < HST_BINS; i++) {
+    sum += hist->bin[i];
+    if (sum >= rank) break;
+  }
+
+  if ((i == 0) || (i >= (HST_BINS - 1))) return (CNERR);
+
+  return (HST_TMIN + (int32_t) i - 1);
+}
@@ -0,0 +1,128 @@
+/***************************************************************************************************
+ *
+ * file     : slg_hist.h
+ *
+ * function : senslog project c-library - temperature histogram functions
+ *            - one bucket per 0.1 degree in range HST_TMIN..HST_TMAX plus one underflow
+ *              and one overflow bucket
+ *            - histograms are built in one pass and merged by adding bucket counts
+ *            - percentiles are exact (nearest rank), no sorting is needed
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_temper.h"
+
+
+#ifndef _slg_hist_h
+#define _slg_hist_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define HST_TMIN   -600                          /* lowest bucket value (T*10) */
+# define HST_TMAX    600                          /* highest bucket value (T*10) */
+# define HST_BINS   (HST_TMAX - HST_TMIN + 3)     /* number of buckets incl. under- and overflow */
+
+
+/* temperature histogram */
+typedef struct {
+  uint32_t  count;            /* number of values */
+  uint32_t  bin[HST_BINS];    /* bin[0]: values < HST_TMIN, bin[HST_BINS-1]: values > HST_TMAX,
+                                 bin[i]: values == HST_TMIN + i - 1 */
+} slg_hist;
+
+
+
+/* histogram functions ****************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* clears a histogram
+ *
+ * parameters:
+ *   *hist:  histogram object
+ *
+ ****************************************************************************************/
+void slg_hist_clear (slg_hist *hist);
+
+
+/* gets bucket index of a temperature value
+ *
+ * parameters:
+ *   val:  temperature T*10 (no CNERR)
+ *
+ * return value:
+ *   bucket index (0..HST_BINS-1)
+ *
+ ****************************************************************************************/
+uint32_t slg_hist_bin (int32_t val);
+
+
+/* adds values of an array to a histogram (CNERR values are skipped)
+ *
+ * parameters:
+ *   *hist:  histogram object
+ *   *val :  array of temperatures T*10
+ *   len  :  array length
+ *
+ ****************************************************************************************/
+void slg_hist_add (slg_hist *hist, int32_t *val, uint32_t len);
+
+
+/* adds all valid values of a day to a histogram
+ *
+ * parameters:
+ *   *hist   :  histogram object
+ *   *dtemper:  day temperature object
+ *
+ ****************************************************************************************/
+void slg_hist_add_dtemper (slg_hist *hist, slg_dtemper *dtemper);
+
+
+/* adds all valid values of all valid days of a month to a histogram
+ *
+ * parameters:
+ *   *hist   :  histogram object
+ *   *mtemper:  month temperature object
+ *
+ ****************************************************************************************/
+void slg_hist_add_mtemper (slg_hist *hist, slg_mtemper *mtemper);
+
+
+/* merges a histogram into another one (e.g. months into a year)
+ *
+ * parameters:
+ *   *hist :  target histogram object
+ *   *histi:  histogram object to add
+ *
+ ****************************************************************************************/
+void slg_hist_merge (slg_hist *hist, slg_hist *histi);
+
+
+/* calculates an exact percentile (nearest rank method)
+ * - value of rank ceil(pm * count / 1000) in ascending order (rank 1 if pm is 0)
+ *
+ * parameters:
+ *   *hist:  histogram object
+ *   pm   :  percentile in permille (0..1000, e.g. 50: P5, 500: median, 950: P95)
+ *
+ * return value:
+ *   CNERR :  empty histogram, invalid percentile or value is in under- or overflow bucket
+ *   temper:  temperature T*10
+ *
+ ****************************************************************************************/
+int32_t slg_hist_percentile (slg_hist *hist, uint32_t pm);
+
+
+
+#endif
+
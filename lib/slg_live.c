@@ -0,0 +1,495 @@
+/***************************************************************************************************
+ *
+ * file     : slg_live.c
+ *
+ * function : senslog project c-library - live dayfile state functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "slg_live.h"
+#include "slg_date.h"
+#include "slg_values.h"
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+#include "slg_records.h"
+
+
+
+/* private functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* reads a complete line (incl. line end) from a text file in the same way as
+ * slg_readtxtline() (carriage returns are removed, tabs are replaced by a space)
+ *
+ * parameters:
+ *   *raw  :  resulting raw line (LIV_RAWLEN bytes must be allocated)
+ *   *rlen :  resulting raw length of line (incl. line end)
+ *   *line :  resulting line (MAX_MLN_LEN bytes must be allocated, empty for empty lines)
+ *   *fpr  :  pointer to file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  no complete line left (end of file reached before line end)
+ *    2 :  error: line contains invalid chars or is to long
+ *
+ ****************************************************************************************/
+static uint32_t slg_liv_getline (char *raw, uint32_t *rlen, char *line, FILE *fpr)
+{
+  int      chint;
+  char     ch;
+  uint32_t i, j;
+
+  i = 0;
+  j = 0;
+  chint = getc(fpr);
+  while (chint != EOF) {
+    ch = (char) (chint & 0xff);
+    if (i == LIV_RAWLEN) return (2);
+    raw[i] = ch;
+    i++;
+
+    if (ch == 0x0a) {
+      line[j] = 0x00;
+      *rlen = i;
+      return (0);
+    }
+
+    if ((ch & 0x80) || (ch == 0x00)) return (2);   /* filter for invalid chars */
+    if (ch == 0x09) ch = 0x20;  /* replace a tab by a space */
+    if (ch != 0x0d) {
+      line[j] = ch;
+      j++;
+      if (j == MAX_MLN_LEN) return (2);
+    }
+
+    chint = getc(fpr);
+  }
+
+  return (1);
+}
+
+
+/* checks a measurement line against the state and adds it (checks are the same as
+ * in slg_readdayfile())
+ *
+ * parameters:
+ *   *live:  live state object
+ *   *line:  measurement line
+ *   *raw :  raw line
+ *   rlen :  raw length of line
+ *   pos  :  file offset of line
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: line is invalid or out of order (state is unchanged)
+ *
+ ****************************************************************************************/
+static uint32_t slg_liv_addline (slg_live *live, char *line, char *raw, uint32_t rlen, uint64_t pos)
+{
+  char       tmp[MAX_MLN_LEN];
+  uint32_t   j, k;
+  int32_t    v;
+  slg_date   dtmp;
+  slg_dstats *ds;
+
+  /* check number of values, date and time of line */
+  if (slg_mlnumval (line) != (live->daydata.colnum + 2)) return (1);
+
+  if (slg_mlgetval (tmp, line, 0) != 0) return (1);
+  if (slg_date_set_str (&dtmp, tmp) == 0) return (1);
+  if (slg_date_compare (&dtmp, &live->daydata.date) != 1) return (1);
+
+  if (slg_mlgetval (tmp, line, 1) != 0) return (1);
+  k = slg_str2timeindex (live->daydata.tmode, tmp);
+  if (k == CNERR) return (1);
+  if ((live->lnum > 0) && (k <= live->last)) return (1);
+
+  for (j = 0; j < live->daydata.colnum; j++) {
+    if (slg_mlgetval (tmp, line, (2+j)) != 0) return (1);
+  }
+
+  /* add line and update running statistics (newest min. and max. values win) */
+  strcpy (live->daydata.msrline[k], line);
+
+  for (j = 0; j < live->daydata.colnum; j++) {
+    slg_mlgetval (tmp, line, (2+j));
+    v = CNERR;
+    if (live->daydata.coltyp[j] == DF_TEMP) v = slg_str2temper (tmp);
+    if (live->daydata.coltyp[j] == DF_RAIN) v = (int32_t) slg_str2rain (tmp);
+    if (live->daydata.coltyp[j] == DF_EVNT) v = (int32_t) slg_str2event (tmp);
+
+    live->cur[j] = v;
+    if (v == CNERR) continue;
+
+    ds = &live->dstats[j];
+    if ((ds->count == 0) || (v <= ds->min)) {
+      ds->min = v;
+      ds->indmin = k;
+    }
+    if ((ds->count == 0) || (v >= ds->max)) {
+      ds->max = v;
+      ds->indmax = k;
+    }
+    ds->count++;
+    ds->sum += v;
+  }
+
+  live->lnum++;
+  live->last = k;
+  live->lpos = pos;
+  live->llen = rlen;
+  memcpy (live->lline, raw, rlen);
+
+  return (0);
+}
+
+
+/* reads all complete lines appended since the last update (tail reader)
+ * - the last line read before is compared first, so a rewritten dayfile is detected
+ *
+ * parameters:
+ *   *live:  live state object
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: dayfile does not match the state or contains an invalid line
+ *
+ ****************************************************************************************/
+static uint32_t slg_liv_tail (slg_live *live)
+{
+  FILE     *fpr;
+  char     raw[LIV_RAWLEN], line[MAX_MLN_LEN];
+  uint32_t rlen, res;
+
+  fpr = fopen (live->filename, "rb");
+  if (fpr == NULL) return (1);
+
+  /* compare last line read */
+  if (live->llen > 0) {
+    if ((fseek (fpr, (long) live->lpos, SEEK_SET) != 0) ||
+        (fread (raw, 1, live->llen, fpr) != live->llen) ||
+        (memcmp (raw, live->lline, live->llen) != 0)) {
+      fclose (fpr);
+      return (1);
+    }
+  }
+
+  /* read appended lines */
+  if (fseek (fpr, (long) live->offset, SEEK_SET) != 0) {fclose (fpr); return (1);}
+
+  res = slg_liv_getline (raw, &rlen, line, fpr);
+  while (res == 0) {
+    if (line[0] != 0x00) {
+      if (slg_liv_addline (live, line, raw, rlen, live->offset) != 0) {fclose (fpr); return (1);}
+    }
+    live->offset += rlen;
+    res = slg_liv_getline (raw, &rlen, line, fpr);
+  }
+
+  fclose (fpr);
+  if (res == 2) return (1);
+
+  return (0);
+}
+
+
+/* rebuilds a live state from the whole dayfile
+ *
+ * parameters:
+ *   *live     :  live state object
+ *   *filename :  path/filename of dayfile
+ *   hmode     :  header mode of dayfile
+ *
+ * return value:
+ *    0     :  operation successfull
+ *    1..15 :  error of slg_readdayfile() (state is cleared)
+ *   16     :  error: dayfile was changed while it was read (state is cleared)
+ *
+ ****************************************************************************************/
+static uint32_t slg_liv_rebuild (slg_live *live, char *filename, uint32_t hmode)
+{
+  FILE        *fpr;
+  char        raw[LIV_RAWLEN], line[MAX_MLN_LEN];
+  uint32_t    res, rlen, i, n;
+  struct stat st;
+
+  slg_live_clear (live);
+  if (strlen (filename) > 255) return (1);
+
+  /* read and check header and all lines, measurement lines are read again by tail reader */
+  res = slg_readdayfile (&live->daydata, filename, hmode);
+  if (res != 0) {slg_live_clear (live); return (res);}
+
+  for (i = 0; i < MAX_MLN_NUM; i++) live->daydata.msrline[i][0] = 0x00;
+
+  for (i = 0; i < MAX_MLN_VALS; i++) {
+    live->dstats[i].min = CNERR;
+    live->dstats[i].max = CNERR;
+    live->cur[i] = CNERR;
+  }
+
+  strcpy (live->filename, filename);
+  live->hmode = hmode;
+
+  if (stat (filename, &st) != 0) {slg_live_clear (live); return (1);}
+  live->ino = (uint64_t) st.st_ino;
+
+  /* find first measurement line (behind second separator line of header) */
+  if (hmode == 0) {
+    fpr = fopen (filename, "rb");
+    if (fpr == NULL) {slg_live_clear (live); return (1);}
+
+    n = 0;
+    while (n < 2) {
+      if (slg_liv_getline (raw, &rlen, line, fpr) != 0) {fclose (fpr); slg_live_clear (live); return (16);}
+      if (strstr (line, "----------") == line) n++;
+      live->offset += rlen;
+    }
+    fclose (fpr);
+  }
+
+  live->valid = 1;
+
+  if (slg_liv_tail (live) != 0) {slg_live_clear (live); return (16);}
+
+  return (0);
+}
+
+
+/* updates the current day of records by the running statistics of a live state
+ *
+ * parameters:
+ *   *live   :  valid live state object
+ *   *records:  records object
+ *
+ ****************************************************************************************/
+static void slg_liv_records (slg_live *live, slg_records *records)
+{
+  slg_dstats dstats[MAX_MLN_VALS];
+  uint32_t   c, k;
+
+  if ((live->daydata.locid != records->locid) || (live->daydata.tmode != records->tmode)) return;
+
+  for (c = 0; c < records->colnum; c++) {
+    k = slg_colexist (&live->daydata, records->coltyp[c], records->colid[c]);
+    if ((k == 0) || (records->coltyp[c] == DF_EVNT)) {
+      dstats[c].count = 0;
+      dstats[c].sum = 0;
+      dstats[c].min = CNERR;
+      dstats[c].max = CNERR;
+      dstats[c].indmin = 0;
+      dstats[c].indmax = 0;
+      continue;
+    }
+
+    memcpy (&dstats[c], &live->dstats[k-2], sizeof(slg_dstats));
+  }
+
+  slg_records_add_dstats (records, &live->daydata.date, dstats);
+}
+
+
+
+/* state functions ********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* clears a live state (next update reads the whole dayfile)
+ *
+ * parameters:
+ *   *live:  live state object
+ *
+ ****************************************************************************************/
+void slg_live_clear (slg_live *live)
+{
+  memset (live, 0, sizeof(slg_live));
+  strcpy (live->magic, LIV_MAGIC);
+  live->version = LIV_VERSION;
+}
+
+
+/* loads a live state from a state file
+ *
+ * parameters:
+ *   *live     :  live state object
+ *   *filename :  path/filename of state file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: file not found or invalid (state is cleared)
+ *
+ ****************************************************************************************/
+uint32_t slg_live_load (slg_live *live, char *filename)
+{
+  FILE     *fpr;
+  uint32_t res;
+
+  fpr = fopen (filename, "rb");
+  if (fpr == NULL) {slg_live_clear (live); return (1);}
+
+  res = (uint32_t) fread (live, sizeof(slg_live), 1, fpr);
+  fclose (fpr);
+
+  if ((res != 1) || (strcmp (live->magic, LIV_MAGIC) != 0) || (live->version != LIV_VERSION)) {
+    slg_live_clear (live);
+    return (1);
+  }
+
+  return (0);
+}
+
+
+/* saves a live state to a state file
+ * - the file is written under a temporary name and renamed, so readers never see
+ *   a partly written state
+ *
+ * parameters:
+ *   *live     :  live state object
+ *   *filename :  path/filename of state file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: file can not be written
+ *
+ ****************************************************************************************/
+uint32_t slg_live_save (slg_live *live, char *filename)
+{
+  FILE     *fpw;
+  char     tname[300];
+  uint32_t res;
+
+  if (strlen (filename) > 290) return (1);
+  strcpy (tname, filename);
+  strcat (tname, ".tmp");
+
+  fpw = fopen (tname, "wb");
+  if (fpw == NULL) return (1);
+
+  res = (uint32_t) fwrite (live, sizeof(slg_live), 1, fpw);
+  if (fclose (fpw) != 0) res = 0;
+
+  if ((res != 1) || (rename (tname, filename) != 0)) {
+    remove (tname);
+    return (1);
+  }
+
+  return (0);
+}
+
+
+/* updates a live state by all lines appended to its dayfile
+ * - the state is rebuilt from the whole dayfile if it is empty, belongs to another
+ *   dayfile or header mode, or does not match the dayfile anymore
+ * - records of the same location and time mode are updated in O(1): the running
+ *   statistics of the state replace the statistics of the current day of the records
+ *   (see slg_records_add_dstats()), so no line is counted twice, errors are ignored
+ *
+ * parameters:
+ *   *live     :  live state object
+ *   *filename :  path/filename of dayfile
+ *   hmode     :  header mode of dayfile (see slg_readdayfile())
+ *   *records  :  records object or NULL (no records)
+ *
+ * return value:
+ *    0     :  operation successfull
+ *    1..15 :  error of slg_readdayfile() (state is cleared)
+ *   16     :  error: dayfile was changed while it was read (state is cleared)
+ *
+ ****************************************************************************************/
+uint32_t slg_live_update (slg_live *live, char *filename, uint32_t hmode, slg_records *records)
+{
+  struct stat st;
+  uint32_t    res;
+
+  res = 0;
+
+  if ((live->valid == 0) || (live->hmode != hmode) || (strcmp (live->filename, filename) != 0)) {
+    res = slg_liv_rebuild (live, filename, hmode);
+  }
+  else {
+    if (stat (filename, &st) != 0) {
+      slg_live_clear (live);
+      return (1);
+    }
+
+    /* rewritten or truncated dayfile */
+    if ((live->ino != (uint64_t) st.st_ino) || ((uint64_t) st.st_size < live->offset)) {
+      res = slg_liv_rebuild (live, filename, hmode);
+    }
+    else {
+      /* appended lines (an invalid line leads to a rebuild), the last line read is
+         compared also if the size is unchanged (dayfile rewritten in place) */
+      if (slg_liv_tail (live) != 0) res = slg_liv_rebuild (live, filename, hmode);
+    }
+  }
+
+  if ((res == 0) && (records != NULL)) slg_liv_records (live, records);
+
+  return (res);
+}
+
+
+/* gets running statistics of a column (same as slg_dstats_calc() over all values of
+ * the column)
+ *
+ * parameters:
+ *   *live  :  live state object
+ *   typ    :  column type (DF_TEMP, DF_RAIN, DF_EVNT)
+ *   id     :  column id
+ *   *dstats:  resulting statistics object
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: state is empty or column does not exist
+ *
+ ****************************************************************************************/
+uint32_t slg_live_dstats (slg_live *live, uint32_t typ, uint32_t id, slg_dstats *dstats)
+{
+  uint32_t c;
+
+  if (live->valid == 0) return (1);
+
+  c = slg_colexist (&live->daydata, typ, id);
+  if (c == 0) return (1);
+
+  memcpy (dstats, &live->dstats[c-2], sizeof(slg_dstats));
+
+  return (0);
+}
+
+
+/* gets value of a column of the last measurement line read
+ *
+ * parameters:
+ *   *live:  live state object
+ *   typ  :  column type (DF_TEMP, DF_RAIN, DF_EVNT)
+ *   id   :  column id
+ *
+ * return value:
+ *   CNERR :  state is empty, column does not exist or value is invalid
+ *   other :  value (temperature T*10, rain*100 or event)
+ *
+ ****************************************************************************************/
+int32_t slg_live_current (slg_live *live, uint32_t typ, uint32_t id)
+{
+  uint32_t c;
+
+  if (live->valid == 0) return (CNERR);
+
+  c = slg_colexist (&live->daydata, typ, id);
+  if (c == 0) return (CNERR);
+
+  return (live->cur[c-2]);
+}
@@ -0,0 +1,164 @@
+/***************************************************************************************************
+ *
+ * file     : slg_live.h
+ *
+ * function : senslog project c-library - live dayfile state functions
+ *            - keeps the content of a growing dayfile (e.g. of today) together with running
+ *              statistics of all columns in a state, which is saved between runs
+ *            - an update reads only the lines appended since the last update (tail reader),
+ *              statistics are updated in O(1) per line
+ *            - the state is checked against the dayfile (inode, size and last line read),
+ *              a rewritten or truncated dayfile or an unexpected line leads to a rebuild
+ *              from the whole dayfile, so the state is always identical to a full read
+ *            - a last line without line end is still being written and is read by the
+ *              next update
+ *            - all-time records can be kept up to date by each update
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+#include "slg_records.h"
+
+
+#ifndef _slg_live_h
+#define _slg_live_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define LIV_MAGIC     "SLGLIV"              /* state file magic (8 bytes incl. zero padding) */
+# define LIV_VERSION   1                     /* state file format version */
+# define LIV_RAWLEN    (MAX_MLN_LEN + 8)     /* max. raw length of a line (incl. line end) */
+
+
+/* live state of a dayfile (stored 1:1 in state file) */
+typedef struct {
+  char         magic[8];                   /* LIV_MAGIC */
+  uint32_t     version;                    /* LIV_VERSION */
+  uint32_t     valid;                      /* 0: state is empty, 1: state is valid */
+  char         filename[256];              /* path/filename of dayfile */
+  uint32_t     hmode;                      /* header mode of dayfile (see slg_readdayfile()) */
+  uint64_t     ino;                        /* inode of dayfile */
+  uint64_t     offset;                     /* file offset behind last line read */
+  uint64_t     lpos;                       /* file offset of last measurement line read */
+  uint32_t     llen;                       /* raw length of last measurement line read (0: none) */
+  char         lline[LIV_RAWLEN];          /* raw last measurement line read */
+  uint32_t     lnum;                       /* number of measurement lines read */
+  uint32_t     last;                       /* time index of last measurement line read */
+  slg_dstats   dstats[MAX_MLN_VALS];       /* running statistics of columns (index: column index - 2) */
+  int32_t      cur[MAX_MLN_VALS];          /* values of last measurement line (CNERR: invalid) */
+  slg_daydata  daydata;                    /* daydata object of all lines read */
+} slg_live;
+
+
+
+/* state functions ********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* clears a live state (next update reads the whole dayfile)
+ *
+ * parameters:
+ *   *live:  live state object
+ *
+ ****************************************************************************************/
+void slg_live_clear (slg_live *live);
+
+
+/* loads a live state from a state file
+ *
+ * parameters:
+ *   *live     :  live state object
+ *   *filename :  path/filename of state file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: file not found or invalid (state is cleared)
+ *
+ ****************************************************************************************/
+uint32_t slg_live_load (slg_live *live, char *filename);
+
+
+/* saves a live state to a state file
+ * - the file is written under a temporary name and renamed, so readers never see
+ *   a partly written state
+ *
+ * parameters:
+ *   *live     :  live state object
+ *   *filename :  path/filename of state file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: file can not be written
+ *
+ ****************************************************************************************/
+uint32_t slg_live_save (slg_live *live, char *filename);
+
+
+/* updates a live state by all lines appended to its dayfile
+ * - the state is rebuilt from the whole dayfile if it is empty, belongs to another
+ *   dayfile or header mode, or does not match the dayfile anymore
+ * - records of the same location and time mode are updated in O(1): the running
+ *   statistics of the state replace the statistics of the current day of the records
+ *   (see slg_records_add_dstats()), so no line is counted twice, errors are ignored
+ *
+ * parameters:
+ *   *live     :  live state object
+ *   *filename :  path/filename of dayfile
+ *   hmode     :  header mode of dayfile (see slg_readdayfile())
+ *   *records  :  records object or NULL (no records)
+ *
+ * return value:
+ *    0     :  operation successfull
+ *    1..15 :  error of slg_readdayfile() (state is cleared)
+ *   16     :  error: dayfile was changed while it was read (state is cleared)
+ *
+ ****************************************************************************************/
+uint32_t slg_live_update (slg_live *live, char *filename, uint32_t hmode, slg_records *records);
+
+
+/* gets running statistics of a column (same as slg_dstats_calc() over all values of
+ * the column)
+ *
+ * parameters:
+ *   *live  :  live state object
+ *   typ    :  column type (DF_TEMP, DF_RAIN, DF_EVNT)
+ *   id     :  column id
+ *   *dstats:  resulting statistics object
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: state is empty or column does not exist
+ *
+ ****************************************************************************************/
+uint32_t slg_live_dstats (slg_live *live, uint32_t typ, uint32_t id, slg_dstats *dstats);
+
+
+/* gets value of a column of the last measurement line read
+ *
+ * parameters:
+ *   *live:  live state object
+ *   typ  :  column type (DF_TEMP, DF_RAIN, DF_EVNT)
+ *   id   :  column id
+ *
+ * return value:
+ *   CNERR :  state is empty, column does not exist or value is invalid
+ *   other :  value (temperature T*10, rain*100 or event)
+ *
+ ****************************************************************************************/
+int32_t slg_live_current (slg_live *live, uint32_t typ, uint32_t id);
+
+
+
+#endif
+
@@ -0,0 +1,295 @@
+/***************************************************************************************************
+ *
+ * file     : slg_metday.c
+ *
+ * function : senslog project c-library - meteorological day window functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "slg_metday.h"
+#include "slg_date.h"
+#include "slg_values.h"
+#include "slg_temper.h"
+
+
+
+/* private functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* adds a slot segment of a day to window statistics (single pass, newest ones win)
+ *
+ * parameters:
+ *   *dstats :  window statistics (sum, count, min., max. and indices are updated)
+ *   *dtemper:  day temperature object
+ *   ib      :  first time index of segment
+ *   ie      :  last time index of segment + 1
+ *   woffs   :  window index of time index 0 of day (window index = time index + woffs)
+ *
+ ****************************************************************************************/
+static void slg_mdw_segment (slg_dstats *dstats, slg_dtemper *dtemper, uint32_t ib, uint32_t ie, int32_t woffs)
+{
+  uint32_t i, valid, newmin, newmax;
+  int32_t  v;
+
+  for (i = ib; i < ie; i++) {
+    v = dtemper->val[i];
+    valid = (v != CNERR) & (((dtemper->qflag[i / 32] >> (i % 32)) & 1) ^ 1);
+    newmin = valid & (v <= dstats->min);
+    newmax = valid & (v >= dstats->max);
+
+    dstats->count += valid;
+    dstats->sum += valid ? v : 0;
+    dstats->min = newmin ? v : dstats->min;
+    dstats->max = newmax ? v : dstats->max;
+    dstats->indmin = newmin ? (uint32_t) ((int32_t) i + woffs) : dstats->indmin;
+    dstats->indmax = newmax ? (uint32_t) ((int32_t) i + woffs) : dstats->indmax;
+  }
+}
+
+
+/* calculates statistics of a day window from reference day and day before
+ *
+ * parameters:
+ *   *dprev :  day temperature object of day before (NULL: missing)
+ *   *dcur  :  day temperature object of reference day (NULL: missing)
+ *   *win   :  day window
+ *   *dstats:  resulting statistics object
+ *
+ * return value:
+ *         0 :  valid values exist
+ *         1 :  no valid values found
+ *
+ ****************************************************************************************/
+static uint32_t slg_mdw_stats (slg_dtemper *dprev, slg_dtemper *dcur, slg_mdwin *win, slg_dstats *dstats)
+{
+  int32_t wend;
+
+  dstats->count = 0;
+  dstats->sum = 0;
+  dstats->min = CNERR;
+  dstats->max = - CNERR;
+  dstats->indmin = 0;
+  dstats->indmax = 0;
+
+  wend = win->offs + (int32_t) win->len;
+
+  /* segment of day before (older values first) */
+  if ((win->offs < 0) && (dprev != NULL)) {
+    slg_mdw_segment (dstats, dprev, (uint32_t) (MAX_MLN_NUM + win->offs),
+                     (wend < 0) ? (uint32_t) (MAX_MLN_NUM + wend) : MAX_MLN_NUM,
+                     - (MAX_MLN_NUM + win->offs));
+  }
+
+  /* segment of reference day */
+  if ((wend > 0) && (dcur != NULL)) {
+    slg_mdw_segment (dstats, dcur, (win->offs > 0) ? (uint32_t) win->offs : 0, (uint32_t) wend, - win->offs);
+  }
+
+  if (dstats->count == 0) {
+    dstats->min = CNERR;
+    dstats->max = CNERR;
+    return (1);
+  }
+
+  return (0);
+}
+
+
+
+/* window functions *******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* sets a day window from UTC times
+ * - window holds all slots with time stamp in start..start+len (slot time stamps of both
+ *   time modes result in the same slot range)
+ *
+ * parameters:
+ *   *win :  resulting day window
+ *   start:  start of window in minutes UTC relative to 00:00 UTC of reference day
+ *           (multiple of 15, e.g. -360: 18:00 UTC of day before)
+ *   len  :  length of window in minutes (multiple of 15)
+ *
+ * return value:
+ *    0 :  successfull
+ *    1 :  error: times are not multiples of 15 minutes or window is not within day before
+ *               and reference day
+ *
+ ****************************************************************************************/
+uint32_t slg_metday_setwin (slg_mdwin *win, int32_t start, uint32_t len)
+{
+  int32_t offs, num;
+
+  if ((start % 15 != 0) || (len % 15 != 0) || (len == 0)) return (1);
+  if (len > 2 * 15 * MAX_MLN_NUM) return (1);
+
+  offs = (start + MDW_MEZ_OFFS) / 15;
+  num = (int32_t) len / 15;
+  if ((offs < - MAX_MLN_NUM) || (offs + num > MAX_MLN_NUM)) return (1);
+
+  win->offs = offs;
+  win->len = (uint32_t) num;
+
+  return (0);
+}
+
+
+
+/* ring functions *********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* clears a day ring
+ *
+ * parameters:
+ *   *metday:  day ring object
+ *
+ ****************************************************************************************/
+void slg_metday_init (slg_metday *metday)
+{
+  metday->dvalid[0] = 0;
+  metday->dvalid[1] = 0;
+  metday->cur = 0;
+}
+
+
+/* adds a day as new reference day to a day ring
+ * - the former reference day is kept as day before if it is the day before of date,
+ *   else the day before is empty
+ *
+ * parameters:
+ *   *metday :  day ring object
+ *   *dtemper:  day temperature object of date (NULL: day is missing)
+ *   *date   :  date of day
+ *
+ ****************************************************************************************/
+void slg_metday_push (slg_metday *metday, slg_dtemper *dtemper, slg_date *date)
+{
+  slg_date prev;
+  uint32_t old;
+
+  old = metday->cur;
+  metday->cur ^= 1;
+
+  /* former reference day becomes day before */
+  slg_date_copy (&prev, date);
+  slg_date_dec (&prev);
+  if ((metday->dvalid[old] == 0) || (slg_date_compare (&metday->date[old], &prev) != 1)) {
+    metday->dvalid[old] = 0;
+  }
+
+  slg_date_copy (&metday->date[metday->cur], date);
+  if (dtemper != NULL) {
+    memcpy (&metday->dtemper[metday->cur], dtemper, sizeof(slg_dtemper));
+    metday->dvalid[metday->cur] = 1;
+  }
+  else {
+    metday->dvalid[metday->cur] = 0;
+  }
+}
+
+
+/* calculates statistics of a day window ending on reference day of a day ring
+ * - indices of statistics are relative to window start (0..len-1)
+ * - values of a missing day are invalid, flagged values are ignored
+ * - finds the newest ones if there are more than one minimums or maximums
+ *
+ * parameters:
+ *   *metday:  day ring object
+ *   *win   :  day window
+ *   *dstats:  resulting statistics object
+ *
+ * return value:
+ *         0 :  valid values exist
+ *         1 :  no valid values found
+ *
+ ****************************************************************************************/
+uint32_t slg_metday_stats (slg_metday *metday, slg_mdwin *win, slg_dstats *dstats)
+{
+  slg_dtemper *dprev, *dcur;
+
+  dprev = (metday->dvalid[metday->cur ^ 1]) ? &metday->dtemper[metday->cur ^ 1] : NULL;
+  dcur = (metday->dvalid[metday->cur]) ? &metday->dtemper[metday->cur] : NULL;
+
+  return (slg_mdw_stats (dprev, dcur, win, dstats));
+}
+
+
+/* converts a window index into date and time index of its day
+ *
+ * parameters:
+ *   *metday:  day ring object
+ *   *win   :  day window
+ *   ind    :  window index (0..len-1)
+ *   *date  :  resulting date
+ *   *tind  :  resulting time index of date
+ *
+ * return value:
+ *    0 :  successfull
+ *    1 :  error: invalid index or ring is empty
+ *
+ ****************************************************************************************/
+uint32_t slg_metday_index (slg_metday *metday, slg_mdwin *win, uint32_t ind, slg_date *date, uint32_t *tind)
+{
+  int32_t slot;
+
+  if (ind >= win->len) return (1);
+  if ((metday->dvalid[0] == 0) && (metday->dvalid[1] == 0)) return (1);
+
+  slg_date_copy (date, &metday->date[metday->cur]);
+
+  slot = win->offs + (int32_t) ind;
+  if (slot < 0) {
+    slg_date_dec (date);
+    slot += MAX_MLN_NUM;
+  }
+  *tind = (uint32_t) slot;
+
+  return (0);
+}
+
+
+/* calculates statistics of a day window for all days of a month
+ * - the day before of day 1 is taken from dprev (last day of month before)
+ *
+ * parameters:
+ *   *mtemper:  month temperature object
+ *   *dprev  :  day temperature object of last day of month before (NULL: missing)
+ *   *win    :  day window
+ *   *dstats :  resulting array of 31 statistics objects (count 0: no valid values)
+ *
+ * return value:
+ *   0..31 :  number of days with valid values
+ *
+ ****************************************************************************************/
+uint32_t slg_metday_mtemper (slg_mtemper *mtemper, slg_dtemper *dprev, slg_mdwin *win, slg_dstats *dstats)
+{
+  slg_dtemper *prev, *cur;
+  uint32_t    d, dnum;
+
+  dnum = 0;
+  prev = dprev;
+  for (d = 0; d < 31; d++) {
+    cur = (mtemper->dvalid[d]) ? &mtemper->dtemper[d] : NULL;
+
+    /* days without dayfile have no window statistics */
+    if (slg_mdw_stats (prev, cur, win, &dstats[d]) == 0) dnum += (cur != NULL);
+    if (cur == NULL) slg_mdw_stats (NULL, NULL, win, &dstats[d]);
+
+    prev = cur;
+  }
+
+  return (dnum);
+}
+
@@ -0,0 +1,157 @@
+/***************************************************************************************************
+ *
+ * file     : slg_metday.h
+ *
+ * function : senslog project c-library - meteorological day window functions
+ *            - statistics over day windows which do not start at 00:00 MEZ, e.g. 18-18 UTC
+ *              for min. values or 18-06 UTC for night min. values
+ *            - a window ends on a reference day and may start on the day before, the two
+ *              days are kept in a ring and window statistics are combined from one segment
+ *              of each day (no slot values are copied)
+ *            - window times are given in UTC minutes, slot times of dayfiles are MEZ
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_date.h"
+#include "slg_temper.h"
+
+
+#ifndef _slg_metday_h
+#define _slg_metday_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define MDW_MEZ_OFFS   60    /* offset of dayfile time (MEZ) to UTC in minutes */
+
+
+/* day window (slot range relative to slot 0 of reference day) */
+typedef struct {
+  int32_t   offs;         /* first slot of window (-MAX_MLN_NUM..MAX_MLN_NUM-1, < 0: day before) */
+  uint32_t  len;          /* number of slots of window (window ends on reference day) */
+} slg_mdwin;
+
+
+/* ring of the two newest days */
+typedef struct {
+  uint32_t     dvalid[2];     /* 0: ring entry is empty, 1: ring entry is valid */
+  slg_date     date[2];       /* dates of ring entries */
+  slg_dtemper  dtemper[2];    /* day temperature objects of ring entries */
+  uint32_t     cur;           /* ring index of newest day (reference day) */
+} slg_metday;
+
+
+
+/* window functions *******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* sets a day window from UTC times
+ * - window holds all slots with time stamp in start..start+len (slot time stamps of both
+ *   time modes result in the same slot range)
+ *
+ * parameters:
+ *   *win :  resulting day window
+ *   start:  start of window in minutes UTC relative to 00:00 UTC of reference day
+ *           (multiple of 15, e.g. -360: 18:00 UTC of day before)
+ *   len  :  length of window in minutes (multiple of 15)
+ *
+ * return value:
+ *    0 :  successfull
+ *    1 :  error: times are not multiples of 15 minutes or window is not within day before
+ *               and reference day
+ *
+ ****************************************************************************************/
+uint32_t slg_metday_setwin (slg_mdwin *win, int32_t start, uint32_t len);
+
+
+
+/* ring functions *********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* clears a day ring
+ *
+ * parameters:
+ *   *metday:  day ring object
+ *
+ ****************************************************************************************/
+void slg_metday_init (slg_metday *metday);
+
+
+/* adds a day as new reference day to a day ring
+ * - the former reference day is kept as day before if it is the day before of date,
+ *   else the day before is empty
+ *
+ * parameters:
+ *   *metday :  day ring object
+ *   *dtemper:  day temperature object of date (NULL: day is missing)
+ *   *date   :  date of day
+ *
+ ****************************************************************************************/
+void slg_metday_push (slg_metday *metday, slg_dtemper *dtemper, slg_date *date);
+
+
+/* calculates statistics of a day window ending on reference day of a day ring
+ * - indices of statistics are relative to window start (0..len-1)
+ * - values of a missing day are invalid, flagged values are ignored
+ * - finds the newest ones if there are more than one minimums or maximums
+ *
+ * parameters:
+ *   *metday:  day ring object
+ *   *win   :  day window
+ *   *dstats:  resulting statistics object
+ *
+ * return value:
+ *         0 :  valid values exist
+ *         1 :  no valid values found
+ *
+ ****************************************************************************************/
+uint32_t slg_metday_stats (slg_metday *metday, slg_mdwin *win, slg_dstats *dstats);
+
+
+/* converts a window index into date and time index of its day
+ *
+ * parameters:
+ *   *metday:  day ring object
+ *   *win   :  day window
+ *   ind    :  window index (0..len-1)
+ *   *date  :  resulting date
+ *   *tind  :  resulting time index of date
+ *
+ * return value:
+ *    0 :  successfull
+ *    1 :  error: invalid index or ring is empty
+ *
+ ****************************************************************************************/
+uint32_t slg_metday_index (slg_metday *metday, slg_mdwin *win, uint32_t ind, slg_date *date, uint32_t *tind);
+
+
+/* calculates statistics of a day window for all days of a month
+ * - the day before of day 1 is taken from dprev (last day of month before)
+ *
+ * parameters:
+ *   *mtemper:  month temperature object
+ *   *dprev  :  day temperature object of last day of month before (NULL: missing)
+ *   *win    :  day window
+ *   *dstats :  resulting array of 31 statistics objects (count 0: no valid values)
+ *
+ * return value:
+ *   0..31 :  number of days with valid values
+ *
+ ****************************************************************************************/
+uint32_t slg_metday_mtemper (slg_mtemper *mtemper, slg_dtemper *dprev, slg_mdwin *win, slg_dstats *dstats);
+
+
+
+#endif
+
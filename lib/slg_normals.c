@@ -0,0 +1,687 @@
+/***************************************************************************************************
+ *
+ * file     : slg_normals.c
+ *
+ * function : senslog project c-library - climatological normals functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "slg_normals.h"
+#include "slg_date.h"
+#include "slg_values.h"
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+#include "slg_hist.h"
+#include "slg_cache.h"
+
+
+/* lock of cache shared by build jobs */
+static pthread_mutex_t slg_nrm_lock = PTHREAD_MUTEX_INITIALIZER;
+
+
+
+/* private functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* sets cache key of a day summary of a column
+ *
+ * parameters:
+ *   *key :  resulting cache key
+ *   *job :  build job
+ *   *date:  date of day
+ *   c    :  column index
+ *
+ ****************************************************************************************/
+static void slg_nrm_cchkey (slg_cchkey *key, slg_nrmjob *job, slg_date *date, uint32_t c)
+{
+  memset (key, 0, sizeof(slg_cchkey));
+  key->locid = job->normals->locid;
+  key->typ = DF_TEMP;
+  key->colid = job->normals->colid[c];
+  key->op = NRM_CCH_OP;
+  slg_date_copy (&key->date_b, date);
+  slg_date_copy (&key->date_e, date);
+  key->param = (int32_t) job->hmode;
+}
+
+
+/* gets day summaries of all temperature columns of a day from the cache
+ *
+ * parameters:
+ *   *job   :  build job
+ *   *date  :  date of day
+ *   fp     :  fingerprint of dayfile
+ *   *nrmday:  resulting day summary (valid only on a hit)
+ *
+ * return value:
+ *    0 :  hit of all temperature columns
+ *    1 :  miss
+ *
+ ****************************************************************************************/
+static uint32_t slg_nrm_cacheget (slg_nrmjob *job, slg_date *date, uint64_t fp, slg_nrmday *nrmday)
+{
+  slg_cchkey key;
+  slg_cchres res;
+  uint32_t   c, miss;
+
+  for (c = 0; c < job->normals->colnum; c++) {
+    nrmday->dstats[c].count = 0;
+    if (job->normals->coltyp[c] != DF_TEMP) continue;
+
+    slg_nrm_cchkey (&key, job, date, c);
+    pthread_mutex_lock (&slg_nrm_lock);
+    miss = slg_cache_get (job->cache, &key, fp, &res);
+    pthread_mutex_unlock (&slg_nrm_lock);
+    if (miss) return (1);
+
+    nrmday->dstats[c].count = (uint32_t) res.val[0];
+    nrmday->dstats[c].sum = (int32_t) res.val[1];
+    nrmday->dstats[c].min = (int32_t) res.val[2];
+    nrmday->dstats[c].max = (int32_t) res.val[3];
+    nrmday->dstats[c].indmin = (uint32_t) res.val[4];
+    nrmday->dstats[c].indmax = (uint32_t) res.val[5];
+  }
+  nrmday->valid = 1;
+
+  return (0);
+}
+
+
+/* stores day summaries of all temperature columns of a day in the cache
+ *
+ * parameters:
+ *   *job   :  build job
+ *   *date  :  date of day
+ *   fp     :  fingerprint of dayfile
+ *   *nrmday:  valid day summary
+ *
+ ****************************************************************************************/
+static void slg_nrm_cacheput (slg_nrmjob *job, slg_date *date, uint64_t fp, slg_nrmday *nrmday)
+{
+  slg_cchkey key;
+  slg_cchres res;
+  uint32_t   c;
+
+  for (c = 0; c < job->normals->colnum; c++) {
+    if (job->normals->coltyp[c] != DF_TEMP) continue;
+
+    slg_nrm_cchkey (&key, job, date, c);
+    memset (&res, 0, sizeof(slg_cchres));
+    res.val[0] = nrmday->dstats[c].count;
+    res.val[1] = nrmday->dstats[c].sum;
+    res.val[2] = nrmday->dstats[c].min;
+    res.val[3] = nrmday->dstats[c].max;
+    res.val[4] = nrmday->dstats[c].indmin;
+    res.val[5] = nrmday->dstats[c].indmax;
+
+    pthread_mutex_lock (&slg_nrm_lock);
+    slg_cache_put (job->cache, &key, fp, &res);
+    pthread_mutex_unlock (&slg_nrm_lock);
+  }
+}
+
+
+/* thread function of build: reads dayfiles of a job and calculates day summaries
+ *
+ * parameters:
+ *   *arg:  build job (slg_nrmjob)
+ *
+ ****************************************************************************************/
+static void *slg_nrm_job (void *arg)
+{
+  slg_nrmjob  *job;
+  slg_daydata daydata;
+  slg_date    date;
+  uint32_t    i, c, k, n, tlen, res;
+  int32_t     val[MAX_MLN_NUM];
+  uint64_t    fp;
+  char        fname[300], temp[20];
+
+  job = (slg_nrmjob *) arg;
+  slg_date_copy (&date, &job->date);
+
+  for (i = 0; i < job->num; i++) {
+    job->nrmday[i].valid = 0;
+    job->nrmday[i].doy = slg_normals_doy (&date);
+
+    /* unchanged dayfile: day summary from cache (fingerprint is taken before reading) */
+    fp = 0;
+    if (job->cache != NULL) {
+      fp = slg_cache_fingerprint (job->pathname, &date, &date);
+      if (slg_nrm_cacheget (job, &date, fp, &job->nrmday[i]) == 0) {
+        slg_date_inc (&date);
+        continue;
+      }
+    }
+
+    strcpy (fname, job->pathname);
+    slg_date_to_fstring (temp, &date);
+    strcat (fname, temp);
+    strcat (fname, ".txt");
+
+    res = slg_readdayfile (&daydata, fname, job->hmode);
+    if ((res == 0) && (daydata.locid == job->normals->locid) && (daydata.tmode == job->normals->tmode)) {
+      tlen = slg_timeindexnum (daydata.tmode);
+
+      for (c = 0; c < job->normals->colnum; c++) {
+        job->nrmday[i].dstats[c].count = 0;
+
+        k = slg_colexist (&daydata, DF_TEMP, job->normals->colid[c]);
+        if ((k == 0) || (job->normals->coltyp[c] != DF_TEMP)) continue;
+
+        for (n = 0; n < tlen; n++) val[n] = slg_gettemperval (&daydata, k, n);
+        slg_dstats_calc (&job->nrmday[i].dstats[c], val, tlen);
+      }
+      job->nrmday[i].valid = 1;
+
+      if (job->cache != NULL) slg_nrm_cacheput (job, &date, fp, &job->nrmday[i]);
+    }
+
+    slg_date_inc (&date);
+  }
+
+  return (NULL);
+}
+
+
+/* calculates normal values of a column and a day of year from day summaries
+ *
+ * parameters:
+ *   *normals:  normals object
+ *   *nrmday :  array of day summaries
+ *   num     :  number of day summaries
+ *   c       :  column index
+ *   doy     :  day of year
+ *
+ ****************************************************************************************/
+static void slg_nrm_calc (slg_normals *normals, slg_nrmday *nrmday, uint32_t num, uint32_t c, uint32_t doy)
+{
+  slg_hist    havg, hmin, hmax;
+  slg_nrment  *nent;
+  slg_dstats  *dstats;
+  int64_t     savg, smin, smax;
+  int32_t     avg;
+  uint32_t    i, dist, count;
+
+  slg_hist_clear (&havg);
+  slg_hist_clear (&hmin);
+  slg_hist_clear (&hmax);
+  savg = 0;
+  smin = 0;
+  smax = 0;
+  count = 0;
+
+  for (i = 0; i < num; i++) {
+    if (nrmday[i].valid == 0) continue;
+    dstats = &nrmday[i].dstats[c];
+    if (dstats->count == 0) continue;
+
+    /* cyclic distance of days of year */
+    dist = (nrmday[i].doy > doy) ? nrmday[i].doy - doy : doy - nrmday[i].doy;
+    if (dist > (NRM_DOYNUM / 2)) dist = NRM_DOYNUM - dist;
+    if (dist > normals->win) continue;
+
+    avg = slg_dstats_average (dstats);
+    slg_hist_add (&havg, &avg, 1);
+    slg_hist_add (&hmin, &dstats->min, 1);
+    slg_hist_add (&hmax, &dstats->max, 1);
+    savg += avg;
+    smin += dstats->min;
+    smax += dstats->max;
+    count++;
+  }
+
+  nent = &normals->ent[c][doy];
+  nent->count = count;
+  if (count == 0) return;
+
+  nent->avg = (int32_t) (savg / (int64_t) count);
+  nent->avgmin = (int32_t) (smin / (int64_t) count);
+  nent->avgmax = (int32_t) (smax / (int64_t) count);
+  nent->p10 = slg_hist_percentile (&havg, 100);
+  nent->p90 = slg_hist_percentile (&havg, 900);
+  nent->p10min = slg_hist_percentile (&hmin, 100);
+  nent->p90max = slg_hist_percentile (&hmax, 900);
+}
+
+
+
+/* normals functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* calculates day of year of a date in leap year calendar
+ *
+ * parameters:
+ *   *date:  date
+ *
+ * return value:
+ *   0..365 :  day of year (29.02. is 59, 01.03. is 60 in all years)
+ *   CNERR  :  invalid date
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_doy (slg_date *date)
+{
+  slg_date jan1;
+  uint32_t doy;
+
+  if (slg_date_number_days_in_month (date) == 0) return (CNERR);
+  if ((date->d < 1) || (date->d > slg_date_number_days_in_month (date))) return (CNERR);
+
+  slg_date_set_int (&jan1, 1, 1, date->y);
+  doy = (uint32_t) slg_date_sub (date, &jan1);
+
+  /* skip 29.02. in non leap years */
+  if ((date->m > 2) && (slg_date_number_days_in_year (date) == 365)) doy++;
+
+  return (doy);
+}
+
+
+/* builds a normals table from all dayfiles of a reference period
+ * - location, time mode and columns are taken from a template dayfile
+ * - dayfiles are read in parallel, normals are calculated from day summaries afterwards
+ * - with a cache, day summaries of unchanged dayfiles are taken from the cache instead
+ *   of reading the dayfile (fingerprint of the dayfile, see slg_cache_fingerprint())
+ *
+ * parameters:
+ *   *normals :  normals object
+ *   *daydata :  template daydata object
+ *   *pathname:  path name of dayfiles (incl. '/') or empty string
+ *   yfirst   :  first year of reference period
+ *   ylast    :  last year of reference period
+ *   hmode    :  header mode of dayfiles (see slg_readdayfile())
+ *   win      :  smoothing half window (0..NRM_MAX_WIN days)
+ *   tnum     :  number of threads (1..NRM_MAX_THREADS)
+ *   *cache   :  cache object or NULL (no cache)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid parameter
+ *    2 :  error: out of memory or thread creation failed
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_build (slg_normals *normals, slg_daydata *daydata, char *pathname,
+                            uint32_t yfirst, uint32_t ylast, uint32_t hmode, uint32_t win, uint32_t tnum,
+                            slg_cache *cache)
+{
+  slg_nrmjob  job[NRM_MAX_THREADS];
+  pthread_t   thread[NRM_MAX_THREADS];
+  slg_nrmday  *nrmday;
+  slg_date    date, date_e;
+  uint32_t    num, chunk, t, i, c, ret;
+
+  if ((tnum < 1) || (tnum > NRM_MAX_THREADS) || (win > NRM_MAX_WIN)) return (1);
+  if (strlen(pathname) > 280) return (1);
+  if (slg_date_set_int (&date, 1, 1, yfirst) == 0) return (1);
+  if (slg_date_set_int (&date_e, 31, 12, ylast) == 0) return (1);
+  if (yfirst > ylast) return (1);
+
+  /* set header */
+  memset (normals, 0, sizeof(slg_normals));
+  strcpy (normals->magic, NRM_MAGIC);
+  normals->version = NRM_VERSION;
+  normals->locid = daydata->locid;
+  normals->tmode = daydata->tmode;
+  normals->yfirst = yfirst;
+  normals->ylast = ylast;
+  normals->win = win;
+  normals->colnum = daydata->colnum;
+  for (i = 0; i < daydata->colnum; i++) {
+    normals->coltyp[i] = daydata->coltyp[i];
+    normals->colid[i] = daydata->colid[i];
+  }
+
+  num = (uint32_t) slg_date_sub (&date_e, &date) + 1;
+  if (tnum > num) tnum = num;
+
+  nrmday = (slg_nrmday *) malloc (num * sizeof(slg_nrmday));
+  if (nrmday == NULL) return (2);
+
+  /* split reference period into jobs of neighboured days */
+  chunk = (num + tnum - 1) / tnum;
+  tnum = (num + chunk - 1) / chunk;
+  for (t = 0; t < tnum; t++) {
+    job[t].normals = normals;
+    job[t].pathname = pathname;
+    slg_date_copy (&job[t].date, &date);
+    job[t].num = ((t + 1) * chunk <= num) ? chunk : num - t * chunk;
+    job[t].hmode = hmode;
+    job[t].cache = cache;
+    job[t].nrmday = &nrmday[t * chunk];
+
+    slg_date_add (&date, (int32_t) job[t].num);
+  }
+
+  /* read dayfiles in parallel */
+  ret = 0;
+  for (t = 0; t < tnum; t++) {
+    if (pthread_create (&thread[t], NULL, slg_nrm_job, &job[t]) != 0) {
+      ret = 2;
+      break;
+    }
+  }
+  while (t > 0) {
+    t--;
+    pthread_join (thread[t], NULL);
+  }
+  if (ret != 0) {
+    free (nrmday);
+    return (ret);
+  }
+
+  /* calculate normals of all temperature columns and days of year */
+  for (c = 0; c < normals->colnum; c++) {
+    if (normals->coltyp[c] != DF_TEMP) continue;
+    for (i = 0; i < NRM_DOYNUM; i++) slg_nrm_calc (normals, nrmday, num, c, i);
+  }
+
+  free (nrmday);
+
+  return (0);
+}
+
+
+/* gets normal values of a column for a date
+ *
+ * parameters:
+ *   *normals:  normals object
+ *   c       :  column index (0..colnum-1)
+ *   *date   :  date
+ *
+ * return value:
+ *    NULL :  invalid date or column, column is not temperature or no normal values
+ *   other :  pointer to normal values
+ *
+ ****************************************************************************************/
+slg_nrment *slg_normals_get (slg_normals *normals, uint32_t c, slg_date *date)
+{
+  uint32_t doy;
+
+  if ((c >= normals->colnum) || (normals->coltyp[c] != DF_TEMP)) return (NULL);
+
+  doy = slg_normals_doy (date);
+  if (doy == CNERR) return (NULL);
+  if (normals->ent[c][doy].count == 0) return (NULL);
+
+  return (&normals->ent[c][doy]);
+}
+
+
+/* checks if a column of a special typ and id exists in normals table
+ *
+ * parameters:
+ *   *normals:  normals object
+ *   typ     :  column typ
+ *   id      :  column id
+ *
+ * return value:
+ *         0 :  column does not exist
+ *      >= 1 :  column number (index in table + 1)
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_colexist (slg_normals *normals, uint32_t typ, uint32_t id)
+{
+  uint32_t i;
+
+  for (i = 0; i < normals->colnum; i++) {
+    if ((normals->coltyp[i] == typ) && (normals->colid[i] == id)) return (i + 1);
+  }
+
+  return (0);
+}
+
+
+
+/* anomaly functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* calculates slot anomalies of a day (value minus normal average of its day of year)
+ *
+ * parameters:
+ *   *normals:  normals object
+ *   c       :  column index of normals table
+ *   *date   :  date of values
+ *   *val    :  array of temperatures T*10 (CNERR: invalid value)
+ *   len     :  array length
+ *   *anom   :  resulting array of anomalies (len entries, CNERR: invalid value)
+ *
+ * return value:
+ *   CNERR :  no normal values of column and date (all anomalies are CNERR)
+ *   other :  number of valid anomalies
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_anomaly (slg_normals *normals, uint32_t c, slg_date *date,
+                              int32_t *val, uint32_t len, int32_t *anom)
+{
+  slg_nrment *nent;
+  uint32_t   i, count;
+  int32_t    avg;
+
+  nent = slg_normals_get (normals, c, date);
+  if (nent == NULL) {
+    for (i = 0; i < len; i++) anom[i] = CNERR;
+    return (CNERR);
+  }
+
+  avg = nent->avg;
+  count = 0;
+  for (i = 0; i < len; i++) {
+    if (val[i] == CNERR) {
+      anom[i] = CNERR;
+    }
+    else {
+      anom[i] = val[i] - avg;
+      count++;
+    }
+  }
+
+  return (count);
+}
+
+
+/* calculates anomaly of a day average (day average minus normal average)
+ *
+ * parameters:
+ *   *normals:  normals object
+ *   c       :  column index of normals table
+ *   *date   :  date of day
+ *   *dstats :  day statistics
+ *
+ * return value:
+ *   CNERR :  no valid values or no normal values of column and date
+ *   other :  anomaly (T*10)
+ *
+ ****************************************************************************************/
+int32_t slg_normals_danomaly (slg_normals *normals, uint32_t c, slg_date *date, slg_dstats *dstats)
+{
+  slg_nrment *nent;
+
+  if (dstats->count == 0) return (CNERR);
+
+  nent = slg_normals_get (normals, c, date);
+  if (nent == NULL) return (CNERR);
+
+  return (slg_dstats_average (dstats) - nent->avg);
+}
+
+
+/* calculates anomalies of all days of a month (uses day statistics of month object)
+ *
+ * parameters:
+ *   *normals:  normals object
+ *   c       :  column index of normals table
+ *   *mtemper:  month temperature object
+ *   year    :  year of month
+ *   month   :  month (1..12)
+ *   *anom   :  resulting array of 31 anomalies (index: day - 1, CNERR: invalid day)
+ *
+ * return value:
+ *   0..31 :  number of days with valid anomaly
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_manomaly (slg_normals *normals, uint32_t c, slg_mtemper *mtemper,
+                               uint32_t year, uint32_t month, int32_t *anom)
+{
+  slg_date date;
+  uint32_t i, dnum;
+
+  dnum = 0;
+  for (i = 0; i < 31; i++) {
+    anom[i] = CNERR;
+    if (mtemper->dvalid[i] == 0) continue;
+    if (slg_date_set_int (&date, i + 1, month, year) == 0) continue;
+
+    anom[i] = slg_normals_danomaly (normals, c, &date, &mtemper->dstats[i]);
+    if (anom[i] != CNERR) dnum++;
+  }
+
+  return (dnum);
+}
+
+
+/* calculates cumulative anomaly series (invalid anomalies do not change the sum)
+ *
+ * parameters:
+ *   *anom:  array of anomalies (CNERR: invalid value)
+ *   len  :  array length
+ *   *cum :  resulting array of cumulative anomalies (len entries, may be equal to anom)
+ *
+ ****************************************************************************************/
+void slg_normals_cumulate (int32_t *anom, uint32_t len, int32_t *cum)
+{
+  uint32_t i;
+  int32_t  sum;
+
+  sum = 0;
+  for (i = 0; i < len; i++) {
+    if (anom[i] != CNERR) sum += anom[i];
+    cum[i] = sum;
+  }
+}
+
+
+/* calculates summary of a series of daily anomalies
+ *
+ * parameters:
+ *   *anom :  array of anomalies (CNERR: invalid value)
+ *   len   :  array length
+ *   *nanom:  resulting anomaly summary
+ *
+ * return value:
+ *    0 :  successfull
+ *    1 :  no valid anomalies (dnum is 0)
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_anomaly_stats (int32_t *anom, uint32_t len, slg_nrmanom *nanom)
+{
+  uint32_t i;
+
+  memset (nanom, 0, sizeof(slg_nrmanom));
+  nanom->avg = CNERR;
+  nanom->min = CNERR;
+  nanom->max = CNERR;
+
+  for (i = 0; i < len; i++) {
+    if (anom[i] == CNERR) continue;
+
+    if ((nanom->dnum == 0) || (anom[i] <= nanom->min)) {
+      nanom->min = anom[i];
+      nanom->imin = i;
+    }
+    if ((nanom->dnum == 0) || (anom[i] >= nanom->max)) {
+      nanom->max = anom[i];
+      nanom->imax = i;
+    }
+    if (anom[i] > 0) nanom->nwarm++;
+    if (anom[i] < 0) nanom->ncold++;
+
+    nanom->sum += anom[i];
+    nanom->dnum++;
+  }
+
+  if (nanom->dnum == 0) return (1);
+
+  nanom->avg = nanom->sum / (int32_t) nanom->dnum;
+
+  return (0);
+}
+
+
+
+/* file functions *********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* saves a normals table into a file
+ *
+ * parameters:
+ *   *normals :  normals object
+ *   *filename:  path/filename of normals file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: writing file failed
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_save (slg_normals *normals, char *filename)
+{
+  FILE *fpw;
+
+  fpw = fopen (filename, "wb");
+  if (fpw == NULL) return (1);
+
+  if (fwrite (normals, sizeof(slg_normals), 1, fpw) != 1) {
+    fclose (fpw);
+    return (1);
+  }
+
+  if (fclose (fpw) != 0) return (1);
+
+  return (0);
+}
+
+
+/* loads a normals table from a file
+ *
+ * parameters:
+ *   *normals :  normals object
+ *   *filename:  path/filename of normals file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: file not found or can not be read
+ *    2 :  error: invalid file (magic or version)
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_load (slg_normals *normals, char *filename)
+{
+  FILE *fpr;
+
+  fpr = fopen (filename, "rb");
+  if (fpr == NULL) return (1);
+
+  if (fread (normals, sizeof(slg_normals), 1, fpr) != 1) {
+    fclose (fpr);
+    return (1);
+  }
+  fclose (fpr);
+
+  if ((strncmp (normals->magic, NRM_MAGIC, 8) != 0) || (normals->version != NRM_VERSION)) return (2);
+  if (normals->colnum > MAX_MLN_VALS) return (2);
+
+  return (0);
+}
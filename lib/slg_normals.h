@@ -0,0 +1,309 @@
+/***************************************************************************************************
+ *
+ * file     : slg_normals.h
+ *
+ * function : senslog project c-library - climatological normals functions
+ *            - a normals table holds for each day of year and temperature column the
+ *              normal values of a reference period (averages and percentiles of day
+ *              average, day min. and day max.)
+ *            - days of year are counted in a leap year calendar (29.02. is index 59),
+ *              values are smoothed over a window of +-win days around each day of year
+ *            - dayfiles are read once in parallel threads, the table is stored as a
+ *              binary file
+ *            - anomalies (value minus normal average) of slots and days, cumulative
+ *              anomaly series and anomaly summaries of months and years
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_date.h"
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+#include "slg_cache.h"
+
+
+#ifndef _slg_normals_h
+#define _slg_normals_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define NRM_MAGIC        "SLGNRM"   /* file magic (8 bytes incl. zero padding) */
+# define NRM_VERSION      1          /* file format version */
+
+# define NRM_DOYNUM       366        /* number of days of year (leap year calendar) */
+# define NRM_MAX_WIN      15         /* max. smoothing half window (days) */
+# define NRM_MAX_THREADS  16         /* max. number of threads of build */
+
+# define NRM_CCH_OP       (CCH_OP_USER + 0)  /* cache operation: day summary of a column
+                                                (key param: header mode of dayfiles) */
+
+
+/* normal values of a day of year (values are invalid if count is 0) */
+typedef struct {
+  uint32_t  count;        /* number of days in window over all years */
+  int32_t   avg;          /* average of day averages (T*10) */
+  int32_t   avgmin;       /* average of day min. values */
+  int32_t   avgmax;       /* average of day max. values */
+  int32_t   p10;          /* 10 % percentile of day averages */
+  int32_t   p90;          /* 90 % percentile of day averages */
+  int32_t   p10min;       /* 10 % percentile of day min. values */
+  int32_t   p90max;       /* 90 % percentile of day max. values */
+} slg_nrment;
+
+
+/* normals table of a location (stored 1:1 in normals file) */
+typedef struct {
+  char        magic[8];                     /* NRM_MAGIC */
+  uint32_t    version;                      /* NRM_VERSION */
+  uint32_t    locid;                        /* location id */
+  uint32_t    tmode;                        /* time_mode */
+  uint32_t    yfirst;                       /* first year of reference period */
+  uint32_t    ylast;                        /* last year of reference period */
+  uint32_t    win;                          /* smoothing half window (days) */
+  uint32_t    colnum;                       /* number of columns */
+  uint32_t    coltyp[MAX_MLN_VALS];         /* list of column types */
+  uint32_t    colid[MAX_MLN_VALS];          /* list of column ids */
+  slg_nrment  ent[MAX_MLN_VALS][NRM_DOYNUM];  /* normals (temperature columns only) */
+} slg_normals;
+
+
+/* summary of a series of daily anomalies (values are invalid if dnum is 0) */
+typedef struct {
+  uint32_t  dnum;         /* number of days with valid anomaly */
+  int32_t   sum;          /* sum of anomalies (cumulative anomaly, T*10 * days) */
+  int32_t   avg;          /* average anomaly (T*10) */
+  int32_t   min;          /* min. anomaly */
+  int32_t   max;          /* max. anomaly */
+  uint32_t  imin;         /* series index of min. anomaly (newest one) */
+  uint32_t  imax;         /* series index of max. anomaly (newest one) */
+  uint32_t  nwarm;        /* number of days warmer than normal (anomaly > 0) */
+  uint32_t  ncold;        /* number of days colder than normal (anomaly < 0) */
+} slg_nrmanom;
+
+
+/* day summary of all columns (used by build) */
+typedef struct {
+  uint32_t    valid;                  /* 0: dayfile not found or invalid, 1: valid */
+  uint32_t    doy;                    /* day of year (leap year calendar) */
+  slg_dstats  dstats[MAX_MLN_VALS];   /* statistics of all columns */
+} slg_nrmday;
+
+
+/* build job of a thread (a part of the reference period) */
+typedef struct {
+  slg_normals  *normals;              /* normals object (read only in thread) */
+  char         *pathname;             /* path name of dayfiles */
+  slg_date     date;                  /* first date of job */
+  uint32_t     num;                   /* number of days of job */
+  uint32_t     hmode;                 /* header mode of dayfiles */
+  slg_cache    *cache;                /* cache object or NULL (shared by all jobs) */
+  slg_nrmday   *nrmday;               /* day summaries of job (num entries) */
+} slg_nrmjob;
+
+
+
+/* normals functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* calculates day of year of a date in leap year calendar
+ *
+ * parameters:
+ *   *date:  date
+ *
+ * return value:
+ *   0..365 :  day of year (29.02. is 59, 01.03. is 60 in all years)
+ *   CNERR  :  invalid date
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_doy (slg_date *date);
+
+
+/* builds a normals table from all dayfiles of a reference period
+ * - location, time mode and columns are taken from a template dayfile
+ * - dayfiles are read in parallel, normals are calculated from day summaries afterwards
+ * - with a cache, day summaries of unchanged dayfiles are taken from the cache instead
+ *   of reading the dayfile (fingerprint of the dayfile, see slg_cache_fingerprint())
+ *
+ * parameters:
+ *   *normals :  normals object
+ *   *daydata :  template daydata object
+ *   *pathname:  path name of dayfiles (incl. '/') or empty string
+ *   yfirst   :  first year of reference period
+ *   ylast    :  last year of reference period
+ *   hmode    :  header mode of dayfiles (see slg_readdayfile())
+ *   win      :  smoothing half window (0..NRM_MAX_WIN days)
+ *   tnum     :  number of threads (1..NRM_MAX_THREADS)
+ *   *cache   :  cache object or NULL (no cache)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid parameter
+ *    2 :  error: out of memory or thread creation failed
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_build (slg_normals *normals, slg_daydata *daydata, char *pathname,
+                            uint32_t yfirst, uint32_t ylast, uint32_t hmode, uint32_t win, uint32_t tnum,
+                            slg_cache *cache);
+
+
+/* gets normal values of a column for a date
+ *
+ * parameters:
+ *   *normals:  normals object
+ *   c       :  column index (0..colnum-1)
+ *   *date   :  date
+ *
+ * return value:
+ *    NULL :  invalid date or column, column is not temperature or no normal values
+ *   other :  pointer to normal values
+ *
+ ****************************************************************************************/
+slg_nrment *slg_normals_get (slg_normals *normals, uint32_t c, slg_date *date);
+
+
+/* checks if a column of a special typ and id exists in normals table
+ *
+ * parameters:
+ *   *normals:  normals object
+ *   typ     :  column typ
+ *   id      :  column id
+ *
+ * return value:
+ *         0 :  column does not exist
+ *      >= 1 :  column number (index in table + 1)
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_colexist (slg_normals *normals, uint32_t typ, uint32_t id);
+
+
+
+/* anomaly functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* calculates slot anomalies of a day (value minus normal average of its day of year)
+ *
+ * parameters:
+ *   *normals:  normals object
+ *   c       :  column index of normals table
+ *   *date   :  date of values
+ *   *val    :  array of temperatures T*10 (CNERR: invalid value)
+ *   len     :  array length
+ *   *anom   :  resulting array of anomalies (len entries, CNERR: invalid value)
+ *
+ * return value:
+ *   CNERR :  no normal values of column and date (all anomalies are CNERR)
+ *   other :  number of valid anomalies
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_anomaly (slg_normals *normals, uint32_t c, slg_date *date,
+                              int32_t *val, uint32_t len, int32_t *anom);
+
+
+/* calculates anomaly of a day average (day average minus normal average)
+ *
+ * parameters:
+ *   *normals:  normals object
+ *   c       :  column index of normals table
+ *   *date   :  date of day
+ *   *dstats :  day statistics
+ *
+ * return value:
+ *   CNERR :  no valid values or no normal values of column and date
+ *   other :  anomaly (T*10)
+ *
+ ****************************************************************************************/
+int32_t slg_normals_danomaly (slg_normals *normals, uint32_t c, slg_date *date, slg_dstats *dstats);
+
+
+/* calculates anomalies of all days of a month (uses day statistics of month object)
+ *
+ * parameters:
+ *   *normals:  normals object
+ *   c       :  column index of normals table
+ *   *mtemper:  month temperature object
+ *   year    :  year of month
+ *   month   :  month (1..12)
+ *   *anom   :  resulting array of 31 anomalies (index: day - 1, CNERR: invalid day)
+ *
+ * return value:
+ *   0..31 :  number of days with valid anomaly
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_manomaly (slg_normals *normals, uint32_t c, slg_mtemper *mtemper,
+                               uint32_t year, uint32_t month, int32_t *anom);
+
+
+/* calculates cumulative anomaly series (invalid anomalies do not change the sum)
+ *
+ * parameters:
+ *   *anom:  array of anomalies (CNERR: invalid value)
+ *   len  :  array length
+ *   *cum :  resulting array of cumulative anomalies (len entries, may be equal to anom)
+ *
+ ****************************************************************************************/
+void slg_normals_cumulate (int32_t *anom, uint32_t len, int32_t *cum);
+
+
+/* calculates summary of a series of daily anomalies
+ *
+ * parameters:
+ *   *anom :  array of anomalies (CNERR: invalid value)
+ *   len   :  array length
+ *   *nanom:  resulting anomaly summary
+ *
+ * return value:
+ *    0 :  successfull
+ *    1 :  no valid anomalies (dnum is 0)
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_anomaly_stats (int32_t *anom, uint32_t len, slg_nrmanom *nanom);
+
+
+
+/* file functions *********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* saves a normals table into a file
+ *
+ * parameters:
+ *   *normals :  normals object
+ *   *filename:  path/filename of normals file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: writing file failed
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_save (slg_normals *normals, char *filename);
+
+
+/* loads a normals table from a file
+ *
+ * parameters:
+ *   *normals :  normals object
+ *   *filename:  path/filename of normals file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: file not found or can not be read
+ *    2 :  error: invalid file (magic or version)
+ *
+ ****************************************************************************************/
+uint32_t slg_normals_load (slg_normals *normals, char *filename);
+
+
+
+#endif
+
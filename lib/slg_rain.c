@@ -7,7 +7,7 @@
  * author   : Jochen Ertel
  *
  * created  : 15.01.2022
- * updated  : 05.11.2023
+ * updated  : 18.10.2026
  *
  **************************************************************************************************/
 
@@ -148,7 +148,214 @@ uint32_t slg_mrain_sum (slg_mrain *mrain)
 
 
 
+/* prefix sum related functions *******************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* initialises an empty rain series
+ *
+ * parameters:
+ *   *rainps:  rain series object
+ *
+ ****************************************************************************************/
+void slg_rainps_init (slg_rainps *rainps)
+{
+  rainps->dnum = 0;
+  rainps->ps[0] = 0;
+  rainps->max1h = 0;
+  rainps->max3h = 0;
+  rainps->max6h = 0;
+  rainps->imax1h = 0;
+  rainps->imax3h = 0;
+  rainps->imax6h = 0;
+  rainps->wetspells = 0;
+  rainps->dryspells = 0;
+  rainps->wetmax = 0;
+  rainps->drymax = 0;
+  rainps->wetmaxend = 0;
+  rainps->drymaxend = 0;
+  rainps->spell = 0;
+  rainps->spellen = 0;
+}
+
+
+/* updates max. sum of windows ending at a slot (private function)
+ *
+ * parameters:
+ *   *rainps:  rain series object
+ *   n      :  number of slots in series (window ends at slot n - 1)
+ *   wlen   :  window length in slots
+ *   *max   :  max. sum of window length
+ *   *imax  :  last slot of max. window
+ *
+ ****************************************************************************************/
+static void slg_rainps_window (slg_rainps *rainps, uint32_t n, uint32_t wlen, uint32_t *max, uint32_t *imax)
+{
+  uint32_t w;
+
+  if (n < wlen) return;
+
+  w = rainps->ps[n] - rainps->ps[n - wlen];
+  if (w >= *max) {
+    *max = w;
+    *imax = n - 1;
+  }
+}
+
+
+/* appends a day to a rain series
+ * - prefix sums, max. 1h/3h/6h sums (windows can span day boundaries) and spells
+ *   are updated in O(number of slots of day)
+ * - a missing day adds MAX_MLN_NUM invalid slots and ends the current spell
+ * - a day is wet if its sum is >= RPS_WETDAY, otherwise it is dry
+ *
+ * parameters:
+ *   *rainps:  rain series object
+ *   *drain :  day rain object (NULL: day does not exist)
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  error, rain series is full (RPS_MAX_DAYS)
+ *
+ ****************************************************************************************/
+uint32_t slg_rainps_add (slg_rainps *rainps, slg_drain *drain)
+{
+  uint32_t i, n, v, sum, count, spell;
+
+  if (rainps->dnum >= RPS_MAX_DAYS) return (1);
+
+  sum = 0;
+  count = 0;
+  n = rainps->dnum * MAX_MLN_NUM;
+
+  for (i = 0; i < MAX_MLN_NUM; i++) {
+    v = 0;
+    if ((drain != NULL) && (i < drain->tlen) && (drain->val[i] != CNERR)) {
+      v = drain->val[i];
+      count++;
+    }
+    sum += v;
+
+    n++;
+    rainps->ps[n] = rainps->ps[n - 1] + v;
+
+    slg_rainps_window (rainps, n, RPS_W1H, &rainps->max1h, &rainps->imax1h);
+    slg_rainps_window (rainps, n, RPS_W3H, &rainps->max3h, &rainps->imax3h);
+    slg_rainps_window (rainps, n, RPS_W6H, &rainps->max6h, &rainps->imax6h);
+  }
+
+  /* day sum and spells (days without any valid value end a spell) */
+  if (count == 0) {
+    rainps->dsum[rainps->dnum] = CNERR;
+    spell = 0;
+  }
+  else {
+    rainps->dsum[rainps->dnum] = sum;
+    spell = (sum >= RPS_WETDAY) ? 1 : 2;
+  }
+
+  if (spell != rainps->spell) {
+    rainps->spell = spell;
+    rainps->spellen = 0;
+    if (spell == 1) rainps->wetspells++;
+    if (spell == 2) rainps->dryspells++;
+  }
+
+  if (spell == 1) {
+    rainps->spellen++;
+    if (rainps->spellen >= rainps->wetmax) {
+      rainps->wetmax = rainps->spellen;
+      rainps->wetmaxend = rainps->dnum;
+    }
+  }
+
+  if (spell == 2) {
+    rainps->spellen++;
+    if (rainps->spellen >= rainps->drymax) {
+      rainps->drymax = rainps->spellen;
+      rainps->drymaxend = rainps->dnum;
+    }
+  }
+
+  rainps->dnum++;
+
+  return (0);
+}
+
+
+/* appends all days of a month to a rain series (a year is built by appending 12 months)
+ *
+ * parameters:
+ *   *rainps:  rain series object
+ *   *mrain :  month rain object
+ *   dnum   :  number of days of month
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  error, rain series is full (RPS_MAX_DAYS)
+ *
+ ****************************************************************************************/
+uint32_t slg_rainps_add_month (slg_rainps *rainps, slg_mrain *mrain, uint32_t dnum)
+{
+  uint32_t i, res;
+
+  if (dnum > 31) dnum = 31;
+
+  for (i = 0; i < dnum; i++) {
+    res = slg_rainps_add (rainps, (mrain->dvalid[i]) ? &mrain->drain[i] : NULL);
+    if (res != 0) return (1);
+  }
+
+  return (0);
+}
 
 
+/* calculates rain sum of a slot interval in O(1)
+ * -> slot index of series is day * MAX_MLN_NUM + time index
+ *
+ * parameters:
+ *   *rainps:  rain series object
+ *   ib     :  first slot of interval
+ *   ie     :  last slot of interval
+ *
+ * return value:
+ *   CNERR :  invalid interval
+ *   srain :  sum rain*100
+ *
+ ****************************************************************************************/
+uint32_t slg_rainps_sum (slg_rainps *rainps, uint32_t ib, uint32_t ie)
+{
+  if ((ib > ie) || (ie >= rainps->dnum * MAX_MLN_NUM)) return (CNERR);
+
+  return (rainps->ps[ie + 1] - rainps->ps[ib]);
+}
 
 
+/* calculates max. rain sum over any window of wlen slots in O(number of slots)
+ * (1h, 3h and 6h values are already calculated in rain series object)
+ *
+ * parameters:
+ *   *rainps:  rain series object
+ *   wlen   :  window length in slots
+ *   *ind   :  last slot of max. window (newest one)
+ *
+ * return value:
+ *   CNERR :  invalid window length
+ *   srain :  max. sum rain*100
+ *
+ ****************************************************************************************/
+uint32_t slg_rainps_maxsum (slg_rainps *rainps, uint32_t wlen, uint32_t *ind)
+{
+  uint32_t n, max;
+
+  if ((wlen == 0) || (wlen > rainps->dnum * MAX_MLN_NUM)) return (CNERR);
+
+  max = 0;
+  *ind = 0;
+
+  for (n = wlen; n <= rainps->dnum * MAX_MLN_NUM; n++) {
+    slg_rainps_window (rainps, n, wlen, &max, ind);
+  }
+
+  return (max);
+}
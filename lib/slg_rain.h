@@ -7,7 +7,7 @@
  * author   : Jochen Ertel
  *
  * created  : 15.01.2022
- * updated  : 05.11.2023
+ * updated  : 18.10.2026
  *
  **************************************************************************************************/
 
@@ -25,6 +25,15 @@
 /**************************************************************************************************/
 /**************************************************************************************************/
 
+# define RPS_MAX_DAYS  366                           /* max. number of days of a rain series */
+# define RPS_MAX_LEN   (RPS_MAX_DAYS * MAX_MLN_NUM)  /* max. number of slots of a rain series */
+
+# define RPS_W1H       4     /* number of slots of 1 hour */
+# define RPS_W3H      12     /* number of slots of 3 hours */
+# define RPS_W6H      24     /* number of slots of 6 hours */
+
+# define RPS_WETDAY   10     /* min. rain sum*100 of a wet day (0.1 mm) */
+
 
 /* day rain array */
 typedef struct {
@@ -43,6 +52,28 @@ typedef struct {
 } slg_mrain;
 
 
+/* rain series with prefix sums (a day, month or year, MAX_MLN_NUM slots per day) */
+typedef struct {
+  uint32_t  dnum;                    /* number of days in series */
+  uint32_t  ps[RPS_MAX_LEN + 1];     /* prefix sums: ps[i] is sum of slots 0..i-1 (invalid: 0) */
+  uint32_t  dsum[RPS_MAX_DAYS];      /* day sums (CNERR: day does not exist) */
+  uint32_t  max1h;                   /* max. rain sum of 1 hour */
+  uint32_t  max3h;                   /* max. rain sum of 3 hours */
+  uint32_t  max6h;                   /* max. rain sum of 6 hours */
+  uint32_t  imax1h;                  /* last slot of max. 1 hour window (newest one) */
+  uint32_t  imax3h;                  /* last slot of max. 3 hour window (newest one) */
+  uint32_t  imax6h;                  /* last slot of max. 6 hour window (newest one) */
+  uint32_t  wetspells;               /* number of spells of wet days */
+  uint32_t  dryspells;               /* number of spells of dry days */
+  uint32_t  wetmax;                  /* length of longest wet spell (days) */
+  uint32_t  drymax;                  /* length of longest dry spell (days) */
+  uint32_t  wetmaxend;               /* last day of longest wet spell (newest one) */
+  uint32_t  drymaxend;               /* last day of longest dry spell (newest one) */
+  uint32_t  spell;                   /* current spell: 0: none, 1: wet, 2: dry */
+  uint32_t  spellen;                 /* length of current spell (days) */
+} slg_rainps;
+
+
 
 /* day related functions **************************************************************************/
 /**************************************************************************************************/
@@ -108,6 +139,85 @@ uint32_t slg_mrain_sum (slg_mrain *mrain);
 
 
 
+/* prefix sum related functions *******************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* initialises an empty rain series
+ *
+ * parameters:
+ *   *rainps:  rain series object
+ *
+ ****************************************************************************************/
+void slg_rainps_init (slg_rainps *rainps);
+
+
+/* appends a day to a rain series
+ * - prefix sums, max. 1h/3h/6h sums (windows can span day boundaries) and spells
+ *   are updated in O(number of slots of day)
+ * - a missing day adds MAX_MLN_NUM invalid slots and ends the current spell
+ * - a day is wet if its sum is >= RPS_WETDAY, otherwise it is dry
+ *
+ * parameters:
+ *   *rainps:  rain series object
+ *   *drain :  day rain object (NULL: day does not exist)
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  error, rain series is full (RPS_MAX_DAYS)
+ *
+ ****************************************************************************************/
+uint32_t slg_rainps_add (slg_rainps *rainps, slg_drain *drain);
+
+
+/* appends all days of a month to a rain series (a year is built by appending 12 months)
+ *
+ * parameters:
+ *   *rainps:  rain series object
+ *   *mrain :  month rain object
+ *   dnum   :  number of days of month
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  error, rain series is full (RPS_MAX_DAYS)
+ *
+ ****************************************************************************************/
+uint32_t slg_rainps_add_month (slg_rainps *rainps, slg_mrain *mrain, uint32_t dnum);
+
+
+/* calculates rain sum of a slot interval in O(1)
+ * -> slot index of series is day * MAX_MLN_NUM + time index
+ *
+ * parameters:
+ *   *rainps:  rain series object
+ *   ib     :  first slot of interval
+ *   ie     :  last slot of interval
+ *
+ * return value:
+ *   CNERR :  invalid interval
+ *   srain :  sum rain*100
+ *
+ ****************************************************************************************/
+uint32_t slg_rainps_sum (slg_rainps *rainps, uint32_t ib, uint32_t ie);
+
+
+/* calculates max. rain sum over any window of wlen slots in O(number of slots)
+ * (1h, 3h and 6h values are already calculated in rain series object)
+ *
+ * parameters:
+ *   *rainps:  rain series object
+ *   wlen   :  window length in slots
+ *   *ind   :  last slot of max. window (newest one)
+ *
+ * return value:
+ *   CNERR :  invalid window length
+ *   srain :  max. sum rain*100
+ *
+ ****************************************************************************************/
+uint32_t slg_rainps_maxsum (slg_rainps *rainps, uint32_t wlen, uint32_t *ind);
+
+
+
 
 #endif
 
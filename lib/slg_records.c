@@ -0,0 +1,558 @@
+/***************************************************************************************************
+ *
+ * file     : slg_records.c
+ *
+ * function : senslog project c-library - all-time records functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "slg_records.h"
+#include "slg_date.h"
+#include "slg_values.h"
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+#include "slg_rain.h"
+
+
+
+/* private functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* updates a record if a value is higher/lower or equal (newest one wins)
+ *
+ * parameters:
+ *   *rec :  record
+ *   val  :  new value (CNERR: nothing is done)
+ *   *date:  date of new value
+ *   ind  :  time index of new value
+ *   lower:  0: higher value is record, 1: lower value is record
+ *
+ ****************************************************************************************/
+static void slg_rec_update (slg_record *rec, int32_t val, slg_date *date, uint32_t ind, uint32_t lower)
+{
+  if (val == CNERR) return;
+
+  if (rec->val != CNERR) {
+    if ((lower == 0) && (val < rec->val)) return;
+    if ((lower == 1) && (val > rec->val)) return;
+  }
+
+  rec->val = val;
+  slg_date_copy (&rec->date, date);
+  rec->ind = ind;
+}
+
+
+/* clears running statistics of a column
+ *
+ * parameters:
+ *   *dstats:  statistics object
+ *
+ ****************************************************************************************/
+static void slg_rec_clearstats (slg_dstats *dstats)
+{
+  dstats->count = 0;
+  dstats->sum = 0;
+  dstats->min = CNERR;
+  dstats->max = CNERR;
+  dstats->indmin = 0;
+  dstats->indmax = 0;
+}
+
+
+/* clears all records and running states (header is kept)
+ *
+ * parameters:
+ *   *records:  records object
+ *
+ ****************************************************************************************/
+static void slg_rec_clear (slg_records *records)
+{
+  uint32_t c, r;
+
+  records->curvalid = 0;
+  records->curopen = 0;
+  memset (&records->curdate, 0, sizeof(slg_date));
+  memset (&records->lastdate, 0, sizeof(slg_date));
+
+  for (c = 0; c < MAX_MLN_VALS; c++) {
+    for (r = 0; r < REC_NUM; r++) {
+      records->col[c].rec[r].val = CNERR;
+      memset (&records->col[c].rec[r].date, 0, sizeof(slg_date));
+      records->col[c].rec[r].ind = 0;
+    }
+    slg_rec_clearstats (&records->col[c].cur);
+    records->col[c].dryspell = 0;
+  }
+}
+
+
+/* updates records which can be set before a day is complete
+ *
+ * parameters:
+ *   *records:  records object
+ *   c       :  column index
+ *
+ ****************************************************************************************/
+static void slg_rec_running (slg_records *records, uint32_t c)
+{
+  slg_reccol *rcol;
+
+  rcol = &records->col[c];
+  if (rcol->cur.count == 0) return;
+
+  if (records->coltyp[c] == DF_TEMP) {
+    slg_rec_update (&rcol->rec[REC_MAX], rcol->cur.max, &records->curdate, rcol->cur.indmax, 0);
+    slg_rec_update (&rcol->rec[REC_MIN], rcol->cur.min, &records->curdate, rcol->cur.indmin, 1);
+  }
+
+  if (records->coltyp[c] == DF_RAIN) {
+    slg_rec_update (&rcol->rec[REC_MAX], rcol->cur.max, &records->curdate, rcol->cur.indmax, 0);
+    slg_rec_update (&rcol->rec[REC_RAINDAY], rcol->cur.sum, &records->curdate, 0, 0);
+  }
+}
+
+
+/* starts a day, an open older day is closed before
+ *
+ * parameters:
+ *   *records:  records object
+ *   *date   :  date of day
+ *
+ * return value:
+ *    0 :  new day started
+ *    1 :  error: invalid date
+ *    2 :  error: date is older than current day or current day is closed
+ *    3 :  date is current open day
+ *
+ ****************************************************************************************/
+static uint32_t slg_rec_newday (slg_records *records, slg_date *date)
+{
+  uint32_t c, res;
+
+  if (slg_date_number_days_in_month (date) == 0) return (1);
+  if ((date->d < 1) || (date->d > slg_date_number_days_in_month (date))) return (1);
+
+  if (records->curvalid) {
+    res = slg_date_compare (date, &records->curdate);
+    if (res == 2) return (2);
+    if (res == 1) return ((records->curopen) ? 3 : 2);
+    if (records->curopen) slg_records_close (records);
+  }
+
+  records->curvalid = 1;
+  records->curopen = 1;
+  slg_date_copy (&records->curdate, date);
+
+  for (c = 0; c < MAX_MLN_VALS; c++) slg_rec_clearstats (&records->col[c].cur);
+
+  return (0);
+}
+
+
+/* calculates statistics of all columns of a dayfile
+ *
+ * parameters:
+ *   *records:  records object
+ *   *daydata:  daydata object
+ *   *dstats :  resulting statistics of all columns of records object
+ *
+ ****************************************************************************************/
+static void slg_rec_daystats (slg_records *records, slg_daydata *daydata, slg_dstats *dstats)
+{
+  uint32_t c, k, i, tlen;
+  int32_t  val[MAX_MLN_NUM];
+
+  tlen = slg_timeindexnum (daydata->tmode);
+
+  for (c = 0; c < records->colnum; c++) {
+    k = slg_colexist (daydata, records->coltyp[c], records->colid[c]);
+    if ((k == 0) || (records->coltyp[c] == DF_EVNT)) {
+      slg_rec_clearstats (&dstats[c]);
+      continue;
+    }
+
+    for (i = 0; i < tlen; i++) {
+      if (records->coltyp[c] == DF_TEMP) val[i] = slg_gettemperval (daydata, k, i);
+      if (records->coltyp[c] == DF_RAIN) val[i] = (int32_t) slg_getrainval (daydata, k, i);
+    }
+
+    slg_dstats_calc (&dstats[c], val, tlen);
+  }
+}
+
+
+/* thread function of rebuild: reads dayfiles of a job and calculates day summaries
+ *
+ * parameters:
+ *   *arg:  rebuild job (slg_recjob)
+ *
+ ****************************************************************************************/
+static void *slg_rec_job (void *arg)
+{
+  slg_recjob  *job;
+  slg_daydata daydata;
+  slg_date    date;
+  uint32_t    i, res;
+  char        fname[300], temp[20];
+
+  job = (slg_recjob *) arg;
+  slg_date_copy (&date, &job->date);
+
+  for (i = 0; i < job->num; i++) {
+    job->recday[i].valid = 0;
+
+    strcpy (fname, job->pathname);
+    slg_date_to_fstring (temp, &date);
+    strcat (fname, temp);
+    strcat (fname, ".txt");
+
+    res = slg_readdayfile (&daydata, fname, job->hmode);
+    if ((res == 0) && (daydata.locid == job->records->locid) && (daydata.tmode == job->records->tmode)) {
+      slg_rec_daystats (job->records, &daydata, job->recday[i].dstats);
+      job->recday[i].valid = 1;
+    }
+
+    slg_date_inc (&date);
+  }
+
+  return (NULL);
+}
+
+
+
+/* records functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* initialises an empty records object
+ * - location, time mode and columns are taken from a template dayfile
+ *
+ * parameters:
+ *   *records:  records object
+ *   *daydata:  template daydata object
+ *
+ ****************************************************************************************/
+void slg_records_init (slg_records *records, slg_daydata *daydata)
+{
+  uint32_t i;
+
+  memset (records, 0, sizeof(slg_records));
+  strcpy (records->magic, REC_MAGIC);
+  records->version = REC_VERSION;
+  records->locid = daydata->locid;
+  records->tmode = daydata->tmode;
+  records->colnum = daydata->colnum;
+  for (i = 0; i < daydata->colnum; i++) {
+    records->coltyp[i] = daydata->coltyp[i];
+    records->colid[i] = daydata->colid[i];
+  }
+
+  slg_rec_clear (records);
+}
+
+
+/* adds statistics of a complete or partial day
+ * - a newer date closes the current day, the same date replaces current day statistics
+ *   (e.g. dayfile was extended)
+ *
+ * parameters:
+ *   *records:  records object
+ *   *date   :  date of day
+ *   *dstats :  statistics of all columns (same order as in records object)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date
+ *    2 :  error: date is older than current day or current day is closed
+ *
+ ****************************************************************************************/
+uint32_t slg_records_add_dstats (slg_records *records, slg_date *date, slg_dstats *dstats)
+{
+  uint32_t c, res;
+
+  res = slg_rec_newday (records, date);
+  if ((res == 1) || (res == 2)) return (res);
+
+  for (c = 0; c < records->colnum; c++) {
+    records->col[c].cur = dstats[c];
+    slg_rec_running (records, c);
+  }
+
+  return (0);
+}
+
+
+/* adds all values of a dayfile (see slg_records_add_dstats())
+ *
+ * parameters:
+ *   *records:  records object
+ *   *daydata:  daydata object
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date
+ *    2 :  error: date is older than current day or current day is closed
+ *    3 :  error: dayfile has other location id or time mode than records object
+ *
+ ****************************************************************************************/
+uint32_t slg_records_add_day (slg_records *records, slg_daydata *daydata)
+{
+  slg_dstats dstats[MAX_MLN_VALS];
+
+  if ((daydata->locid != records->locid) || (daydata->tmode != records->tmode)) return (3);
+
+  slg_rec_daystats (records, daydata, dstats);
+
+  return (slg_records_add_dstats (records, &daydata->date, dstats));
+}
+
+
+/* adds a single new value (e.g. an appended line of the current dayfile)
+ * - a newer date closes the current day
+ * - a value must not be added twice
+ *
+ * parameters:
+ *   *records:  records object
+ *   *date   :  date of value
+ *   c       :  column index (0..colnum-1)
+ *   k       :  time index
+ *   val     :  value (temperature T*10, rain*100, CNERR: invalid value)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date or column
+ *    2 :  error: date is older than current day or current day is closed
+ *
+ ****************************************************************************************/
+uint32_t slg_records_add_value (slg_records *records, slg_date *date, uint32_t c, uint32_t k, int32_t val)
+{
+  slg_dstats *cur;
+  uint32_t   res;
+
+  if (c >= records->colnum) return (1);
+
+  res = slg_rec_newday (records, date);
+  if ((res == 1) || (res == 2)) return (res);
+
+  if ((val == CNERR) || (records->coltyp[c] == DF_EVNT)) return (0);
+
+  /* update running statistics ("<=" and ">=" keep newest index) */
+  cur = &records->col[c].cur;
+  if ((cur->count == 0) || (val <= cur->min)) {
+    cur->min = val;
+    cur->indmin = k;
+  }
+  if ((cur->count == 0) || (val >= cur->max)) {
+    cur->max = val;
+    cur->indmax = k;
+  }
+  cur->sum += val;
+  cur->count++;
+
+  slg_rec_running (records, c);
+
+  return (0);
+}
+
+
+/* closes current day (day related records are set, further values of day are rejected)
+ *
+ * parameters:
+ *   *records:  records object
+ *
+ ****************************************************************************************/
+void slg_records_close (slg_records *records)
+{
+  slg_reccol *rcol;
+  uint32_t   c, follow;
+
+  if ((records->curvalid == 0) || (records->curopen == 0)) return;
+
+  /* current day directly follows last closed day */
+  follow = (records->lastdate.y != 0) && (slg_date_sub (&records->curdate, &records->lastdate) == 1);
+
+  for (c = 0; c < records->colnum; c++) {
+    rcol = &records->col[c];
+
+    if ((records->coltyp[c] == DF_TEMP) && (rcol->cur.count != 0)) {
+      slg_rec_update (&rcol->rec[REC_NIGHTMAX], rcol->cur.min, &records->curdate, 0, 0);
+      slg_rec_update (&rcol->rec[REC_DAYMIN], rcol->cur.max, &records->curdate, 0, 1);
+    }
+
+    if (records->coltyp[c] == DF_RAIN) {
+      if ((rcol->cur.count != 0) && (rcol->cur.sum < RPS_WETDAY)) {
+        rcol->dryspell = (follow) ? rcol->dryspell + 1 : 1;
+        slg_rec_update (&rcol->rec[REC_DRYSPELL], (int32_t) rcol->dryspell, &records->curdate, 0, 0);
+      }
+      else {
+        rcol->dryspell = 0;
+      }
+    }
+  }
+
+  slg_date_copy (&records->lastdate, &records->curdate);
+  records->curopen = 0;
+}
+
+
+/* rebuilds records from all dayfiles of a date range
+ * - records object must be initialised, all records are cleared before
+ * - dayfiles are read in parallel, records are updated in date order afterwards
+ * - last day of range is kept open
+ *
+ * parameters:
+ *   *records :  records object
+ *   *pathname:  path name of dayfiles (incl. '/') or empty string
+ *   *date_b  :  first date of range
+ *   *date_e  :  last date of range
+ *   hmode    :  header mode of dayfiles (see slg_readdayfile())
+ *   tnum     :  number of threads (1..REC_MAX_THREADS)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date range or thread number
+ *    2 :  error: out of memory or thread creation failed
+ *
+ ****************************************************************************************/
+uint32_t slg_records_rebuild (slg_records *records, char *pathname, slg_date *date_b,
+                              slg_date *date_e, uint32_t hmode, uint32_t tnum)
+{
+  slg_recjob  job[REC_MAX_THREADS];
+  pthread_t   thread[REC_MAX_THREADS];
+  slg_recday  *recday;
+  slg_date    date;
+  uint32_t    num, chunk, t, i, ret;
+
+  if ((tnum < 1) || (tnum > REC_MAX_THREADS)) return (1);
+  if (strlen(pathname) > 280) return (1);
+  if ((slg_date_compare (date_e, date_b) == 0) || (slg_date_compare (date_e, date_b) == 2)) return (1);
+
+  num = (uint32_t) slg_date_sub (date_e, date_b) + 1;
+  if (tnum > num) tnum = num;
+
+  recday = (slg_recday *) malloc (num * sizeof(slg_recday));
+  if (recday == NULL) return (2);
+
+  /* split date range into jobs of neighboured days */
+  chunk = (num + tnum - 1) / tnum;
+  tnum = (num + chunk - 1) / chunk;
+  slg_date_copy (&date, date_b);
+  for (t = 0; t < tnum; t++) {
+    job[t].records = records;
+    job[t].pathname = pathname;
+    slg_date_copy (&job[t].date, &date);
+    job[t].num = ((t + 1) * chunk <= num) ? chunk : num - t * chunk;
+    job[t].hmode = hmode;
+    job[t].recday = &recday[t * chunk];
+
+    slg_date_add (&date, (int32_t) job[t].num);
+  }
+
+  /* read dayfiles in parallel */
+  ret = 0;
+  for (t = 0; t < tnum; t++) {
+    if (pthread_create (&thread[t], NULL, slg_rec_job, &job[t]) != 0) {
+      ret = 2;
+      break;
+    }
+  }
+  while (t > 0) {
+    t--;
+    pthread_join (thread[t], NULL);
+  }
+  if (ret != 0) {
+    free (recday);
+    return (ret);
+  }
+
+  /* update records in date order */
+  slg_rec_clear (records);
+  slg_date_copy (&date, date_b);
+  for (i = 0; i < num; i++) {
+    if (recday[i].valid) slg_records_add_dstats (records, &date, recday[i].dstats);
+    slg_date_inc (&date);
+  }
+
+  free (recday);
+
+  return (0);
+}
+
+
+
+/* file functions *********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* saves a records object into a file
+ *
+ * parameters:
+ *   *records :  records object
+ *   *filename:  path/filename of records file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: writing file failed
+ *
+ ****************************************************************************************/
+uint32_t slg_records_save (slg_records *records, char *filename)
+{
+  FILE *fpw;
+
+  fpw = fopen (filename, "wb");
+  if (fpw == NULL) return (1);
+
+  if (fwrite (records, sizeof(slg_records), 1, fpw) != 1) {
+    fclose (fpw);
+    return (1);
+  }
+
+  if (fclose (fpw) != 0) return (1);
+
+  return (0);
+}
+
+
+/* loads a records object from a file
+ *
+ * parameters:
+ *   *records :  records object
+ *   *filename:  path/filename of records file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: file not found or can not be read
+ *    2 :  error: invalid file (magic or version)
+ *
+ ****************************************************************************************/
+uint32_t slg_records_load (slg_records *records, char *filename)
+{
+  FILE *fpr;
+
+  fpr = fopen (filename, "rb");
+  if (fpr == NULL) return (1);
+
+  if (fread (records, sizeof(slg_records), 1, fpr) != 1) {
+    fclose (fpr);
+    return (1);
+  }
+  fclose (fpr);
+
+  if ((strncmp (records->magic, REC_MAGIC, 8) != 0) || (records->version != REC_VERSION)) return (2);
+  if (records->colnum > MAX_MLN_VALS) return (2);
+
+  return (0);
+}
@@ -0,0 +1,240 @@
+/***************************************************************************************************
+ *
+ * file     : slg_records.h
+ *
+ * function : senslog project c-library - all-time records functions
+ *            - a records object holds the records of all columns of one location
+ *              (temperature: absolute max./min., warmest night, coldest day,
+ *               rain: max. value, highest day sum, longest dry spell)
+ *            - records are updated in O(1) per new day summary or appended value,
+ *              day related records are set when the current day is closed (next day
+ *              arrives or slg_records_close() is called)
+ *            - records objects are saved to and loaded from binary files, a complete
+ *              rebuild from dayfiles reads the dayfiles in parallel threads
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_date.h"
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+
+
+#ifndef _slg_records_h
+#define _slg_records_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define REC_MAGIC     "SLGREC"   /* file magic (8 bytes incl. zero padding) */
+# define REC_VERSION   1          /* file format version */
+
+# define REC_MAX       0          /* temperature and rain: absolute max. value */
+# define REC_MIN       1          /* temperature: absolute min. value */
+# define REC_NIGHTMAX  2          /* temperature: highest day min. value (warmest night) */
+# define REC_DAYMIN    3          /* temperature: lowest day max. value (coldest day) */
+# define REC_RAINDAY   4          /* rain: highest day sum */
+# define REC_DRYSPELL  5          /* rain: longest dry spell in days (date: last day of spell) */
+# define REC_NUM       6          /* number of record types */
+
+# define REC_MAX_THREADS  16      /* max. number of threads of rebuild */
+
+
+/* a single record */
+typedef struct {
+  int32_t   val;                  /* record value (CNERR: no record yet) */
+  slg_date  date;                 /* date of record (newest one if values are equal) */
+  uint32_t  ind;                  /* time index (REC_MAX and REC_MIN only) */
+} slg_record;
+
+
+/* records of a column */
+typedef struct {
+  slg_record  rec[REC_NUM];       /* records (index: REC_...) */
+  slg_dstats  cur;                /* running statistics of current day */
+  uint32_t    dryspell;           /* length of dry spell up to last closed day (days) */
+} slg_reccol;
+
+
+/* records object of a location (stored 1:1 in records file) */
+typedef struct {
+  char        magic[8];               /* REC_MAGIC */
+  uint32_t    version;                /* REC_VERSION */
+  uint32_t    locid;                  /* location id */
+  uint32_t    tmode;                  /* time_mode */
+  uint32_t    colnum;                 /* number of columns */
+  uint32_t    coltyp[MAX_MLN_VALS];   /* list of column types */
+  uint32_t    colid[MAX_MLN_VALS];    /* list of column ids */
+  uint32_t    curvalid;               /* 0: no day added yet, 1: curdate is valid */
+  uint32_t    curopen;                /* 0: current day is closed, 1: current day is open */
+  slg_date    curdate;                /* date of current (newest) day */
+  slg_date    lastdate;               /* date of last closed day */
+  slg_reccol  col[MAX_MLN_VALS];      /* records of all columns (same order as in header) */
+} slg_records;
+
+
+/* day summary of all columns (used by rebuild) */
+typedef struct {
+  uint32_t    valid;                  /* 0: dayfile not found or invalid, 1: valid */
+  slg_dstats  dstats[MAX_MLN_VALS];   /* statistics of all columns */
+} slg_recday;
+
+
+/* rebuild job of a thread (a part of the date range) */
+typedef struct {
+  slg_records  *records;              /* records object (read only in thread) */
+  char         *pathname;             /* path name of dayfiles */
+  slg_date     date;                  /* first date of job */
+  uint32_t     num;                   /* number of days of job */
+  uint32_t     hmode;                 /* header mode of dayfiles */
+  slg_recday   *recday;               /* day summaries of job (num entries) */
+} slg_recjob;
+
+
+
+/* records functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* initialises an empty records object
+ * - location, time mode and columns are taken from a template dayfile
+ *
+ * parameters:
+ *   *records:  records object
+ *   *daydata:  template daydata object
+ *
+ ****************************************************************************************/
+void slg_records_init (slg_records *records, slg_daydata *daydata);
+
+
+/* adds statistics of a complete or partial day
+ * - a newer date closes the current day, the same date replaces current day statistics
+ *   (e.g. dayfile was extended)
+ *
+ * parameters:
+ *   *records:  records object
+ *   *date   :  date of day
+ *   *dstats :  statistics of all columns (same order as in records object)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date
+ *    2 :  error: date is older than current day or current day is closed
+ *
+ ****************************************************************************************/
+uint32_t slg_records_add_dstats (slg_records *records, slg_date *date, slg_dstats *dstats);
+
+
+/* adds all values of a dayfile (see slg_records_add_dstats())
+ *
+ * parameters:
+ *   *records:  records object
+ *   *daydata:  daydata object
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date
+ *    2 :  error: date is older than current day or current day is closed
+ *    3 :  error: dayfile has other location id or time mode than records object
+ *
+ ****************************************************************************************/
+uint32_t slg_records_add_day (slg_records *records, slg_daydata *daydata);
+
+
+/* adds a single new value (e.g. an appended line of the current dayfile)
+ * - a newer date closes the current day
+ * - a value must not be added twice
+ *
+ * parameters:
+ *   *records:  records object
+ *   *date   :  date of value
+ *   c       :  column index (0..colnum-1)
+ *   k       :  time index
+ *   val     :  value (temperature T*10, rain*100, CNERR: invalid value)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date or column
+ *    2 :  error: date is older than current day or current day is closed
+ *
+ ****************************************************************************************/
+uint32_t slg_records_add_value (slg_records *records, slg_date *date, uint32_t c, uint32_t k, int32_t val);
+
+
+/* closes current day (day related records are set, further values of day are rejected)
+ *
+ * parameters:
+ *   *records:  records object
+ *
+ ****************************************************************************************/
+void slg_records_close (slg_records *records);
+
+
+/* rebuilds records from all dayfiles of a date range
+ * - records object must be initialised, all records are cleared before
+ * - dayfiles are read in parallel, records are updated in date order afterwards
+ * - last day of range is kept open
+ *
+ * parameters:
+ *   *records :  records object
+ *   *pathname:  path name of dayfiles (incl. '/') or empty string
+ *   *date_b  :  first date of range
+ *   *date_e  :  last date of range
+ *   hmode    :  header mode of dayfiles (see slg_readdayfile())
+ *   tnum     :  number of threads (1..REC_MAX_THREADS)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date range or thread number
+ *    2 :  error: out of memory or thread creation failed
+ *
+ ****************************************************************************************/
+uint32_t slg_records_rebuild (slg_records *records, char *pathname, slg_date *date_b,
+                              slg_date *date_e, uint32_t hmode, uint32_t tnum);
+
+
+
+/* file functions *********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* saves a records object into a file
+ *
+ * parameters:
+ *   *records :  records object
+ *   *filename:  path/filename of records file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: writing file failed
+ *
+ ****************************************************************************************/
+uint32_t slg_records_save (slg_records *records, char *filename);
+
+
+/* loads a records object from a file
+ *
+ * parameters:
+ *   *records :  records object
+ *   *filename:  path/filename of records file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: file not found or can not be read
+ *    2 :  error: invalid file (magic or version)
+ *
+ ****************************************************************************************/
+uint32_t slg_records_load (slg_records *records, char *filename);
+
+
+
+#endif
+
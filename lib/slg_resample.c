@@ -0,0 +1,209 @@
+/***************************************************************************************************
+ *
+ * file     : slg_resample.c
+ *
+ * function : senslog project c-library - resampling functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "slg_resample.h"
+#include "slg_date.h"
+#include "slg_values.h"
+#include "slg_temper.h"
+
+
+
+/* private functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* adds slot values of a dayfile to bucket accumulators
+ *
+ * parameters:
+ *   *acc :  bucket accumulators
+ *   *map :  mapping of dayfile
+ *   *val :  slot values of dayfile (MAX_MLN_NUM values, CNERR: invalid value)
+ *   boffs:  bucket offset (slot bucket - boffs is accumulator index), 0: day, bnum: day before
+ *
+ ****************************************************************************************/
+static void slg_rsm_add (slg_rsmacc *acc, slg_rsmmap *map, int32_t *val, uint32_t boffs)
+{
+  uint32_t i, b;
+  int32_t  v;
+
+  for (i = 0; i < MAX_MLN_NUM; i++) {
+    v = val[i];
+    b = map->bucket[i] - boffs;
+    if ((v == CNERR) || (map->bucket[i] < boffs) || (b >= map->bnum)) continue;
+
+    acc->count[b]++;
+    acc->sum[b] += v;
+    if (v < acc->min[b]) acc->min[b] = v;
+    if (v > acc->max[b]) acc->max[b] = v;
+    acc->last[b] = v;
+  }
+}
+
+
+
+/* resample functions *****************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* calculates slot to bucket mapping of a day
+ *
+ * parameters:
+ *   *map  :  resulting mapping
+ *   summer:  0: normal time, 1: summertime (see slg_date_is_summertime())
+ *   blen  :  bucket length in minutes (multiple of 15 and divisor of 1440, e.g. RSM_H1)
+ *
+ * return value:
+ *    0 :  successfull
+ *    1 :  error: invalid bucket length or summer flag
+ *
+ ****************************************************************************************/
+uint32_t slg_resample_map (slg_rsmmap *map, uint32_t summer, uint32_t blen)
+{
+  uint32_t i;
+
+  if ((blen == 0) || (blen % 15 != 0) || (1440 % blen != 0) || (summer > 1)) return (1);
+
+  map->blen = blen;
+  map->bnum = 1440 / blen;
+  map->summer = summer;
+
+  /* slot i covers 15 min. from i*15 MEZ (time stamp of mode 1 is end of slot) */
+  for (i = 0; i < MAX_MLN_NUM; i++) {
+    map->bucket[i] = (i * 15 + summer * 60) / blen;
+  }
+
+  return (0);
+}
+
+
+/* resamples slot values of a local day
+ * - buckets are filled from slots of dayfile of day and from slots of dayfile of day
+ *   before which belong to local day (summertime)
+ *
+ * parameters:
+ *   *mprev:  mapping of day before (NULL: day before is missing)
+ *   *vprev:  slot values of day before (MAX_MLN_NUM values, CNERR: invalid, NULL: missing)
+ *   *mcur :  mapping of day (same bucket length as mprev)
+ *   *vcur :  slot values of day (MAX_MLN_NUM values, CNERR: invalid, NULL: missing)
+ *   op    :  resample operator (RSM_...)
+ *   *out  :  resulting bucket values (bnum values, CNERR: no valid value in bucket)
+ *
+ * return value:
+ *   CNERR :  error: invalid operator
+ *   other :  number of buckets with valid values
+ *
+ ****************************************************************************************/
+uint32_t slg_resample_day (slg_rsmmap *mprev, int32_t *vprev, slg_rsmmap *mcur, int32_t *vcur,
+                           uint32_t op, int32_t *out)
+{
+  slg_rsmacc acc;
+  uint32_t   b, num;
+
+  if (op > RSM_LAST) return (CNERR);
+
+  for (b = 0; b < mcur->bnum; b++) {
+    acc.count[b] = 0;
+    acc.sum[b] = 0;
+    acc.min[b] = CNERR;
+    acc.max[b] = - CNERR;
+  }
+
+  /* older values first (last value of bucket is newest) */
+  if ((mprev != NULL) && (vprev != NULL) && (mprev->blen == mcur->blen)) {
+    slg_rsm_add (&acc, mprev, vprev, mprev->bnum);
+  }
+  if (vcur != NULL) slg_rsm_add (&acc, mcur, vcur, 0);
+
+  num = 0;
+  for (b = 0; b < mcur->bnum; b++) {
+    if (acc.count[b] == 0) {
+      out[b] = CNERR;
+      continue;
+    }
+
+    if (op == RSM_MEAN) out[b] = acc.sum[b] / (int32_t) acc.count[b];
+    if (op == RSM_MIN)  out[b] = acc.min[b];
+    if (op == RSM_MAX)  out[b] = acc.max[b];
+    if (op == RSM_SUM)  out[b] = acc.sum[b];
+    if (op == RSM_LAST) out[b] = acc.last[b];
+    num++;
+  }
+
+  return (num);
+}
+
+
+/* resamples all days of a month to one bucket series
+ *
+ * parameters:
+ *   *mtemper:  month temperature object
+ *   year    :  year of month
+ *   month   :  month (1..12)
+ *   *dprev  :  day temperature object of last day of month before (NULL: missing)
+ *   blen    :  bucket length in minutes (see slg_resample_map())
+ *   op      :  resample operator (RSM_...)
+ *   *out    :  resulting bucket series (days of month * bnum values, CNERR: no valid value)
+ *
+ * return value:
+ *   CNERR :  error: invalid month, bucket length or operator
+ *   other :  number of values of bucket series
+ *
+ ****************************************************************************************/
+uint32_t slg_resample_mtemper (slg_mtemper *mtemper, uint32_t year, uint32_t month, slg_dtemper *dprev,
+                               uint32_t blen, uint32_t op, int32_t *out)
+{
+  slg_rsmmap map[2];
+  slg_rsmmap *mprev, *mcur;
+  slg_date   date;
+  int32_t    *vprev, *vcur;
+  uint32_t   d, dnum, b;
+
+  if (op > RSM_LAST) return (CNERR);
+  if (slg_date_set_int (&date, 1, month, year) == 0) return (CNERR);
+
+  /* mappings of normal time and summertime (calculated once) */
+  if (slg_resample_map (&map[0], 0, blen) != 0) return (CNERR);
+  slg_resample_map (&map[1], 1, blen);
+
+  dnum = slg_date_number_days_in_month (&date);
+
+  slg_date_dec (&date);
+  mprev = &map[slg_date_is_summertime (&date)];
+  vprev = (dprev != NULL) ? dprev->val : NULL;
+  slg_date_inc (&date);
+
+  for (d = 0; d < dnum; d++) {
+    mcur = &map[slg_date_is_summertime (&date)];
+    vcur = (mtemper->dvalid[d]) ? mtemper->dtemper[d].val : NULL;
+
+    /* local days without dayfile have no buckets */
+    if (vcur != NULL) {
+      slg_resample_day (mprev, vprev, mcur, vcur, op, &out[d * mcur->bnum]);
+    }
+    else {
+      for (b = 0; b < mcur->bnum; b++) out[d * mcur->bnum + b] = CNERR;
+    }
+
+    mprev = mcur;
+    vprev = vcur;
+    slg_date_inc (&date);
+  }
+
+  return (dnum * map[0].bnum);
+}
+
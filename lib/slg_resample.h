@@ -0,0 +1,130 @@
+/***************************************************************************************************
+ *
+ * file     : slg_resample.h
+ *
+ * function : senslog project c-library - resampling functions
+ *            - resampling of 15 min. slots to hourly, 3 hourly or daily buckets (mean, min.,
+ *              max., sum or last value)
+ *            - buckets follow local clock time: in summertime slots are shifted by one hour,
+ *              so the last hour of a dayfile belongs to the next local day
+ *            - slot to bucket mapping is calculated once per day type (normal time and
+ *              summertime), resampling needs no time arithmetic per value
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_date.h"
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+
+
+#ifndef _slg_resample_h
+#define _slg_resample_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define RSM_MEAN     0      /* resample operator: average of valid values (like slg_dstats_average()) */
+# define RSM_MIN      1      /* resample operator: min. value */
+# define RSM_MAX      2      /* resample operator: max. value */
+# define RSM_SUM      3      /* resample operator: sum of valid values */
+# define RSM_LAST     4      /* resample operator: last valid value */
+
+# define RSM_H1       60     /* bucket length: hour (minutes) */
+# define RSM_H3       180    /* bucket length: 3 hours (minutes) */
+# define RSM_DAY      1440   /* bucket length: day (minutes) */
+
+# define RSM_MAX_BNUM 96     /* max. number of buckets of a day (bucket length 15 min.) */
+
+
+/* slot to bucket mapping of a day */
+typedef struct {
+  uint32_t  blen;                   /* bucket length (minutes) */
+  uint32_t  bnum;                   /* number of buckets of a local day */
+  uint32_t  summer;                 /* 0: normal time, 1: summertime (local time = MEZ + 1 h) */
+  uint32_t  bucket[MAX_MLN_NUM];    /* bucket of each slot (>= bnum: bucket bnum less of next day) */
+} slg_rsmmap;
+
+
+/* bucket accumulators (used by slg_resample_day()) */
+typedef struct {
+  uint32_t  count[RSM_MAX_BNUM];    /* number of valid values */
+  int32_t   sum[RSM_MAX_BNUM];      /* sum of valid values */
+  int32_t   min[RSM_MAX_BNUM];      /* min. value */
+  int32_t   max[RSM_MAX_BNUM];      /* max. value */
+  int32_t   last[RSM_MAX_BNUM];     /* last valid value */
+} slg_rsmacc;
+
+
+
+/* resample functions *****************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* calculates slot to bucket mapping of a day
+ *
+ * parameters:
+ *   *map  :  resulting mapping
+ *   summer:  0: normal time, 1: summertime (see slg_date_is_summertime())
+ *   blen  :  bucket length in minutes (multiple of 15 and divisor of 1440, e.g. RSM_H1)
+ *
+ * return value:
+ *    0 :  successfull
+ *    1 :  error: invalid bucket length or summer flag
+ *
+ ****************************************************************************************/
+uint32_t slg_resample_map (slg_rsmmap *map, uint32_t summer, uint32_t blen);
+
+
+/* resamples slot values of a local day
+ * - buckets are filled from slots of dayfile of day and from slots of dayfile of day
+ *   before which belong to local day (summertime)
+ *
+ * parameters:
+ *   *mprev:  mapping of day before (NULL: day before is missing)
+ *   *vprev:  slot values of day before (MAX_MLN_NUM values, CNERR: invalid, NULL: missing)
+ *   *mcur :  mapping of day (same bucket length as mprev)
+ *   *vcur :  slot values of day (MAX_MLN_NUM values, CNERR: invalid, NULL: missing)
+ *   op    :  resample operator (RSM_...)
+ *   *out  :  resulting bucket values (bnum values, CNERR: no valid value in bucket)
+ *
+ * return value:
+ *   CNERR :  error: invalid operator
+ *   other :  number of buckets with valid values
+ *
+ ****************************************************************************************/
+uint32_t slg_resample_day (slg_rsmmap *mprev, int32_t *vprev, slg_rsmmap *mcur, int32_t *vcur,
+                           uint32_t op, int32_t *out);
+
+
+/* resamples all days of a month to one bucket series
+ *
+ * parameters:
+ *   *mtemper:  month temperature object
+ *   year    :  year of month
+ *   month   :  month (1..12)
+ *   *dprev  :  day temperature object of last day of month before (NULL: missing)
+ *   blen    :  bucket length in minutes (see slg_resample_map())
+ *   op      :  resample operator (RSM_...)
+ *   *out    :  resulting bucket series (days of month * bnum values, CNERR: no valid value)
+ *
+ * return value:
+ *   CNERR :  error: invalid month, bucket length or operator
+ *   other :  number of values of bucket series
+ *
+ ****************************************************************************************/
+uint32_t slg_resample_mtemper (slg_mtemper *mtemper, uint32_t year, uint32_t month, slg_dtemper *dprev,
+                               uint32_t blen, uint32_t op, int32_t *out);
+
+
+
+#endif
+
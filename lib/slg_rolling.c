@@ -0,0 +1,235 @@
+/***************************************************************************************************
+ *
+ * file     : slg_rolling.c
+ *
+ * function : senslog project c-library - rolling window statistics functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "slg_rolling.h"
+#include "slg_values.h"
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+#include "slg_rain.h"
+
+
+
+/* rolling window functions ***********************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* initialises an empty rolling window
+ *
+ * parameters:
+ *   *rolling:  rolling window object
+ *   wlen    :  window length in slots (1..RLW_MAX_LEN, e.g. 96 for 24 h)
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  error, invalid window length
+ *
+ ****************************************************************************************/
+uint32_t slg_rolling_init (slg_rolling *rolling, uint32_t wlen)
+{
+  if ((wlen == 0) || (wlen > RLW_MAX_LEN)) return (1);
+
+  rolling->wlen = wlen;
+  rolling->pos = 0;
+  rolling->sum = 0;
+  rolling->count = 0;
+  rolling->qminb = 0;
+  rolling->qminn = 0;
+  rolling->qmaxb = 0;
+  rolling->qmaxn = 0;
+
+  return (0);
+}
+
+
+/* pushes next slot value into rolling window (oldest value drops out if window is full)
+ *
+ * parameters:
+ *   *rolling:  rolling window object
+ *   val     :  value of slot (CNERR: slot is invalid)
+ *
+ ****************************************************************************************/
+void slg_rolling_push (slg_rolling *rolling, int32_t val)
+{
+  uint32_t wlen, pos, old;
+
+  wlen = rolling->wlen;
+  pos = rolling->pos;
+
+  /* drop oldest slot if window is full */
+  if (pos >= wlen) {
+    old = pos - wlen;
+
+    if (rolling->val[old % wlen] != CNERR) {
+      rolling->sum -= rolling->val[old % wlen];
+      rolling->count--;
+    }
+
+    if ((rolling->qminn != 0) && (rolling->qmin[rolling->qminb] == old)) {
+      rolling->qminb = (rolling->qminb + 1) % wlen;
+      rolling->qminn--;
+    }
+
+    if ((rolling->qmaxn != 0) && (rolling->qmax[rolling->qmaxb] == old)) {
+      rolling->qmaxb = (rolling->qmaxb + 1) % wlen;
+      rolling->qmaxn--;
+    }
+  }
+
+  rolling->val[pos % wlen] = val;
+  rolling->pos = pos + 1;
+
+  if (val == CNERR) return;
+
+  rolling->sum += val;
+  rolling->count++;
+
+  /* remove older values which can not become min. or max. anymore ("newest wins") */
+  while ((rolling->qminn != 0) &&
+         (rolling->val[rolling->qmin[(rolling->qminb + rolling->qminn - 1) % wlen] % wlen] >= val)) {
+    rolling->qminn--;
+  }
+  rolling->qmin[(rolling->qminb + rolling->qminn) % wlen] = pos;
+  rolling->qminn++;
+
+  while ((rolling->qmaxn != 0) &&
+         (rolling->val[rolling->qmax[(rolling->qmaxb + rolling->qmaxn - 1) % wlen] % wlen] <= val)) {
+    rolling->qmaxn--;
+  }
+  rolling->qmax[(rolling->qmaxb + rolling->qmaxn) % wlen] = pos;
+  rolling->qmaxn++;
+}
+
+
+/* gets statistic values of current window
+ * -> indices are window indices (0: oldest slot in window), newest ones are taken
+ *    if there are more than one minimums or maximums
+ * -> if all values in window are invalid min. and max. are CNERR and indices are 0
+ *
+ * parameters:
+ *   *rolling:  rolling window object
+ *   *dstats :  resulting statistics object
+ *
+ * return value:
+ *         0 :  valid values in window exist
+ *         1 :  no valid values in window
+ *
+ ****************************************************************************************/
+uint32_t slg_rolling_stats (slg_rolling *rolling, slg_dstats *dstats)
+{
+  uint32_t first;
+
+  dstats->count = rolling->count;
+  dstats->sum = rolling->sum;
+
+  if (rolling->count == 0) {
+    dstats->min = CNERR;
+    dstats->max = CNERR;
+    dstats->indmin = 0;
+    dstats->indmax = 0;
+    return (1);
+  }
+
+  /* slot number of oldest slot in window */
+  first = (rolling->pos > rolling->wlen) ? rolling->pos - rolling->wlen : 0;
+
+  dstats->min = rolling->val[rolling->qmin[rolling->qminb] % rolling->wlen];
+  dstats->max = rolling->val[rolling->qmax[rolling->qmaxb] % rolling->wlen];
+  dstats->indmin = rolling->qmin[rolling->qminb] - first;
+  dstats->indmax = rolling->qmax[rolling->qmaxb] - first;
+
+  return (0);
+}
+
+
+/* pushes temperature values of a day into rolling window
+ *
+ * parameters:
+ *   *rolling:  rolling window object
+ *   *dtemper:  day temperature object
+ *   last    :  last index to push (e.g. dtemper->last or dtemper->tlen - 1)
+ *   *dstats :  array of statistics objects (window after each slot, 0..last) or NULL
+ *
+ ****************************************************************************************/
+void slg_rolling_dtemper (slg_rolling *rolling, slg_dtemper *dtemper, uint32_t last, slg_dstats *dstats)
+{
+  uint32_t i;
+
+  if (last >= dtemper->tlen) last = dtemper->tlen - 1;
+
+  for (i = 0; i <= last; i++) {
+    slg_rolling_push (rolling, dtemper->val[i]);
+    if (dstats != NULL) slg_rolling_stats (rolling, &dstats[i]);
+  }
+}
+
+
+/* pushes rain values of a day into rolling window (rolling rain sum is dstats.sum)
+ *
+ * parameters:
+ *   *rolling:  rolling window object
+ *   *drain  :  day rain object
+ *   last    :  last index to push (e.g. drain->last or drain->tlen - 1)
+ *   *dstats :  array of statistics objects (window after each slot, 0..last) or NULL
+ *
+ ****************************************************************************************/
+void slg_rolling_drain (slg_rolling *rolling, slg_drain *drain, uint32_t last, slg_dstats *dstats)
+{
+  uint32_t i;
+
+  if (last >= drain->tlen) last = drain->tlen - 1;
+
+  for (i = 0; i <= last; i++) {
+    slg_rolling_push (rolling, (int32_t) drain->val[i]);
+    if (dstats != NULL) slg_rolling_stats (rolling, &dstats[i]);
+  }
+}
+
+
+/* pushes temperature values of a month into rolling window (missing days are invalid slots)
+ * - a missing day pushes as many slots as a valid day of the month (time mode)
+ *
+ * parameters:
+ *   *rolling:  rolling window object
+ *   *mtemper:  month temperature object
+ *   dnum    :  number of days of month
+ *
+ ****************************************************************************************/
+void slg_rolling_mtemper (slg_rolling *rolling, slg_mtemper *mtemper, uint32_t dnum)
+{
+  uint32_t d, i, tlen;
+
+  if (dnum > 31) dnum = 31;
+
+  /* slots per day of month (all days of a month have the same time mode) */
+  tlen = 0;
+  for (d = 0; d < dnum; d++) {
+    if (mtemper->dvalid[d]) {
+      tlen = mtemper->dtemper[d].tlen;
+      break;
+    }
+  }
+
+  for (d = 0; d < dnum; d++) {
+    if (mtemper->dvalid[d]) {
+      slg_rolling_dtemper (rolling, &mtemper->dtemper[d], mtemper->dtemper[d].tlen - 1, NULL);
+    }
+    else {
+      for (i = 0; i < tlen; i++) slg_rolling_push (rolling, CNERR);
+    }
+  }
+}
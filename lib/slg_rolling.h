@@ -0,0 +1,137 @@
+/***************************************************************************************************
+ *
+ * file     : slg_rolling.h
+ *
+ * function : senslog project c-library - rolling window statistics functions
+ *            - a rolling object holds the last n slots of a value series (e.g. last 24 h)
+ *            - values are pushed slot by slot, day objects can be pushed one after another,
+ *              so windows continue across day boundaries
+ *            - average and sum are updated incrementally, min. and max. via monotonic
+ *              deques, so each push and each query costs O(1) (amortized)
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+#include "slg_rain.h"
+
+
+#ifndef _slg_rolling_h
+#define _slg_rolling_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define RLW_MAX_LEN  (7 * MAX_MLN_NUM)   /* max. window length in slots (7 days) */
+
+
+/* rolling window object */
+typedef struct {
+  uint32_t  wlen;                 /* window length in slots */
+  uint32_t  pos;                  /* number of pushed slots (slot number of next value) */
+  int32_t   val[RLW_MAX_LEN];     /* ring buffer of window values (index: slot number % wlen) */
+  int32_t   sum;                  /* sum of valid values in window */
+  uint32_t  count;                /* number of valid values in window */
+  uint32_t  qmin[RLW_MAX_LEN];    /* deque of slot numbers with increasing values (min.) */
+  uint32_t  qminb;                /* begin of min. deque in ring */
+  uint32_t  qminn;                /* size of min. deque */
+  uint32_t  qmax[RLW_MAX_LEN];    /* deque of slot numbers with decreasing values (max.) */
+  uint32_t  qmaxb;                /* begin of max. deque in ring */
+  uint32_t  qmaxn;                /* size of max. deque */
+} slg_rolling;
+
+
+
+/* rolling window functions ***********************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* initialises an empty rolling window
+ *
+ * parameters:
+ *   *rolling:  rolling window object
+ *   wlen    :  window length in slots (1..RLW_MAX_LEN, e.g. 96 for 24 h)
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  error, invalid window length
+ *
+ ****************************************************************************************/
+uint32_t slg_rolling_init (slg_rolling *rolling, uint32_t wlen);
+
+
+/* pushes next slot value into rolling window (oldest value drops out if window is full)
+ *
+ * parameters:
+ *   *rolling:  rolling window object
+ *   val     :  value of slot (CNERR: slot is invalid)
+ *
+ ****************************************************************************************/
+void slg_rolling_push (slg_rolling *rolling, int32_t val);
+
+
+/* gets statistic values of current window
+ * -> indices are window indices (0: oldest slot in window), newest ones are taken
+ *    if there are more than one minimums or maximums
+ * -> if all values in window are invalid min. and max. are CNERR and indices are 0
+ *
+ * parameters:
+ *   *rolling:  rolling window object
+ *   *dstats :  resulting statistics object
+ *
+ * return value:
+ *         0 :  valid values in window exist
+ *         1 :  no valid values in window
+ *
+ ****************************************************************************************/
+uint32_t slg_rolling_stats (slg_rolling *rolling, slg_dstats *dstats);
+
+
+/* pushes temperature values of a day into rolling window
+ *
+ * parameters:
+ *   *rolling:  rolling window object
+ *   *dtemper:  day temperature object
+ *   last    :  last index to push (e.g. dtemper->last or dtemper->tlen - 1)
+ *   *dstats :  array of statistics objects (window after each slot, 0..last) or NULL
+ *
+ ****************************************************************************************/
+void slg_rolling_dtemper (slg_rolling *rolling, slg_dtemper *dtemper, uint32_t last, slg_dstats *dstats);
+
+
+/* pushes rain values of a day into rolling window (rolling rain sum is dstats.sum)
+ *
+ * parameters:
+ *   *rolling:  rolling window object
+ *   *drain  :  day rain object
+ *   last    :  last index to push (e.g. drain->last or drain->tlen - 1)
+ *   *dstats :  array of statistics objects (window after each slot, 0..last) or NULL
+ *
+ ****************************************************************************************/
+void slg_rolling_drain (slg_rolling *rolling, slg_drain *drain, uint32_t last, slg_dstats *dstats);
+
+
+/* pushes temperature values of a month into rolling window (missing days are invalid slots)
+ * - a missing day pushes as many slots as a valid day of the month (time mode)
+ *
+ * parameters:
+ *   *rolling:  rolling window object
+ *   *mtemper:  month temperature object
+ *   dnum    :  number of days of month
+ *
+ ****************************************************************************************/
+void slg_rolling_mtemper (slg_rolling *rolling, slg_mtemper *mtemper, uint32_t dnum);
+
+
+
+#endif
+
@@ -0,0 +1,1119 @@
+/***************************************************************************************************
+ *
+ * file     : slg_rollup.c
+ *
+ * function : senslog project c-library - rollup index functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+#include "slg_rollup.h"
+#include "slg_date.h"
+#include "slg_values.h"
+#include "slg_dayfile.h"
+#include "slg_temper.h"
+#include "slg_simd.h"
+#include "slg_hist.h"
+#include "slg_sketch.h"
+#include "slg_climate.h"
+#include "slg_normals.h"
+#include "slg_correl.h"
+
+
+
+/* private functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* clears a rollup entry (all summaries invalid)
+ *
+ * parameters:
+ *   *rent:  rollup entry
+ *
+ ****************************************************************************************/
+static void slg_rlpent_clear (slg_rlpent *rent)
+{
+  memset (rent, 0, sizeof(slg_rlpent));
+}
+
+
+/* stores a rollup entry into the mapped file
+ * - valid is cleared before the summaries are written and set afterwards, so a reader
+ *   never sees partly written summaries marked as valid
+ *
+ * parameters:
+ *   *dst:  mapped rollup entry
+ *   *src:  new rollup entry
+ *
+ ****************************************************************************************/
+static void slg_rlpent_store (slg_rlpent *dst, slg_rlpent *src)
+{
+  dst->valid = 0;
+  __sync_synchronize ();
+
+  dst->mtime = src->mtime;
+  dst->fsize = src->fsize;
+  memcpy (dst->col, src->col, sizeof(dst->col));
+  __sync_synchronize ();
+
+  dst->valid = src->valid;
+}
+
+
+/* merges a column summary into another one
+ * - src must be newer than dst, so src wins if min. or max. values are equal
+ *
+ * parameters:
+ *   *dst:  column summary to be extended
+ *   *src:  column summary to be added
+ *
+ ****************************************************************************************/
+static void slg_rlpsum_merge (slg_rlpsum *dst, slg_rlpsum *src)
+{
+  uint32_t i;
+
+  if (src->count == 0) return;
+
+  if ((dst->count == 0) || (src->min <= dst->min)) {
+    dst->min = src->min;
+    dst->dmin = src->dmin;
+    dst->imin = src->imin;
+  }
+
+  if ((dst->count == 0) || (src->max >= dst->max)) {
+    dst->max = src->max;
+    dst->dmax = src->dmax;
+    dst->imax = src->imax;
+  }
+
+  dst->sum += src->sum;
+  dst->count += src->count;
+  dst->novfl += src->novfl;
+
+  for (i = 0; i < CLM_NUM; i++) dst->ntype[i] += src->ntype[i];
+}
+
+
+/* calculates day of year of a date
+ *
+ * parameters:
+ *   *date:  date
+ *
+ * return value:
+ *   doy :  day of year (0..365)
+ *
+ ****************************************************************************************/
+static uint32_t slg_rlp_doy (slg_date *date)
+{
+  slg_date jan1;
+
+  slg_date_set_int (&jan1, 1, 1, date->y);
+
+  return ((uint32_t) slg_date_sub (date, &jan1));
+}
+
+
+/* recalculates month and year entries of a year block from its day entries
+ * - month histograms of temperature columns and month sketches of rain columns are
+ *   rebuilt from slot values
+ * - entries, histograms and sketches are calculated locally and then copied into the
+ *   mapped file (entries see slg_rlpent_store())
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   *ryear :  year block
+ *   *rslot :  slot block of year
+ *   year   :  year
+ *   month  :  month to be recalculated (1..12)
+ *
+ ****************************************************************************************/
+static void slg_rlp_reduce (slg_rollup *rollup, slg_rlpyear *ryear, slg_rlpslot *rslot, uint32_t year,
+                            uint32_t month)
+{
+  slg_date   date;
+  uint32_t   doy, dnum, i, c, k;
+  slg_rlpent rent;
+  uint16_t   mhist[HST_BINS], msketch[SKT_BINS];
+
+  /* month entry from day entries */
+  slg_date_set_int (&date, 1, month, year);
+  doy = slg_rlp_doy (&date);
+  dnum = slg_date_number_days_in_month (&date);
+
+  slg_rlpent_clear (&rent);
+  for (i = doy; i < (doy + dnum); i++) {
+    if (ryear->day[i].valid) {
+      rent.valid++;
+      for (c = 0; c < rollup->head->colnum; c++) {
+        slg_rlpsum_merge (&rent.col[c], &ryear->day[i].col[c]);
+      }
+    }
+  }
+  slg_rlpent_store (&ryear->month[month-1], &rent);
+
+  /* month histograms from slot values of valid days */
+  for (c = 0; c < rollup->head->colnum; c++) {
+    if (rollup->head->coltyp[c] != DF_TEMP) continue;
+
+    memset (mhist, 0, sizeof(mhist));
+    for (i = doy; i < (doy + dnum); i++) {
+      if (ryear->day[i].valid == 0) continue;
+      for (k = 0; k < MAX_MLN_NUM; k++) {
+        if (rslot->slot[i][c][k] != RLP_SLOTINV) mhist[slg_hist_bin (rslot->slot[i][c][k])]++;
+      }
+    }
+    memcpy (rslot->mhist[month-1][c], mhist, sizeof(mhist));
+  }
+
+  /* month sketches from slot values of valid days */
+  for (c = 0; c < rollup->head->colnum; c++) {
+    if (rollup->head->coltyp[c] != DF_RAIN) continue;
+
+    memset (msketch, 0, sizeof(msketch));
+    for (i = doy; i < (doy + dnum); i++) {
+      if (ryear->day[i].valid == 0) continue;
+      for (k = 0; k < MAX_MLN_NUM; k++) {
+        if (rslot->slot[i][c][k] != RLP_SLOTINV) msketch[slg_sketch_bin (rslot->slot[i][c][k])]++;
+      }
+    }
+    memcpy (rslot->msketch[month-1][c], msketch, sizeof(msketch));
+  }
+
+  /* year entry from month entries */
+  slg_rlpent_clear (&rent);
+  for (i = 0; i < 12; i++) {
+    rent.valid += ryear->month[i].valid;
+    for (c = 0; c < rollup->head->colnum; c++) {
+      slg_rlpsum_merge (&rent.col[c], &ryear->month[i].col[c]);
+    }
+  }
+  slg_rlpent_store (&ryear->year, &rent);
+}
+
+
+/* calculates day entry and slot values from a dayfile
+ * - the day entry is invalid while its slot values are rewritten
+ *
+ * parameters:
+ *   *rollup :  rollup object
+ *   *ryear  :  year block
+ *   *rslot  :  slot block of year
+ *   *daydata:  daydata object
+ *   doy     :  day of year of dayfile
+ *   mtime   :  mtime of dayfile
+ *   fsize   :  size of dayfile
+ *
+ ****************************************************************************************/
+static void slg_rlp_dayent (slg_rollup *rollup, slg_rlpyear *ryear, slg_rlpslot *rslot, slg_daydata *daydata,
+                            uint32_t doy, int64_t mtime, uint32_t fsize)
+{
+  uint32_t   c, k, i, tlen, dtype;
+  int32_t    val[MAX_MLN_NUM];
+  slg_dstats dstats;
+  slg_rlpent rent;
+  slg_rlpsum *rsum;
+
+  tlen = slg_timeindexnum (daydata->tmode);
+
+  ryear->day[doy].valid = 0;
+  __sync_synchronize ();
+
+  slg_rlpent_clear (&rent);
+  rent.mtime = mtime;
+  rent.fsize = fsize;
+
+  for (c = 0; c < rollup->head->colnum; c++) {
+    rsum = &rent.col[c];
+    for (i = 0; i < MAX_MLN_NUM; i++) rslot->slot[doy][c][i] = RLP_SLOTINV;
+
+    k = slg_colexist (daydata, rollup->head->coltyp[c], rollup->head->colid[c]);
+    if (k == 0) continue;
+
+    /* read column values as signed integers (CNERR is kept) */
+    for (i = 0; i < tlen; i++) {
+      if (rollup->head->coltyp[c] == DF_TEMP) val[i] = slg_gettemperval (daydata, k, i);
+      if (rollup->head->coltyp[c] == DF_RAIN) val[i] = (int32_t) slg_getrainval (daydata, k, i);
+      if (rollup->head->coltyp[c] == DF_EVNT) val[i] = (int32_t) slg_geteventval (daydata, k, i);
+
+      if ((val[i] != CNERR) && ((val[i] <= RLP_SLOTINV) || (val[i] > INT16_MAX))) rsum->novfl = 1;
+    }
+
+    /* slot values only if all values fit into int16 (no partly truncated days) */
+    if (rsum->novfl == 0) {
+      for (i = 0; i < tlen; i++) {
+        if (val[i] != CNERR) rslot->slot[doy][c][i] = (int16_t) val[i];
+      }
+    }
+
+    slg_dstats_calc (&dstats, val, tlen);
+
+    rsum->sum = dstats.sum;
+    rsum->count = dstats.count;
+    rsum->min = dstats.min;
+    rsum->max = dstats.max;
+    rsum->dmin = doy;
+    rsum->imin = dstats.indmin;
+    rsum->dmax = doy;
+    rsum->imax = dstats.indmax;
+
+    dtype = slg_climate_daytype (rollup->head->coltyp[c], &dstats);
+    for (i = 0; i < CLM_NUM; i++) rsum->ntype[i] = (dtype >> i) & 1;
+  }
+
+  rent.valid = 1;
+  slg_rlpent_store (&ryear->day[doy], &rent);
+}
+
+
+
+/* creates an empty index or slot file (header and zero blocks)
+ * - the file is written under a temporary name and renamed, so an existing file that
+ *   is mapped by readers is replaced and never truncated
+ *
+ * parameters:
+ *   *filename:  path/filename of file to create
+ *   *head    :  file header
+ *   bsize    :  size of one year block
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    2 :  error: writing file failed
+ *
+ ****************************************************************************************/
+static uint32_t slg_rlp_mkfile (char *filename, slg_rlphead *head, size_t bsize)
+{
+  FILE   *fpw;
+  size_t size;
+  char   tname[320];
+
+  sprintf (tname, "%s.%lu", filename, (unsigned long) getpid ());
+
+  fpw = fopen (tname, "wb");
+  if (fpw == NULL) return (2);
+
+  if (fwrite (head, sizeof(slg_rlphead), 1, fpw) != 1) {fclose (fpw); remove (tname); return (2);}
+  fclose (fpw);
+
+  size = sizeof(slg_rlphead) + (size_t) head->ynum * bsize;
+  if (truncate (tname, (off_t) size) != 0) {remove (tname); return (2);}
+  if (rename (tname, filename) != 0) {remove (tname); return (2);}
+
+  return (0);
+}
+
+
+/* opens and maps an index or slot file
+ *
+ * parameters:
+ *   *filename:  path/filename of file
+ *   *magic   :  expected file magic
+ *   bsize    :  size of one year block
+ *   wmode    :  0: read only, 1: read and write
+ *   *fd      :  resulting file descriptor
+ *   *size    :  resulting file size
+ *   **map    :  resulting mapped file
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: file not found or can not be opened
+ *    2 :  error: invalid file (magic, version or size)
+ *    3 :  error: mapping file failed
+ *
+ ****************************************************************************************/
+static uint32_t slg_rlp_mapfile (char *filename, char *magic, size_t bsize, uint32_t wmode, int *fd,
+                                 size_t *size, void **map)
+{
+  struct stat st;
+  slg_rlphead head;
+
+  *fd = open (filename, (wmode) ? O_RDWR : O_RDONLY);
+  if (*fd < 0) return (1);
+
+  /* check header and file size */
+  if (read (*fd, &head, sizeof(slg_rlphead)) != sizeof(slg_rlphead)) {close (*fd); return (2);}
+  if (strcmp (head.magic, magic) != 0) {close (*fd); return (2);}
+  if (head.version != RLP_VERSION) {close (*fd); return (2);}
+  if (head.colnum > MAX_MLN_VALS) {close (*fd); return (2);}
+
+  if (fstat (*fd, &st) != 0) {close (*fd); return (1);}
+  *size = sizeof(slg_rlphead) + (size_t) head.ynum * bsize;
+  if ((size_t) st.st_size != *size) {close (*fd); return (2);}
+
+  /* map file */
+  *map = mmap (NULL, *size, (wmode) ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, *fd, 0);
+  if (*map == MAP_FAILED) {close (*fd); return (3);}
+
+  return (0);
+}
+
+
+
+/* file functions *********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* creates a new empty rollup index file
+ * - location, time mode and columns are taken from a template dayfile
+ *
+ * parameters:
+ *   *filename:  path/filename of rollup file to create
+ *   *daydata :  template daydata object
+ *   yfirst   :  first year of index
+ *   ylast    :  last year of index
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid year range
+ *    2 :  error: writing file failed
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_create (char *filename, slg_daydata *daydata, uint32_t yfirst, uint32_t ylast)
+{
+  slg_rlphead head;
+  uint32_t    i;
+  char        sname[300];
+
+  if ((yfirst < 1970) || (ylast > 2105) || (yfirst > ylast)) return (1);
+  if (strlen (filename) > 280) return (2);
+
+  /* set header */
+  memset (&head, 0, sizeof(slg_rlphead));
+  strcpy (head.magic, RLP_MAGIC);
+  head.version = RLP_VERSION;
+  head.locid = daydata->locid;
+  head.tmode = daydata->tmode;
+  head.yfirst = yfirst;
+  head.ynum = ylast - yfirst + 1;
+  head.colnum = daydata->colnum;
+  for (i = 0; i < daydata->colnum; i++) {
+    head.coltyp[i] = daydata->coltyp[i];
+    head.colid[i] = daydata->colid[i];
+  }
+
+  /* write headers, year blocks are zero (= empty entries), slot file first, so an
+     index file is never found without its slot file */
+  strcpy (head.magic, RLP_SMAGIC);
+  strcpy (sname, filename);
+  strcat (sname, RLP_SEXT);
+  if (slg_rlp_mkfile (sname, &head, sizeof(slg_rlpslot)) != 0) return (2);
+
+  strcpy (head.magic, RLP_MAGIC);
+  if (slg_rlp_mkfile (filename, &head, sizeof(slg_rlpyear)) != 0) return (2);
+
+  return (0);
+}
+
+
+/* opens a rollup index file and maps it into memory
+ * - the index file is locked until it is closed (writers exclusive, readers shared), so
+ *   a writer waits for readers and readers and other writers wait for a writer
+ *
+ * parameters:
+ *   *rollup  :  rollup object
+ *   *filename:  path/filename of rollup file
+ *   wmode    :  0: read only
+ *               1: read and write (needed for updates)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: file not found or can not be opened
+ *    2 :  error: invalid file (magic, version or size)
+ *    3 :  error: mapping file failed
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_open (slg_rollup *rollup, char *filename, uint32_t wmode)
+{
+  void     *map, *smap;
+  uint32_t res;
+  char     sname[300];
+
+  if (strlen (filename) > 280) return (1);
+
+  /* map index file */
+  res = slg_rlp_mapfile (filename, RLP_MAGIC, sizeof(slg_rlpyear), wmode, &rollup->fd, &rollup->size, &map);
+  if (res != 0) return (res);
+
+  if (flock (rollup->fd, (wmode) ? LOCK_EX : LOCK_SH) != 0) {
+    munmap (map, rollup->size);
+    close (rollup->fd);
+    return (1);
+  }
+
+  /* map slot file (must match index file) */
+  strcpy (sname, filename);
+  strcat (sname, RLP_SEXT);
+  res = slg_rlp_mapfile (sname, RLP_SMAGIC, sizeof(slg_rlpslot), wmode, &rollup->sfd, &rollup->ssize, &smap);
+  if ((res == 0) && (memcmp ((char *) map + 8, (char *) smap + 8, sizeof(slg_rlphead) - 8) != 0)) {
+    munmap (smap, rollup->ssize);
+    close (rollup->sfd);
+    res = 2;
+  }
+  if (res != 0) {
+    munmap (map, rollup->size);
+    close (rollup->fd);
+    return ((res == 1) ? 2 : res);
+  }
+
+  rollup->wmode = wmode;
+  rollup->head = (slg_rlphead *) map;
+  rollup->year = (slg_rlpyear *) ((char *) map + sizeof(slg_rlphead));
+  rollup->shead = (slg_rlphead *) smap;
+  rollup->slot = (slg_rlpslot *) ((char *) smap + sizeof(slg_rlphead));
+
+  return (0);
+}
+
+
+/* closes a rollup index file (changes are written back, lock is released)
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *
+ ****************************************************************************************/
+void slg_rollup_close (slg_rollup *rollup)
+{
+  if (rollup->wmode) {
+    msync (rollup->head, rollup->size, MS_SYNC);
+    msync (rollup->shead, rollup->ssize, MS_SYNC);
+  }
+  munmap (rollup->head, rollup->size);
+  munmap (rollup->shead, rollup->ssize);
+  close (rollup->fd);
+  close (rollup->sfd);
+}
+
+
+
+/* update functions *******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* updates day summary of a date if mtime or size of dayfile has changed
+ * - month and year summaries of date are recalculated from day summaries
+ * - a removed dayfile removes its day summary
+ * - dayfile names are assumed to be in format "yyyy-mm-dd.txt"
+ *
+ * parameters:
+ *   *rollup  :  rollup object (opened in write mode)
+ *   *pathname:  path name of dayfiles (incl. '/') or empty string
+ *   *date    :  date of dayfile
+ *   hmode    :  header mode of dayfile (see slg_readdayfile())
+ *
+ * return value:
+ *      0 :  day summary updated
+ *      1 :  day summary is up to date
+ *      2 :  dayfile not found (an existing day summary is removed)
+ *      3 :  error: date is invalid or out of year range of index
+ *      4 :  error: rollup index is opened read only
+ *      5 :  error: dayfile has other location id or time mode than index
+ *    100+dayerror: error reading dayfile (errorcode % 100: errorcode of dayfile)
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_update (slg_rollup *rollup, char *pathname, slg_date *date, uint32_t hmode)
+{
+  struct stat  st;
+  slg_rlpyear  *ryear;
+  slg_rlpslot  *rslot;
+  slg_rlpent   *rent, dent;
+  slg_daydata  daydata;
+  uint32_t     res;
+  char         fname[300], temp[20];
+
+  /* check parameters */
+  rent = slg_rollup_day (rollup, date);
+  if (rent == NULL) return (3);
+  if (rollup->wmode == 0) return (4);
+  if (strlen(pathname) > 280) return (3);
+  ryear = &rollup->year[date->y - rollup->head->yfirst];
+  rslot = &rollup->slot[date->y - rollup->head->yfirst];
+
+  /* prepare day file name */
+  strcpy (fname, pathname);
+  slg_date_to_fstring (temp, date);
+  strcat (fname, temp);
+  strcat (fname, ".txt");
+
+  /* dayfile removed or not existing */
+  if (stat (fname, &st) != 0) {
+    if (rent->valid) {
+      slg_rlpent_clear (&dent);
+      slg_rlpent_store (rent, &dent);
+      slg_rlp_reduce (rollup, ryear, rslot, date->y, date->m);
+    }
+    return (2);
+  }
+
+  /* dayfile unchanged */
+  if ((rent->valid) && (rent->mtime == (int64_t) st.st_mtime) && (rent->fsize == (uint32_t) st.st_size)) {
+    return (1);
+  }
+
+  /* read dayfile and recalculate day entry */
+  res = slg_readdayfile (&daydata, fname, hmode);
+  if (res == 1) return (2);
+  if (res > 1) return (100 + res);
+  if ((daydata.locid != rollup->head->locid) || (daydata.tmode != rollup->head->tmode)) return (5);
+
+  slg_rlp_dayent (rollup, ryear, rslot, &daydata, slg_rlp_doy (date), (int64_t) st.st_mtime,
+                  (uint32_t) st.st_size);
+
+  slg_rlp_reduce (rollup, ryear, rslot, date->y, date->m);
+
+  return (0);
+}
+
+
+/* updates day summaries of a date range (see slg_rollup_update())
+ *
+ * parameters:
+ *   *rollup  :  rollup object (opened in write mode)
+ *   *pathname:  path name of dayfiles (incl. '/') or empty string
+ *   *date_b  :  first date of range
+ *   *date_e  :  last date of range
+ *   hmode    :  header mode of dayfiles (see slg_readdayfile())
+ *   *nupd    :  number of updated day summaries
+ *
+ * return value:
+ *      0 :  operation successfull
+ *   else :  first error code of slg_rollup_update() (>= 3)
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_update_range (slg_rollup *rollup, char *pathname, slg_date *date_b,
+                                  slg_date *date_e, uint32_t hmode, uint32_t *nupd)
+{
+  slg_date date;
+  uint32_t res, ret;
+
+  *nupd = 0;
+  ret = 0;
+
+  slg_date_copy (&date, date_b);
+  while (slg_date_compare (&date, date_e) < 3) {
+    res = slg_rollup_update (rollup, pathname, &date, hmode);
+    if (res == 0) *nupd += 1;
+    if ((res > 2) && (ret == 0)) ret = res;
+
+    if (slg_date_inc (&date) == 0) break;
+  }
+
+  return (ret);
+}
+
+
+
+/* query functions ********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* checks if a column of a special typ and id exists in index
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   typ    :  column typ
+ *   id     :  column id
+ *
+ * return value:
+ *         0 :  column does not exist
+ *      >= 1 :  column number (index in entry + 1)
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_colexist (slg_rollup *rollup, uint32_t typ, uint32_t id)
+{
+  uint32_t i;
+
+  for (i=0; i < rollup->head->colnum; i++) {
+    if ((rollup->head->coltyp[i] == typ) && (rollup->head->colid[i] == id)) return (i + 1);
+  }
+
+  return (0);
+}
+
+
+/* gets rollup entry of a day
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   *date  :  date
+ *
+ * return value:
+ *    NULL :  date is invalid or out of year range
+ *   other :  pointer to day entry
+ *
+ ****************************************************************************************/
+slg_rlpent *slg_rollup_day (slg_rollup *rollup, slg_date *date)
+{
+  /* check whole date (day number is 0 for invalid year, month or day) */
+  if (slg_date_to_dnum (date) == 0) return (NULL);
+  if (slg_rollup_year (rollup, date->y) == NULL) return (NULL);
+
+  return (&rollup->year[date->y - rollup->head->yfirst].day[slg_rlp_doy (date)]);
+}
+
+
+/* gets rollup entry of a month
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   year   :  year
+ *   month  :  month (1..12)
+ *
+ * return value:
+ *    NULL :  month is invalid or out of year range
+ *   other :  pointer to month entry
+ *
+ ****************************************************************************************/
+slg_rlpent *slg_rollup_month (slg_rollup *rollup, uint32_t year, uint32_t month)
+{
+  if (slg_rollup_year (rollup, year) == NULL) return (NULL);
+  if ((month < 1) || (month > 12)) return (NULL);
+
+  return (&rollup->year[year - rollup->head->yfirst].month[month-1]);
+}
+
+
+/* gets rollup entry of a year
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   year   :  year
+ *
+ * return value:
+ *    NULL :  year is out of year range
+ *   other :  pointer to year entry
+ *
+ ****************************************************************************************/
+slg_rlpent *slg_rollup_year (slg_rollup *rollup, uint32_t year)
+{
+  if ((year < rollup->head->yfirst) || (year >= (rollup->head->yfirst + rollup->head->ynum))) return (NULL);
+
+  return (&rollup->year[year - rollup->head->yfirst].year);
+}
+
+
+/* gets slot values of a column of a day
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   *date  :  date
+ *   c      :  column index (0..colnum-1)
+ *   *val   :  array of MAX_MLN_NUM values (CNERR: invalid value)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date, date out of year range or invalid column
+ *    2 :  error: no day summary of date
+ *    3 :  error: slot values of day are out of int16 range (all values CNERR)
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_slots (slg_rollup *rollup, slg_date *date, uint32_t c, int32_t *val)
+{
+  slg_rlpent *rent;
+  int16_t    *slot;
+  uint32_t   i;
+
+  rent = slg_rollup_day (rollup, date);
+  if ((rent == NULL) || (c >= rollup->head->colnum)) return (1);
+  if (rent->valid == 0) return (2);
+  if (rent->col[c].novfl) {
+    for (i = 0; i < MAX_MLN_NUM; i++) val[i] = CNERR;
+    return (3);
+  }
+
+  slot = rollup->slot[date->y - rollup->head->yfirst].slot[slg_rlp_doy (date)][c];
+  for (i = 0; i < MAX_MLN_NUM; i++) {
+    val[i] = (slot[i] == RLP_SLOTINV) ? CNERR : slot[i];
+  }
+
+  return (0);
+}
+
+
+/* calculates statistics of a time window of slot values of a column of a day
+ * - statistics are calculated directly on the int16 slot values (int16 kernel, see
+ *   slg_simd_dstats16())
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   *date  :  date
+ *   c      :  column index (0..colnum-1)
+ *   ib     :  first time index of window
+ *   ie     :  last time index of window (ib..MAX_MLN_NUM-1)
+ *   *dstats:  resulting statistics object (indices are time indices of day)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date, date out of year range, invalid column or invalid window
+ *    2 :  error: no day summary of date
+ *    3 :  error: slot values of day are out of int16 range
+ *    4 :  error: no valid values in window
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_slotstats (slg_rollup *rollup, slg_date *date, uint32_t c, uint32_t ib, uint32_t ie,
+                               slg_dstats *dstats)
+{
+  slg_rlpent *rent;
+  int16_t    *slot;
+
+  rent = slg_rollup_day (rollup, date);
+  if ((rent == NULL) || (c >= rollup->head->colnum) || (ib > ie) || (ie >= MAX_MLN_NUM)) return (1);
+  if (rent->valid == 0) return (2);
+  if (rent->col[c].novfl) return (3);
+
+  slot = rollup->slot[date->y - rollup->head->yfirst].slot[slg_rlp_doy (date)][c];
+  if (slg_simd_dstats16 (dstats, &slot[ib], ie - ib + 1) != 0) return (4);
+
+  dstats->indmin += ib;
+  dstats->indmax += ib;
+
+  return (0);
+}
+
+
+/* gets slot values of a column of a date range as one series
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   c      :  column index (0..colnum-1)
+ *   *date_b:  first date of range
+ *   *date_e:  last date of range
+ *   *val   :  resulting array of values (MAX_MLN_NUM per day, CNERR: invalid value or
+ *             no day summary)
+ *   maxlen :  max. number of values of array
+ *
+ * return value:
+ *   CNERR :  error: invalid date range, invalid column or array too small
+ *   other :  number of values (days * MAX_MLN_NUM)
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_series (slg_rollup *rollup, uint32_t c, slg_date *date_b, slg_date *date_e,
+                            int32_t *val, uint32_t maxlen)
+{
+  slg_date date;
+  uint32_t i, k, num;
+
+  if ((slg_date_compare (date_e, date_b) == 0) || (slg_date_compare (date_e, date_b) == 2)) return (CNERR);
+  if (c >= rollup->head->colnum) return (CNERR);
+
+  num = ((uint32_t) slg_date_sub (date_e, date_b) + 1) * MAX_MLN_NUM;
+  if (num > maxlen) return (CNERR);
+
+  slg_date_copy (&date, date_b);
+  for (i = 0; i < num; i += MAX_MLN_NUM) {
+    if (slg_rollup_slots (rollup, &date, c, &val[i]) != 0) {
+      for (k = 0; k < MAX_MLN_NUM; k++) val[i+k] = CNERR;
+    }
+    slg_date_inc (&date);
+  }
+
+  return (num);
+}
+
+
+/* calculates difference statistics, correlation and best lag of two columns over a date range
+ * (see slg_correl_series())
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   ca     :  column index a (0..colnum-1)
+ *   cb     :  column index b (0..colnum-1)
+ *   *date_b:  first date of range
+ *   *date_e:  last date of range
+ *   maxlag :  lags -maxlag..maxlag are searched (0..COR_MAX_LAG)
+ *   *correl:  resulting correlation object
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date range, invalid column or invalid max. lag
+ *    2 :  error: out of memory
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_correl (slg_rollup *rollup, uint32_t ca, uint32_t cb, slg_date *date_b,
+                            slg_date *date_e, uint32_t maxlag, slg_correl *correl)
+{
+  int32_t  *a, *b;
+  uint32_t num, res;
+
+  if ((ca >= rollup->head->colnum) || (cb >= rollup->head->colnum) || (maxlag > COR_MAX_LAG)) return (1);
+  if ((slg_date_compare (date_e, date_b) == 0) || (slg_date_compare (date_e, date_b) == 2)) return (1);
+
+  num = ((uint32_t) slg_date_sub (date_e, date_b) + 1) * MAX_MLN_NUM;
+  a = (int32_t *) malloc (2 * num * sizeof(int32_t));
+  if (a == NULL) return (2);
+  b = &a[num];
+
+  slg_rollup_series (rollup, ca, date_b, date_e, a, num);
+  slg_rollup_series (rollup, cb, date_b, date_e, b, num);
+  res = slg_correl_series (a, b, num, maxlag, correl);
+
+  free (a);
+
+  return (res);
+}
+
+
+/* gets histogram of a temperature column of a month or year
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   c      :  column index (0..colnum-1)
+ *   year   :  year
+ *   month  :  month (1..12) or 0 (whole year)
+ *   *hist  :  resulting histogram object
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid month, year out of range or column is not temperature
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_hist (slg_rollup *rollup, uint32_t c, uint32_t year, uint32_t month, slg_hist *hist)
+{
+  slg_rlpslot *rslot;
+  uint16_t    *mhist;
+  uint32_t    m, i;
+
+  if (slg_rollup_year (rollup, year) == NULL) return (1);
+  if ((month > 12) || (c >= rollup->head->colnum)) return (1);
+  if (rollup->head->coltyp[c] != DF_TEMP) return (1);
+
+  rslot = &rollup->slot[year - rollup->head->yfirst];
+  slg_hist_clear (hist);
+
+  for (m = 1; m <= 12; m++) {
+    if ((month != 0) && (m != month)) continue;
+
+    mhist = rslot->mhist[m-1][c];
+    for (i = 0; i < HST_BINS; i++) {
+      hist->bin[i] += mhist[i];
+      hist->count += mhist[i];
+    }
+  }
+
+  return (0);
+}
+
+
+/* gets quantile sketch of a rain column of a month or year range
+ * - month sketches of all years of range are merged (e.g. all July months of 30 years)
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   c      :  column index (0..colnum-1)
+ *   yfirst :  first year of range
+ *   ylast  :  last year of range
+ *   month  :  month (1..12) or 0 (whole years)
+ *   *sketch:  resulting sketch object
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid month, year out of range or column is not rain
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_sketch (slg_rollup *rollup, uint32_t c, uint32_t yfirst, uint32_t ylast, uint32_t month,
+                            slg_sketch *sketch)
+{
+  slg_rlpslot *rslot;
+  uint16_t    *msketch;
+  uint32_t    y, m, i;
+
+  if ((slg_rollup_year (rollup, yfirst) == NULL) || (slg_rollup_year (rollup, ylast) == NULL)) return (1);
+  if ((yfirst > ylast) || (month > 12) || (c >= rollup->head->colnum)) return (1);
+  if (rollup->head->coltyp[c] != DF_RAIN) return (1);
+
+  slg_sketch_clear (sketch);
+
+  for (y = yfirst; y <= ylast; y++) {
+    rslot = &rollup->slot[y - rollup->head->yfirst];
+
+    for (m = 1; m <= 12; m++) {
+      if ((month != 0) && (m != month)) continue;
+
+      msketch = rslot->msketch[m-1][c];
+      for (i = 0; i < SKT_BINS; i++) {
+        sketch->bin[i] += msketch[i];
+        sketch->count += msketch[i];
+      }
+    }
+  }
+
+  return (0);
+}
+
+
+/* calculates heating and cooling degree day sums of a temperature column over a date range
+ * - CLM_DD_MEAN uses day summaries only, CLM_DD_SLOT uses slot values of days
+ * - days without summary and days out of year range of index are skipped
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   c      :  column index (0..colnum-1)
+ *   *date_b:  first date of range
+ *   *date_e:  last date of range
+ *   base   :  base temperature (T*10)
+ *   method :  CLM_DD_MEAN or CLM_DD_SLOT
+ *   *hdd   :  resulting heating degree days (T*10 * days)
+ *   *cdd   :  resulting cooling degree days (T*10 * days)
+ *   *dnum  :  number of days with valid values
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date range, column is not temperature or invalid method
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_dd (slg_rollup *rollup, uint32_t c, slg_date *date_b, slg_date *date_e,
+                        int32_t base, uint32_t method, int32_t *hdd, int32_t *cdd, uint32_t *dnum)
+{
+  slg_date   date;
+  slg_rlpent *rent;
+  slg_dstats dstats;
+  int32_t    val[MAX_MLN_NUM];
+  int32_t    h, k;
+  uint32_t   res;
+
+  *hdd = 0;
+  *cdd = 0;
+  *dnum = 0;
+
+  if ((slg_date_compare (date_e, date_b) == 0) || (slg_date_compare (date_e, date_b) == 2)) return (1);
+  if ((c >= rollup->head->colnum) || (rollup->head->coltyp[c] != DF_TEMP)) return (1);
+  if ((method != CLM_DD_MEAN) && (method != CLM_DD_SLOT)) return (1);
+
+  slg_date_copy (&date, date_b);
+  while (slg_date_compare (&date, date_e) < 3) {
+    rent = slg_rollup_day (rollup, &date);
+
+    if ((rent != NULL) && (rent->valid)) {
+      if (method == CLM_DD_MEAN) {
+        dstats.count = rent->col[c].count;
+        dstats.sum = (int32_t) rent->col[c].sum;
+        res = slg_climate_dd_dstats (&dstats, base, &h, &k);
+      }
+      else {
+        slg_rollup_slots (rollup, &date, c, val);
+        res = slg_climate_dd (val, MAX_MLN_NUM, base, method, &h, &k);
+      }
+
+      if (res == 0) {
+        *hdd += h;
+        *cdd += k;
+        *dnum += 1;
+      }
+    }
+
+    if (slg_date_inc (&date) == 0) break;
+  }
+
+  return (0);
+}
+
+
+/* calculates daily anomalies of a temperature column of a month or year against a normals table
+ * - anomalies use day summaries of index, the normals column is found by column id
+ * - days without summary are invalid (CNERR)
+ *
+ * parameters:
+ *   *rollup :  rollup object
+ *   c       :  column index (0..colnum-1)
+ *   *normals:  normals table of location
+ *   year    :  year
+ *   month   :  month (1..12) or 0 (whole year)
+ *   *anom   :  resulting array of daily anomalies (31 or 366 entries, index: day of month
+ *              or year - 1, CNERR: invalid day) or NULL
+ *   *nanom  :  resulting anomaly summary
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid month, year out of range, column is not temperature or not in normals
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_anomaly (slg_rollup *rollup, uint32_t c, slg_normals *normals, uint32_t year,
+                            uint32_t month, int32_t *anom, slg_nrmanom *nanom)
+{
+  slg_date   date;
+  slg_rlpent *rent;
+  slg_dstats dstats;
+  int32_t    val[366];
+  uint32_t   nc, i, num;
+
+  if ((c >= rollup->head->colnum) || (rollup->head->coltyp[c] != DF_TEMP)) return (1);
+  if ((month > 12) || (slg_rollup_year (rollup, year) == NULL)) return (1);
+
+  nc = slg_normals_colexist (normals, DF_TEMP, rollup->head->colid[c]);
+  if (nc == 0) return (1);
+
+  slg_date_set_int (&date, 1, (month == 0) ? 1 : month, year);
+  num = (month == 0) ? slg_date_number_days_in_year (&date) : slg_date_number_days_in_month (&date);
+
+  for (i = 0; i < num; i++) {
+    val[i] = CNERR;
+    rent = slg_rollup_day (rollup, &date);
+
+    if ((rent != NULL) && (rent->valid)) {
+      dstats.count = rent->col[c].count;
+      dstats.sum = (int32_t) rent->col[c].sum;
+      val[i] = slg_normals_danomaly (normals, nc - 1, &date, &dstats);
+    }
+
+    slg_date_inc (&date);
+  }
+
+  slg_normals_anomaly_stats (val, num, nanom);
+  if (anom != NULL) {
+    for (i = 0; i < num; i++) anom[i] = val[i];
+  }
+
+  return (0);
+}
+
+
+/* calculates average value of a column summary
+ *
+ * parameters:
+ *   *rsum:  column summary
+ *
+ * return value:
+ *   CNERR :  no valid values
+ *   other :  average value
+ *
+ ****************************************************************************************/
+int32_t slg_rlpsum_average (slg_rlpsum *rsum)
+{
+  if (rsum->count == 0) return (CNERR);
+
+  return ((int32_t) (rsum->sum / (int64_t) rsum->count));
+}
+
+
+/* converts a day of year into a date
+ *
+ * parameters:
+ *   *date:  pointer to result date
+ *   year :  year
+ *   doy  :  day of year (0..365)
+ *
+ * return value:
+ *   0 :  in error case (invalid year or day of year)
+ *   1 :  ok
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_doy2date (slg_date *date, uint32_t year, uint32_t doy)
+{
+  if (slg_date_set_int (date, 1, 1, year) == 0) return (0);
+  if (doy >= slg_date_number_days_in_year (date)) return (0);
+
+  return (slg_date_add (date, (int32_t) doy));
+}
+
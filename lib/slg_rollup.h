@@ -0,0 +1,495 @@
+/***************************************************************************************************
+ *
+ * file     : slg_rollup.h
+ *
+ * function : senslog project c-library - rollup index functions
+ *            - a rollup index file stores day, month and year summaries of all columns
+ *              of one location (min. and max. with time stamp, sum and count)
+ *            - the file has a fixed binary layout and is accessed via mmap, so readers
+ *              touch only the summaries they need
+ *            - an opened index is locked (one writer or several readers), entries are
+ *              invalid while they are rewritten
+ *            - day summaries are updated incrementally if mtime or size of a dayfile change,
+ *              month and year summaries are reduced from the day summaries
+ *            - slot values of all days (int16) and the month histograms and sketches built
+ *              from them are kept in a separate slot file (index file name + RLP_SEXT), so
+ *              the index file holds only the summaries (some hundred kilobytes per year)
+ *            - month histograms of temperature columns are rebuilt from the slot values
+ *              when a day changes
+ *            - a column of a day with values out of int16 range (e.g. rain*100 or event
+ *              counters) keeps no slot values and is counted in novfl of its summaries
+ *            - day types (frost, ice, summer, hot, rain day) are classified when a day
+ *              changes and counted in month and year summaries
+ *            - daily anomalies of months and years against a normals table
+ *            - slot series of date ranges and correlation of two columns
+ *            - statistics of time windows of days directly on int16 slot values
+ *            - month quantile sketches of rain columns, quantiles of month or year ranges
+ *              are calculated by merging sketches
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_date.h"
+#include "slg_dayfile.h"
+#include "slg_simd.h"
+#include "slg_hist.h"
+#include "slg_climate.h"
+#include "slg_normals.h"
+#include "slg_correl.h"
+#include "slg_sketch.h"
+
+
+#ifndef _slg_rollup_h
+#define _slg_rollup_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define RLP_MAGIC     "SLGRLP"   /* index file magic (8 bytes incl. zero padding) */
+# define RLP_SMAGIC    "SLGRLS"   /* slot file magic (8 bytes incl. zero padding) */
+# define RLP_SEXT      ".slots"   /* slot file name: index file name + extension */
+# define RLP_VERSION   6          /* file format version */
+
+# define RLP_SLOTINV   SIMD_INV16 /* slot value: invalid (same as invalid value of int16 kernels) */
+
+
+/* summary of one column over a day, month or year (values are invalid if count is 0) */
+typedef struct {
+  int64_t   sum;          /* sum of valid values (temperature T*10, rain*100, event 0/1) */
+  uint32_t  count;        /* number of valid values */
+  int32_t   min;          /* min. value */
+  int32_t   max;          /* max. value */
+  uint32_t  dmin;         /* day of year of min. value (0..365, newest one) */
+  uint32_t  imin;         /* time index of min. value */
+  uint32_t  dmax;         /* day of year of max. value (0..365, newest one) */
+  uint32_t  imax;         /* time index of max. value */
+  uint16_t  ntype[CLM_NUM];  /* number of days of each day type (index: CLM_...) */
+  uint16_t  novfl;        /* number of days with values out of int16 range (slot values of
+                             these days are invalid, summaries are complete) */
+} slg_rlpsum;
+
+
+/* rollup entry of a day, month or year */
+typedef struct {
+  int64_t     mtime;              /* day: mtime of dayfile, month and year: 0 */
+  uint32_t    valid;              /* number of valid days (day: 0 or 1) */
+  uint32_t    fsize;              /* day: size of dayfile, month and year: 0 */
+  slg_rlpsum  col[MAX_MLN_VALS];  /* summaries of all columns (same order as in header) */
+} slg_rlpent;
+
+
+/* rollup block of one year (index file) */
+typedef struct {
+  slg_rlpent  year;               /* year summary */
+  slg_rlpent  month[12];          /* month summaries */
+  slg_rlpent  day[366];           /* day summaries (index: day of year 0..365) */
+} slg_rlpyear;
+
+
+/* slot block of one year (slot file) */
+typedef struct {
+  int16_t     slot[366][MAX_MLN_VALS][MAX_MLN_NUM];  /* slot values of days (valid days only) */
+  uint16_t    mhist[12][MAX_MLN_VALS][HST_BINS];     /* month histograms (temperature columns) */
+  uint16_t    msketch[12][MAX_MLN_VALS][SKT_BINS];   /* month quantile sketches (rain columns) */
+} slg_rlpslot;
+
+
+/* rollup file header */
+typedef struct {
+  char      magic[8];             /* RLP_MAGIC */
+  uint32_t  version;              /* RLP_VERSION */
+  uint32_t  locid;                /* location id */
+  uint32_t  tmode;                /* time_mode */
+  uint32_t  yfirst;               /* first year in file */
+  uint32_t  ynum;                 /* number of years in file */
+  uint32_t  colnum;               /* number of columns */
+  uint32_t  coltyp[MAX_MLN_VALS]; /* list of column types */
+  uint32_t  colid[MAX_MLN_VALS];  /* list of column ids */
+} slg_rlphead;
+
+
+/* rollup index object (opened file) */
+typedef struct {
+  int           fd;               /* file descriptor of index file */
+  size_t        size;             /* size of index file */
+  int           sfd;              /* file descriptor of slot file */
+  size_t        ssize;            /* size of slot file */
+  uint32_t      wmode;            /* 0: read only, 1: read and write */
+  slg_rlphead  *head;             /* mapped header of index file */
+  slg_rlpyear  *year;             /* mapped year blocks */
+  slg_rlphead  *shead;            /* mapped header of slot file */
+  slg_rlpslot  *slot;             /* mapped slot blocks */
+} slg_rollup;
+
+
+
+/* file functions *********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* creates a new empty rollup index file and its slot file
+ * - location, time mode and columns are taken from a template dayfile
+ * - files are written under temporary names and renamed (an existing index is replaced)
+ *
+ * parameters:
+ *   *filename:  path/filename of rollup file to create (max. 280 characters)
+ *   *daydata :  template daydata object
+ *   yfirst   :  first year of index
+ *   ylast    :  last year of index
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid year range
+ *    2 :  error: writing file failed
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_create (char *filename, slg_daydata *daydata, uint32_t yfirst, uint32_t ylast);
+
+
+/* opens a rollup index file and its slot file and maps them into memory
+ * - the index file is locked until it is closed: exclusive in write mode, shared in
+ *   read only mode (waits until the lock is granted)
+ *
+ * parameters:
+ *   *rollup  :  rollup object
+ *   *filename:  path/filename of rollup file (max. 280 characters)
+ *   wmode    :  0: read only
+ *               1: read and write (needed for updates)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: index file not found or can not be opened
+ *    2 :  error: invalid file (magic, version or size) or slot file is missing
+ *    3 :  error: mapping file failed
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_open (slg_rollup *rollup, char *filename, uint32_t wmode);
+
+
+/* closes a rollup index file and its slot file (changes are written back, lock is released)
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *
+ ****************************************************************************************/
+void slg_rollup_close (slg_rollup *rollup);
+
+
+
+/* update functions *******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* updates day summary of a date if mtime or size of dayfile has changed
+ * - month and year summaries of date are recalculated from day summaries
+ * - a removed dayfile removes its day summary
+ * - dayfile names are assumed to be in format "yyyy-mm-dd.txt"
+ *
+ * parameters:
+ *   *rollup  :  rollup object (opened in write mode)
+ *   *pathname:  path name of dayfiles (incl. '/') or empty string
+ *   *date    :  date of dayfile
+ *   hmode    :  header mode of dayfile (see slg_readdayfile())
+ *
+ * return value:
+ *      0 :  day summary updated
+ *      1 :  day summary is up to date
+ *      2 :  dayfile not found (an existing day summary is removed)
+ *      3 :  error: date is invalid or out of year range of index
+ *      4 :  error: rollup index is opened read only
+ *      5 :  error: dayfile has other location id or time mode than index
+ *    100+dayerror: error reading dayfile (errorcode % 100: errorcode of dayfile)
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_update (slg_rollup *rollup, char *pathname, slg_date *date, uint32_t hmode);
+
+
+/* updates day summaries of a date range (see slg_rollup_update())
+ *
+ * parameters:
+ *   *rollup  :  rollup object (opened in write mode)
+ *   *pathname:  path name of dayfiles (incl. '/') or empty string
+ *   *date_b  :  first date of range
+ *   *date_e  :  last date of range
+ *   hmode    :  header mode of dayfiles (see slg_readdayfile())
+ *   *nupd    :  number of updated day summaries
+ *
+ * return value:
+ *      0 :  operation successfull
+ *   else :  first error code of slg_rollup_update() (>= 3)
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_update_range (slg_rollup *rollup, char *pathname, slg_date *date_b,
+                                  slg_date *date_e, uint32_t hmode, uint32_t *nupd);
+
+
+
+/* query functions ********************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* checks if a column of a special typ and id exists in index
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   typ    :  column typ
+ *   id     :  column id
+ *
+ * return value:
+ *         0 :  column does not exist
+ *      >= 1 :  column number (index in entry + 1)
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_colexist (slg_rollup *rollup, uint32_t typ, uint32_t id);
+
+
+/* gets rollup entry of a day
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   *date  :  date
+ *
+ * return value:
+ *    NULL :  date is invalid or out of year range
+ *   other :  pointer to day entry
+ *
+ ****************************************************************************************/
+slg_rlpent *slg_rollup_day (slg_rollup *rollup, slg_date *date);
+
+
+/* gets rollup entry of a month
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   year   :  year
+ *   month  :  month (1..12)
+ *
+ * return value:
+ *    NULL :  month is invalid or out of year range
+ *   other :  pointer to month entry
+ *
+ ****************************************************************************************/
+slg_rlpent *slg_rollup_month (slg_rollup *rollup, uint32_t year, uint32_t month);
+
+
+/* gets rollup entry of a year
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   year   :  year
+ *
+ * return value:
+ *    NULL :  year is out of year range
+ *   other :  pointer to year entry
+ *
+ ****************************************************************************************/
+slg_rlpent *slg_rollup_year (slg_rollup *rollup, uint32_t year);
+
+
+/* gets slot values of a column of a day
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   *date  :  date
+ *   c      :  column index (0..colnum-1)
+ *   *val   :  array of MAX_MLN_NUM values (CNERR: invalid value)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date, date out of year range or invalid column
+ *    2 :  error: no day summary of date
+ *    3 :  error: slot values of day are out of int16 range (all values CNERR)
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_slots (slg_rollup *rollup, slg_date *date, uint32_t c, int32_t *val);
+
+
+/* calculates statistics of a time window of slot values of a column of a day
+ * - statistics are calculated directly on the int16 slot values (int16 kernel, see
+ *   slg_simd_dstats16())
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   *date  :  date
+ *   c      :  column index (0..colnum-1)
+ *   ib     :  first time index of window
+ *   ie     :  last time index of window (ib..MAX_MLN_NUM-1)
+ *   *dstats:  resulting statistics object (indices are time indices of day)
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date, date out of year range, invalid column or invalid window
+ *    2 :  error: no day summary of date
+ *    3 :  error: slot values of day are out of int16 range
+ *    4 :  error: no valid values in window
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_slotstats (slg_rollup *rollup, slg_date *date, uint32_t c, uint32_t ib, uint32_t ie,
+                               slg_dstats *dstats);
+
+
+/* gets slot values of a column of a date range as one series
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   c      :  column index (0..colnum-1)
+ *   *date_b:  first date of range
+ *   *date_e:  last date of range
+ *   *val   :  resulting array of values (MAX_MLN_NUM per day, CNERR: invalid value or
+ *             no day summary)
+ *   maxlen :  max. number of values of array
+ *
+ * return value:
+ *   CNERR :  error: invalid date range, invalid column or array too small
+ *   other :  number of values (days * MAX_MLN_NUM)
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_series (slg_rollup *rollup, uint32_t c, slg_date *date_b, slg_date *date_e,
+                            int32_t *val, uint32_t maxlen);
+
+
+/* calculates difference statistics, correlation and best lag of two columns over a date range
+ * (see slg_correl_series())
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   ca     :  column index a (0..colnum-1)
+ *   cb     :  column index b (0..colnum-1)
+ *   *date_b:  first date of range
+ *   *date_e:  last date of range
+ *   maxlag :  lags -maxlag..maxlag are searched (0..COR_MAX_LAG)
+ *   *correl:  resulting correlation object
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date range, invalid column or invalid max. lag
+ *    2 :  error: out of memory
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_correl (slg_rollup *rollup, uint32_t ca, uint32_t cb, slg_date *date_b,
+                            slg_date *date_e, uint32_t maxlag, slg_correl *correl);
+
+
+/* gets histogram of a temperature column of a month or year
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   c      :  column index (0..colnum-1)
+ *   year   :  year
+ *   month  :  month (1..12) or 0 (whole year)
+ *   *hist  :  resulting histogram object
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid month, year out of range or column is not temperature
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_hist (slg_rollup *rollup, uint32_t c, uint32_t year, uint32_t month, slg_hist *hist);
+
+
+/* gets quantile sketch of a rain column of a month or year range
+ * - month sketches of all years of range are merged (e.g. all July months of 30 years)
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   c      :  column index (0..colnum-1)
+ *   yfirst :  first year of range
+ *   ylast  :  last year of range
+ *   month  :  month (1..12) or 0 (whole years)
+ *   *sketch:  resulting sketch object
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid month, year out of range or column is not rain
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_sketch (slg_rollup *rollup, uint32_t c, uint32_t yfirst, uint32_t ylast, uint32_t month,
+                            slg_sketch *sketch);
+
+
+/* calculates heating and cooling degree day sums of a temperature column over a date range
+ * - CLM_DD_MEAN uses day summaries only, CLM_DD_SLOT uses slot values of days
+ * - days without summary and days out of year range of index are skipped
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   c      :  column index (0..colnum-1)
+ *   *date_b:  first date of range
+ *   *date_e:  last date of range
+ *   base   :  base temperature (T*10)
+ *   method :  CLM_DD_MEAN or CLM_DD_SLOT
+ *   *hdd   :  resulting heating degree days (T*10 * days)
+ *   *cdd   :  resulting cooling degree days (T*10 * days)
+ *   *dnum  :  number of days with valid values
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid date range, column is not temperature or invalid method
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_dd (slg_rollup *rollup, uint32_t c, slg_date *date_b, slg_date *date_e,
+                        int32_t base, uint32_t method, int32_t *hdd, int32_t *cdd, uint32_t *dnum);
+
+
+/* calculates daily anomalies of a temperature column of a month or year against a normals table
+ * - anomalies use day summaries of index, the normals column is found by column id
+ * - days without summary are invalid (CNERR)
+ *
+ * parameters:
+ *   *rollup :  rollup object
+ *   c       :  column index (0..colnum-1)
+ *   *normals:  normals table of location
+ *   year    :  year
+ *   month   :  month (1..12) or 0 (whole year)
+ *   *anom   :  resulting array of daily anomalies (31 or 366 entries, index: day of month
+ *              or year - 1, CNERR: invalid day) or NULL
+ *   *nanom  :  resulting anomaly summary
+ *
+ * return value:
+ *    0 :  operation successfull
+ *    1 :  error: invalid month, year out of range, column is not temperature or not in normals
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_anomaly (slg_rollup *rollup, uint32_t c, slg_normals *normals, uint32_t year,
+                            uint32_t month, int32_t *anom, slg_nrmanom *nanom);
+
+
+/* calculates average value of a column summary
+ *
+ * parameters:
+ *   *rsum:  column summary
+ *
+ * return value:
+ *   CNERR :  no valid values
+ *   other :  average value
+ *
+ ****************************************************************************************/
+int32_t slg_rlpsum_average (slg_rlpsum *rsum);
+
+
+/* converts a day of year into a date
+ *
+ * parameters:
+ *   *date:  pointer to result date
+ *   year :  year
+ *   doy  :  day of year (0..365)
+ *
+ * return value:
+ *   0 :  in error case (invalid year or day of year)
+ *   1 :  ok
+ *
+ ****************************************************************************************/
+uint32_t slg_rollup_doy2date (slg_date *date, uint32_t year, uint32_t doy);
+
+
+
+#endif
+
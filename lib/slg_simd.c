@@ -0,0 +1,699 @@
+/***************************************************************************************************
+ *
+ * file     : slg_simd.c
+ *
+ * function : senslog project c-library - vectorized statistics kernels
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "slg_simd.h"
+#include "slg_values.h"
+#include "slg_temper.h"
+
+
+/* selected kernel variant */
+static uint32_t slg_simd_lvl = SIMD_SCALAR;
+
+
+
+/* private functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* detects the best kernel variant of the cpu
+ *
+ * return value:
+ *   best kernel variant (SIMD_...)
+ *
+ ****************************************************************************************/
+static uint32_t slg_smd_detect (void)
+{
+  uint32_t level;
+
+  level = SIMD_SCALAR;
+
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("sse2")) level = SIMD_SSE2;
+  if (__builtin_cpu_supports ("avx2")) level = SIMD_AVX2;
+  if (__builtin_cpu_supports ("avx512f")) level = SIMD_AVX512;
+#endif
+
+  return (level);
+}
+
+
+/* selects kernel variant at program start (before any thread is created)
+ *
+ ****************************************************************************************/
+__attribute__ ((constructor)) static void slg_smd_start (void)
+{
+  slg_simd_init ();
+}
+
+
+/* scalar kernel: adds values ib..len-1 of an array to running statistics
+ * - running statistics start with count 0, sum 0, min. CNERR, max. -CNERR
+ *
+ * parameters:
+ *   *dstats:  running statistics object
+ *   *val   :  value array
+ *   ib     :  first index
+ *   len    :  array length
+ *   *mask  :  bitmap of ignored values or NULL
+ *
+ ****************************************************************************************/
+static void slg_smd_scalar (slg_dstats *dstats, int32_t *val, uint32_t ib, uint32_t len, uint32_t *mask)
+{
+  uint32_t i, count, indmin, indmax, valid, newmin, newmax;
+  int32_t  v, sum, min, max;
+
+  count = dstats->count;
+  sum = dstats->sum;
+  min = dstats->min;
+  max = dstats->max;
+  indmin = dstats->indmin;
+  indmax = dstats->indmax;
+
+  /* branch free loop body: invalid values are masked out, "<=" and ">=" keep newest index */
+  for (i = ib; i < len; i++) {
+    v = val[i];
+    valid = (v != CNERR);
+    if (mask != NULL) valid &= ((mask[i / 32] >> (i % 32)) & 1) ^ 1;
+    newmin = valid & (v <= min);
+    newmax = valid & (v >= max);
+
+    count += valid;
+    sum += valid ? v : 0;
+    min = newmin ? v : min;
+    max = newmax ? v : max;
+    indmin = newmin ? i : indmin;
+    indmax = newmax ? i : indmax;
+  }
+
+  dstats->count = count;
+  dstats->sum = sum;
+  dstats->min = min;
+  dstats->max = max;
+  dstats->indmin = indmin;
+  dstats->indmax = indmax;
+}
+
+
+/* reduces lane results of a vector kernel to running statistics
+ * - a lane holds statistics of every lanes-th value, so the newest min. (max.) of the
+ *   array is the one with the highest index of all lanes with the lowest (highest) value
+ *
+ * parameters:
+ *   *dstats:  running statistics object
+ *   lanes  :  number of lanes
+ *   *lcount:  lane counts
+ *   *lsum  :  lane sums
+ *   *lmin  :  lane min. values
+ *   *limin :  lane indices of min. values
+ *   *lmax  :  lane max. values
+ *   *limax :  lane indices of max. values
+ *
+ ****************************************************************************************/
+static void slg_smd_reduce (slg_dstats *dstats, uint32_t lanes, int32_t *lcount, int32_t *lsum,
+                            int32_t *lmin, int32_t *limin, int32_t *lmax, int32_t *limax)
+{
+  uint32_t l;
+
+  for (l = 0; l < lanes; l++) {
+    dstats->count += (uint32_t) lcount[l];
+    dstats->sum = (int32_t) ((uint32_t) dstats->sum + (uint32_t) lsum[l]);
+
+    if ((lmin[l] < dstats->min) || ((lmin[l] == dstats->min) && ((uint32_t) limin[l] > dstats->indmin))) {
+      dstats->min = lmin[l];
+      dstats->indmin = (uint32_t) limin[l];
+    }
+    if ((lmax[l] > dstats->max) || ((lmax[l] == dstats->max) && ((uint32_t) limax[l] > dstats->indmax))) {
+      dstats->max = lmax[l];
+      dstats->indmax = (uint32_t) limax[l];
+    }
+  }
+}
+
+
+/* scalar kernel (int16): adds values ib..len-1 of an array to running statistics
+ *
+ * parameters:
+ *   *dstats:  running statistics object
+ *   *val   :  value array
+ *   ib     :  first index
+ *   len    :  array length
+ *
+ ****************************************************************************************/
+static void slg_smd_scalar16 (slg_dstats *dstats, int16_t *val, uint32_t ib, uint32_t len)
+{
+  uint32_t i, valid, newmin, newmax;
+  int32_t  v;
+
+  for (i = ib; i < len; i++) {
+    v = val[i];
+    valid = (v != SIMD_INV16);
+    newmin = valid & (v <= dstats->min);
+    newmax = valid & (v >= dstats->max);
+
+    dstats->count += valid;
+    dstats->sum += valid ? v : 0;
+    dstats->min = newmin ? v : dstats->min;
+    dstats->max = newmax ? v : dstats->max;
+    dstats->indmin = newmin ? i : dstats->indmin;
+    dstats->indmax = newmax ? i : dstats->indmax;
+  }
+}
+
+
+/* reduces int16 lane results of a vector kernel to running statistics
+ * - lanes without valid values are skipped, lane sums are int32 sums of lane pairs
+ *
+ * parameters:
+ *   *dstats:  running statistics object
+ *   lanes  :  number of int16 lanes
+ *   *lcount:  lane counts
+ *   *lsum  :  int32 sums (lanes/2 values)
+ *   *lmin  :  lane min. values
+ *   *limin :  lane indices of min. values
+ *   *lmax  :  lane max. values
+ *   *limax :  lane indices of max. values
+ *
+ ****************************************************************************************/
+static void slg_smd_reduce16 (slg_dstats *dstats, uint32_t lanes, int16_t *lcount, int32_t *lsum,
+                              int16_t *lmin, int16_t *limin, int16_t *lmax, int16_t *limax)
+{
+  int32_t  wcount[16], wsum[16], wmin[16], wimin[16], wmax[16], wimax[16];
+  uint32_t l;
+
+  for (l = 0; l < lanes; l++) {
+    wcount[l] = lcount[l];
+    wsum[l] = (l < (lanes / 2)) ? lsum[l] : 0;
+    wmin[l] = (lcount[l] > 0) ? lmin[l] : CNERR;
+    wimin[l] = (lcount[l] > 0) ? limin[l] : 0;
+    wmax[l] = (lcount[l] > 0) ? lmax[l] : - CNERR;
+    wimax[l] = (lcount[l] > 0) ? limax[l] : 0;
+  }
+
+  slg_smd_reduce (dstats, lanes, wcount, wsum, wmin, wimin, wmax, wimax);
+}
+
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/* SSE2 kernel: adds all values of an array to running statistics (4 lanes)
+ *
+ * parameters:
+ *   *dstats:  running statistics object
+ *   *val   :  value array
+ *   len    :  array length
+ *   *mask  :  bitmap of ignored values or NULL
+ *
+ ****************************************************************************************/
+__attribute__ ((target ("sse2")))
+static void slg_smd_sse2 (slg_dstats *dstats, int32_t *val, uint32_t len, uint32_t *mask)
+{
+  __m128i  v, cn, ones, lbit, cur, step, ign, valid, newmin, newmax;
+  __m128i  vcount, vsum, vmin, vmax, vimin, vimax;
+  int32_t  lcount[4], lsum[4], lmin[4], limin[4], lmax[4], limax[4];
+  uint32_t i, n, bits;
+
+  n = len & ~3u;
+  cn = _mm_set1_epi32 (CNERR);
+  ones = _mm_set1_epi32 (-1);
+  lbit = _mm_setr_epi32 (1, 2, 4, 8);
+  cur = _mm_setr_epi32 (0, 1, 2, 3);
+  step = _mm_set1_epi32 (4);
+
+  vcount = _mm_setzero_si128 ();
+  vsum = _mm_setzero_si128 ();
+  vmin = _mm_set1_epi32 (CNERR);
+  vmax = _mm_set1_epi32 (- CNERR);
+  vimin = _mm_setzero_si128 ();
+  vimax = _mm_setzero_si128 ();
+
+  for (i = 0; i < n; i += 4) {
+    v = _mm_loadu_si128 ((__m128i *) &val[i]);
+
+    /* lane mask of valid values (all bits set) */
+    ign = _mm_cmpeq_epi32 (v, cn);
+    if (mask != NULL) {
+      bits = (mask[i / 32] >> (i % 32)) & 0xF;
+      ign = _mm_or_si128 (ign, _mm_cmpeq_epi32 (_mm_and_si128 (_mm_set1_epi32 ((int32_t) bits), lbit), lbit));
+    }
+    valid = _mm_andnot_si128 (ign, ones);
+
+    /* v <= min is !(v > min), v >= max is !(max > v) */
+    newmin = _mm_andnot_si128 (_mm_cmpgt_epi32 (v, vmin), valid);
+    newmax = _mm_andnot_si128 (_mm_cmpgt_epi32 (vmax, v), valid);
+
+    vcount = _mm_sub_epi32 (vcount, valid);
+    vsum = _mm_add_epi32 (vsum, _mm_and_si128 (v, valid));
+    vmin = _mm_or_si128 (_mm_and_si128 (newmin, v), _mm_andnot_si128 (newmin, vmin));
+    vmax = _mm_or_si128 (_mm_and_si128 (newmax, v), _mm_andnot_si128 (newmax, vmax));
+    vimin = _mm_or_si128 (_mm_and_si128 (newmin, cur), _mm_andnot_si128 (newmin, vimin));
+    vimax = _mm_or_si128 (_mm_and_si128 (newmax, cur), _mm_andnot_si128 (newmax, vimax));
+
+    cur = _mm_add_epi32 (cur, step);
+  }
+
+  _mm_storeu_si128 ((__m128i *) lcount, vcount);
+  _mm_storeu_si128 ((__m128i *) lsum, vsum);
+  _mm_storeu_si128 ((__m128i *) lmin, vmin);
+  _mm_storeu_si128 ((__m128i *) limin, vimin);
+  _mm_storeu_si128 ((__m128i *) lmax, vmax);
+  _mm_storeu_si128 ((__m128i *) limax, vimax);
+  slg_smd_reduce (dstats, 4, lcount, lsum, lmin, limin, lmax, limax);
+
+  slg_smd_scalar (dstats, val, n, len, mask);
+}
+
+
+/* AVX2 kernel: adds all values of an array to running statistics (8 lanes)
+ *
+ * parameters:
+ *   *dstats:  running statistics object
+ *   *val   :  value array
+ *   len    :  array length
+ *   *mask  :  bitmap of ignored values or NULL
+ *
+ ****************************************************************************************/
+__attribute__ ((target ("avx2")))
+static void slg_smd_avx2 (slg_dstats *dstats, int32_t *val, uint32_t len, uint32_t *mask)
+{
+  __m256i  v, cn, ones, lbit, cur, step, ign, valid, newmin, newmax;
+  __m256i  vcount, vsum, vmin, vmax, vimin, vimax;
+  int32_t  lcount[8], lsum[8], lmin[8], limin[8], lmax[8], limax[8];
+  uint32_t i, n, bits;
+
+  n = len & ~7u;
+  cn = _mm256_set1_epi32 (CNERR);
+  ones = _mm256_set1_epi32 (-1);
+  lbit = _mm256_setr_epi32 (1, 2, 4, 8, 16, 32, 64, 128);
+  cur = _mm256_setr_epi32 (0, 1, 2, 3, 4, 5, 6, 7);
+  step = _mm256_set1_epi32 (8);
+
+  vcount = _mm256_setzero_si256 ();
+  vsum = _mm256_setzero_si256 ();
+  vmin = _mm256_set1_epi32 (CNERR);
+  vmax = _mm256_set1_epi32 (- CNERR);
+  vimin = _mm256_setzero_si256 ();
+  vimax = _mm256_setzero_si256 ();
+
+  for (i = 0; i < n; i += 8) {
+    v = _mm256_loadu_si256 ((__m256i *) &val[i]);
+
+    ign = _mm256_cmpeq_epi32 (v, cn);
+    if (mask != NULL) {
+      bits = (mask[i / 32] >> (i % 32)) & 0xFF;
+      ign = _mm256_or_si256 (ign, _mm256_cmpeq_epi32 (_mm256_and_si256 (_mm256_set1_epi32 ((int32_t) bits), lbit), lbit));
+    }
+    valid = _mm256_andnot_si256 (ign, ones);
+
+    newmin = _mm256_andnot_si256 (_mm256_cmpgt_epi32 (v, vmin), valid);
+    newmax = _mm256_andnot_si256 (_mm256_cmpgt_epi32 (vmax, v), valid);
+
+    vcount = _mm256_sub_epi32 (vcount, valid);
+    vsum = _mm256_add_epi32 (vsum, _mm256_and_si256 (v, valid));
+    vmin = _mm256_blendv_epi8 (vmin, v, newmin);
+    vmax = _mm256_blendv_epi8 (vmax, v, newmax);
+    vimin = _mm256_blendv_epi8 (vimin, cur, newmin);
+    vimax = _mm256_blendv_epi8 (vimax, cur, newmax);
+
+    cur = _mm256_add_epi32 (cur, step);
+  }
+
+  _mm256_storeu_si256 ((__m256i *) lcount, vcount);
+  _mm256_storeu_si256 ((__m256i *) lsum, vsum);
+  _mm256_storeu_si256 ((__m256i *) lmin, vmin);
+  _mm256_storeu_si256 ((__m256i *) limin, vimin);
+  _mm256_storeu_si256 ((__m256i *) lmax, vmax);
+  _mm256_storeu_si256 ((__m256i *) limax, vimax);
+  _mm256_zeroupper ();   /* avoid transition penalty in following SSE code */
+  slg_smd_reduce (dstats, 8, lcount, lsum, lmin, limin, lmax, limax);
+
+  slg_smd_scalar (dstats, val, n, len, mask);
+}
+
+
+/* AVX-512 kernel: adds all values of an array to running statistics (16 lanes)
+ *
+ * parameters:
+ *   *dstats:  running statistics object
+ *   *val   :  value array
+ *   len    :  array length
+ *   *mask  :  bitmap of ignored values or NULL
+ *
+ ****************************************************************************************/
+__attribute__ ((target ("avx512f")))
+static void slg_smd_avx512 (slg_dstats *dstats, int32_t *val, uint32_t len, uint32_t *mask)
+{
+  __m512i   v, cn, one, cur, step;
+  __m512i   vcount, vsum, vmin, vmax, vimin, vimax;
+  __mmask16 valid, newmin, newmax;
+  int32_t   lcount[16], lsum[16], lmin[16], limin[16], lmax[16], limax[16];
+  uint32_t  i, n;
+
+  n = len & ~15u;
+  cn = _mm512_set1_epi32 (CNERR);
+  one = _mm512_set1_epi32 (1);
+  cur = _mm512_setr_epi32 (0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  step = _mm512_set1_epi32 (16);
+
+  vcount = _mm512_setzero_si512 ();
+  vsum = _mm512_setzero_si512 ();
+  vmin = _mm512_set1_epi32 (CNERR);
+  vmax = _mm512_set1_epi32 (- CNERR);
+  vimin = _mm512_setzero_si512 ();
+  vimax = _mm512_setzero_si512 ();
+
+  for (i = 0; i < n; i += 16) {
+    v = _mm512_loadu_si512 ((void *) &val[i]);
+
+    /* mask bits of 16 values are used directly as lane mask */
+    valid = _mm512_cmpneq_epi32_mask (v, cn);
+    if (mask != NULL) valid &= (__mmask16) ~(mask[i / 32] >> (i % 32));
+
+    newmin = _mm512_mask_cmple_epi32_mask (valid, v, vmin);
+    newmax = _mm512_mask_cmpge_epi32_mask (valid, v, vmax);
+
+    vcount = _mm512_mask_add_epi32 (vcount, valid, vcount, one);
+    vsum = _mm512_mask_add_epi32 (vsum, valid, vsum, v);
+    vmin = _mm512_mask_mov_epi32 (vmin, newmin, v);
+    vmax = _mm512_mask_mov_epi32 (vmax, newmax, v);
+    vimin = _mm512_mask_mov_epi32 (vimin, newmin, cur);
+    vimax = _mm512_mask_mov_epi32 (vimax, newmax, cur);
+
+    cur = _mm512_add_epi32 (cur, step);
+  }
+
+  _mm512_storeu_si512 ((void *) lcount, vcount);
+  _mm512_storeu_si512 ((void *) lsum, vsum);
+  _mm512_storeu_si512 ((void *) lmin, vmin);
+  _mm512_storeu_si512 ((void *) limin, vimin);
+  _mm512_storeu_si512 ((void *) lmax, vmax);
+  _mm512_storeu_si512 ((void *) limax, vimax);
+  _mm256_zeroupper ();   /* avoid transition penalty in following SSE code */
+  slg_smd_reduce (dstats, 16, lcount, lsum, lmin, limin, lmax, limax);
+
+  slg_smd_scalar (dstats, val, n, len, mask);
+}
+
+
+/* SSE2 kernel (int16): adds all values of an array to running statistics (8 lanes)
+ * - array length must not exceed SIMD_MAXLEN16 (lane counts and indices are int16)
+ *
+ * parameters:
+ *   *dstats:  running statistics object
+ *   *val   :  value array
+ *   len    :  array length
+ *
+ ****************************************************************************************/
+__attribute__ ((target ("sse2")))
+static void slg_smd_sse2_16 (slg_dstats *dstats, int16_t *val, uint32_t len)
+{
+  __m128i  v, inv, ones, cur, step, valid, newmin, newmax;
+  __m128i  vcount, vsum, vmin, vmax, vimin, vimax;
+  int16_t  lcount[8], lmin[8], limin[8], lmax[8], limax[8];
+  int32_t  lsum[4];
+  uint32_t i, n;
+
+  n = len & ~7u;
+  inv = _mm_set1_epi16 (SIMD_INV16);
+  ones = _mm_set1_epi16 (1);
+  cur = _mm_setr_epi16 (0, 1, 2, 3, 4, 5, 6, 7);
+  step = _mm_set1_epi16 (8);
+
+  vcount = _mm_setzero_si128 ();
+  vsum = _mm_setzero_si128 ();
+  vmin = _mm_set1_epi16 (INT16_MAX);
+  vmax = _mm_set1_epi16 (INT16_MIN);
+  vimin = _mm_setzero_si128 ();
+  vimax = _mm_setzero_si128 ();
+
+  for (i = 0; i < n; i += 8) {
+    v = _mm_loadu_si128 ((__m128i *) &val[i]);
+
+    valid = _mm_cmpeq_epi16 (v, inv);
+    valid = _mm_xor_si128 (valid, _mm_set1_epi16 (-1));
+
+    newmin = _mm_andnot_si128 (_mm_cmpgt_epi16 (v, vmin), valid);
+    newmax = _mm_andnot_si128 (_mm_cmpgt_epi16 (vmax, v), valid);
+
+    /* sums of lane pairs are widened to int32 (no int16 overflow) */
+    vcount = _mm_sub_epi16 (vcount, valid);
+    vsum = _mm_add_epi32 (vsum, _mm_madd_epi16 (_mm_and_si128 (v, valid), ones));
+    vmin = _mm_or_si128 (_mm_and_si128 (newmin, v), _mm_andnot_si128 (newmin, vmin));
+    vmax = _mm_or_si128 (_mm_and_si128 (newmax, v), _mm_andnot_si128 (newmax, vmax));
+    vimin = _mm_or_si128 (_mm_and_si128 (newmin, cur), _mm_andnot_si128 (newmin, vimin));
+    vimax = _mm_or_si128 (_mm_and_si128 (newmax, cur), _mm_andnot_si128 (newmax, vimax));
+
+    cur = _mm_add_epi16 (cur, step);
+  }
+
+  _mm_storeu_si128 ((__m128i *) lcount, vcount);
+  _mm_storeu_si128 ((__m128i *) lsum, vsum);
+  _mm_storeu_si128 ((__m128i *) lmin, vmin);
+  _mm_storeu_si128 ((__m128i *) limin, vimin);
+  _mm_storeu_si128 ((__m128i *) lmax, vmax);
+  _mm_storeu_si128 ((__m128i *) limax, vimax);
+  slg_smd_reduce16 (dstats, 8, lcount, lsum, lmin, limin, lmax, limax);
+
+  slg_smd_scalar16 (dstats, val, n, len);
+}
+
+
+/* AVX2 kernel (int16): adds all values of an array to running statistics (16 lanes)
+ * - array length must not exceed SIMD_MAXLEN16 (lane counts and indices are int16)
+ *
+ * parameters:
+ *   *dstats:  running statistics object
+ *   *val   :  value array
+ *   len    :  array length
+ *
+ ****************************************************************************************/
+__attribute__ ((target ("avx2")))
+static void slg_smd_avx2_16 (slg_dstats *dstats, int16_t *val, uint32_t len)
+{
+  __m256i  v, inv, ones, cur, step, valid, newmin, newmax;
+  __m256i  vcount, vsum, vmin, vmax, vimin, vimax;
+  int16_t  lcount[16], lmin[16], limin[16], lmax[16], limax[16];
+  int32_t  lsum[8];
+  uint32_t i, n;
+
+  n = len & ~15u;
+  inv = _mm256_set1_epi16 (SIMD_INV16);
+  ones = _mm256_set1_epi16 (1);
+  cur = _mm256_setr_epi16 (0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  step = _mm256_set1_epi16 (16);
+
+  vcount = _mm256_setzero_si256 ();
+  vsum = _mm256_setzero_si256 ();
+  vmin = _mm256_set1_epi16 (INT16_MAX);
+  vmax = _mm256_set1_epi16 (INT16_MIN);
+  vimin = _mm256_setzero_si256 ();
+  vimax = _mm256_setzero_si256 ();
+
+  for (i = 0; i < n; i += 16) {
+    v = _mm256_loadu_si256 ((__m256i *) &val[i]);
+
+    valid = _mm256_cmpeq_epi16 (v, inv);
+    valid = _mm256_xor_si256 (valid, _mm256_set1_epi16 (-1));
+
+    newmin = _mm256_andnot_si256 (_mm256_cmpgt_epi16 (v, vmin), valid);
+    newmax = _mm256_andnot_si256 (_mm256_cmpgt_epi16 (vmax, v), valid);
+
+    vcount = _mm256_sub_epi16 (vcount, valid);
+    vsum = _mm256_add_epi32 (vsum, _mm256_madd_epi16 (_mm256_and_si256 (v, valid), ones));
+    vmin = _mm256_blendv_epi8 (vmin, v, newmin);
+    vmax = _mm256_blendv_epi8 (vmax, v, newmax);
+    vimin = _mm256_blendv_epi8 (vimin, cur, newmin);
+    vimax = _mm256_blendv_epi8 (vimax, cur, newmax);
+
+    cur = _mm256_add_epi16 (cur, step);
+  }
+
+  _mm256_storeu_si256 ((__m256i *) lcount, vcount);
+  _mm256_storeu_si256 ((__m256i *) lsum, vsum);
+  _mm256_storeu_si256 ((__m256i *) lmin, vmin);
+  _mm256_storeu_si256 ((__m256i *) limin, vimin);
+  _mm256_storeu_si256 ((__m256i *) lmax, vmax);
+  _mm256_storeu_si256 ((__m256i *) limax, vimax);
+  _mm256_zeroupper ();   /* avoid transition penalty in following SSE code */
+  slg_smd_reduce16 (dstats, 16, lcount, lsum, lmin, limin, lmax, limax);
+
+  slg_smd_scalar16 (dstats, val, n, len);
+}
+
+#endif
+
+
+
+/* kernel functions *******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* detects the best kernel variant of the cpu and selects it
+ * - is called once at program start, may be called again to reset a forced variant
+ * - SSE2 is not selected (scalar loop is used instead), because with the build flags
+ *   of the tools (no optimization) the SSE2 kernel is slower than the scalar loop,
+ *   it can be forced by slg_simd_set()
+ *
+ * return value:
+ *   selected kernel variant (SIMD_...)
+ *
+ ****************************************************************************************/
+uint32_t slg_simd_init (void)
+{
+  slg_simd_lvl = slg_smd_detect ();
+  if (slg_simd_lvl == SIMD_SSE2) slg_simd_lvl = SIMD_SCALAR;
+
+  return (slg_simd_lvl);
+}
+
+
+/* gets selected kernel variant
+ *
+ * return value:
+ *   selected kernel variant (SIMD_...)
+ *
+ ****************************************************************************************/
+uint32_t slg_simd_level (void)
+{
+  return (slg_simd_lvl);
+}
+
+
+/* forces a kernel variant (e.g. for comparing variants)
+ * - must not be called while other threads calculate statistics
+ *
+ * parameters:
+ *   level:  kernel variant (SIMD_...)
+ *
+ * return value:
+ *    0 :  successfull
+ *    1 :  error: variant is not supported by cpu
+ *
+ ****************************************************************************************/
+uint32_t slg_simd_set (uint32_t level)
+{
+  if (level > slg_smd_detect ()) return (1);
+
+  slg_simd_lvl = level;
+
+  return (0);
+}
+
+
+/* calculates all statistic values of a value array with the selected kernel
+ * -> count, sum, min. and max. value and their indices (see slg_dstats_calc())
+ * -> finds the newest ones if there are more than one minimums or maximums
+ * -> invalid values (CNERR) and values with a set mask bit are ignored, if all are
+ *    ignored min. and max. are CNERR
+ *
+ * parameters:
+ *   *dstats:  resulting statistics object
+ *   *val   :  value array (e.g. temperature T*10 or rain*100)
+ *   len    :  array length
+ *   *mask  :  bitmap of ignored values (bit i: val[i] is ignored) or NULL
+ *
+ * return value:
+ *         0 :  valid values exist
+ *         1 :  no valid values found
+ *
+ ****************************************************************************************/
+uint32_t slg_simd_dstats (slg_dstats *dstats, int32_t *val, uint32_t len, uint32_t *mask)
+{
+  dstats->count = 0;
+  dstats->sum = 0;
+  dstats->min = CNERR;
+  dstats->max = - CNERR;
+  dstats->indmin = 0;
+  dstats->indmax = 0;
+
+  switch (slg_simd_lvl) {
+#if defined(__x86_64__) || defined(__i386__)
+    case SIMD_AVX512: slg_smd_avx512 (dstats, val, len, mask);
+                      break;
+    case SIMD_AVX2:   slg_smd_avx2 (dstats, val, len, mask);
+                      break;
+    case SIMD_SSE2:   slg_smd_sse2 (dstats, val, len, mask);
+                      break;
+#endif
+    default:          slg_smd_scalar (dstats, val, 0, len, mask);
+                      break;
+  }
+
+  if (dstats->count == 0) {
+    dstats->min = CNERR;
+    dstats->max = CNERR;
+    return (1);
+  }
+
+  return (0);
+}
+
+
+/* calculates all statistic values of an int16 value array with the selected kernel
+ * -> same results as slg_simd_dstats() with the values widened to int32
+ * -> int16 arrays are processed in twice as many lanes per step (AVX-512 uses the AVX2
+ *    kernel)
+ * -> invalid values (SIMD_INV16) are ignored, if all are ignored min. and max. are CNERR
+ *
+ * parameters:
+ *   *dstats:  resulting statistics object
+ *   *val   :  value array (e.g. slot values of a rollup index)
+ *   len    :  array length (max. SIMD_MAXLEN16)
+ *
+ * return value:
+ *         0 :  valid values exist
+ *         1 :  no valid values found
+ *         2 :  error: array too long
+ *
+ ****************************************************************************************/
+uint32_t slg_simd_dstats16 (slg_dstats *dstats, int16_t *val, uint32_t len)
+{
+  dstats->count = 0;
+  dstats->sum = 0;
+  dstats->min = CNERR;
+  dstats->max = - CNERR;
+  dstats->indmin = 0;
+  dstats->indmax = 0;
+
+  if (len > SIMD_MAXLEN16) return (2);
+
+  switch (slg_simd_lvl) {
+#if defined(__x86_64__) || defined(__i386__)
+    case SIMD_AVX512:
+    case SIMD_AVX2:   slg_smd_avx2_16 (dstats, val, len);
+                      break;
+    case SIMD_SSE2:   slg_smd_sse2_16 (dstats, val, len);
+                      break;
+#endif
+    default:          slg_smd_scalar16 (dstats, val, 0, len);
+                      break;
+  }
+
+  if (dstats->count == 0) {
+    dstats->min = CNERR;
+    dstats->max = CNERR;
+    return (1);
+  }
+
+  return (0);
+}
+
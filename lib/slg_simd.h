@@ -0,0 +1,127 @@
+/***************************************************************************************************
+ *
+ * file     : slg_simd.h
+ *
+ * function : senslog project c-library - vectorized statistics kernels
+ *            - count, sum, min., max. and indices of min. and max. of value arrays in
+ *              SSE2, AVX2 and AVX-512 variants and a scalar fallback
+ *            - int16 variants for int16 arrays (e.g. slot values of rollup index)
+ *            - the kernel is selected once at program start by cpu detection (only
+ *              variants faster than the scalar loop), all variants give identical
+ *              results (invalid values are masked out, newest min. and max. values win)
+ *            - slg_dstats_calc() and slg_dstats_calc_mask() use these kernels, so all day,
+ *              month and year statistics run on them
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+#include "slg_temper.h"
+
+
+#ifndef _slg_simd_h
+#define _slg_simd_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define SIMD_SCALAR   0     /* kernel variant: scalar loop */
+# define SIMD_SSE2     1     /* kernel variant: SSE2 (4 values per step) */
+# define SIMD_AVX2     2     /* kernel variant: AVX2 (8 values per step) */
+# define SIMD_AVX512   3     /* kernel variant: AVX-512 (16 values per step) */
+
+# define SIMD_INV16    INT16_MIN   /* int16 arrays: invalid value */
+# define SIMD_MAXLEN16 INT16_MAX   /* int16 arrays: max. array length */
+
+
+
+/* kernel functions *******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* detects the best kernel variant of the cpu and selects it
+ * - is called once at program start, may be called again to reset a forced variant
+ * - SSE2 is not selected (scalar loop is used instead), because with the build flags
+ *   of the tools (no optimization) the SSE2 kernel is slower than the scalar loop,
+ *   it can be forced by slg_simd_set()
+ *
+ * return value:
+ *   selected kernel variant (SIMD_...)
+ *
+ ****************************************************************************************/
+uint32_t slg_simd_init (void);
+
+
+/* gets selected kernel variant
+ *
+ * return value:
+ *   selected kernel variant (SIMD_...)
+ *
+ ****************************************************************************************/
+uint32_t slg_simd_level (void);
+
+
+/* forces a kernel variant (e.g. for comparing variants)
+ * - must not be called while other threads calculate statistics
+ *
+ * parameters:
+ *   level:  kernel variant (SIMD_...)
+ *
+ * return value:
+ *    0 :  successfull
+ *    1 :  error: variant is not supported by cpu
+ *
+ ****************************************************************************************/
+uint32_t slg_simd_set (uint32_t level);
+
+
+/* calculates all statistic values of a value array with the selected kernel
+ * -> count, sum, min. and max. value and their indices (see slg_dstats_calc())
+ * -> finds the newest ones if there are more than one minimums or maximums
+ * -> invalid values (CNERR) and values with a set mask bit are ignored, if all are
+ *    ignored min. and max. are CNERR
+ *
+ * parameters:
+ *   *dstats:  resulting statistics object
+ *   *val   :  value array (e.g. temperature T*10 or rain*100)
+ *   len    :  array length
+ *   *mask  :  bitmap of ignored values (bit i: val[i] is ignored) or NULL
+ *
+ * return value:
+ *         0 :  valid values exist
+ *         1 :  no valid values found
+ *
+ ****************************************************************************************/
+uint32_t slg_simd_dstats (slg_dstats *dstats, int32_t *val, uint32_t len, uint32_t *mask);
+
+
+/* calculates all statistic values of an int16 value array with the selected kernel
+ * -> same results as slg_simd_dstats() with the values widened to int32
+ * -> int16 arrays are processed in twice as many lanes per step (AVX-512 uses the AVX2
+ *    kernel)
+ * -> invalid values (SIMD_INV16) are ignored, if all are ignored min. and max. are CNERR
+ *
+ * parameters:
+ *   *dstats:  resulting statistics object
+ *   *val   :  value array (e.g. slot values of a rollup index)
+ *   len    :  array length (max. SIMD_MAXLEN16)
+ *
+ * return value:
+ *         0 :  valid values exist
+ *         1 :  no valid values found
+ *         2 :  error: array too long
+ *
+ ****************************************************************************************/
+uint32_t slg_simd_dstats16 (slg_dstats *dstats, int16_t *val, uint32_t len);
+
+
+
+#endif
+
@@ -0,0 +1,214 @@
+/***************************************************************************************************
+ *
+ * file     : slg_sketch.c
+ *
+ * function : senslog project c-library - quantile sketch functions
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "slg_sketch.h"
+#include "slg_values.h"
+
+
+
+/* private functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* finds bucket of a rank in a bucket range (nearest rank method)
+ *
+ * parameters:
+ *   *sketch:  sketch object
+ *   ib     :  first bucket of range
+ *   pm     :  quantile in permille (0..1000)
+ *
+ * return value:
+ *   CNERR :  empty range or invalid quantile
+ *   other :  value of bucket of rank
+ *
+ ****************************************************************************************/
+static int32_t slg_skt_rank (slg_sketch *sketch, uint32_t ib, uint32_t pm)
+{
+  uint64_t rank;
+  uint32_t i, num, sum;
+
+  num = 0;
+  for (i = ib; i < SKT_BINS; i++) num += sketch->bin[i];
+
+  if ((num == 0) || (pm > 1000)) return (CNERR);
+
+  rank = ((uint64_t) pm * num + 999) / 1000;
+  if (rank == 0) rank = 1;
+
+  sum = 0;
+  for (i = ib; i < SKT_BINS; i++) {
+    sum += sketch->bin[i];
+    if (sum >= rank) break;
+  }
+
+  return (slg_sketch_value (i));
+}
+
+
+
+/* sketch functions *******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* clears a sketch
+ *
+ * parameters:
+ *   *sketch:  sketch object
+ *
+ ****************************************************************************************/
+void slg_sketch_clear (slg_sketch *sketch)
+{
+  memset (sketch, 0, sizeof(slg_sketch));
+}
+
+
+/* gets bucket index of a value
+ *
+ * parameters:
+ *   val:  value (no CNERR)
+ *
+ * return value:
+ *   bucket index (0..SKT_BINS-1)
+ *
+ ****************************************************************************************/
+uint32_t slg_sketch_bin (int32_t val)
+{
+  uint32_t u, e, m;
+
+  u = (val < 0) ? (uint32_t) 0 - (uint32_t) val : (uint32_t) val;
+
+  /* magnitude bucket: exponent and SKT_MBITS bits below leading one */
+  if (u < SKT_SUB) {
+    m = u;
+  }
+  else {
+    e = 31 - (uint32_t) __builtin_clz (u);
+    m = (e - SKT_MBITS) * SKT_SUB + (u >> (e - SKT_MBITS));
+  }
+
+  return ((val < 0) ? SKT_ZERO - m : SKT_ZERO + m);
+}
+
+
+/* gets representative value of a bucket (center of bucket, exact for small values)
+ *
+ * parameters:
+ *   bin:  bucket index (0..SKT_BINS-1)
+ *
+ * return value:
+ *   value of bucket
+ *
+ ****************************************************************************************/
+int32_t slg_sketch_value (uint32_t bin)
+{
+  uint32_t m, k;
+  int64_t  lo, w, v;
+
+  m = (bin >= SKT_ZERO) ? bin - SKT_ZERO : SKT_ZERO - bin;
+
+  if (m < 2 * SKT_SUB) {
+    v = m;
+  }
+  else {
+    k = m / SKT_SUB;
+    w = (int64_t) 1 << (k - 1);
+    lo = (int64_t) (SKT_SUB + m % SKT_SUB) * w;
+    v = lo + (w - 1) / 2;
+  }
+
+  if (bin < SKT_ZERO) v = - v;
+  if (v > INT32_MAX) v = INT32_MAX;
+  if (v < INT32_MIN) v = INT32_MIN;
+
+  return ((int32_t) v);
+}
+
+
+/* adds values of an array to a sketch (CNERR values are skipped)
+ *
+ * parameters:
+ *   *sketch:  sketch object
+ *   *val   :  value array
+ *   len    :  array length
+ *
+ ****************************************************************************************/
+void slg_sketch_add (slg_sketch *sketch, int32_t *val, uint32_t len)
+{
+  uint32_t i;
+
+  for (i = 0; i < len; i++) {
+    if (val[i] != CNERR) {
+      sketch->bin[slg_sketch_bin (val[i])]++;
+      sketch->count++;
+    }
+  }
+}
+
+
+/* merges a sketch into another one (e.g. months into a range of years)
+ *
+ * parameters:
+ *   *sketch :  target sketch object
+ *   *sketchi:  sketch object to add
+ *
+ ****************************************************************************************/
+void slg_sketch_merge (slg_sketch *sketch, slg_sketch *sketchi)
+{
+  uint32_t i;
+
+  for (i = 0; i < SKT_BINS; i++) {
+    sketch->bin[i] += sketchi->bin[i];
+  }
+  sketch->count += sketchi->count;
+}
+
+
+/* calculates an approximate quantile (nearest rank method, see slg_hist_percentile())
+ *
+ * parameters:
+ *   *sketch:  sketch object
+ *   pm     :  quantile in permille (0..1000, e.g. 500: median, 950: P95)
+ *
+ * return value:
+ *   CNERR :  empty sketch or invalid quantile
+ *   other :  value of bucket of rank ceil(pm * count / 1000)
+ *
+ ****************************************************************************************/
+int32_t slg_sketch_quantile (slg_sketch *sketch, uint32_t pm)
+{
+  return (slg_skt_rank (sketch, 0, pm));
+}
+
+
+/* calculates an approximate quantile of the positive values of a sketch
+ * (e.g. rain intensity of slots with rain)
+ *
+ * parameters:
+ *   *sketch:  sketch object
+ *   pm     :  quantile in permille (0..1000)
+ *
+ * return value:
+ *   CNERR :  no positive values or invalid quantile
+ *   other :  value of bucket of rank ceil(pm * number of positive values / 1000)
+ *
+ ****************************************************************************************/
+int32_t slg_sketch_quantile_pos (slg_sketch *sketch, uint32_t pm)
+{
+  return (slg_skt_rank (sketch, SKT_ZERO + 1, pm));
+}
+
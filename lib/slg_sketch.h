@@ -0,0 +1,136 @@
+/***************************************************************************************************
+ *
+ * file     : slg_sketch.h
+ *
+ * function : senslog project c-library - quantile sketch functions
+ *            - approximate quantiles of unbounded int32 series (e.g. rain intensity or
+ *              differences) with a fixed relative error
+ *            - log-linear buckets: values below 2*SKT_SUB are exact, above each power of 2
+ *              is split into SKT_SUB buckets (max. relative error 1/(2*SKT_SUB))
+ *            - a sketch has a fixed size, sketches are merged by adding bucket counts, so
+ *              results do not depend on the order of values or merges
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdint.h>
+
+
+#ifndef _slg_sketch_h
+#define _slg_sketch_h
+
+
+/* defines and structures *************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+# define SKT_MBITS  5                             /* mantissa bits of bucket index */
+# define SKT_SUB    (1 << SKT_MBITS)              /* buckets per power of 2 */
+# define SKT_ZERO   ((32 - SKT_MBITS) * SKT_SUB)  /* bucket index of value 0 (and number of
+                                                     buckets of negative values) */
+# define SKT_BINS   (2 * SKT_ZERO + 1)            /* number of buckets */
+
+
+/* quantile sketch */
+typedef struct {
+  uint32_t  count;            /* number of values */
+  uint32_t  bin[SKT_BINS];    /* bin[SKT_ZERO]: value 0, bin[SKT_ZERO+m]: positive values,
+                                 bin[SKT_ZERO-m]: negative values of magnitude bucket m */
+} slg_sketch;
+
+
+
+/* sketch functions *******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* clears a sketch
+ *
+ * parameters:
+ *   *sketch:  sketch object
+ *
+ ****************************************************************************************/
+void slg_sketch_clear (slg_sketch *sketch);
+
+
+/* gets bucket index of a value
+ *
+ * parameters:
+ *   val:  value (no CNERR)
+ *
+ * return value:
+ *   bucket index (0..SKT_BINS-1)
+ *
+ ****************************************************************************************/
+uint32_t slg_sketch_bin (int32_t val);
+
+
+/* gets representative value of a bucket (center of bucket, exact for small values)
+ *
+ * parameters:
+ *   bin:  bucket index (0..SKT_BINS-1)
+ *
+ * return value:
+ *   value of bucket
+ *
+ ****************************************************************************************/
+int32_t slg_sketch_value (uint32_t bin);
+
+
+/* adds values of an array to a sketch (CNERR values are skipped)
+ *
+ * parameters:
+ *   *sketch:  sketch object
+ *   *val   :  value array
+ *   len    :  array length
+ *
+ ****************************************************************************************/
+void slg_sketch_add (slg_sketch *sketch, int32_t *val, uint32_t len);
+
+
+/* merges a sketch into another one (e.g. months into a range of years)
+ *
+ * parameters:
+ *   *sketch :  target sketch object
+ *   *sketchi:  sketch object to add
+ *
+ ****************************************************************************************/
+void slg_sketch_merge (slg_sketch *sketch, slg_sketch *sketchi);
+
+
+/* calculates an approximate quantile (nearest rank method, see slg_hist_percentile())
+ *
+ * parameters:
+ *   *sketch:  sketch object
+ *   pm     :  quantile in permille (0..1000, e.g. 500: median, 950: P95)
+ *
+ * return value:
+ *   CNERR :  empty sketch or invalid quantile
+ *   other :  value of bucket of rank ceil(pm * count / 1000)
+ *
+ ****************************************************************************************/
+int32_t slg_sketch_quantile (slg_sketch *sketch, uint32_t pm);
+
+
+/* calculates an approximate quantile of the positive values of a sketch
+ * (e.g. rain intensity of slots with rain)
+ *
+ * parameters:
+ *   *sketch:  sketch object
+ *   pm     :  quantile in permille (0..1000)
+ *
+ * return value:
+ *   CNERR :  no positive values or invalid quantile
+ *   other :  value of bucket of rank ceil(pm * number of positive values / 1000)
+ *
+ ****************************************************************************************/
+int32_t slg_sketch_quantile_pos (slg_sketch *sketch, uint32_t pm);
+
+
+
+#endif
+
@@ -7,7 +7,7 @@
  * author   : Jochen Ertel
  *
  * created  : 09.01.2022
- * updated  : 30.11.2023
+ * updated  : 18.10.2026
  *
  **************************************************************************************************/
 
@@ -20,14 +20,159 @@
 #include "slg_date.h"
 #include "slg_values.h"
 #include "slg_dayfile.h"
+#include "slg_simd.h"
 
 
+/* load options of temperature reads (TMP_LOAD_...) and max. gap length to fill */
+static uint32_t slg_tmp_lopts = 0;
+static uint32_t slg_tmp_lgap = 0;
 
-/* day related functions **************************************************************************/
+
+
+/* private functions ******************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
 
-/* read all temperature values of a column from dayfile
+/* fills short gaps of a series by linear interpolation (rounded)
+ * - one scan finds the runs of invalid values between two valid values, a run with
+ *   length <= maxgap is filled in one loop (rounding is symmetric to zero, so a
+ *   falling slope gives the negated values of a rising one)
+ *
+ * parameters:
+ *   *val  :  value array (CNERR: invalid value)
+ *   len   :  array length
+ *   maxgap:  max. gap length to fill
+ *   *ipol :  interpolated bitmap of array (bits of filled values are set)
+ *
+ * return value:
+ *   number of filled values
+ *
+ ****************************************************************************************/
+static uint32_t slg_ipl_series (int32_t *val, uint32_t len, uint32_t maxgap, uint32_t *ipol)
+{
+  uint32_t i, p, n, num;
+  int32_t  dv, d, k, m;
+
+  num = 0;
+  p = CNERR;
+  for (n = 0; n < len; n++) {
+    if (val[n] == CNERR) continue;
+
+    /* run p+1..n-1 between valid values p and n */
+    if ((p != CNERR) && (n - p > 1) && (n - p - 1 <= maxgap)) {
+      m = (int32_t) (n - p);
+      dv = val[n] - val[p];
+      for (i = p + 1; i < n; i++) {
+        k = (int32_t) (i - p);
+        d = dv * k;
+        d = (d >= 0) ? (d + m / 2) / m : - ((- d + m / 2) / m);
+        val[i] = val[p] + d;
+        ipol[i / 32] |= (uint32_t) 1 << (i % 32);
+      }
+      num += n - p - 1;
+    }
+    p = n;
+  }
+
+  return (num);
+}
+
+
+/* calculates median of a small array (array is sorted)
+ *
+ * parameters:
+ *   *val:  value array
+ *   len :  array length (>= 1)
+ *
+ * return value:
+ *   median (mean of both middle values if len is even)
+ *
+ ****************************************************************************************/
+static int32_t slg_spk_median (int32_t *val, uint32_t len)
+{
+  uint32_t i, k;
+  int32_t  v;
+
+  /* insertion sort */
+  for (i = 1; i < len; i++) {
+    v = val[i];
+    for (k = i; (k > 0) && (val[k-1] > v); k--) val[k] = val[k-1];
+    val[k] = v;
+  }
+
+  if (len % 2) return (val[len / 2]);
+
+  return ((val[len / 2 - 1] + val[len / 2]) / 2);
+}
+
+
+/* flags spikes and outliers of a series (see slg_dtemper_despike())
+ *
+ * parameters:
+ *   *val  :  value array (CNERR: invalid value)
+ *   len   :  array length
+ *   *qflag:  quality bitmap of array (bits of flagged values are set)
+ *
+ * return value:
+ *   number of flagged values
+ *
+ ****************************************************************************************/
+static uint32_t slg_spk_series (int32_t *val, uint32_t len, uint32_t *qflag)
+{
+  int32_t  win[2 * SPK_WIN], dev[2 * SPK_WIN];
+  int32_t  v, med, mad, lim, sp, sn;
+  uint32_t i, k, n, num, p;
+
+  num = 0;
+  for (i = 0; i < len; i++) {
+    v = val[i];
+    if (v == CNERR) continue;
+
+    /* SPK_WIN valid values before and after */
+    n = 0;
+    for (k = i, p = 0; (k > 0) && (p < SPK_WIN); k--) {
+      if (val[k-1] != CNERR) {
+        win[n++] = val[k-1];
+        p++;
+      }
+    }
+    sp = (n > 0) ? v - win[0] : 0;
+    for (k = i + 1, p = 0; (k < len) && (p < SPK_WIN); k++) {
+      if (val[k] != CNERR) {
+        if (p == 0) sn = val[k] - v;
+        win[n++] = val[k];
+        p++;
+      }
+    }
+    if (p == 0) sn = 0;
+
+    /* spike: large steps to and back from value */
+    if (((sp > SPK_STEP) && (sn < - SPK_STEP)) || ((sp < - SPK_STEP) && (sn > SPK_STEP))) {
+      qflag[i / 32] |= (uint32_t) 1 << (i % 32);
+      num++;
+      continue;
+    }
+
+    /* outlier: deviation from rolling median */
+    if (n < SPK_WIN) continue;
+    med = slg_spk_median (win, n);
+    for (k = 0; k < n; k++) dev[k] = (win[k] > med) ? win[k] - med : med - win[k];
+    mad = slg_spk_median (dev, n);
+
+    lim = (mad * SPK_KMAD) / 10;
+    if (lim < SPK_MINDEV) lim = SPK_MINDEV;
+
+    if ((v - med > lim) || (med - v > lim)) {
+      qflag[i / 32] |= (uint32_t) 1 << (i % 32);
+      num++;
+    }
+  }
+
+  return (num);
+}
+
+
+/* reads all temperature values of a column from dayfile (without load options)
  *
  * parameters:
  *   *dtemper:  day temperature object
@@ -39,7 +184,7 @@
  *         1 :  error, invalid id or id is not temperature
  *
  ****************************************************************************************/
-uint32_t slg_dtemper_read (slg_dtemper *dtemper, slg_daydata *daydata, uint32_t id)
+static uint32_t slg_tmp_read (slg_dtemper *dtemper, slg_daydata *daydata, uint32_t id)
 {
   uint32_t c, i;
 
@@ -50,6 +195,8 @@ uint32_t slg_dtemper_read (slg_dtemper *dtemper, slg_daydata *daydata, uint32_t
   dtemper->tlen = slg_timeindexnum (daydata->tmode);
   dtemper->last = slg_lastmline (daydata);
   strcpy (dtemper->name, daydata->colstr[c-2]);
+  memset (dtemper->ipol, 0, sizeof(dtemper->ipol));
+  memset (dtemper->qflag, 0, sizeof(dtemper->qflag));
 
   for (i=0; i < dtemper->tlen; i++) {
     dtemper->val[i] = slg_gettemperval (daydata, c, i);
@@ -59,6 +206,152 @@ uint32_t slg_dtemper_read (slg_dtemper *dtemper, slg_daydata *daydata, uint32_t
 }
 
 
+/* load option functions **************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* sets load options of slg_dtemper_read() and slg_mtemper_read()
+ * - options are applied to all following reads of the program (e.g. by generators
+ *   or aggregation jobs), default is no option
+ * - spikes are flagged before gaps are filled, flagged values are no gaps
+ * - must not be called while other threads read temperatures
+ *
+ * parameters:
+ *   opts  :  bitmap of load options (TMP_LOAD_...) or 0
+ *   maxgap:  max. gap length to fill (1..IPL_MAX_GAP, only used with TMP_LOAD_IPOL)
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  error: invalid max. gap length (options are not changed)
+ *
+ ****************************************************************************************/
+uint32_t slg_temper_setload (uint32_t opts, uint32_t maxgap)
+{
+  if ((opts & TMP_LOAD_IPOL) && ((maxgap < 1) || (maxgap > IPL_MAX_GAP))) return (1);
+
+  slg_tmp_lopts = opts;
+  slg_tmp_lgap = maxgap;
+
+  return (0);
+}
+
+
+
+/* day related functions **************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* read all temperature values of a column from dayfile
+ * - load options are applied (see slg_temper_setload())
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *   *daydata:  daydata object
+ *   id      :  temperature column id in daydata
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  error, invalid id or id is not temperature
+ *
+ ****************************************************************************************/
+uint32_t slg_dtemper_read (slg_dtemper *dtemper, slg_daydata *daydata, uint32_t id)
+{
+  if (slg_tmp_read (dtemper, daydata, id) != 0) return (1);
+
+  if (slg_tmp_lopts & TMP_LOAD_DESPIKE) slg_dtemper_despike (dtemper);
+  if (slg_tmp_lopts & TMP_LOAD_IPOL) slg_dtemper_interpolate (dtemper, slg_tmp_lgap);
+
+  return (0);
+}
+
+
+/* calculates all statistic values of a value array in one single pass
+ * -> count, sum, min. and max. value and their indices
+ * -> finds the newest ones if there are more than one minimums or maximums
+ * -> invalid values (CNERR) are ignored, if all are invalid min. and max. are CNERR
+ *
+ * parameters:
+ *   *dstats:  resulting statistics object
+ *   *val   :  value array (e.g. temperature T*10 or rain*100)
+ *   len    :  array length
+ *
+ * return value:
+ *         0 :  valid values exist
+ *         1 :  no valid values found
+ *
+ ****************************************************************************************/
+uint32_t slg_dstats_calc (slg_dstats *dstats, int32_t *val, uint32_t len)
+{
+  /* vector kernel selected at program start (scalar loop if no SIMD is available) */
+  return (slg_simd_dstats (dstats, val, len, NULL));
+}
+
+
+/* calculates all statistic values of a value array in one single pass (see slg_dstats_calc())
+ * -> values with a set bit in mask are ignored like invalid values
+ *
+ * parameters:
+ *   *dstats:  resulting statistics object
+ *   *val   :  value array (e.g. temperature T*10 or rain*100)
+ *   len    :  array length
+ *   *mask  :  bitmap of ignored values (bit i: val[i] is ignored)
+ *
+ * return value:
+ *         0 :  valid values exist
+ *         1 :  no valid values found
+ *
+ ****************************************************************************************/
+uint32_t slg_dstats_calc_mask (slg_dstats *dstats, int32_t *val, uint32_t len, uint32_t *mask)
+{
+  /* same kernel as slg_dstats_calc(), mask bits are part of the valid lanes */
+  return (slg_simd_dstats (dstats, val, len, mask));
+}
+
+
+/* calculates all statistic values of a day in one single pass
+ * -> count, sum, min. and max. value and their indices
+ * -> finds the newest ones if there are more than one minimums or maximums
+ * -> if all temperature values are invalid min. and max. are CNERR and indices are 0
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *   *dstats :  resulting day statistics object
+ *
+ * return value:
+ *         0 :  valid temperature values exist
+ *         1 :  no valid temperature values found
+ *
+ ****************************************************************************************/
+uint32_t slg_dtemper_stats (slg_dtemper *dtemper, slg_dstats *dstats)
+{
+  uint32_t i, flagged;
+
+  flagged = 0;
+  for (i = 0; i < MAX_MLN_BMW; i++) flagged |= dtemper->qflag[i];
+
+  if (flagged) return (slg_dstats_calc_mask (dstats, dtemper->val, dtemper->tlen, dtemper->qflag));
+
+  return (slg_dstats_calc (dstats, dtemper->val, dtemper->tlen));
+}
+
+
+/* calculates average value from a day statistics object
+ *
+ * parameters:
+ *   *dstats:  day statistics object
+ *
+ * return value:
+ *   average :  average value (CNERR if no valid value exists)
+ *
+ ****************************************************************************************/
+int32_t slg_dstats_average (slg_dstats *dstats)
+{
+  if (dstats->count == 0) return (CNERR);
+
+  return (dstats->sum / (int32_t) dstats->count);
+}
+
+
 /* check if at least one valid temperature value exist
  *
  * parameters:
@@ -71,16 +364,9 @@ uint32_t slg_dtemper_read (slg_dtemper *dtemper, slg_daydata *daydata, uint32_t
  ****************************************************************************************/
 int32_t slg_dtemper_checkvalid (slg_dtemper *dtemper)
 {
-  uint32_t i;
-
-  /* check if all values are invalid */
-  i = 0;
-  while ((dtemper->val[i] == CNERR) && (i != (dtemper->tlen - 1))) {
-    i++;
-  }
-  if (dtemper->val[i] == CNERR) return (1);
+  slg_dstats dstats;
 
-  return (0);
+  return ((int32_t) slg_dtemper_stats (dtemper, &dstats));
 }
 
 
@@ -97,26 +383,11 @@ int32_t slg_dtemper_checkvalid (slg_dtemper *dtemper)
  ****************************************************************************************/
 uint32_t slg_dtemper_indmin (slg_dtemper *dtemper)
 {
-  uint32_t i, ind, res;
-  int32_t  min;
+  slg_dstats dstats;
 
-  /* check if all values are invalid */
-  res = slg_dtemper_checkvalid (dtemper);
-  if (res == 1) return (0);
+  slg_dtemper_stats (dtemper, &dstats);
 
-  /* find minimum */
-  min = CNERR;
-
-  for (i = 0; i < dtemper->tlen; i++) {
-    if (dtemper->val[i] != CNERR) {
-      if (dtemper->val[i] <= min) {
-        ind = i;
-        min = dtemper->val[i];
-      }
-    }
-  }
-
-  return (ind);
+  return (dstats.indmin);
 }
 
 
@@ -133,26 +404,11 @@ uint32_t slg_dtemper_indmin (slg_dtemper *dtemper)
  ****************************************************************************************/
 uint32_t slg_dtemper_indmax (slg_dtemper *dtemper)
 {
-  uint32_t i, ind, res;
-  int32_t  max;
+  slg_dstats dstats;
 
-  /* check if all values are invalid */
-  res = slg_dtemper_checkvalid (dtemper);
-  if (res == 1) return (0);
+  slg_dtemper_stats (dtemper, &dstats);
 
-  /* find maximum */
-  max = - CNERR;
-
-  for (i = 0; i < dtemper->tlen; i++) {
-    if (dtemper->val[i] != CNERR) {
-      if (dtemper->val[i] >= max) {
-        ind = i;
-        max = dtemper->val[i];
-      }
-    }
-  }
-
-  return (ind);
+  return (dstats.indmax);
 }
 
 
@@ -167,25 +423,11 @@ uint32_t slg_dtemper_indmax (slg_dtemper *dtemper)
  ****************************************************************************************/
 int32_t slg_dtemper_average (slg_dtemper *dtemper)
 {
-  uint32_t i, res;
-  int32_t  at, k;
+  slg_dstats dstats;
 
-  /* check if all values are invalid */
-  res = slg_dtemper_checkvalid (dtemper);
-  if (res == 1) return (CNERR);
-
-  /* calculate average */
-  at = 0;
-  k = 0;
+  slg_dtemper_stats (dtemper, &dstats);
 
-  for (i = 0; i < dtemper->tlen; i++) {
-    if (dtemper->val[i] != CNERR) {
-      at += dtemper->val[i];
-      k++;
-    }
-  }
-
-  return (at / k);
+  return (slg_dstats_average (&dstats));
 }
 
 
@@ -203,15 +445,13 @@ int32_t slg_dtemper_average (slg_dtemper *dtemper)
  ****************************************************************************************/
 int32_t slg_dtemper_maxindayout30 (slg_dtemper *dtemper, slg_date *date)
 {
-  int32_t  th[12] = {150, 150, 200, 250, 300, 350, 350, 350, 300, 250, 200, 150};
-  int32_t  tmin, tmax, res;
-  uint32_t k;
-
-  k = slg_dtemper_indmin (dtemper);
-  tmin = dtemper->val[k];
+  int32_t    th[12] = {150, 150, 200, 250, 300, 350, 350, 350, 300, 250, 200, 150};
+  int32_t    tmin, tmax, res;
+  slg_dstats dstats;
 
-  k = slg_dtemper_indmax (dtemper);
-  tmax = dtemper->val[k];
+  slg_dtemper_stats (dtemper, &dstats);
+  tmin = dstats.min;
+  tmax = dstats.max;
 
   res = th[date->m -1];
   if ((tmin != CNERR) && (tmax != CNERR)) {
@@ -223,6 +463,104 @@ int32_t slg_dtemper_maxindayout30 (slg_dtemper *dtemper, slg_date *date)
 }
 
 
+/* merges n temperature objects to a new one in the following way:
+ * - for each index the values of all inputs are reduced by operator (min., max. or median)
+ * - if all values of an index are valid, all of them are used
+ * - if at least one value is invalid, valid values are used only outside of their
+ *   invalid window, the result is invalid if no value is left
+ * - for two inputs and MRG_MIN this is the same as slg_dtemper_merge_2()
+ *
+ * parameters:
+ *   *dtemper  :  output day temperature object
+ *   *name     :  name of output object
+ *   op        :  merge operator (MRG_MIN, MRG_MAX, MRG_MEDIAN)
+ *   n         :  number of input objects (1..MRG_MAX_NUM)
+ *   *dtemperi :  array of input day temperature objects
+ *   *invwindb :  array of invalid temperature window begins of input objects
+ *   *invwinde :  array of invalid temperature window ends of input objects
+ *
+ * return value:
+ *          0 :  successfull
+ *          1 :  input objects are not of same format
+ *          2 :  invalid operator or number of input objects
+ *
+ ****************************************************************************************/
+uint32_t slg_dtemper_merge_n (slg_dtemper *dtemper, char *name, uint32_t op, uint32_t n,
+                              slg_dtemper *dtemperi[], uint32_t invwindb[], uint32_t invwinde[])
+{
+  uint32_t i, k, j, tlen, use;
+  uint32_t nvalid[MAX_MLN_NUM], nused[MAX_MLN_NUM];
+  int32_t  v, a, b, acc[MAX_MLN_NUM], srt[MRG_MAX_NUM][MAX_MLN_NUM];
+
+  /* check input ****************************************************/
+  if ((n < 1) || (n > MRG_MAX_NUM) || (op > MRG_MEDIAN)) return (2);
+  for (k = 1; k < n; k++) {
+    if (dtemperi[k]->tmode != dtemperi[0]->tmode) return (1);
+    if (dtemperi[k]->tlen != dtemperi[0]->tlen) return (1);
+    if (dtemperi[k]->last != dtemperi[0]->last) return (1);
+  }
+
+  /* set header values **********************************************/
+  tlen = dtemperi[0]->tlen;
+  dtemper->tmode = dtemperi[0]->tmode;
+  dtemper->tlen = tlen;
+  dtemper->last = dtemperi[0]->last;
+  strcpy (dtemper->name, name);
+  memset (dtemper->ipol, 0, sizeof(dtemper->ipol));
+  memset (dtemper->qflag, 0, sizeof(dtemper->qflag));
+
+  /* count valid values per index ***********************************/
+  for (i = 0; i < tlen; i++) {
+    nvalid[i] = 0;
+    nused[i] = 0;
+    acc[i] = (op == MRG_MAX) ? - CNERR : CNERR;
+  }
+  for (k = 0; k < n; k++) {
+    for (i = 0; i < tlen; i++) {
+      nvalid[i] += (dtemperi[k]->val[i] != CNERR);
+    }
+  }
+
+  /* masked reduction: all loops over i are branch free *************/
+  for (k = 0; k < n; k++) {
+    for (i = 0; i < tlen; i++) {
+      v = dtemperi[k]->val[i];
+      use = (v != CNERR) & ((nvalid[i] == n) | (i < invwindb[k]) | (i > invwinde[k]));
+      nused[i] += use;
+
+      if (op == MRG_MIN) acc[i] = (use & (v < acc[i])) ? v : acc[i];
+      if (op == MRG_MAX) acc[i] = (use & (v > acc[i])) ? v : acc[i];
+      if (op == MRG_MEDIAN) srt[k][i] = use ? v : CNERR;  /* unused values are sorted to the end */
+    }
+  }
+
+  /* median: odd-even transposition sort of all columns at once *****/
+  if (op == MRG_MEDIAN) {
+    for (j = 0; j < n; j++) {
+      for (k = (j & 1); (k + 1) < n; k += 2) {
+        for (i = 0; i < tlen; i++) {
+          a = srt[k][i];
+          b = srt[k+1][i];
+          srt[k][i] = (a < b) ? a : b;
+          srt[k+1][i] = (a < b) ? b : a;
+        }
+      }
+    }
+    for (i = 0; i < tlen; i++) {
+      if (nused[i] > 0) {
+        acc[i] = (srt[(nused[i]-1)/2][i] + srt[nused[i]/2][i]) / 2;
+      }
+    }
+  }
+
+  for (i = 0; i < tlen; i++) {
+    dtemper->val[i] = (nused[i] > 0) ? acc[i] : CNERR;
+  }
+
+  return (0);
+}
+
+
 /* merges two temperature objects to a new one in the following way:
  * - for each index the lowest temperature value is taken
  * - if one value is invalid the result is invalid only if the other is in invalid window
@@ -246,43 +584,18 @@ uint32_t slg_dtemper_merge_2 (slg_dtemper *dtemper, char *name,
                               slg_dtemper *dtemper1, uint32_t invwind1b, uint32_t invwind1e,
                               slg_dtemper *dtemper2, uint32_t invwind2b, uint32_t invwind2e)
 {
-  uint32_t i;
-
-  /* check input ****************************************************/
-  if (dtemper1->tmode != dtemper2->tmode) return (1);
-  if (dtemper1->tlen != dtemper2->tlen) return (1);
-  if (dtemper1->last != dtemper2->last) return (1);
-
-  /* set header values **********************************************/
-  dtemper->tmode = dtemper1->tmode;
-  dtemper->tlen = dtemper1->tlen;
-  dtemper->last = dtemper1->last;
-  strcpy (dtemper->name, name);
-
-  /* merge temperature values ***************************************/
-  for (i = 0; i < dtemper->tlen; i++) {
+  slg_dtemper *dtemperi[2];
+  uint32_t    invwindb[2], invwinde[2];
 
-    if ((dtemper1->val[i] != CNERR) && (dtemper2->val[i] != CNERR)) {
-      if (dtemper1->val[i] < dtemper2->val[i]) dtemper->val[i] = dtemper1->val[i];
-      else dtemper->val[i] = dtemper2->val[i];
-    }
+  dtemperi[0] = dtemper1;
+  invwindb[0] = invwind1b;
+  invwinde[0] = invwind1e;
 
-    if ((dtemper1->val[i] == CNERR) && (dtemper2->val[i] == CNERR)) {
-      dtemper->val[i] = CNERR;
-    }
+  dtemperi[1] = dtemper2;
+  invwindb[1] = invwind2b;
+  invwinde[1] = invwind2e;
 
-    if ((dtemper1->val[i] != CNERR) && (dtemper2->val[i] == CNERR)) {
-      if ((i >= invwind1b) && (i <= invwind1e)) dtemper->val[i] = CNERR;
-      else dtemper->val[i] = dtemper1->val[i];
-    }
-
-    if ((dtemper1->val[i] == CNERR) && (dtemper2->val[i] != CNERR)) {
-      if ((i >= invwind2b) && (i <= invwind2e)) dtemper->val[i] = CNERR;
-      else dtemper->val[i] = dtemper2->val[i];
-    }
-  }
-
-  return (0);
+  return (slg_dtemper_merge_n (dtemper, name, MRG_MIN, 2, dtemperi, invwindb, invwinde));
 }
 
 
@@ -292,6 +605,7 @@ uint32_t slg_dtemper_merge_2 (slg_dtemper *dtemper, char *name,
 /**************************************************************************************************/
 
 /* read all temperature values of an id from all valid days of a month
+ * - load options are applied to the month as one series (see slg_temper_setload())
  *
  * parameters:
  *   *mtemper  :  month temperature object
@@ -309,8 +623,9 @@ uint32_t slg_mtemper_read (slg_mtemper *mtemper, slg_monthdata *monthdata, uint3
 
   for (i=0; i < 31; i++) {
     if (monthdata->dvalid[i]) {
-      res = slg_dtemper_read (&mtemper->dtemper[i], &monthdata->daydata[i], id);
+      res = slg_tmp_read (&mtemper->dtemper[i], &monthdata->daydata[i], id);
       if (res == 1) return (1);
+      slg_dtemper_stats (&mtemper->dtemper[i], &mtemper->dstats[i]);
       mtemper->dvalid[i] = 1;
     }
     else {
@@ -318,6 +633,10 @@ uint32_t slg_mtemper_read (slg_mtemper *mtemper, slg_monthdata *monthdata, uint3
     }
   }
 
+  /* month functions refresh day statistics of changed days */
+  if (slg_tmp_lopts & TMP_LOAD_DESPIKE) slg_mtemper_despike (mtemper);
+  if (slg_tmp_lopts & TMP_LOAD_IPOL) slg_mtemper_interpolate (mtemper, slg_tmp_lgap);
+
   return (0);
 }
 
@@ -334,22 +653,13 @@ uint32_t slg_mtemper_read (slg_mtemper *mtemper, slg_monthdata *monthdata, uint3
  ****************************************************************************************/
 int32_t slg_mtemper_checkvalid (slg_mtemper *mtemper)
 {
-  uint32_t i, j, flag;
-
-  /* check if all values are invalid */
-  flag = 0;
-  i = 0;
-  while ((flag == 0) && (i < 31)) {
-    j = 0;
-    while ((mtemper->dtemper[i].val[j] == CNERR) && (i != (mtemper->dtemper[i].tlen - 1))) {
-      j++;
-    }
-    if (mtemper->dtemper[i].val[j] != CNERR) flag = 1;
-    i++;
+  uint32_t i;
+
+  for (i = 0; i < 31; i++) {
+    if ((mtemper->dvalid[i]) && (mtemper->dstats[i].count > 0)) return (0);
   }
-  if (flag == 0) return (1);
 
-  return (0);
+  return (1);
 }
 
 
@@ -366,25 +676,18 @@ int32_t slg_mtemper_checkvalid (slg_mtemper *mtemper)
  ****************************************************************************************/
 uint32_t slg_mtemper_daymin (slg_mtemper *mtemper)
 {
-  uint32_t res, i, ind, day;
+  uint32_t i, day;
   int32_t  min;
 
-  /* check if there exist valid temperature values in month */
-  res = slg_mtemper_checkvalid (mtemper);
-  if (res == 1) return (0);
-
-  /* find maximum */
+  /* find minimum in day statistics */
   min = CNERR;
   day = 0;
 
   for (i = 0; i < 31; i++) {
-    if (mtemper->dvalid[i]) {
-      ind = slg_dtemper_indmin (&mtemper->dtemper[i]);
-      if (mtemper->dtemper[i].val[ind] != CNERR) {
-        if (mtemper->dtemper[i].val[ind] <= min) {
-          day = i + 1;  /* day range is (1..31) */
-          min = mtemper->dtemper[i].val[ind];
-        }
+    if ((mtemper->dvalid[i]) && (mtemper->dstats[i].count > 0)) {
+      if (mtemper->dstats[i].min <= min) {
+        day = i + 1;  /* day range is (1..31) */
+        min = mtemper->dstats[i].min;
       }
     }
   }
@@ -406,25 +709,18 @@ uint32_t slg_mtemper_daymin (slg_mtemper *mtemper)
  ****************************************************************************************/
 uint32_t slg_mtemper_daymax (slg_mtemper *mtemper)
 {
-  uint32_t res, i, ind, day;
+  uint32_t i, day;
   int32_t  max;
 
-  /* check if there exist valid temperature values in month */
-  res = slg_mtemper_checkvalid (mtemper);
-  if (res == 1) return (0);
-
-  /* find maximum */
+  /* find maximum in day statistics */
   max = - CNERR;
   day = 0;
 
   for (i = 0; i < 31; i++) {
-    if (mtemper->dvalid[i]) {
-      ind = slg_dtemper_indmax (&mtemper->dtemper[i]);
-      if (mtemper->dtemper[i].val[ind] != CNERR) {
-        if (mtemper->dtemper[i].val[ind] >= max) {
-          day = i + 1;  /* day range is (1..31) */
-          max = mtemper->dtemper[i].val[ind];
-        }
+    if ((mtemper->dvalid[i]) && (mtemper->dstats[i].count > 0)) {
+      if (mtemper->dstats[i].max >= max) {
+        day = i + 1;  /* day range is (1..31) */
+        max = mtemper->dstats[i].max;
       }
     }
   }
@@ -444,32 +740,76 @@ uint32_t slg_mtemper_daymax (slg_mtemper *mtemper)
  ****************************************************************************************/
 int32_t slg_mtemper_average (slg_mtemper *mtemper)
 {
-  uint32_t res, i, j;
+  uint32_t i;
   int32_t  at, k;
 
-  /* check if there exist valid temperature values in month */
-  res = slg_mtemper_checkvalid (mtemper);
-  if (res == 1) return (CNERR);
-
-  /* calculate average */
+  /* sum up day statistics */
   at = 0;
   k = 0;
 
   for (i = 0; i < 31; i++) {
     if (mtemper->dvalid[i]) {
-      for (j = 0; j < mtemper->dtemper[i].tlen; j++) {
-        if (mtemper->dtemper[i].val[j] != CNERR) {
-          at += mtemper->dtemper[i].val[j];
-          k++;
-        }
-      }
+      at += mtemper->dstats[i].sum;
+      k += (int32_t) mtemper->dstats[i].count;
     }
   }
 
+  if (k == 0) return (CNERR);
+
   return (at / k);
 }
 
 
+/* merges n month temperature objects to a new one in the following way:
+ * - days are merged by slg_dtemper_merge_n(), a day is valid only if it is valid in all inputs
+ * - for two inputs and MRG_MIN this is the same as slg_mtemper_merge_2()
+ *
+ * parameters:
+ *   *mtemper  :  output month temperature object
+ *   *name     :  name of output object
+ *   op        :  merge operator (MRG_MIN, MRG_MAX, MRG_MEDIAN)
+ *   n         :  number of input objects (1..MRG_MAX_NUM)
+ *   *mtemperi :  array of input month temperature objects
+ *   *invwindb :  array of invalid temperature window begins of input objects
+ *   *invwinde :  array of invalid temperature window ends of input objects
+ *
+ * return value:
+ *          0 :  successfull
+ *          1 :  input objects are not of same format
+ *          2 :  invalid operator or number of input objects
+ *
+ ****************************************************************************************/
+uint32_t slg_mtemper_merge_n (slg_mtemper *mtemper, char *name, uint32_t op, uint32_t n,
+                              slg_mtemper *mtemperi[], uint32_t invwindb[], uint32_t invwinde[])
+{
+  uint32_t    i, k, valid, res;
+  slg_dtemper *dtemperi[MRG_MAX_NUM];
+
+  if ((n < 1) || (n > MRG_MAX_NUM) || (op > MRG_MEDIAN)) return (2);
+
+  /* merge day by day ***********************************************/
+  for (i=0; i < 31; i++) {
+    valid = 1;
+    for (k = 0; k < n; k++) {
+      if (mtemperi[k]->dvalid[i] != 1) valid = 0;
+      dtemperi[k] = &mtemperi[k]->dtemper[i];
+    }
+
+    if (valid) {
+      res = slg_dtemper_merge_n (&mtemper->dtemper[i], name, op, n, dtemperi, invwindb, invwinde);
+      if (res != 0) return (res);
+      slg_dtemper_stats (&mtemper->dtemper[i], &mtemper->dstats[i]);
+      mtemper->dvalid[i] = 1;
+    }
+    else {
+      mtemper->dvalid[i] = 0;
+    }
+  }
+
+  return (0);
+}
+
+
 /* merges two month temperature objects to a new one in the following way:
  * - for each index the lowest temperature value is taken
  * - if one value is invalid the result is invalid only if the other is in invalid window
@@ -493,24 +833,205 @@ uint32_t slg_mtemper_merge_2 (slg_mtemper *mtemper, char *name,
                               slg_mtemper *mtemper1, uint32_t invwind1b, uint32_t invwind1e,
                               slg_mtemper *mtemper2, uint32_t invwind2b, uint32_t invwind2e)
 {
-  uint32_t i, res;
+  slg_mtemper *mtemperi[2];
+  uint32_t    invwindb[2], invwinde[2];
 
-  /* merge day by day ***********************************************/
-  for (i=0; i < 31; i++) {
-    if ((mtemper1->dvalid[i] == 1) && (mtemper2->dvalid[i] == 1)) {
-      res = slg_dtemper_merge_2 (&mtemper->dtemper[i], name,
-                                 &mtemper1->dtemper[i], invwind1b, invwind1e,
-                                 &mtemper2->dtemper[i], invwind2b, invwind2e);
-      if (res == 1) return (1);
-      mtemper->dvalid[i] = 1;
+  mtemperi[0] = mtemper1;
+  invwindb[0] = invwind1b;
+  invwinde[0] = invwind1e;
+
+  mtemperi[1] = mtemper2;
+  invwindb[1] = invwind2b;
+  invwinde[1] = invwind2e;
+
+  return (slg_mtemper_merge_n (mtemper, name, MRG_MIN, 2, mtemperi, invwindb, invwinde));
+}
+
+
+/* interpolation functions ************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* fills short gaps of a day by linear interpolation
+ * - a gap is a run of invalid values with valid values on both sides, gaps longer than
+ *   maxgap values stay invalid
+ * - filled values are marked in interpolated bitmap
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *   maxgap  :  max. gap length to fill (1..IPL_MAX_GAP)
+ *
+ * return value:
+ *   CNERR :  error: invalid max. gap length
+ *   other :  number of filled values
+ *
+ ****************************************************************************************/
+uint32_t slg_dtemper_interpolate (slg_dtemper *dtemper, uint32_t maxgap)
+{
+  if ((maxgap < 1) || (maxgap > IPL_MAX_GAP)) return (CNERR);
+
+  return (slg_ipl_series (dtemper->val, dtemper->tlen, maxgap, dtemper->ipol));
+}
+
+
+/* checks if a value of a day is interpolated
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *   ind     :  time index
+ *
+ * return value:
+ *         0 :  value is measured, invalid or index is out of range
+ *         1 :  value is interpolated
+ *
+ ****************************************************************************************/
+uint32_t slg_dtemper_is_ipol (slg_dtemper *dtemper, uint32_t ind)
+{
+  if (ind >= dtemper->tlen) return (0);
+
+  return ((dtemper->ipol[ind / 32] >> (ind % 32)) & 1);
+}
+
+
+/* fills short gaps of a month by linear interpolation (see slg_dtemper_interpolate())
+ * - days are handled as one series, so gaps around midnight are filled too, a missing
+ *   day is never filled
+ * - day statistics of changed days are recalculated
+ *
+ * parameters:
+ *   *mtemper:  month temperature object
+ *   maxgap  :  max. gap length to fill (1..IPL_MAX_GAP)
+ *
+ * return value:
+ *   CNERR :  error: invalid max. gap length
+ *   other :  number of filled values
+ *
+ ****************************************************************************************/
+uint32_t slg_mtemper_interpolate (slg_mtemper *mtemper, uint32_t maxgap)
+{
+  int32_t  val[IPL_MAX_LEN];
+  uint32_t ipol[IPL_MAX_LEN / 32 + 1];
+  uint32_t d, i, k, num;
+
+  if ((maxgap < 1) || (maxgap > IPL_MAX_GAP)) return (CNERR);
+
+  /* month as one series (missing days and indices >= tlen are invalid) */
+  for (d = 0; d < 31; d++) {
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      k = (mtemper->dvalid[d]) && (i < mtemper->dtemper[d].tlen);
+      val[d * MAX_MLN_NUM + i] = k ? mtemper->dtemper[d].val[i] : CNERR;
     }
-    else {
-      mtemper->dvalid[i] = 0;
+  }
+  memset (ipol, 0, sizeof(ipol));
+
+  num = slg_ipl_series (val, IPL_MAX_LEN, maxgap, ipol);
+  if (num == 0) return (0);
+
+  /* write back filled values and refresh day statistics */
+  for (d = 0; d < 31; d++) {
+    if (mtemper->dvalid[d] == 0) continue;
+
+    k = 0;
+    for (i = 0; i < mtemper->dtemper[d].tlen; i++) {
+      if (((ipol[(d * MAX_MLN_NUM + i) / 32] >> ((d * MAX_MLN_NUM + i) % 32)) & 1) == 0) continue;
+      mtemper->dtemper[d].val[i] = val[d * MAX_MLN_NUM + i];
+      mtemper->dtemper[d].ipol[i / 32] |= (uint32_t) 1 << (i % 32);
+      k = 1;
     }
+
+    if (k) slg_dtemper_stats (&mtemper->dtemper[d], &mtemper->dstats[d]);
   }
 
-  return (0);
+  return (num);
 }
 
 
+/* outlier functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
 
+/* flags spikes and outliers of a day in quality bitmap
+ * - a value is an outlier if its deviation from the median of the SPK_WIN valid values
+ *   before and after it is larger than SPK_MINDEV and SPK_KMAD/10 times the median
+ *   absolute deviation (MAD) of these values
+ * - a value is a spike if the steps from the previous and to the next valid value are
+ *   larger than SPK_STEP in opposite direction
+ * - values are not changed, statistics functions ignore flagged values
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *
+ * return value:
+ *   number of flagged values
+ *
+ ****************************************************************************************/
+uint32_t slg_dtemper_despike (slg_dtemper *dtemper)
+{
+  return (slg_spk_series (dtemper->val, dtemper->tlen, dtemper->qflag));
+}
+
+
+/* checks if a value of a day is flagged as outlier
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *   ind     :  time index
+ *
+ * return value:
+ *         0 :  value is not flagged or index is out of range
+ *         1 :  value is flagged
+ *
+ ****************************************************************************************/
+uint32_t slg_dtemper_is_flagged (slg_dtemper *dtemper, uint32_t ind)
+{
+  if (ind >= dtemper->tlen) return (0);
+
+  return ((dtemper->qflag[ind / 32] >> (ind % 32)) & 1);
+}
+
+
+/* flags spikes and outliers of a month in quality bitmaps (see slg_dtemper_despike())
+ * - days are handled as one series, so windows reach into neighboured days
+ * - day statistics of changed days are recalculated
+ *
+ * parameters:
+ *   *mtemper:  month temperature object
+ *
+ * return value:
+ *   number of flagged values
+ *
+ ****************************************************************************************/
+uint32_t slg_mtemper_despike (slg_mtemper *mtemper)
+{
+  int32_t  val[IPL_MAX_LEN];
+  uint32_t qflag[IPL_MAX_LEN / 32 + 1];
+  uint32_t d, i, k, num;
+
+  /* month as one series (missing days and indices >= tlen are invalid) */
+  for (d = 0; d < 31; d++) {
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      k = (mtemper->dvalid[d]) && (i < mtemper->dtemper[d].tlen);
+      val[d * MAX_MLN_NUM + i] = k ? mtemper->dtemper[d].val[i] : CNERR;
+    }
+  }
+  memset (qflag, 0, sizeof(qflag));
+
+  num = slg_spk_series (val, IPL_MAX_LEN, qflag);
+  if (num == 0) return (0);
+
+  /* set flags of days and refresh day statistics */
+  for (d = 0; d < 31; d++) {
+    if (mtemper->dvalid[d] == 0) continue;
+
+    k = 0;
+    for (i = 0; i < mtemper->dtemper[d].tlen; i++) {
+      if (((qflag[(d * MAX_MLN_NUM + i) / 32] >> ((d * MAX_MLN_NUM + i) % 32)) & 1) == 0) continue;
+      mtemper->dtemper[d].qflag[i / 32] |= (uint32_t) 1 << (i % 32);
+      k = 1;
+    }
+
+    if (k) slg_dtemper_stats (&mtemper->dtemper[d], &mtemper->dstats[d]);
+  }
+
+  return (num);
+}
@@ -7,7 +7,7 @@
  * author   : Jochen Ertel
  *
  * created  : 09.01.2022
- * updated  : 30.11.2023
+ * updated  : 18.10.2026
  *
  **************************************************************************************************/
 
@@ -26,6 +26,36 @@
 /**************************************************************************************************/
 
 
+# define MRG_MIN      0    /* merge operator: lowest value */
+# define MRG_MAX      1    /* merge operator: highest value */
+# define MRG_MEDIAN   2    /* merge operator: median value (mean of both middle values if even) */
+
+# define MRG_MAX_NUM  8    /* max. number of merge input objects */
+
+# define IPL_MAX_GAP  (MAX_MLN_NUM - 1)      /* max. length of an interpolated gap (less than a day) */
+# define IPL_MAX_LEN  (31 * MAX_MLN_NUM)     /* max. length of an interpolated series (a month) */
+
+# define TMP_LOAD_DESPIKE  1   /* load option: flag spikes and outliers (see slg_dtemper_despike()) */
+# define TMP_LOAD_IPOL     2   /* load option: fill short gaps (see slg_dtemper_interpolate()) */
+
+# define SPK_WIN      4    /* half window of rolling median (values) */
+# define SPK_STEP     100  /* max. step between neighboured values (T*10), larger steps to and back
+                              from a value mark a spike */
+# define SPK_MINDEV   50   /* min. deviation from rolling median of an outlier (T*10) */
+# define SPK_KMAD     74   /* deviation limit in 1/10 MAD (5 sigma: 5 * 1.4826 * MAD) */
+
+
+/* day statistics (result of single pass statistics functions) */
+typedef struct {
+  uint32_t  count;             /* number of valid values */
+  int32_t   sum;               /* sum of all valid values */
+  int32_t   min;               /* min. value (CNERR if no valid value exists) */
+  int32_t   max;               /* max. value (CNERR if no valid value exists) */
+  uint32_t  indmin;            /* index of min. value (newest one, 0 if no valid value exists) */
+  uint32_t  indmax;            /* index of max. value (newest one, 0 if no valid value exists) */
+} slg_dstats;
+
+
 /* day temperature array */
 typedef struct {
   uint32_t  tmode;             /* time_mode */
@@ -33,6 +63,9 @@ typedef struct {
   uint32_t  last;              /* last index (last mline in related dayfile) */
   char      name[50];          /* name of temperature */
   int32_t   val[MAX_MLN_NUM];  /* temperature values */
+  uint32_t  ipol[MAX_MLN_BMW]; /* bit i: val[i] is interpolated (see slg_dtemper_interpolate()) */
+  uint32_t  qflag[MAX_MLN_BMW];/* bit i: val[i] is flagged as outlier (see slg_dtemper_despike()),
+                                  flagged values are ignored by statistics functions */
 } slg_dtemper;
 
 
@@ -40,15 +73,40 @@ typedef struct {
 typedef struct {
   uint32_t     dvalid[31];     /* 0: day does not exist, 1: day exists */
   slg_dtemper  dtemper[31];    /* array of day temper objects */
+  slg_dstats   dstats[31];     /* day statistics, filled when day objects are set */
 } slg_mtemper;
 
 
 
+/* load option functions **************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* sets load options of slg_dtemper_read() and slg_mtemper_read()
+ * - options are applied to all following reads of the program (e.g. by generators
+ *   or aggregation jobs), default is no option
+ * - spikes are flagged before gaps are filled, flagged values are no gaps
+ * - must not be called while other threads read temperatures
+ *
+ * parameters:
+ *   opts  :  bitmap of load options (TMP_LOAD_...) or 0
+ *   maxgap:  max. gap length to fill (1..IPL_MAX_GAP, only used with TMP_LOAD_IPOL)
+ *
+ * return value:
+ *         0 :  successfull
+ *         1 :  error: invalid max. gap length (options are not changed)
+ *
+ ****************************************************************************************/
+uint32_t slg_temper_setload (uint32_t opts, uint32_t maxgap);
+
+
+
 /* day related functions **************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
 
 /* read all temperature values of a column from dayfile
+ * - load options are applied (see slg_temper_setload())
  *
  * parameters:
  *   *dtemper:  day temperature object
@@ -63,6 +121,70 @@ typedef struct {
 uint32_t slg_dtemper_read (slg_dtemper *dtemper, slg_daydata *daydata, uint32_t id);
 
 
+/* calculates all statistic values of a value array in one single pass
+ * -> count, sum, min. and max. value and their indices
+ * -> finds the newest ones if there are more than one minimums or maximums
+ * -> invalid values (CNERR) are ignored, if all are invalid min. and max. are CNERR
+ *
+ * parameters:
+ *   *dstats:  resulting statistics object
+ *   *val   :  value array (e.g. temperature T*10 or rain*100)
+ *   len    :  array length
+ *
+ * return value:
+ *         0 :  valid values exist
+ *         1 :  no valid values found
+ *
+ ****************************************************************************************/
+uint32_t slg_dstats_calc (slg_dstats *dstats, int32_t *val, uint32_t len);
+
+
+/* calculates all statistic values of a value array in one single pass (see slg_dstats_calc())
+ * -> values with a set bit in mask are ignored like invalid values
+ *
+ * parameters:
+ *   *dstats:  resulting statistics object
+ *   *val   :  value array (e.g. temperature T*10 or rain*100)
+ *   len    :  array length
+ *   *mask  :  bitmap of ignored values (bit i: val[i] is ignored)
+ *
+ * return value:
+ *         0 :  valid values exist
+ *         1 :  no valid values found
+ *
+ ****************************************************************************************/
+uint32_t slg_dstats_calc_mask (slg_dstats *dstats, int32_t *val, uint32_t len, uint32_t *mask);
+
+
+/* calculates all statistic values of a day in one single pass
+ * -> count, sum, min. and max. value and their indices
+ * -> finds the newest ones if there are more than one minimums or maximums
+ * -> if all temperature values are invalid min. and max. are CNERR and indices are 0
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *   *dstats :  resulting day statistics object
+ *
+ * return value:
+ *         0 :  valid temperature values exist
+ *         1 :  no valid temperature values found
+ *
+ ****************************************************************************************/
+uint32_t slg_dtemper_stats (slg_dtemper *dtemper, slg_dstats *dstats);
+
+
+/* calculates average value from a day statistics object
+ *
+ * parameters:
+ *   *dstats:  day statistics object
+ *
+ * return value:
+ *   average :  average value (CNERR if no valid value exists)
+ *
+ ****************************************************************************************/
+int32_t slg_dstats_average (slg_dstats *dstats);
+
+
 /* check if at least one valid temperature value exist
  *
  * parameters:
@@ -131,6 +253,32 @@ int32_t slg_dtemper_average (slg_dtemper *dtemper);
 int32_t slg_dtemper_maxindayout30 (slg_dtemper *dtemper, slg_date *date);
 
 
+/* merges n temperature objects to a new one in the following way:
+ * - for each index the values of all inputs are reduced by operator (min., max. or median)
+ * - if all values of an index are valid, all of them are used
+ * - if at least one value is invalid, valid values are used only outside of their
+ *   invalid window, the result is invalid if no value is left
+ * - for two inputs and MRG_MIN this is the same as slg_dtemper_merge_2()
+ *
+ * parameters:
+ *   *dtemper  :  output day temperature object
+ *   *name     :  name of output object
+ *   op        :  merge operator (MRG_MIN, MRG_MAX, MRG_MEDIAN)
+ *   n         :  number of input objects (1..MRG_MAX_NUM)
+ *   *dtemperi :  array of input day temperature objects
+ *   *invwindb :  array of invalid temperature window begins of input objects
+ *   *invwinde :  array of invalid temperature window ends of input objects
+ *
+ * return value:
+ *          0 :  successfull
+ *          1 :  input objects are not of same format
+ *          2 :  invalid operator or number of input objects
+ *
+ ****************************************************************************************/
+uint32_t slg_dtemper_merge_n (slg_dtemper *dtemper, char *name, uint32_t op, uint32_t n,
+                              slg_dtemper *dtemperi[], uint32_t invwindb[], uint32_t invwinde[]);
+
+
 /* merges two temperature objects to a new one in the following way:
  * - for each index the lowest temperature value is taken
  * - if one value is invalid the result is invalid only if the other is in invalid window
@@ -161,6 +309,7 @@ uint32_t slg_dtemper_merge_2 (slg_dtemper *dtemper, char *name,
 /**************************************************************************************************/
 
 /* read all temperature values of an id from all valid days of a month
+ * - load options are applied to the month as one series (see slg_temper_setload())
  *
  * parameters:
  *   *mtemper  :  month temperature object
@@ -228,6 +377,29 @@ uint32_t slg_mtemper_daymax (slg_mtemper *mtemper);
 int32_t slg_mtemper_average (slg_mtemper *mtemper);
 
 
+/* merges n month temperature objects to a new one in the following way:
+ * - days are merged by slg_dtemper_merge_n(), a day is valid only if it is valid in all inputs
+ * - for two inputs and MRG_MIN this is the same as slg_mtemper_merge_2()
+ *
+ * parameters:
+ *   *mtemper  :  output month temperature object
+ *   *name     :  name of output object
+ *   op        :  merge operator (MRG_MIN, MRG_MAX, MRG_MEDIAN)
+ *   n         :  number of input objects (1..MRG_MAX_NUM)
+ *   *mtemperi :  array of input month temperature objects
+ *   *invwindb :  array of invalid temperature window begins of input objects
+ *   *invwinde :  array of invalid temperature window ends of input objects
+ *
+ * return value:
+ *          0 :  successfull
+ *          1 :  input objects are not of same format
+ *          2 :  invalid operator or number of input objects
+ *
+ ****************************************************************************************/
+uint32_t slg_mtemper_merge_n (slg_mtemper *mtemper, char *name, uint32_t op, uint32_t n,
+                              slg_mtemper *mtemperi[], uint32_t invwindb[], uint32_t invwinde[]);
+
+
 /* merges two month temperature objects to a new one in the following way:
  * - for each index the lowest temperature value is taken
  * - if one value is invalid the result is invalid only if the other is in invalid window
@@ -252,5 +424,107 @@ uint32_t slg_mtemper_merge_2 (slg_mtemper *mtemper, char *name,
                               slg_mtemper *mtemper2, uint32_t invwind2b, uint32_t invwind2e);
 
 
+/* interpolation functions ************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* fills short gaps of a day by linear interpolation
+ * - a gap is a run of invalid values with valid values on both sides, gaps longer than
+ *   maxgap values stay invalid
+ * - filled values are marked in interpolated bitmap
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *   maxgap  :  max. gap length to fill (1..IPL_MAX_GAP)
+ *
+ * return value:
+ *   CNERR :  error: invalid max. gap length
+ *   other :  number of filled values
+ *
+ ****************************************************************************************/
+uint32_t slg_dtemper_interpolate (slg_dtemper *dtemper, uint32_t maxgap);
+
+
+/* checks if a value of a day is interpolated
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *   ind     :  time index
+ *
+ * return value:
+ *         0 :  value is measured, invalid or index is out of range
+ *         1 :  value is interpolated
+ *
+ ****************************************************************************************/
+uint32_t slg_dtemper_is_ipol (slg_dtemper *dtemper, uint32_t ind);
+
+
+/* fills short gaps of a month by linear interpolation (see slg_dtemper_interpolate())
+ * - days are handled as one series, so gaps around midnight are filled too, a missing
+ *   day is never filled
+ * - day statistics of changed days are recalculated
+ *
+ * parameters:
+ *   *mtemper:  month temperature object
+ *   maxgap  :  max. gap length to fill (1..IPL_MAX_GAP)
+ *
+ * return value:
+ *   CNERR :  error: invalid max. gap length
+ *   other :  number of filled values
+ *
+ ****************************************************************************************/
+uint32_t slg_mtemper_interpolate (slg_mtemper *mtemper, uint32_t maxgap);
+
+
+/* outlier functions ******************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+
+/* flags spikes and outliers of a day in quality bitmap
+ * - a value is an outlier if its deviation from the median of the SPK_WIN valid values
+ *   before and after it is larger than SPK_MINDEV and SPK_KMAD/10 times the median
+ *   absolute deviation (MAD) of these values
+ * - a value is a spike if the steps from the previous and to the next valid value are
+ *   larger than SPK_STEP in opposite direction
+ * - values are not changed, statistics functions ignore flagged values
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *
+ * return value:
+ *   number of flagged values
+ *
+ ****************************************************************************************/
+uint32_t slg_dtemper_despike (slg_dtemper *dtemper);
+
+
+/* checks if a value of a day is flagged as outlier
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *   ind     :  time index
+ *
+ * return value:
+ *         0 :  value is not flagged or index is out of range
+ *         1 :  value is flagged
+ *
+ ****************************************************************************************/
+uint32_t slg_dtemper_is_flagged (slg_dtemper *dtemper, uint32_t ind);
+
+
+/* flags spikes and outliers of a month in quality bitmaps (see slg_dtemper_despike())
+ * - days are handled as one series, so windows reach into neighboured days
+ * - day statistics of changed days are recalculated
+ *
+ * parameters:
+ *   *mtemper:  month temperature object
+ *
+ * return value:
+ *   number of flagged values
+ *
+ ****************************************************************************************/
+uint32_t slg_mtemper_despike (slg_mtemper *mtemper);
+
+
 #endif
 
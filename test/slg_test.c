@@ -5,24 +5,48 @@
  * author   : Jochen Ertel
  *
  * created  : 07.01.2020
- * updated  : 15.01.2022
+ * updated  : 18.10.2026
  *
  **************************************************************************************************/
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
 
 #include "../lib/options.h"
 #include "../lib/slg_date.h"
 #include "../lib/slg_values.h"
 #include "../lib/slg_dayfile.h"
 #include "../lib/slg_temper.h"
+#include "../lib/slg_simd.h"
 #include "../lib/slg_rain.h"
+#include "../lib/slg_live.h"
+#include "../lib/slg_rolling.h"
+#include "../lib/slg_event.h"
+#include "../lib/slg_downsample.h"
+#include "../lib/slg_metday.h"
+#include "../lib/slg_resample.h"
+#include "../lib/slg_rollup.h"
+#include "../lib/slg_hist.h"
+#include "../lib/slg_records.h"
+#include "../lib/slg_aggr.h"
+#include "../lib/slg_normals.h"
+#include "../lib/slg_sketch.h"
+#include "../lib/slg_correl.h"
+#include "../lib/slg_cache.h"
 
 
 #define VERSION "test command line tool for slgshow library code"
 
+#define TST_SEED    4711   /* seed of random test values */
+#define TST_INVPM   100    /* invalid random values per mille */
+#define TST_RLPDAYS 101    /* days of rollup test range (01.12.2023 .. 10.03.2024) */
+#define TST_RECDAYS 90     /* days of records test range (01.01.2024 .. 30.03.2024) */
+
 
 
 /***************************************************************************************************
@@ -30,53 +54,3128 @@
  **************************************************************************************************/
 
 
-/* checks whether a year is a leap-year or not
+/* checks whether a year is a leap-year or not
+ *
+ * parameters:
+ *   year:  year to be checked
+ *
+ * return value:
+ *   0 :  year is not a leap-year
+ *   1 :  year is a leap-year
+ *
+ ****************************************************************************************/
+uint32_t slg_year_is_leap_t (uint32_t year)
+{
+  if (((year % 4) == 0) && (((year % 100) != 0) || ((year % 400) == 0))) {
+    return (1);
+  }
+  else {
+    return (0);
+  }
+}
+
+
+
+
+/* reference: increases a date by one day
+ *
+ * parameters:
+ *   *date:      pointer to date to be increased
+ *
+ * return value:
+ *   -
+ *
+ ****************************************************************************************/
+void ref_date_inc (slg_date *date)
+{
+  uint32_t dpm[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+  if (slg_year_is_leap_t(date->y)) dpm[1] = 29;
+
+  date->d += 1;
+  if (date->d > dpm[date->m -1]) {
+    date->d = 1;
+    date->m += 1;
+    if (date->m > 12) {
+      date->m = 1;
+      date->y += 1;
+    }
+  }
+}
+
+
+/* reference: calculates statistics of a value array by a simple scan
+ * (newest min. and max. values win)
+ *
+ * parameters:
+ *   *dstats:  resulting statistics object
+ *   *val   :  value array (CNERR: invalid value)
+ *   len    :  length of value array
+ *
+ ****************************************************************************************/
+void ref_dstats (slg_dstats *dstats, int32_t *val, uint32_t len)
+{
+  uint32_t i;
+
+  dstats->count = 0;
+  dstats->sum = 0;
+  dstats->min = CNERR;
+  dstats->max = CNERR;
+  dstats->indmin = 0;
+  dstats->indmax = 0;
+
+  for (i = 0; i < len; i++) {
+    if (val[i] == CNERR) continue;
+    if ((dstats->count == 0) || (val[i] <= dstats->min)) {
+      dstats->min = val[i];
+      dstats->indmin = i;
+    }
+    if ((dstats->count == 0) || (val[i] >= dstats->max)) {
+      dstats->max = val[i];
+      dstats->indmax = i;
+    }
+    dstats->sum += val[i];
+    dstats->count++;
+  }
+}
+
+
+/* compares two statistics objects
+ *
+ * return value:
+ *   0 :  equal
+ *   1 :  not equal
+ *
+ ****************************************************************************************/
+uint32_t ref_dstats_cmp (slg_dstats *a, slg_dstats *b)
+{
+  if ((a->count != b->count) || (a->sum != b->sum) || (a->min != b->min) || (a->max != b->max) ||
+      (a->indmin != b->indmin) || (a->indmax != b->indmax)) return (1);
+
+  return (0);
+}
+
+
+/* gets a random temperature value (T*10, -30.0..40.0, TST_INVPM per mille are CNERR)
+ *
+ * return value:
+ *   random value
+ *
+ ****************************************************************************************/
+int32_t ref_rand_temper (void)
+{
+  if ((rand () % 1000) < TST_INVPM) return (CNERR);
+
+  return ((rand () % 701) - 300);
+}
+
+
+/* fills a day temperature object with random values (time mode 1)
+ *
+ * parameters:
+ *   *dtemper:  resulting day temperature object
+ *
+ ****************************************************************************************/
+void ref_rand_dtemper (slg_dtemper *dtemper)
+{
+  uint32_t i;
+
+  memset (dtemper, 0, sizeof(slg_dtemper));
+  dtemper->tmode = 1;
+  dtemper->tlen = slg_timeindexnum (1);
+  dtemper->last = dtemper->tlen - 1;
+  for (i = 0; i < dtemper->tlen; i++) dtemper->val[i] = ref_rand_temper ();
+}
+
+
+/* builds a daydata object of location 1 and time mode 1 from value arrays
+ * (column 1: TEMP, column 2: RAIN, column 3: EVNT, a line is missing if all
+ *  values of the time index are CNERR)
+ *
+ * parameters:
+ *   *daydata:  resulting daydata object
+ *   *date   :  date of day
+ *   *tval   :  temperature values (T*10, CNERR: invalid)
+ *   *rval   :  rain values (rain*100, CNERR: invalid)
+ *   *eval   :  event values (0/1, CNERR: invalid)
+ *
+ ****************************************************************************************/
+void ref_daydata (slg_daydata *daydata, slg_date *date, int32_t *tval, int32_t *rval, int32_t *eval)
+{
+  uint32_t i;
+  char     sdate[20], stime[20], st[20], sr[20], se[20];
+
+  memset (daydata, 0, sizeof(slg_daydata));
+  daydata->locid = 1;
+  daydata->tmode = 1;
+  slg_date_copy (&daydata->date, date);
+  daydata->colnum = 3;
+  daydata->coltyp[0] = DF_TEMP;
+  daydata->coltyp[1] = DF_RAIN;
+  daydata->coltyp[2] = DF_EVNT;
+  for (i = 0; i < 3; i++) daydata->colid[i] = i + 1;
+  strcpy (daydata->colstr[2], "Heizung");
+
+  slg_date_to_string (sdate, date);
+  for (i = 0; i < slg_timeindexnum (1); i++) {
+    if ((tval[i] == CNERR) && (rval[i] == CNERR) && (eval[i] == CNERR)) continue;
+
+    slg_timeindex2str (stime, 1, 0, i);
+    if (tval[i] == CNERR) strcpy (st, "E");
+    else slg_temper2str (st, 0, tval[i]);
+    if (rval[i] == CNERR) strcpy (sr, "E");
+    else slg_rain2str (sr, 0, (uint32_t) rval[i]);
+    if (eval[i] == CNERR) strcpy (se, "E");
+    else sprintf (se, "%d", (int) eval[i]);
+
+    sprintf (daydata->msrline[i], "%s %s %s %s %s", sdate, stime, st, sr, se);
+  }
+}
+
+
+/* reference: finds index of min. temperature value by the scan of the former
+ * slg_dtemper_indmin() (newest one wins, 0 if all values are invalid)
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *
+ * return value:
+ *   index of min. temperature value
+ *
+ ****************************************************************************************/
+uint32_t ref_indmin (slg_dtemper *dtemper)
+{
+  uint32_t i, ind;
+  int32_t  min;
+
+  ind = 0;
+  min = CNERR;
+  for (i = 0; i < dtemper->tlen; i++) {
+    if ((dtemper->val[i] != CNERR) && (dtemper->val[i] <= min)) {
+      ind = i;
+      min = dtemper->val[i];
+    }
+  }
+
+  return (ind);
+}
+
+
+/* reference: finds index of max. temperature value by the scan of the former
+ * slg_dtemper_indmax() (newest one wins, 0 if all values are invalid)
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *
+ * return value:
+ *   index of max. temperature value
+ *
+ ****************************************************************************************/
+uint32_t ref_indmax (slg_dtemper *dtemper)
+{
+  uint32_t i, ind;
+  int32_t  max;
+
+  ind = 0;
+  max = - CNERR;
+  for (i = 0; i < dtemper->tlen; i++) {
+    if ((dtemper->val[i] != CNERR) && (dtemper->val[i] >= max)) {
+      ind = i;
+      max = dtemper->val[i];
+    }
+  }
+
+  return (ind);
+}
+
+
+/* reference: calculates average temperature by the scan of the former
+ * slg_dtemper_average()
+ *
+ * parameters:
+ *   *dtemper:  day temperature object
+ *
+ * return value:
+ *   average temperature T*10 (CNERR if all values are invalid)
+ *
+ ****************************************************************************************/
+int32_t ref_average (slg_dtemper *dtemper)
+{
+  uint32_t i;
+  int32_t  at, k;
+
+  at = 0;
+  k = 0;
+  for (i = 0; i < dtemper->tlen; i++) {
+    if (dtemper->val[i] != CNERR) {
+      at += dtemper->val[i];
+      k++;
+    }
+  }
+  if (k == 0) return (CNERR);
+
+  return (at / k);
+}
+
+
+/* reference: merges two temperature objects by the former slg_dtemper_merge_2()
+ * (lowest value, an invalid value invalidates the other one only in its invalid window)
+ *
+ * parameters:
+ *   *dtemper :  output day temperature object
+ *   *dtemper1:  input day temperature object 1
+ *   invwind1b:  invalid temperature window begin of object 1
+ *   invwind1e:  invalid temperature window end of object 1
+ *   *dtemper2:  input day temperature object 2
+ *   invwind2b:  invalid temperature window begin of object 2
+ *   invwind2e:  invalid temperature window end of object 2
+ *
+ ****************************************************************************************/
+void ref_merge_2 (slg_dtemper *dtemper, slg_dtemper *dtemper1, uint32_t invwind1b, uint32_t invwind1e,
+                  slg_dtemper *dtemper2, uint32_t invwind2b, uint32_t invwind2e)
+{
+  uint32_t i;
+
+  for (i = 0; i < dtemper1->tlen; i++) {
+    if ((dtemper1->val[i] != CNERR) && (dtemper2->val[i] != CNERR)) {
+      if (dtemper1->val[i] < dtemper2->val[i]) dtemper->val[i] = dtemper1->val[i];
+      else dtemper->val[i] = dtemper2->val[i];
+    }
+
+    if ((dtemper1->val[i] == CNERR) && (dtemper2->val[i] == CNERR)) {
+      dtemper->val[i] = CNERR;
+    }
+
+    if ((dtemper1->val[i] != CNERR) && (dtemper2->val[i] == CNERR)) {
+      if ((i >= invwind1b) && (i <= invwind1e)) dtemper->val[i] = CNERR;
+      else dtemper->val[i] = dtemper1->val[i];
+    }
+
+    if ((dtemper1->val[i] == CNERR) && (dtemper2->val[i] != CNERR)) {
+      if ((i >= invwind2b) && (i <= invwind2e)) dtemper->val[i] = CNERR;
+      else dtemper->val[i] = dtemper2->val[i];
+    }
+  }
+}
+
+
+/* reference: merges n temperature objects by a sort of the used values of each index
+ *
+ * parameters:
+ *   *val     :  resulting values (tlen of first input object)
+ *   op       :  merge operator (MRG_MIN, MRG_MAX, MRG_MEDIAN)
+ *   n        :  number of input objects
+ *   *dtemperi:  array of input day temperature objects
+ *   *invwindb:  array of invalid temperature window begins of input objects
+ *   *invwinde:  array of invalid temperature window ends of input objects
+ *
+ ****************************************************************************************/
+void ref_merge_n (int32_t *val, uint32_t op, uint32_t n, slg_dtemper *dtemperi[],
+                  uint32_t invwindb[], uint32_t invwinde[])
+{
+  uint32_t i, k, j, m, nvalid;
+  int32_t  v, srt[MRG_MAX_NUM];
+
+  for (i = 0; i < dtemperi[0]->tlen; i++) {
+    nvalid = 0;
+    for (k = 0; k < n; k++) {
+      if (dtemperi[k]->val[i] != CNERR) nvalid++;
+    }
+
+    /* insertion sort of used values */
+    m = 0;
+    for (k = 0; k < n; k++) {
+      v = dtemperi[k]->val[i];
+      if (v == CNERR) continue;
+      if ((nvalid != n) && (i >= invwindb[k]) && (i <= invwinde[k])) continue;
+
+      j = m;
+      while ((j > 0) && (srt[j-1] > v)) {
+        srt[j] = srt[j-1];
+        j--;
+      }
+      srt[j] = v;
+      m++;
+    }
+
+    val[i] = CNERR;
+    if (m == 0) continue;
+    if (op == MRG_MIN) val[i] = srt[0];
+    if (op == MRG_MAX) val[i] = srt[m-1];
+    if (op == MRG_MEDIAN) val[i] = (srt[(m-1)/2] + srt[m/2]) / 2;
+  }
+}
+
+
+/* reference: writes bytes to a file
+ *
+ * parameters:
+ *   *filename:  path/filename of file
+ *   *mode    :  fopen mode ("wb": new file, "ab": append, "r+b": overwrite in place)
+ *   *buf     :  bytes to write
+ *   len      :  number of bytes
+ *
+ ****************************************************************************************/
+void ref_write (char *filename, char *mode, char *buf, uint32_t len)
+{
+  FILE *fpw;
+
+  fpw = fopen (filename, mode);
+  if (fpw == NULL) return;
+  fwrite (buf, 1, len, fpw);
+  fclose (fpw);
+}
+
+
+/* reference: checks a live state against a full read of the complete lines of a dayfile
+ * (running statistics and current values of all columns, measurement lines)
+ *
+ * parameters:
+ *   *live:  live state object
+ *   *buf :  content of dayfile
+ *   len  :  length of content (an incomplete last line is not read)
+ *
+ * return value:
+ *   0 :  state matches
+ *   1 :  state does not match
+ *
+ ****************************************************************************************/
+uint32_t ref_live_check (slg_live *live, char *buf, uint32_t len)
+{
+  static slg_daydata daydata;
+  int32_t            val[MAX_MLN_NUM];
+  uint32_t           c, i, last, typ, id;
+  slg_dstats         dstats, rstats;
+
+  while ((len > 0) && (buf[len-1] != 0x0a)) len--;
+  ref_write ("slg_test_live.ref", "wb", buf, len);
+  if (slg_readdayfile (&daydata, "slg_test_live.ref", 0) != 0) return (1);
+
+  last = MAX_MLN_NUM;
+  for (i = 0; i < MAX_MLN_NUM; i++) {
+    if (strcmp (live->daydata.msrline[i], daydata.msrline[i]) != 0) return (1);
+    if (daydata.msrline[i][0] != 0x00) last = i;
+  }
+
+  for (c = 0; c < daydata.colnum; c++) {
+    typ = daydata.coltyp[c];
+    id = daydata.colid[c];
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      if (typ == DF_TEMP) val[i] = slg_gettemperval (&daydata, c + 2, i);
+      if (typ == DF_RAIN) val[i] = (int32_t) slg_getrainval (&daydata, c + 2, i);
+      if (typ == DF_EVNT) val[i] = (int32_t) slg_geteventval (&daydata, c + 2, i);
+    }
+    ref_dstats (&rstats, val, MAX_MLN_NUM);
+
+    if ((slg_live_dstats (live, typ, id, &dstats) != 0) || (ref_dstats_cmp (&dstats, &rstats) != 0)) return (1);
+    if (slg_live_current (live, typ, id) != ((last == MAX_MLN_NUM) ? CNERR : val[last])) return (1);
+  }
+
+  return (0);
+}
+
+
+/* reference: resamples a local day by a scan of the slots of day before and day
+ * (slot i starts at i*15 MEZ, local time is MEZ + 1 h in summertime)
+ *
+ * parameters:
+ *   *vprev :  slot values of day before (CNERR: invalid, NULL: missing)
+ *   sprev  :  0: day before is normal time, 1: summertime
+ *   *vcur  :  slot values of day (CNERR: invalid, NULL: missing)
+ *   scur   :  0: day is normal time, 1: summertime
+ *   blen   :  bucket length in minutes
+ *   op     :  resample operator (RSM_...)
+ *   *out   :  resulting bucket values (CNERR: no valid value in bucket)
+ *
+ * return value:
+ *   number of buckets with valid values
+ *
+ ****************************************************************************************/
+uint32_t ref_resample (int32_t *vprev, uint32_t sprev, int32_t *vcur, uint32_t scur, uint32_t blen,
+                       uint32_t op, int32_t *out)
+{
+  int32_t    val[2 * MAX_MLN_NUM];
+  uint32_t   b, i, n, num;
+  int32_t    m;
+  slg_dstats dstats;
+
+  num = 0;
+  for (b = 0; b < 1440 / blen; b++) {
+    n = 0;
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      m = (int32_t) (i * 15 + sprev * 60) - 1440;
+      if ((vprev != NULL) && (m >= 0) && ((uint32_t) m / blen == b)) val[n++] = vprev[i];
+    }
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      m = (int32_t) (i * 15 + scur * 60);
+      if ((vcur != NULL) && (m < 1440) && ((uint32_t) m / blen == b)) val[n++] = vcur[i];
+    }
+
+    ref_dstats (&dstats, val, n);
+    out[b] = CNERR;
+    if (dstats.count == 0) continue;
+
+    if (op == RSM_MEAN) out[b] = dstats.sum / (int32_t) dstats.count;
+    if (op == RSM_MIN)  out[b] = dstats.min;
+    if (op == RSM_MAX)  out[b] = dstats.max;
+    if (op == RSM_SUM)  out[b] = dstats.sum;
+    if (op == RSM_LAST) {
+      for (i = 0; i < n; i++) {
+        if (val[i] != CNERR) out[b] = val[i];
+      }
+    }
+    num++;
+  }
+
+  return (num);
+}
+
+
+/* reference: checks a rollup column summary against the values of consecutive days
+ * (min., max. and their positions by slg_dstats_calc() over all values, day types and
+ *  overflow days counted per day, days without valid values are not counted)
+ *
+ * parameters:
+ *   *rsum:  column summary to be checked
+ *   *val :  values of days (MAX_MLN_NUM per day, CNERR: invalid value)
+ *   dnum :  number of days
+ *   doy0 :  day of year of first day
+ *   typ  :  column type
+ *
+ * return value:
+ *   0 :  equal
+ *   1 :  not equal
+ *
+ ****************************************************************************************/
+uint32_t ref_rlpsum_check (slg_rlpsum *rsum, int32_t *val, uint32_t dnum, uint32_t doy0, uint32_t typ)
+{
+  uint32_t   d, i, k, novfl, dtype;
+  uint32_t   ntype[CLM_NUM];
+  slg_dstats dstats;
+
+  memset (ntype, 0, sizeof(ntype));
+  novfl = 0;
+  for (d = 0; d < dnum; d++) {
+    slg_dstats_calc (&dstats, &val[d * MAX_MLN_NUM], MAX_MLN_NUM);
+    dtype = slg_climate_daytype (typ, &dstats);
+    for (k = 0; k < CLM_NUM; k++) ntype[k] += (dtype >> k) & 1;
+
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      if ((val[d * MAX_MLN_NUM + i] != CNERR) && (val[d * MAX_MLN_NUM + i] > INT16_MAX)) break;
+    }
+    if (i < MAX_MLN_NUM) novfl++;
+  }
+
+  slg_dstats_calc (&dstats, val, dnum * MAX_MLN_NUM);
+
+  if ((rsum->count != dstats.count) || (rsum->sum != (int64_t) dstats.sum)) return (1);
+  if (rsum->novfl != novfl) return (1);
+  for (k = 0; k < CLM_NUM; k++) {
+    if (rsum->ntype[k] != ntype[k]) return (1);
+  }
+  if (dstats.count == 0) return (0);
+
+  if ((rsum->min != dstats.min) || (rsum->dmin != doy0 + dstats.indmin / MAX_MLN_NUM) ||
+      (rsum->imin != dstats.indmin % MAX_MLN_NUM)) return (1);
+  if ((rsum->max != dstats.max) || (rsum->dmax != doy0 + dstats.indmax / MAX_MLN_NUM) ||
+      (rsum->imax != dstats.indmax % MAX_MLN_NUM)) return (1);
+
+  return (0);
+}
+
+
+/* reference: checks day, month and year entries, slot values and slot statistics of
+ * random windows of a rollup index against the values of a range of days (columns
+ * of ref_daydata(), days of month or year out of range must be invalid)
+ *
+ * parameters:
+ *   *rollup :  rollup object
+ *   *pathname: path name of dayfiles (incl. '/')
+ *   *date0  :  first date of range
+ *   dnum    :  number of days of range
+ *   *val[]  :  values of the 3 columns (MAX_MLN_NUM per day, CNERR: invalid value)
+ *   *exist  :  1: dayfile of day exists, 0: missing
+ *
+ * return value:
+ *   0 :  equal
+ *   1 :  not equal
+ *
+ ****************************************************************************************/
+uint32_t ref_rollup_check (slg_rollup *rollup, char *pathname, slg_date *date0, uint32_t dnum,
+                           int32_t *val[], uint32_t *exist)
+{
+  uint32_t    d, c, i, n, ib, ie, doy, ms, ys, res, err;
+  uint32_t    typ[3] = {DF_TEMP, DF_RAIN, DF_EVNT};
+  int32_t     sval[MAX_MLN_NUM];
+  slg_date    date, date2, jan1;
+  slg_rlpent  *rent;
+  slg_dstats  dstats, rdstats;
+  struct stat st;
+  char        fname[300], temp[20];
+
+  err = 0;
+  ms = 0;
+  ys = 0;
+  slg_date_copy (&date, date0);
+  for (d = 0; d < dnum; d++) {
+    slg_date_set_int (&jan1, 1, 1, date.y);
+    doy = (uint32_t) slg_date_sub (&date, &jan1);
+
+    /* day entry, slot values and slot statistics */
+    rent = slg_rollup_day (rollup, &date);
+    if (rent == NULL) return (1);
+    if (exist[d] == 0) {
+      if (rent->valid != 0) err = 1;
+    }
+    else {
+      strcpy (fname, pathname);
+      slg_date_to_fstring (temp, &date);
+      strcat (fname, temp);
+      strcat (fname, ".txt");
+      if ((stat (fname, &st) != 0) || (rent->mtime != (int64_t) st.st_mtime) ||
+          (rent->fsize != (uint32_t) st.st_size) || (rent->valid != 1)) err = 1;
+
+      for (c = 0; c < 3; c++) {
+        if (ref_rlpsum_check (&rent->col[c], &val[c][d * MAX_MLN_NUM], 1, doy, typ[c]) != 0) err = 1;
+
+        ib = rand () % MAX_MLN_NUM;
+        ie = ib + rand () % (MAX_MLN_NUM - ib);
+        res = slg_rollup_slotstats (rollup, &date, c, ib, ie, &dstats);
+        if (rent->col[c].novfl) {
+          if ((res != 3) || (slg_rollup_slots (rollup, &date, c, sval) != 3)) err = 1;
+          continue;
+        }
+
+        if (slg_rollup_slots (rollup, &date, c, sval) != 0) err = 1;
+        if (memcmp (sval, &val[c][d * MAX_MLN_NUM], sizeof(sval)) != 0) err = 1;
+
+        slg_dstats_calc (&rdstats, &val[c][d * MAX_MLN_NUM + ib], ie - ib + 1);
+        if (rdstats.count == 0) {
+          if (res != 4) err = 1;
+        }
+        else {
+          rdstats.indmin += ib;
+          rdstats.indmax += ib;
+          if ((res != 0) || (ref_dstats_cmp (&dstats, &rdstats) != 0)) err = 1;
+        }
+      }
+    }
+
+    slg_date_copy (&date2, &date);
+    slg_date_inc (&date);
+
+    /* month entry at end of month or range */
+    if ((d == dnum - 1) || (date.m != date2.m)) {
+      rent = slg_rollup_month (rollup, date2.y, date2.m);
+      if (rent == NULL) return (1);
+      n = 0;
+      for (i = ms; i <= d; i++) n += exist[i];
+      if (rent->valid != n) err = 1;
+      for (c = 0; c < 3; c++) {
+        if (ref_rlpsum_check (&rent->col[c], &val[c][ms * MAX_MLN_NUM], d - ms + 1, doy - (d - ms),
+                              typ[c]) != 0) err = 1;
+      }
+      ms = d + 1;
+    }
+
+    /* year entry at end of year or range */
+    if ((d == dnum - 1) || (date.y != date2.y)) {
+      rent = slg_rollup_year (rollup, date2.y);
+      if (rent == NULL) return (1);
+      n = 0;
+      for (i = ys; i <= d; i++) n += exist[i];
+      if (rent->valid != n) err = 1;
+      for (c = 0; c < 3; c++) {
+        if (ref_rlpsum_check (&rent->col[c], &val[c][ys * MAX_MLN_NUM], d - ys + 1, doy - (d - ys),
+                              typ[c]) != 0) err = 1;
+      }
+      ys = d + 1;
+    }
+  }
+
+  return (err);
+}
+
+
+/* reference: fills gaps of a series of at most maxgap values between two valid values
+ * (linear interpolation in double, rounded half away from zero)
+ *
+ * parameters:
+ *   *val  :  value array (CNERR: invalid value)
+ *   *out  :  resulting value array (copy of val with filled gaps)
+ *   len   :  array length
+ *   maxgap:  max. gap length to fill
+ *   *ipol :  resulting bitmap of filled values (cleared before)
+ *
+ * return value:
+ *   number of filled values
+ *
+ ****************************************************************************************/
+uint32_t ref_interpolate (int32_t *val, int32_t *out, uint32_t len, uint32_t maxgap, uint32_t *ipol)
+{
+  uint32_t i, p, n, num;
+  double   d;
+
+  memset (ipol, 0, ((len + 31) / 32) * sizeof(uint32_t));
+  num = 0;
+  for (i = 0; i < len; i++) {
+    out[i] = val[i];
+    if (val[i] != CNERR) continue;
+
+    /* gap p..n-1, valid values at p-1 and n */
+    for (p = i; (p > 0) && (val[p-1] == CNERR); p--);
+    for (n = i; (n < len) && (val[n] == CNERR); n++);
+    if ((p == 0) || (n == len) || (n - p > maxgap)) continue;
+
+    d = (double) (val[n] - val[p-1]) * (double) (i - p + 1) / (double) (n - p + 1);
+    d = (d >= 0.0) ? floor (d + 0.5) : - floor (- d + 0.5);
+    out[i] = val[p-1] + (int32_t) d;
+    ipol[i / 32] |= (uint32_t) 1 << (i % 32);
+    num++;
+  }
+
+  return (num);
+}
+
+
+/* compares two int32 values (qsort() callback, ascending order)
+ *
+ * return value:
+ *   -1, 0, 1 :  a < b, a == b, a > b
+ *
+ ****************************************************************************************/
+int ref_cmp_int32 (const void *a, const void *b)
+{
+  if (*(const int32_t *) a < *(const int32_t *) b) return (-1);
+  if (*(const int32_t *) a > *(const int32_t *) b) return (1);
+
+  return (0);
+}
+
+
+/* prints result of a check
+ *
+ * parameters:
+ *   *name:  name of check
+ *   err  :  0: passed, other: failed
+ *
+ * return value:
+ *   err
+ *
+ ****************************************************************************************/
+uint32_t ref_result (char *name, uint32_t err)
+{
+  if (err == 0) printf ("%s: OK\n", name);
+  else printf ("%s: FEHLER!\n", name);
+
+  return (err);
+}
+
+
+
+
+/***************************************************************************************************
+ * test functions
+ **************************************************************************************************/
+
+/* checks single pass day statistics against the scans of the former min., max. and
+ * average functions (random days, ties, days with a few or no valid values)
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_dtemper_stats (void)
+{
+  slg_dtemper dtemper;
+  slg_dstats  dstats, rstats;
+  uint32_t    d, i, k, res, err;
+
+  err = 0;
+
+  for (d = 0; d < 1000; d++) {
+    ref_rand_dtemper (&dtemper);
+    k = d % 10;
+    for (i = 0; i < dtemper.tlen; i++) {
+      if (k == 1) dtemper.val[i] = (rand () % 3) - 1;           /* many ties */
+      if ((k == 2) && ((rand () % 20) != 0)) dtemper.val[i] = CNERR;
+      if (k == 3) dtemper.val[i] = CNERR;                       /* no valid value */
+    }
+    if (k == 4) dtemper.tlen = 1 + rand () % dtemper.tlen;
+
+    res = slg_dtemper_stats (&dtemper, &dstats);
+    if (res != ((ref_average (&dtemper) == CNERR) ? 1 : 0)) err = 1;
+    if ((dstats.indmin != ref_indmin (&dtemper)) || (dstats.indmax != ref_indmax (&dtemper))) err = 1;
+    if (slg_dstats_average (&dstats) != ref_average (&dtemper)) err = 1;
+    if ((res == 0) && ((dstats.min != dtemper.val[dstats.indmin]) ||
+                       (dstats.max != dtemper.val[dstats.indmax]))) err = 1;
+    if ((res == 1) && ((dstats.min != CNERR) || (dstats.max != CNERR) || (dstats.count != 0))) err = 1;
+
+    ref_dstats (&rstats, dtemper.val, dtemper.tlen);
+    if (ref_dstats_cmp (&dstats, &rstats) != 0) err = 1;
+
+    /* wrappers */
+    if ((slg_dtemper_indmin (&dtemper) != dstats.indmin) || (slg_dtemper_indmax (&dtemper) != dstats.indmax) ||
+        (slg_dtemper_average (&dtemper) != ref_average (&dtemper)) ||
+        (slg_dtemper_checkvalid (&dtemper) != (int32_t) res)) err = 1;
+  }
+
+  return (ref_result ("slg_dtemper_stats", err));
+}
+
+
+/* checks n-way merge of random days: two inputs against the former slg_dtemper_merge_2()
+ * (max. by negated values), up to MRG_MAX_NUM inputs against a sort of each index
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_merge (void)
+{
+  static slg_dtemper dtemper[MRG_MAX_NUM], neg[2];
+  slg_dtemper        out, rout, *dtemperi[MRG_MAX_NUM];
+  uint32_t           invwindb[MRG_MAX_NUM], invwinde[MRG_MAX_NUM];
+  int32_t            rval[MAX_MLN_NUM];
+  uint32_t           r, n, k, i, op, err;
+
+  err = 0;
+
+  for (r = 0; r < 200; r++) {
+    for (k = 0; k < MRG_MAX_NUM; k++) {
+      ref_rand_dtemper (&dtemper[k]);
+      dtemperi[k] = &dtemper[k];
+      invwindb[k] = rand () % MAX_MLN_NUM;
+      invwinde[k] = invwindb[k] + rand () % 24;
+      if ((r % 4) == 0) {
+        for (i = 0; i < MAX_MLN_NUM; i++) dtemper[k].val[i] = (dtemper[k].val[i] == CNERR) ? CNERR : rand () % 3;
+      }
+    }
+
+    /* two inputs: min. as former merge_2, max. as negated min. */
+    ref_merge_2 (&rout, &dtemper[0], invwindb[0], invwinde[0], &dtemper[1], invwindb[1], invwinde[1]);
+    if (slg_dtemper_merge_n (&out, "merge", MRG_MIN, 2, dtemperi, invwindb, invwinde) != 0) err = 1;
+    if (memcmp (out.val, rout.val, MAX_MLN_NUM * sizeof(int32_t)) != 0) err = 1;
+    if (slg_dtemper_merge_2 (&out, "merge", &dtemper[0], invwindb[0], invwinde[0],
+                             &dtemper[1], invwindb[1], invwinde[1]) != 0) err = 1;
+    if (memcmp (out.val, rout.val, MAX_MLN_NUM * sizeof(int32_t)) != 0) err = 1;
+
+    for (k = 0; k < 2; k++) {
+      neg[k] = dtemper[k];
+      for (i = 0; i < MAX_MLN_NUM; i++) {
+        if (neg[k].val[i] != CNERR) neg[k].val[i] = - neg[k].val[i];
+      }
+    }
+    ref_merge_2 (&rout, &neg[0], invwindb[0], invwinde[0], &neg[1], invwindb[1], invwinde[1]);
+    slg_dtemper_merge_n (&out, "merge", MRG_MAX, 2, dtemperi, invwindb, invwinde);
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      if (out.val[i] != ((rout.val[i] == CNERR) ? CNERR : - rout.val[i])) err = 1;
+    }
+
+    /* n inputs: all operators */
+    for (n = 1; n <= MRG_MAX_NUM; n++) {
+      for (op = MRG_MIN; op <= MRG_MEDIAN; op++) {
+        if (slg_dtemper_merge_n (&out, "merge", op, n, dtemperi, invwindb, invwinde) != 0) err = 1;
+        ref_merge_n (rval, op, n, dtemperi, invwindb, invwinde);
+        if ((out.tlen != MAX_MLN_NUM) || (memcmp (out.val, rval, MAX_MLN_NUM * sizeof(int32_t)) != 0)) err = 1;
+      }
+    }
+  }
+
+  /* invalid operator, number of inputs and format */
+  if (slg_dtemper_merge_n (&out, "merge", MRG_MEDIAN + 1, 2, dtemperi, invwindb, invwinde) != 2) err = 1;
+  if (slg_dtemper_merge_n (&out, "merge", MRG_MIN, 0, dtemperi, invwindb, invwinde) != 2) err = 1;
+  if (slg_dtemper_merge_n (&out, "merge", MRG_MIN, MRG_MAX_NUM + 1, dtemperi, invwindb, invwinde) != 2) err = 1;
+  dtemper[1].tlen--;
+  if (slg_dtemper_merge_n (&out, "merge", MRG_MIN, 2, dtemperi, invwindb, invwinde) != 1) err = 1;
+
+  return (ref_result ("slg_dtemper_merge_n", err));
+}
+
+
+/* checks rolling windows against a scan of the window after each push
+ * (window lengths 1 slot .. 7 days, series across day boundaries, missing days of months)
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_rolling (void)
+{
+  static int32_t     val[3000];
+  static slg_rolling rolling;
+  static slg_mtemper mtemper;
+  uint32_t           wlen[5] = {1, 5, 96, 97, RLW_MAX_LEN};
+  uint32_t           w, i, d, first, err;
+  slg_dstats         dstats, rstats;
+
+  err = 0;
+  for (i = 0; i < 3000; i++) val[i] = ref_rand_temper ();
+  for (i = 500; i < 700; i++) val[i] = CNERR;  /* window with invalid values only */
+
+  for (w = 0; w < 5; w++) {
+    if (slg_rolling_init (&rolling, wlen[w]) != 0) err = 1;
+
+    for (i = 0; i < 3000; i++) {
+      slg_rolling_push (&rolling, val[i]);
+      first = (i + 1 > wlen[w]) ? i + 1 - wlen[w] : 0;
+
+      ref_dstats (&rstats, &val[first], i + 1 - first);
+      if (slg_rolling_stats (&rolling, &dstats) != ((rstats.count == 0) ? 1 : 0)) err = 1;
+      if (ref_dstats_cmp (&dstats, &rstats) != 0) err = 1;
+    }
+  }
+
+  if (slg_rolling_init (&rolling, 0) == 0) err = 1;
+  if (slg_rolling_init (&rolling, RLW_MAX_LEN + 1) == 0) err = 1;
+
+  /* month with missing days: window of 2 days covers a missing day and day 31 */
+  memset (&mtemper, 0, sizeof(slg_mtemper));
+  for (d = 0; d < 31; d++) {
+    ref_rand_dtemper (&mtemper.dtemper[d]);
+    mtemper.dvalid[d] = ((d == 29) || (d == 5)) ? 0 : 1;
+  }
+
+  slg_rolling_init (&rolling, 2 * MAX_MLN_NUM);
+  slg_rolling_mtemper (&rolling, &mtemper, 31);
+  if (rolling.pos != 31 * MAX_MLN_NUM) err = 1;
+
+  for (i = 0; i < MAX_MLN_NUM; i++) val[i] = CNERR;
+  for (i = 0; i < MAX_MLN_NUM; i++) val[MAX_MLN_NUM + i] = mtemper.dtemper[30].val[i];
+  ref_dstats (&rstats, val, 2 * MAX_MLN_NUM);
+  slg_rolling_stats (&rolling, &dstats);
+  if (ref_dstats_cmp (&dstats, &rstats) != 0) err = 1;
+
+  return (ref_result ("slg_rolling", err));
+}
+
+
+/* checks prefix sum rain series of a random year (dry days, wet days and missing days)
+ * against scans of slots and days
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_rainps (void)
+{
+  static slg_rainps rainps;
+  static slg_drain  drain;
+  static uint32_t   val[RPS_MAX_LEN];
+  uint32_t          dsum[RPS_MAX_DAYS];
+  uint32_t          wlen[6] = {RPS_W1H, RPS_W3H, RPS_W6H, 1, MAX_MLN_NUM, 500};
+  uint32_t          w, d, i, k, n, ib, ie, sum, max, imax, ind, res, err;
+  uint32_t          spell, spellen, nspells[3], maxlen[3], maxend[3];
+
+  err = 0;
+  slg_rainps_init (&rainps);
+  n = 0;
+
+  /* random year: rainy or dry days, invalid values and missing days */
+  for (d = 0; d < RPS_MAX_DAYS; d++) {
+    memset (&drain, 0, sizeof(slg_drain));
+    drain.tmode = 1;
+    drain.tlen = slg_timeindexnum (1);
+    k = rand () % 3;
+    for (i = 0; i < drain.tlen; i++) {
+      drain.val[i] = ((k == 0) && ((rand () % 4) == 0)) ? rand () % 50 : 0;
+      if ((rand () % 1000) < TST_INVPM) drain.val[i] = CNERR;
+      if ((k == 1) && ((d % 5) == 0)) drain.val[i] = CNERR;      /* no valid value */
+    }
+
+    dsum[d] = CNERR;
+    if ((d % 17) == 3) {
+      res = slg_rainps_add (&rainps, NULL);
+    }
+    else {
+      res = slg_rainps_add (&rainps, &drain);
+    }
+    if (res != 0) err = 1;
+
+    sum = 0;
+    k = 0;
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      val[n] = 0;
+      if (((d % 17) != 3) && (drain.val[i] != CNERR)) {
+        val[n] = drain.val[i];
+        k++;
+      }
+      sum += val[n];
+      n++;
+    }
+    if (k != 0) dsum[d] = sum;
+  }
+  if (slg_rainps_add (&rainps, &drain) != 1) err = 1;
+  if ((rainps.dnum != RPS_MAX_DAYS) || (memcmp (rainps.dsum, dsum, sizeof(dsum)) != 0)) err = 1;
+
+  /* max. window sums (newest window wins) */
+  for (w = 0; w < 6; w++) {
+    max = 0;
+    imax = 0;
+    for (ie = wlen[w] - 1; ie < n; ie++) {
+      sum = 0;
+      for (i = ie + 1 - wlen[w]; i <= ie; i++) sum += val[i];
+      if (sum >= max) {
+        max = sum;
+        imax = ie;
+      }
+    }
+    if ((slg_rainps_maxsum (&rainps, wlen[w], &ind) != max) || (ind != imax)) err = 1;
+    if ((w == 0) && ((rainps.max1h != max) || (rainps.imax1h != imax))) err = 1;
+    if ((w == 1) && ((rainps.max3h != max) || (rainps.imax3h != imax))) err = 1;
+    if ((w == 2) && ((rainps.max6h != max) || (rainps.imax6h != imax))) err = 1;
+  }
+  if (slg_rainps_maxsum (&rainps, 0, &ind) != CNERR) err = 1;
+  if (slg_rainps_maxsum (&rainps, n + 1, &ind) != CNERR) err = 1;
+
+  /* random intervals */
+  for (k = 0; k < 1000; k++) {
+    ib = rand () % n;
+    ie = ib + rand () % 2000;
+    if (ie >= n) ie = n - 1;
+    sum = 0;
+    for (i = ib; i <= ie; i++) sum += val[i];
+    if (slg_rainps_sum (&rainps, ib, ie) != sum) err = 1;
+  }
+  if (slg_rainps_sum (&rainps, 10, 9) != CNERR) err = 1;
+  if (slg_rainps_sum (&rainps, 0, n) != CNERR) err = 1;
+
+  /* spells (days without valid value end a spell, newest longest spell wins) */
+  spell = 0;
+  spellen = 0;
+  for (k = 0; k < 3; k++) {
+    nspells[k] = 0;
+    maxlen[k] = 0;
+    maxend[k] = 0;
+  }
+  for (d = 0; d < RPS_MAX_DAYS; d++) {
+    k = 0;
+    if (dsum[d] != CNERR) k = (dsum[d] >= RPS_WETDAY) ? 1 : 2;
+    if (k != spell) {
+      nspells[k]++;
+      spellen = 0;
+      spell = k;
+    }
+    spellen++;
+    if (spellen >= maxlen[k]) {
+      maxlen[k] = spellen;
+      maxend[k] = d;
+    }
+  }
+  if ((rainps.wetspells != nspells[1]) || (rainps.wetmax != maxlen[1]) || (rainps.wetmaxend != maxend[1]) ||
+      (rainps.dryspells != nspells[2]) || (rainps.drymax != maxlen[2]) || (rainps.drymaxend != maxend[2])) err = 1;
+  if ((nspells[1] < 5) || (nspells[2] < 5)) err = 1;
+
+  /* spells of same length: dry, dry, wet, wet, missing, dry, dry, wet, wet */
+  slg_rainps_init (&rainps);
+  for (d = 0; d < 9; d++) {
+    for (i = 0; i < drain.tlen; i++) drain.val[i] = ((d % 5 == 2) || (d % 5 == 3)) ? 1 : 0;
+    slg_rainps_add (&rainps, (d == 4) ? NULL : &drain);
+  }
+  if ((rainps.wetspells != 2) || (rainps.wetmax != 2) || (rainps.wetmaxend != 8) ||
+      (rainps.dryspells != 2) || (rainps.drymax != 2) || (rainps.drymaxend != 6)) err = 1;
+
+  return (ref_result ("slg_rainps", err));
+}
+
+
+/* checks event bitmaps of random days against the event values of the dayfile lines
+ * (values, on time, switches, intervals, aggregation and merging of aggregations)
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_event (void)
+{
+  static slg_daydata daydata;
+  int32_t            tval[MAX_MLN_NUM], rval[MAX_MLN_NUM], eval[20][MAX_MLN_NUM];
+  uint32_t           d, i, k, n, err, ontime, validtime, swon, any, all;
+  slg_date           date;
+  slg_devent         devent[20];
+  slg_evtrun         evtrun[MAX_MLN_NUM];
+  slg_evtagg         agg, agga, aggb;
+
+  err = 0;
+  slg_date_set_int (&date, 1, 3, 2024);
+  slg_evtagg_init (&agg);
+  slg_evtagg_init (&agga);
+  slg_evtagg_init (&aggb);
+  ontime = 0;
+  validtime = 0;
+  swon = 0;
+
+  for (d = 0; d < 20; d++) {
+    /* random on/off phases with invalid values and missing lines at the end */
+    k = (uint32_t) (rand () % 2);
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      if ((rand () % 10) == 0) k = 1 - k;
+      eval[d][i] = ((rand () % 1000) < TST_INVPM) ? CNERR : (int32_t) k;
+      tval[i] = (i < 90 - d) ? 0 : CNERR;
+      rval[i] = tval[i];
+      if (tval[i] == CNERR) eval[d][i] = CNERR;
+    }
+
+    ref_daydata (&daydata, &date, tval, rval, eval[d]);
+    if (slg_devent_read (&devent[d], &daydata, 1) == 0) err = 1;
+    if (slg_devent_read (&devent[d], &daydata, 3) != 0) err = 1;
+    if (devent[d].last != 89 - d) err = 1;
+
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      if (slg_devent_get (&devent[d], i) != (uint32_t) eval[d][i]) err = 1;
+      if (eval[d][i] != CNERR) {
+        validtime++;
+        ontime += (uint32_t) eval[d][i];
+        if ((i > 0) && (eval[d][i-1] == 0) && (eval[d][i] == 1)) swon++;
+      }
+    }
+    if (slg_devent_get (&devent[d], MAX_MLN_NUM) != CNERR) err = 1;
+
+    /* intervals: cover the day without gaps, states match and neighbours differ */
+    n = slg_devent_runs (&devent[d], evtrun, MAX_MLN_NUM);
+    if ((n == 0) || (evtrun[0].ib != 0) || (evtrun[n-1].ie != MAX_MLN_NUM - 1)) err = 1;
+    for (k = 0; k < n; k++) {
+      if ((k > 0) && ((evtrun[k].ib != evtrun[k-1].ie + 1) || (evtrun[k].state == evtrun[k-1].state))) err = 1;
+      for (i = evtrun[k].ib; i <= evtrun[k].ie; i++) {
+        if (evtrun[k].state != ((eval[d][i] == CNERR) ? EVT_INV : (uint32_t) eval[d][i])) err = 1;
+      }
+    }
+    if (slg_devent_runs (&devent[d], evtrun, 1) != 1) err = 1;
+
+    slg_evtagg_add_day (&agg, &devent[d]);
+    if (d < 7) slg_evtagg_add_day (&agga, &devent[d]);
+    else slg_evtagg_add_day (&aggb, &devent[d]);
+    slg_date_inc (&date);
+  }
+
+  slg_evtagg_merge (&agga, &aggb);
+
+  if ((agg.dnum != 20) || (agg.ontime != ontime) || (agg.validtime != validtime) || (agg.swon != swon)) err = 1;
+  for (i = 0; i < MAX_MLN_NUM; i++) {
+    any = 0;
+    all = 1;
+    for (d = 0; d < 20; d++) {
+      if (eval[d][i] == 1) any = 1;
+      else all = 0;
+    }
+    if ((((agg.anyon[i / 32] >> (i % 32)) & 1) != any) || (((agg.allon[i / 32] >> (i % 32)) & 1) != all)) err = 1;
+  }
+  if (memcmp (&agg, &agga, sizeof(slg_evtagg)) != 0) err = 1;
+
+  return (ref_result ("slg_event", err));
+}
+
+
+/* checks downsampling of a year series (96 slots per day) against scans of the buckets
+ * (envelope, min./max. points) and against triangle areas in floating point (LTTB)
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_downsample (void)
+{
+  static int32_t    val[366 * MAX_MLN_NUM], emin[700], emax[700];
+  static slg_dpoint pt[1400];
+  uint32_t          bnum[4] = {1, 7, 620, 700};
+  uint32_t          len, t, b, i, k, ib, ie, num, nval, nb;
+  uint32_t          *ind, err;
+  double            ax, ay, sx, sy, area, amax, asel;
+  slg_dstats        rstats;
+
+  err = 0;
+  len = 366 * MAX_MLN_NUM;
+  for (i = 0; i < len; i++) val[i] = ref_rand_temper ();
+  for (i = 1000; i < 2000; i++) val[i] = CNERR;  /* buckets without valid values */
+
+  /* envelope and min./max. points */
+  for (t = 0; t < 4; t++) {
+    if (slg_downsample_envelope (val, len, bnum[t], emin, emax) == CNERR) err = 1;
+    num = slg_downsample_minmax (val, len, bnum[t], pt);
+    if (num == CNERR) err = 1;
+
+    k = 0;
+    for (b = 0; b < bnum[t]; b++) {
+      ib = (uint32_t) (((uint64_t) len * b) / bnum[t]);
+      ie = (uint32_t) (((uint64_t) len * (b + 1)) / bnum[t]);
+      ref_dstats (&rstats, &val[ib], ie - ib);
+      if ((emin[b] != rstats.min) || (emax[b] != rstats.max)) err = 1;
+      if (rstats.count == 0) continue;
+
+      /* points of bucket: min. and max. point in order of index */
+      if ((k >= num) || (pt[k].x != ib + ((rstats.indmin < rstats.indmax) ? rstats.indmin : rstats.indmax))) err = 1;
+      if ((k < num) && (pt[k].y != val[pt[k].x])) err = 1;
+      k++;
+      if (rstats.indmin != rstats.indmax) {
+        if ((k >= num) || (pt[k].x != ib + ((rstats.indmin > rstats.indmax) ? rstats.indmin : rstats.indmax))) err = 1;
+        if ((k < num) && (pt[k].y != val[pt[k].x])) err = 1;
+        k++;
+      }
+    }
+    if (k != num) err = 1;
+  }
+
+  if (slg_downsample_envelope (val, len, 0, emin, emax) != CNERR) err = 1;
+  if (slg_downsample_minmax (val, 5, 6, pt) != CNERR) err = 1;
+
+  /* LTTB: first and last valid value, largest triangle of each bucket */
+  ind = (uint32_t *) malloc (len * sizeof(uint32_t));
+  if (ind == NULL) return (ref_result ("slg_downsample", 1));
+  nval = 0;
+  for (i = 0; i < len; i++) {
+    if (val[i] != CNERR) ind[nval++] = i;
+  }
+
+  for (t = 1; t < 4; t++) {
+    num = slg_downsample_lttb (val, len, bnum[t], pt);
+    if (num != bnum[t]) {
+      err = 1;
+      continue;
+    }
+    if ((pt[0].x != ind[0]) || (pt[num-1].x != ind[nval-1])) err = 1;
+
+    nb = bnum[t] - 2;
+    for (b = 0; b < nb; b++) {
+      ib = 1 + (uint32_t) (((uint64_t) (nval - 2) * b) / nb);
+      ie = 1 + (uint32_t) (((uint64_t) (nval - 2) * (b + 1)) / nb);
+      k = (b + 1 < nb) ? 1 + (uint32_t) (((uint64_t) (nval - 2) * (b + 2)) / nb) : nval;
+
+      sx = 0.0;
+      sy = 0.0;
+      for (i = ie; i < k; i++) {
+        sx += (double) ind[i];
+        sy += (double) val[ind[i]];
+      }
+      sx /= (double) (k - ie);
+      sy /= (double) (k - ie);
+
+      ax = (double) pt[b].x;
+      ay = (double) pt[b].y;
+      amax = 0.0;
+      asel = -1.0;
+      for (i = ib; i < ie; i++) {
+        area = fabs ((ax - sx) * ((double) val[ind[i]] - ay) - (ax - (double) ind[i]) * (sy - ay));
+        if (area > amax) amax = area;
+        if (ind[i] == pt[b+1].x) asel = area;
+      }
+      if ((pt[b+1].y != val[pt[b+1].x]) || (asel < amax * (1.0 - 1e-9))) err = 1;
+    }
+  }
+
+  free (ind);
+
+  /* series with not more valid values than points: all valid values */
+  k = 0;
+  for (i = 0; i < 10; i++) {
+    if (val[i] != CNERR) k++;
+  }
+  if (slg_downsample_lttb (val, 10, 10, pt) != k) err = 1;
+  if (slg_downsample_lttb (val, len, 2, pt) != CNERR) err = 1;
+
+  return (ref_result ("slg_downsample", err));
+}
+
+
+/* checks meteorological day windows against a scan of the concatenated values of day
+ * before and reference day (flagged values and values of missing days are invalid)
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_metday (void)
+{
+  static slg_mtemper mtemper;
+  static slg_metday  metday;
+  static slg_dtemper dprev;
+  int32_t            wstart[5] = {-360, -360, -60, -1500, -1500};
+  uint32_t           wlen[5] = {1440, 720, 1440, 1440, 30};
+  int32_t            woffs[5] = {-20, -20, 0, -96, -96};
+  int32_t            cat[2 * MAX_MLN_NUM];
+  uint32_t           w, d, i, k, dnum, tind, err;
+  slg_mdwin          win;
+  slg_date           date, rdate;
+  slg_dstats         dstats, rstats, mstats[31];
+  slg_dtemper        *prev, *cur;
+
+  err = 0;
+
+  /* windows from UTC times */
+  for (w = 0; w < 5; w++) {
+    if ((slg_metday_setwin (&win, wstart[w], wlen[w]) != 0) ||
+        (win.offs != woffs[w]) || (win.len != wlen[w] / 15)) err = 1;
+  }
+  if (slg_metday_setwin (&win, -355, 1440) == 0) err = 1;
+  if (slg_metday_setwin (&win, 0, 0) == 0) err = 1;
+  if (slg_metday_setwin (&win, 0, 1440) == 0) err = 1;
+  if (slg_metday_setwin (&win, -1515, 15) == 0) err = 1;
+
+  /* random month with missing days and flagged values, last day of month before */
+  ref_rand_dtemper (&dprev);
+  memset (&mtemper, 0, sizeof(slg_mtemper));
+  for (d = 0; d < 31; d++) {
+    ref_rand_dtemper (&mtemper.dtemper[d]);
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      if ((rand () % 50) == 0) mtemper.dtemper[d].qflag[i / 32] |= 1u << (i % 32);
+    }
+    mtemper.dvalid[d] = ((d == 0) || (d == 9) || (d == 10) || (d == 20)) ? 0 : 1;
+  }
+
+  for (w = 0; w < 5; w++) {
+    slg_metday_setwin (&win, wstart[w], wlen[w]);
+    dnum = slg_metday_mtemper (&mtemper, &dprev, &win, mstats);
+
+    slg_metday_init (&metday);
+    slg_date_set_int (&date, 31, 12, 2023);
+    slg_metday_push (&metday, &dprev, &date);
+    k = 0;
+
+    for (d = 0; d < 31; d++) {
+      slg_date_inc (&date);
+      cur = (mtemper.dvalid[d]) ? &mtemper.dtemper[d] : NULL;
+      prev = (d == 0) ? &dprev : ((mtemper.dvalid[d-1]) ? &mtemper.dtemper[d-1] : NULL);
+      slg_metday_push (&metday, cur, &date);
+
+      /* reference: scan of window in concatenated days */
+      for (i = 0; i < MAX_MLN_NUM; i++) {
+        cat[i] = CNERR;
+        cat[MAX_MLN_NUM + i] = CNERR;
+        if ((prev != NULL) && (((prev->qflag[i / 32] >> (i % 32)) & 1) == 0)) cat[i] = prev->val[i];
+        if ((cur != NULL) && (((cur->qflag[i / 32] >> (i % 32)) & 1) == 0)) cat[MAX_MLN_NUM + i] = cur->val[i];
+      }
+      ref_dstats (&rstats, &cat[MAX_MLN_NUM + win.offs], win.len);
+
+      if (slg_metday_stats (&metday, &win, &dstats) != ((rstats.count == 0) ? 1 : 0)) err = 1;
+      if (ref_dstats_cmp (&dstats, &rstats) != 0) err = 1;
+
+      /* month function: no statistics of missing days */
+      if (cur == NULL) ref_dstats (&rstats, cat, 0);
+      if (ref_dstats_cmp (&mstats[d], &rstats) != 0) err = 1;
+      if (rstats.count != 0) k++;
+
+      /* window index of min. value */
+      if (dstats.count != 0) {
+        if (slg_metday_index (&metday, &win, dstats.indmin, &rdate, &tind) != 0) err = 1;
+        i = MAX_MLN_NUM + (uint32_t) win.offs + dstats.indmin;
+        if (tind != i % MAX_MLN_NUM) err = 1;
+        if (slg_date_compare (&rdate, &date) != ((i < MAX_MLN_NUM) ? 2 : 1)) err = 1;
+      }
+      if (slg_metday_index (&metday, &win, win.len, &rdate, &tind) == 0) err = 1;
+    }
+
+    if (dnum != k) err = 1;
+  }
+
+  return (ref_result ("slg_metday", err));
+}
+
+
+
+
+
+/* checks resampling of random days and of a month with change to summertime against
+ * scans of the slots of each bucket
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_resample (void)
+{
+  static slg_mtemper mtemper;
+  static slg_dtemper dprev;
+  static int32_t     mout[31 * RSM_MAX_BNUM];
+  uint32_t           blen[4] = {15, RSM_H1, RSM_H3, RSM_DAY};
+  int32_t            out[RSM_MAX_BNUM], rout[RSM_MAX_BNUM];
+  uint32_t           l, sp, sc, op, i, d, num, err;
+  int32_t            *vprev, *vcur, *pv;
+  slg_rsmmap         mprev, mcur;
+  slg_date           date;
+
+  err = 0;
+
+  /* invalid bucket lengths and summer flags */
+  if (slg_resample_map (&mcur, 0, 0) == 0) err = 1;
+  if (slg_resample_map (&mcur, 0, 7) == 0) err = 1;
+  if (slg_resample_map (&mcur, 0, 105) == 0) err = 1;
+  if (slg_resample_map (&mcur, 2, RSM_H1) == 0) err = 1;
+
+  /* random days of all bucket lengths, normal time and summertime, missing days */
+  ref_rand_dtemper (&dprev);
+  ref_rand_dtemper (&mtemper.dtemper[0]);
+  for (l = 0; l < 4; l++) {
+    for (sp = 0; sp < 2; sp++) {
+      for (sc = 0; sc < 2; sc++) {
+        if ((slg_resample_map (&mprev, sp, blen[l]) != 0) || (slg_resample_map (&mcur, sc, blen[l]) != 0) ||
+            (mcur.bnum != 1440 / blen[l])) err = 1;
+
+        for (i = 0; i < 3; i++) {
+          vprev = (i == 1) ? NULL : dprev.val;
+          vcur = (i == 2) ? NULL : mtemper.dtemper[0].val;
+          for (op = RSM_MEAN; op <= RSM_LAST; op++) {
+            num = slg_resample_day (&mprev, vprev, &mcur, vcur, op, out);
+            if (num != ref_resample (vprev, sp, vcur, sc, blen[l], op, rout)) err = 1;
+            if (memcmp (out, rout, mcur.bnum * sizeof(int32_t)) != 0) err = 1;
+          }
+        }
+      }
+    }
+  }
+  if (slg_resample_day (&mprev, dprev.val, &mcur, dprev.val, RSM_LAST + 1, out) != CNERR) err = 1;
+
+  /* month with change to summertime (31.03.2024) and missing days */
+  memset (&mtemper, 0, sizeof(slg_mtemper));
+  for (d = 0; d < 31; d++) {
+    ref_rand_dtemper (&mtemper.dtemper[d]);
+    mtemper.dvalid[d] = ((d == 4) || (d == 30)) ? 0 : 1;
+  }
+
+  for (l = 0; l < 4; l++) {
+    for (op = RSM_MEAN; op <= RSM_LAST; op++) {
+      num = slg_resample_mtemper (&mtemper, 2024, 3, &dprev, blen[l], op, mout);
+      if (num != 31 * (1440 / blen[l])) err = 1;
+
+      slg_date_set_int (&date, 29, 2, 2024);
+      sp = slg_date_is_summertime (&date);
+      pv = dprev.val;
+      for (d = 0; d < 31; d++) {
+        slg_date_inc (&date);
+        sc = slg_date_is_summertime (&date);
+        vcur = (mtemper.dvalid[d]) ? mtemper.dtemper[d].val : NULL;
+        ref_resample (pv, sp, vcur, sc, blen[l], op, rout);
+        if (vcur == NULL) {
+          for (i = 0; i < 1440 / blen[l]; i++) rout[i] = CNERR;
+        }
+        if (memcmp (&mout[d * (1440 / blen[l])], rout, (1440 / blen[l]) * sizeof(int32_t)) != 0) err = 1;
+        sp = sc;
+        pv = vcur;
+      }
+      if ((sp != 1) || (slg_date_is_summertime (&date) != 1)) err = 1;
+    }
+  }
+  if (slg_resample_mtemper (&mtemper, 2024, 13, &dprev, RSM_H1, RSM_MEAN, mout) != CNERR) err = 1;
+  if (slg_resample_mtemper (&mtemper, 2024, 3, &dprev, 7, RSM_MEAN, mout) != CNERR) err = 1;
+
+  return (ref_result ("slg_resample", err));
+}
+
+
+
+
+
+/* checks a live state of a dayfile growing in random chunks (lines are cut anywhere)
+ * against full reads, also after saving and loading, rewriting and truncation
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_live (void)
+{
+  static slg_live    live, live2;
+  static slg_daydata daydata;
+  static char        buf[MAX_MLN_NUM * MAX_MLN_LEN + 2000];
+  int32_t            tval[MAX_MLN_NUM], rval[MAX_MLN_NUM], eval[MAX_MLN_NUM];
+  uint32_t           i, n, len, cur, nxt, hlen, step, err;
+  slg_date           date;
+  FILE               *fpr;
+
+  err = 0;
+
+  /* random dayfile with missing lines and invalid values */
+  for (i = 0; i < MAX_MLN_NUM; i++) {
+    tval[i] = ref_rand_temper ();
+    rval[i] = ((rand () % 1000) < TST_INVPM) ? CNERR : rand () % 300;
+    eval[i] = ((rand () % 1000) < TST_INVPM) ? CNERR : rand () % 2;
+    if ((rand () % 10) == 0) {
+      tval[i] = CNERR;
+      rval[i] = CNERR;
+      eval[i] = CNERR;
+    }
+  }
+  slg_date_set_int (&date, 18, 10, 2026);
+  ref_daydata (&daydata, &date, tval, rval, eval);
+  slg_writedayfile ("slg_test_live.ref", &daydata, 0);
+
+  fpr = fopen ("slg_test_live.ref", "rb");
+  if (fpr == NULL) return (ref_result ("slg_live", 1));
+  len = (uint32_t) fread (buf, 1, sizeof(buf) - 1, fpr);
+  fclose (fpr);
+
+  /* header (behind second separator line) */
+  n = 0;
+  hlen = 0;
+  while ((n < 2) && (hlen < len)) {
+    if (strncmp (&buf[hlen], "----------", 10) == 0) n++;
+    while ((hlen < len) && (buf[hlen] != 0x0a)) hlen++;
+    hlen++;
+  }
+
+  /* growing dayfile: first update reads header and first line, then random chunks */
+  remove ("slg_test_live.txt");
+  slg_live_clear (&live);
+  cur = 0;
+  nxt = hlen;
+  while ((nxt < len) && (buf[nxt] != 0x0a)) nxt++;
+  nxt++;
+
+  step = 0;
+  while (cur < len) {
+    ref_write ("slg_test_live.txt", "ab", &buf[cur], nxt - cur);
+    cur = nxt;
+    if (slg_live_update (&live, "slg_test_live.txt", 0, NULL) != 0) err = 1;
+    if (ref_live_check (&live, buf, cur) != 0) err = 1;
+
+    /* state saved and loaded between runs */
+    if ((step % 3) == 2) {
+      if (slg_live_save (&live, "slg_test_live.sta") != 0) err = 1;
+      slg_live_clear (&live);
+      if (slg_live_load (&live, "slg_test_live.sta") != 0) err = 1;
+    }
+
+    nxt = cur + 1 + rand () % 400;
+    if (nxt > len) nxt = len;
+    step++;
+  }
+  if (step < 10) err = 1;
+
+  /* unchanged dayfile and full read of a new state */
+  if (slg_live_update (&live, "slg_test_live.txt", 0, NULL) != 0) err = 1;
+  if (ref_live_check (&live, buf, len) != 0) err = 1;
+  slg_live_clear (&live2);
+  if (slg_live_update (&live2, "slg_test_live.txt", 0, NULL) != 0) err = 1;
+  if ((live2.offset != live.offset) || (live2.lnum != live.lnum) || (live2.last != live.last) ||
+      (memcmp (live2.dstats, live.dstats, sizeof(live.dstats)) != 0) ||
+      (memcmp (live2.cur, live.cur, sizeof(live.cur)) != 0)) err = 1;
+
+  /* event value of last line rewritten in place (same size) */
+  buf[len-2] = (buf[len-2] == '1') ? '0' : '1';
+  ref_write ("slg_test_live.txt", "r+b", buf, len);
+  if (slg_live_update (&live, "slg_test_live.txt", 0, NULL) != 0) err = 1;
+  if (ref_live_check (&live, buf, len) != 0) err = 1;
+
+  /* truncated dayfile */
+  len = hlen + (len - hlen) / 2;
+  while (buf[len-1] != 0x0a) len--;
+  ref_write ("slg_test_live.txt", "wb", buf, len);
+  if (slg_live_update (&live, "slg_test_live.txt", 0, NULL) != 0) err = 1;
+  if (ref_live_check (&live, buf, len) != 0) err = 1;
+
+  /* missing dayfile */
+  remove ("slg_test_live.txt");
+  if ((slg_live_update (&live, "slg_test_live.txt", 0, NULL) == 0) || (live.valid != 0)) err = 1;
+
+  remove ("slg_test_live.ref");
+  remove ("slg_test_live.sta");
+
+  return (ref_result ("slg_live", err));
+}
+
+
+/* checks all kernel variants supported by the cpu against a scan of random arrays
+ * (lengths and alignments around the vector widths, masks, ties, int16 arrays)
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_simd (void)
+{
+  static int32_t val[1100], rval[1100];
+  static int16_t val16[1100];
+  uint32_t       mask[1100 / 32 + 1];
+  uint32_t       level, r, len, offs, i, err;
+  slg_dstats     dstats, rstats;
+
+  err = 0;
+  if (slg_simd_set (SIMD_SCALAR) != 0) err = 1;
+
+  for (level = SIMD_SCALAR; level <= SIMD_AVX512; level++) {
+    if (slg_simd_set (level) != 0) continue;
+    if (slg_simd_level () != level) err = 1;
+
+    for (r = 0; r < 300; r++) {
+      len = (r < 70) ? r : rand () % 1025;
+      offs = rand () % 16;
+
+      for (i = 0; i < len + offs; i++) {
+        val[i] = ref_rand_temper ();
+        if ((r % 3) == 1) val[i] = (val[i] == CNERR) ? CNERR : val[i] % 3;   /* many ties */
+        if ((r % 7) == 2) val[i] = CNERR;                                    /* no valid value */
+        val16[i] = (val[i] == CNERR) ? SIMD_INV16 : (int16_t) val[i];
+        if ((r % 5) == 3) val16[i] = (int16_t) ((rand () % 65535) - 32767);  /* full int16 range */
+      }
+      memset (mask, 0, sizeof(mask));
+      for (i = 0; i < len; i++) {
+        if ((rand () % 8) == 0) mask[i / 32] |= 1u << (i % 32);
+      }
+
+      /* int32 without and with mask */
+      ref_dstats (&rstats, &val[offs], len);
+      if (slg_simd_dstats (&dstats, &val[offs], len, NULL) != ((rstats.count == 0) ? 1 : 0)) err = 1;
+      if (ref_dstats_cmp (&dstats, &rstats) != 0) err = 1;
+
+      for (i = 0; i < len; i++) {
+        rval[i] = (((mask[i / 32] >> (i % 32)) & 1) != 0) ? CNERR : val[offs + i];
+      }
+      ref_dstats (&rstats, rval, len);
+      if (slg_simd_dstats (&dstats, &val[offs], len, mask) != ((rstats.count == 0) ? 1 : 0)) err = 1;
+      if (ref_dstats_cmp (&dstats, &rstats) != 0) err = 1;
+
+      /* int16 */
+      for (i = 0; i < len; i++) {
+        rval[i] = (val16[offs + i] == SIMD_INV16) ? CNERR : val16[offs + i];
+      }
+      ref_dstats (&rstats, rval, len);
+      if (slg_simd_dstats16 (&dstats, &val16[offs], len) != ((rstats.count == 0) ? 1 : 0)) err = 1;
+      if (ref_dstats_cmp (&dstats, &rstats) != 0) err = 1;
+    }
+  }
+  if (slg_simd_dstats16 (&dstats, val16, SIMD_MAXLEN16 + 1) != 2) err = 1;
+
+  /* reset to selected variant */
+  level = slg_simd_init ();
+  if ((slg_simd_level () != level) || (level == SIMD_SSE2)) err = 1;
+
+  return (ref_result ("slg_simd", err));
+}
+
+
+/* checks day numbers of all dates of the supported range against a day by day walk,
+ * adding days and the error cases at the range limits and of invalid dates
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_dnum (void)
+{
+  uint32_t dnum, k, err;
+  int32_t  n;
+  slg_date date, date2, first;
+
+  err = 0;
+
+  /* whole date range 01.01.1970 .. 31.12.2105 */
+  slg_date_set_int (&date, 1, 1, 1970);
+  slg_date_copy (&first, &date);
+  for (dnum = DATE_DNUM_MIN; dnum <= DATE_DNUM_MAX; dnum++) {
+    if (slg_date_to_dnum (&date) != dnum) err = 1;
+    if ((slg_date_from_dnum (&date2, dnum) != 1) || (slg_date_compare (&date2, &date) != 1)) err = 1;
+    if (slg_date_sub (&date, &first) != (int32_t) (dnum - DATE_DNUM_MIN)) err = 1;
+
+    /* random distance inside of range */
+    n = (rand () % 20001) - 10000;
+    slg_date_copy (&date2, &date);
+    k = slg_date_add (&date2, n);
+    if (((int32_t) dnum + n < DATE_DNUM_MIN) || ((int32_t) dnum + n > DATE_DNUM_MAX)) {
+      if ((k != 0) || (slg_date_compare (&date2, &date) != 1)) err = 1;
+    }
+    else {
+      if ((k != 1) || (slg_date_to_dnum (&date2) != (uint32_t) ((int32_t) dnum + n))) err = 1;
+    }
+
+    slg_date_copy (&date2, &date);
+    k = slg_date_inc (&date);
+    ref_date_inc (&date2);
+    if ((dnum < DATE_DNUM_MAX) && ((k != 1) || (slg_date_compare (&date, &date2) != 1))) err = 1;
+  }
+  if (k != 0) err = 1;   /* overflow of 31.12.2105 */
+
+  /* invalid dates and day numbers */
+  date.d = 31;
+  date.m = 12;
+  date.y = 1969;
+  if (slg_date_to_dnum (&date) != 0) err = 1;
+  date.d = 1;
+  date.m = 1;
+  date.y = 2106;
+  if (slg_date_to_dnum (&date) != 0) err = 1;
+  date.d = 29;
+  date.m = 2;
+  date.y = 2100;
+  if (slg_date_to_dnum (&date) != 0) err = 1;
+  date.d = 0;
+  date.m = 1;
+  date.y = 2000;
+  if (slg_date_to_dnum (&date) != 0) err = 1;
+  date.d = 1;
+  date.m = 13;
+  if (slg_date_to_dnum (&date) != 0) err = 1;
+
+  slg_date_set_int (&date, 29, 2, 2000);
+  slg_date_copy (&date2, &date);
+  if ((slg_date_from_dnum (&date2, DATE_DNUM_MIN - 1) != 0) || (slg_date_compare (&date2, &date) != 1)) err = 1;
+  if ((slg_date_from_dnum (&date2, DATE_DNUM_MAX + 1) != 0) || (slg_date_compare (&date2, &date) != 1)) err = 1;
+  if (slg_date_to_dnum (&date) != 11017) err = 1;
+
+  return (ref_result ("slg_date_dnum", err));
+}
+
+
+/* checks a rollup index built from random dayfiles of a range over a year change and a
+ * leap day (missing days, one day with the max. rain value of dayfiles) against the
+ * values, then the update of a rewritten and of a removed dayfile and read only access
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_rollup (void)
+{
+  static int32_t     tv[TST_RLPDAYS * MAX_MLN_NUM], rv[TST_RLPDAYS * MAX_MLN_NUM];
+  static int32_t     ev[TST_RLPDAYS * MAX_MLN_NUM];
+  static slg_rlpyear ryear[2];
+  static slg_daydata daydata;
+  static slg_rollup  rollup;
+  int32_t            *val[3] = {tv, rv, ev};
+  uint32_t           exist[TST_RLPDAYS];
+  uint32_t           d, i, n, nupd, err;
+  int32_t            base;
+  slg_date           date0, date, date_e;
+  struct stat        st;
+  struct utimbuf     ut;
+  char               fname[300], temp[20];
+
+  err = 0;
+  mkdir ("slg_test_rlp", 0755);
+
+  /* random days 01.12.2023 .. 10.03.2024, every 13th day is missing */
+  slg_date_set_int (&date0, 1, 12, 2023);
+  slg_date_copy (&date, &date0);
+  for (d = 0; d < TST_RLPDAYS; d++) {
+    exist[d] = ((d % 13) == 5) ? 0 : 1;
+    base = (rand () % 400) - 150;
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      n = d * MAX_MLN_NUM + i;
+      tv[n] = ((rand () % 1000) < TST_INVPM) ? CNERR : base + rand () % 101;
+      rv[n] = ((rand () % 1000) < TST_INVPM) ? CNERR : (((rand () % 5) == 0) ? rand () % 300 : 0);
+      ev[n] = ((rand () % 1000) < TST_INVPM) ? CNERR : rand () % 2;
+      if (exist[d] == 0) {
+        tv[n] = CNERR;
+        rv[n] = CNERR;
+        ev[n] = CNERR;
+      }
+    }
+    if (d == 20) rv[d * MAX_MLN_NUM + 7] = 9999;
+
+    if (exist[d]) {
+      ref_daydata (&daydata, &date, &tv[d * MAX_MLN_NUM], &rv[d * MAX_MLN_NUM], &ev[d * MAX_MLN_NUM]);
+      slg_date_to_fstring (temp, &date);
+      sprintf (fname, "slg_test_rlp/%s.txt", temp);
+      slg_writedayfile (fname, &daydata, 0);
+    }
+    slg_date_copy (&date_e, &date);
+    slg_date_inc (&date);
+  }
+
+  /* index of years 2023 and 2024 */
+  if (slg_rollup_create ("slg_test_rlp/rollup.idx", &daydata, 2023, 2024) != 0) err = 1;
+  if (slg_rollup_open (&rollup, "slg_test_rlp/rollup.idx", 1) != 0) {
+    return (ref_result ("slg_rollup", 1));
+  }
+
+  n = 0;
+  for (d = 0; d < TST_RLPDAYS; d++) n += exist[d];
+  if ((slg_rollup_update_range (&rollup, "slg_test_rlp/", &date0, &date_e, 0, &nupd) != 0) ||
+      (nupd != n)) err = 1;
+  if (ref_rollup_check (&rollup, "slg_test_rlp/", &date0, TST_RLPDAYS, val, exist) != 0) err = 1;
+  if ((slg_rollup_update_range (&rollup, "slg_test_rlp/", &date0, &date_e, 0, &nupd) != 0) ||
+      (nupd != 0)) err = 1;
+
+  /* rewritten dayfile of 29.02.2024: only day, month and year entries of it change */
+  memcpy (ryear, rollup.year, sizeof(ryear));
+  d = 90;
+  base = (rand () % 400) - 150;
+  for (i = 0; i < MAX_MLN_NUM; i++) {
+    tv[d * MAX_MLN_NUM + i] = base + rand () % 101;
+    rv[d * MAX_MLN_NUM + i] = rand () % 300;
+  }
+  slg_date_set_int (&date, 29, 2, 2024);
+  ref_daydata (&daydata, &date, &tv[d * MAX_MLN_NUM], &rv[d * MAX_MLN_NUM], &ev[d * MAX_MLN_NUM]);
+  slg_writedayfile ("slg_test_rlp/2024-02-29.txt", &daydata, 0);
+  if (stat ("slg_test_rlp/2024-02-29.txt", &st) != 0) err = 1;
+  ut.actime = st.st_mtime + 100;
+  ut.modtime = st.st_mtime + 100;
+  utime ("slg_test_rlp/2024-02-29.txt", &ut);
+
+  if (slg_rollup_update (&rollup, "slg_test_rlp/", &date, 0) != 0) err = 1;
+  if (slg_rollup_update (&rollup, "slg_test_rlp/", &date, 0) != 1) err = 1;
+  if (memcmp (&ryear[0], &rollup.year[0], sizeof(slg_rlpyear)) != 0) err = 1;
+  for (i = 0; i < 366; i++) {
+    n = (memcmp (&ryear[1].day[i], &rollup.year[1].day[i], sizeof(slg_rlpent)) != 0) ? 1 : 0;
+    if (n != ((i == 59) ? 1 : 0)) err = 1;
+  }
+  for (i = 0; i < 12; i++) {
+    n = (memcmp (&ryear[1].month[i], &rollup.year[1].month[i], sizeof(slg_rlpent)) != 0) ? 1 : 0;
+    if (n != ((i == 1) ? 1 : 0)) err = 1;
+  }
+  if (memcmp (&ryear[1].year, &rollup.year[1].year, sizeof(slg_rlpent)) == 0) err = 1;
+  if (ref_rollup_check (&rollup, "slg_test_rlp/", &date0, TST_RLPDAYS, val, exist) != 0) err = 1;
+
+  /* removed dayfile of 10.01.2024 */
+  d = 40;
+  remove ("slg_test_rlp/2024-01-10.txt");
+  exist[d] = 0;
+  for (i = 0; i < MAX_MLN_NUM; i++) {
+    tv[d * MAX_MLN_NUM + i] = CNERR;
+    rv[d * MAX_MLN_NUM + i] = CNERR;
+    ev[d * MAX_MLN_NUM + i] = CNERR;
+  }
+  slg_date_set_int (&date, 10, 1, 2024);
+  if (slg_rollup_update (&rollup, "slg_test_rlp/", &date, 0) != 2) err = 1;
+  if (ref_rollup_check (&rollup, "slg_test_rlp/", &date0, TST_RLPDAYS, val, exist) != 0) err = 1;
+  slg_rollup_close (&rollup);
+
+  /* read only access */
+  if (slg_rollup_open (&rollup, "slg_test_rlp/rollup.idx", 0) != 0) {
+    err = 1;
+  }
+  else {
+    if (ref_rollup_check (&rollup, "slg_test_rlp/", &date0, TST_RLPDAYS, val, exist) != 0) err = 1;
+    if (slg_rollup_update (&rollup, "slg_test_rlp/", &date, 0) != 4) err = 1;
+    slg_rollup_close (&rollup);
+  }
+
+  /* remove files */
+  slg_date_copy (&date, &date0);
+  for (d = 0; d < TST_RLPDAYS; d++) {
+    slg_date_to_fstring (temp, &date);
+    sprintf (fname, "slg_test_rlp/%s.txt", temp);
+    if (exist[d]) remove (fname);
+    slg_date_inc (&date);
+  }
+  remove ("slg_test_rlp/rollup.idx");
+  remove ("slg_test_rlp/rollup.idx" RLP_SEXT);
+  rmdir ("slg_test_rlp");
+
+  return (ref_result ("slg_rollup", err));
+}
+
+
+/* checks nearest rank percentiles of histograms against sorted random arrays (values
+ * also in under- and overflow range, CNERR values), the bucket limits and merging
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_hist (void)
+{
+  static int32_t  val[3000], sval[3000];
+  static slg_hist hist, hist1, hist2;
+  uint32_t        pm[8] = {0, 1, 50, 500, 950, 999, 1000, 0};
+  uint32_t        run, len, n, i, k, rank, under, over, err;
+  int32_t         ref;
+
+  err = 0;
+
+  /* bucket limits */
+  if ((slg_hist_bin (HST_TMIN - 1) != 0) || (slg_hist_bin (HST_TMIN) != 1) ||
+      (slg_hist_bin (HST_TMAX) != HST_BINS - 2) || (slg_hist_bin (HST_TMAX + 1) != HST_BINS - 1) ||
+      (slg_hist_bin (-100000) != 0) || (slg_hist_bin (100000) != HST_BINS - 1)) err = 1;
+
+  /* empty histogram and invalid percentile */
+  slg_hist_clear (&hist);
+  if (slg_hist_percentile (&hist, 500) != CNERR) err = 1;
+
+  for (run = 0; run < 200; run++) {
+    len = 1 + rand () % 3000;
+    n = 0;
+    under = 0;
+    over = 0;
+    for (i = 0; i < len; i++) {
+      val[i] = ((rand () % 1000) < TST_INVPM) ? CNERR : (rand () % 1301) - 650;
+      if ((run % 4) == 0) val[i] = (rand () % 21) - 10;    /* many ties */
+      if (val[i] == CNERR) continue;
+      sval[n++] = val[i];
+      if (val[i] < HST_TMIN) under++;
+      if (val[i] > HST_TMAX) over++;
+    }
+    qsort (sval, n, sizeof(int32_t), ref_cmp_int32);
+
+    slg_hist_clear (&hist);
+    slg_hist_add (&hist, val, len);
+    if ((hist.count != n) || (hist.bin[0] != under) || (hist.bin[HST_BINS-1] != over)) err = 1;
+    if (slg_hist_percentile (&hist, 1001) != CNERR) err = 1;
+
+    /* percentiles against rank in sorted array */
+    pm[7] = rand () % 1001;
+    for (k = 0; k < 8; k++) {
+      if (n == 0) {
+        if (slg_hist_percentile (&hist, pm[k]) != CNERR) err = 1;
+        continue;
+      }
+      rank = (pm[k] * n + 999) / 1000;
+      if (rank == 0) rank = 1;
+      ref = sval[rank-1];
+      if ((ref < HST_TMIN) || (ref > HST_TMAX)) ref = CNERR;
+      if (slg_hist_percentile (&hist, pm[k]) != ref) err = 1;
+    }
+
+    /* two parts merged */
+    k = rand () % (len + 1);
+    slg_hist_clear (&hist1);
+    slg_hist_clear (&hist2);
+    slg_hist_add (&hist1, val, k);
+    slg_hist_add (&hist2, &val[k], len - k);
+    slg_hist_merge (&hist1, &hist2);
+    if (memcmp (&hist1, &hist, sizeof(slg_hist)) != 0) err = 1;
+  }
+
+  return (ref_result ("slg_hist", err));
+}
+
+
+/* checks records of random dayfiles (warmest night, coldest day, absolute max., dry spell
+ * broken by a missing day) against a scan of the values: added day by day with a
+ * replaced partial last day and closed, and rebuilt with 1 and more threads (identical
+ * objects), further values of a closed day are rejected
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_records (void)
+{
+  static int32_t     tv[TST_RECDAYS * MAX_MLN_NUM], rv[TST_RECDAYS * MAX_MLN_NUM];
+  static int32_t     ev[TST_RECDAYS * MAX_MLN_NUM], pv[MAX_MLN_NUM];
+  static slg_daydata daydata;
+  static slg_records records, records2, records3;
+  uint32_t           exist[TST_RECDAYS];
+  uint32_t           tnum[3] = {1, 4, REC_MAX_THREADS};
+  uint32_t           d, i, n, t, spell, last, err;
+  int32_t            base, nmax, dmin, smax;
+  uint32_t           dnmax, ddmin, dsmax;
+  slg_date           date0, date, date_e, rdate[TST_RECDAYS];
+  slg_dstats         tds, rds, lds;
+  slg_reccol         *rcol;
+  char               fname[300], temp[20];
+
+  err = 0;
+  mkdir ("slg_test_rec", 0755);
+
+  /* random days from 01.01.2024, day 5 is missing inside of 30 dry days, later every
+   * 11th day is missing and 60 percent of days are dry, days 70 and 81 repeat the
+   * warmest and coldest day before (ties) */
+  slg_date_set_int (&date0, 1, 1, 2024);
+  slg_date_copy (&date, &date0);
+  for (d = 0; d < TST_RECDAYS; d++) {
+    slg_date_copy (&rdate[d], &date);
+    exist[d] = ((d == 5) || ((d > 30) && ((d % 11) == 0))) ? 0 : 1;
+    base = (rand () % 400) - 150;
+    if (d == 69) base = 400;
+    if (d == 80) base = -500;
+    n = ((d < 30) || ((rand () % 10) < 6)) ? 0 : 1;
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      tv[d * MAX_MLN_NUM + i] = ((rand () % 1000) < TST_INVPM) ? CNERR : base + rand () % 101;
+      if ((d == 70) || (d == 81)) tv[d * MAX_MLN_NUM + i] = tv[(d - 1) * MAX_MLN_NUM + i];
+      rv[d * MAX_MLN_NUM + i] = ((rand () % 1000) < TST_INVPM) ? CNERR : n * (rand () % 30);
+      ev[d * MAX_MLN_NUM + i] = CNERR;
+      if (exist[d] == 0) {
+        tv[d * MAX_MLN_NUM + i] = CNERR;
+        rv[d * MAX_MLN_NUM + i] = CNERR;
+      }
+    }
+
+    if (exist[d]) {
+      ref_daydata (&daydata, &date, &tv[d * MAX_MLN_NUM], &rv[d * MAX_MLN_NUM], &ev[d * MAX_MLN_NUM]);
+      slg_date_to_fstring (temp, &date);
+      sprintf (fname, "slg_test_rec/%s.txt", temp);
+      slg_writedayfile (fname, &daydata, 0);
+    }
+    slg_date_copy (&date_e, &date);
+    slg_date_inc (&date);
+  }
+
+  /* reference: day records and dry spells in date order */
+  nmax = CNERR;
+  dmin = CNERR;
+  smax = 0;
+  dnmax = 0;
+  ddmin = 0;
+  dsmax = 0;
+  spell = 0;
+  last = CNERR;
+  for (d = 0; d < TST_RECDAYS; d++) {
+    if (exist[d] == 0) continue;
+    ref_dstats (&tds, &tv[d * MAX_MLN_NUM], MAX_MLN_NUM);
+    ref_dstats (&rds, &rv[d * MAX_MLN_NUM], MAX_MLN_NUM);
+    if ((tds.count != 0) && ((nmax == CNERR) || (tds.min >= nmax))) {
+      nmax = tds.min;
+      dnmax = d;
+    }
+    if ((tds.count != 0) && ((dmin == CNERR) || (tds.max <= dmin))) {
+      dmin = tds.max;
+      ddmin = d;
+    }
+    if ((rds.count != 0) && (rds.sum < RPS_WETDAY)) {
+      spell = (last == d - 1) ? spell + 1 : 1;
+      if (spell >= (uint32_t) smax) {
+        smax = (int32_t) spell;
+        dsmax = d;
+      }
+    }
+    else {
+      spell = 0;
+    }
+    last = d;
+  }
+  ref_dstats (&tds, tv, TST_RECDAYS * MAX_MLN_NUM);
+
+  /* day by day, last day added first with all values at its max. value and replaced
+   * by the real day (fewer values) */
+  slg_records_init (&records, &daydata);
+  for (d = 0; d < TST_RECDAYS; d++) {
+    if (exist[d] == 0) continue;
+    if (d == TST_RECDAYS - 1) {
+      ref_dstats (&lds, &tv[d * MAX_MLN_NUM], MAX_MLN_NUM);
+      for (i = 0; i < MAX_MLN_NUM; i++) pv[i] = lds.max;
+      ref_daydata (&daydata, &rdate[d], pv, &rv[d * MAX_MLN_NUM], &ev[d * MAX_MLN_NUM]);
+      if (slg_records_add_day (&records, &daydata) != 0) err = 1;
+    }
+    ref_daydata (&daydata, &rdate[d], &tv[d * MAX_MLN_NUM], &rv[d * MAX_MLN_NUM], &ev[d * MAX_MLN_NUM]);
+    if (slg_records_add_day (&records, &daydata) != 0) err = 1;
+  }
+  if ((records.curopen != 1) || (ref_dstats_cmp (&records.col[0].cur, &lds) != 0)) err = 1;
+  slg_records_close (&records);
+
+  rcol = &records.col[0];
+  if ((rcol->rec[REC_NIGHTMAX].val != nmax) ||
+      (slg_date_compare (&rcol->rec[REC_NIGHTMAX].date, &rdate[dnmax]) != 1)) err = 1;
+  if ((rcol->rec[REC_DAYMIN].val != dmin) ||
+      (slg_date_compare (&rcol->rec[REC_DAYMIN].date, &rdate[ddmin]) != 1)) err = 1;
+  if ((rcol->rec[REC_MAX].val != tds.max) || (rcol->rec[REC_MAX].ind != tds.indmax % MAX_MLN_NUM) ||
+      (slg_date_compare (&rcol->rec[REC_MAX].date, &rdate[tds.indmax / MAX_MLN_NUM]) != 1)) err = 1;
+  if ((rcol->rec[REC_MIN].val != tds.min) || (rcol->rec[REC_MIN].ind != tds.indmin % MAX_MLN_NUM) ||
+      (slg_date_compare (&rcol->rec[REC_MIN].date, &rdate[tds.indmin / MAX_MLN_NUM]) != 1)) err = 1;
+  if ((dnmax != 70) || (ddmin != 81)) err = 1;
+  rcol = &records.col[1];
+  if ((smax < 24) || (rcol->rec[REC_DRYSPELL].val != smax) ||
+      (slg_date_compare (&rcol->rec[REC_DRYSPELL].date, &rdate[dsmax]) != 1)) err = 1;
+
+  /* closed day rejects further values, closing again changes nothing */
+  memcpy (&records3, &records, sizeof(slg_records));
+  if (slg_records_add_day (&records, &daydata) != 2) err = 1;
+  if (slg_records_add_value (&records, &rdate[TST_RECDAYS-1], 0, 95, 999) != 2) err = 1;
+  if (slg_records_add_value (&records, &rdate[0], 0, 95, 999) != 2) err = 1;
+  slg_records_close (&records);
+  if (memcmp (&records3, &records, sizeof(slg_records)) != 0) err = 1;
+
+  /* rebuild with 1 and more threads */
+  for (t = 0; t < 3; t++) {
+    slg_records_init (&records2, &daydata);
+    if (slg_records_rebuild (&records2, "slg_test_rec/", &date0, &date_e, 0, tnum[t]) != 0) err = 1;
+    slg_records_close (&records2);
+    if (memcmp (&records2, &records, sizeof(slg_records)) != 0) err = 1;
+  }
+
+  /* remove files */
+  for (d = 0; d < TST_RECDAYS; d++) {
+    slg_date_to_fstring (temp, &rdate[d]);
+    sprintf (fname, "slg_test_rec/%s.txt", temp);
+    if (exist[d]) remove (fname);
+  }
+  rmdir ("slg_test_rec");
+
+  return (ref_result ("slg_records", err));
+}
+
+
+/* checks the aggregation of random dayfiles of three years (every second day and all
+ * days around the year change, warmest and coldest day repeated later in the year, one
+ * dayfile of another location) against a scan of the values and the identity of the
+ * results of 1 and more threads
  *
- * parameters:
- *   year:  year to be checked
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_aggr (void)
+{
+  static int32_t     tv[3 * 366 * MAX_MLN_NUM], val[MAX_MLN_NUM], inv[MAX_MLN_NUM];
+  static slg_daydata daydata;
+  static slg_aggr    aggr, aggr2;
+  static slg_hist    hist;
+  uint32_t           tnum[4] = {2, 3, 7, AGR_MAX_THREADS};
+  uint32_t           y, d, i, t, dnum, fnum, err;
+  uint32_t           exist[3 * 366];
+  int32_t            base;
+  int64_t            dsum;
+  slg_date           date, date2;
+  slg_dstats         dstats, dstats2;
+  slg_aggrpart       *part;
+  char               fname[300], temp[20];
+
+  err = 0;
+  mkdir ("slg_test_agr", 0755);
+
+  /* random days of 2023 .. 2025 (index: year * 366 + day of year) */
+  for (i = 0; i < MAX_MLN_NUM; i++) inv[i] = CNERR;
+  fnum = 0;
+  for (y = 0; y < 3; y++) {
+    slg_date_set_int (&date, 1, 1, 2023 + y);
+    for (d = 0; d < 366; d++) {
+      exist[y * 366 + d] = 0;
+      for (i = 0; i < MAX_MLN_NUM; i++) tv[(y * 366 + d) * MAX_MLN_NUM + i] = CNERR;
+      if (date.y != 2023 + y) continue;
+
+      base = (rand () % 400) - 150;
+      if (d == 20) base = 500;
+      if (d == 60) base = -600;
+      for (i = 0; i < MAX_MLN_NUM; i++) val[i] = ((rand () % 1000) < TST_INVPM) ? CNERR : base + rand () % 101;
+      if ((d == 200) || (d == 240)) memcpy (val, &tv[(y * 366 + d - 180) * MAX_MLN_NUM], sizeof(val));
+
+      if (((d % 2) == 0) || (date.m == 12) || (date.m == 1)) {
+        exist[y * 366 + d] = 1;
+        memcpy (&tv[(y * 366 + d) * MAX_MLN_NUM], val, sizeof(val));
+        fnum++;
+      }
+      ref_daydata (&daydata, &date, val, inv, inv);
+      if ((exist[y * 366 + d] == 0) && (d == 201)) daydata.locid = 2;
+      if ((exist[y * 366 + d]) || (daydata.locid == 2)) {
+        slg_date_to_fstring (temp, &date);
+        sprintf (fname, "slg_test_agr/%s.txt", temp);
+        slg_writedayfile (fname, &daydata, 0);
+      }
+      slg_date_inc (&date);
+    }
+  }
+  ref_daydata (&daydata, &date, val, inv, inv);
+
+  /* one thread against scan of values */
+  if (slg_aggr_build (&aggr, &daydata, "slg_test_agr/", 1, 2023, 2025, 0, 1) != 0) err = 1;
+  if (aggr.fnum != fnum) err = 1;
+  for (y = 0; y < 3; y++) {
+    part = slg_aggr_year (&aggr, 2023 + y);
+    if (part == NULL) return (ref_result ("slg_aggr", 1));
+
+    ref_dstats (&dstats, &tv[y * 366 * MAX_MLN_NUM], 366 * MAX_MLN_NUM);
+    slg_hist_clear (&hist);
+    slg_hist_add (&hist, &tv[y * 366 * MAX_MLN_NUM], 366 * MAX_MLN_NUM);
+    dnum = 0;
+    dsum = 0;
+    for (d = 0; d < 366; d++) {
+      ref_dstats (&dstats2, &tv[(y * 366 + d) * MAX_MLN_NUM], MAX_MLN_NUM);
+      if (dstats2.count == 0) continue;
+      dnum++;
+      dsum += slg_dstats_average (&dstats2);
+    }
+
+    if ((part->count != dstats.count) || (part->sum != dstats.sum) || (part->dnum != dnum) ||
+        (part->dsum != dsum)) err = 1;
+    if (memcmp (&part->hist, &hist, sizeof(slg_hist)) != 0) err = 1;
+    slg_date_set_int (&date, 1, 1, 2023 + y);
+    slg_date_copy (&date2, &date);
+    slg_date_add (&date, (int32_t) (dstats.indmin / MAX_MLN_NUM));
+    slg_date_add (&date2, (int32_t) (dstats.indmax / MAX_MLN_NUM));
+    if ((part->min != dstats.min) || (part->imin != dstats.indmin % MAX_MLN_NUM) ||
+        (slg_date_compare (&part->dmin, &date) != 1)) err = 1;
+    if ((part->max != dstats.max) || (part->imax != dstats.indmax % MAX_MLN_NUM) ||
+        (slg_date_compare (&part->dmax, &date2) != 1)) err = 1;
+  }
+
+  /* more threads give identical objects */
+  for (t = 0; t < 4; t++) {
+    if (slg_aggr_build (&aggr2, &daydata, "slg_test_agr/", 1, 2023, 2025, 0, tnum[t]) != 0) err = 1;
+    if (memcmp (&aggr2, &aggr, sizeof(slg_aggr)) != 0) err = 1;
+  }
+
+  /* remove files */
+  for (y = 0; y < 3; y++) {
+    slg_date_set_int (&date, 1, 1, 2023 + y);
+    while (date.y == 2023 + y) {
+      slg_date_to_fstring (temp, &date);
+      sprintf (fname, "slg_test_agr/%s.txt", temp);
+      remove (fname);
+      slg_date_inc (&date);
+    }
+  }
+  rmdir ("slg_test_agr");
+
+  return (ref_result ("slg_aggr", err));
+}
+
+
+/* checks flagging of spikes and outliers: single +40.0 and -40.0 degree spikes on a
+ * smooth and a steep day, a pair of outliers and a step change of a day and a spike at
+ * midnight of a month, flagged values must be skipped by the day statistics
  *
  * return value:
- *   0 :  year is not a leap-year
- *   1 :  year is a leap-year
+ *   0 :  all checks passed
+ *   1 :  check failed
  *
  ****************************************************************************************/
-uint32_t slg_year_is_leap_t (uint32_t year)
+uint32_t test_despike (void)
 {
-  if (((year % 4) == 0) && (((year % 100) != 0) || ((year % 400) == 0))) {
-    return (1);
+  static slg_dtemper dtemper, dtemper2;
+  static slg_mtemper mtemper, mtemper2;
+  uint32_t           i, d, err;
+  slg_dstats         dstats, rdstats;
+
+  err = 0;
+
+  /* smooth day (steps of 0.1 degree) */
+  ref_rand_dtemper (&dtemper);
+  for (i = 0; i < dtemper.tlen; i++) dtemper.val[i] = 100 + (int32_t) (i % 5);
+  memcpy (&dtemper2, &dtemper, sizeof(slg_dtemper));
+  if (slg_dtemper_despike (&dtemper) != 0) err = 1;
+  if (memcmp (&dtemper, &dtemper2, sizeof(slg_dtemper)) != 0) err = 1;
+
+  /* spikes of +40.0 and -40.0 degree */
+  dtemper.val[50] += 400;
+  dtemper.val[70] -= 400;
+  if (slg_dtemper_despike (&dtemper) != 2) err = 1;
+  for (i = 0; i < dtemper.tlen; i++) {
+    if (slg_dtemper_is_flagged (&dtemper, i) != (((i == 50) || (i == 70)) ? 1 : 0)) err = 1;
   }
-  else {
-    return (0);
+  if ((dtemper.qflag[0] != 0) || (dtemper.qflag[1] != ((uint32_t) 1 << 18)) ||
+      (dtemper.qflag[2] != ((uint32_t) 1 << 6))) err = 1;
+
+  /* flagged values are skipped by statistics */
+  memcpy (dtemper2.val, dtemper.val, sizeof(dtemper.val));
+  dtemper2.val[50] = CNERR;
+  dtemper2.val[70] = CNERR;
+  ref_dstats (&rdstats, dtemper2.val, dtemper2.tlen);
+  if ((slg_dtemper_stats (&dtemper, &dstats) != 0) || (ref_dstats_cmp (&dstats, &rdstats) != 0)) err = 1;
+  if ((slg_dtemper_indmax (&dtemper) != rdstats.indmax) ||
+      (slg_dtemper_indmin (&dtemper) != rdstats.indmin)) err = 1;
+  if ((dstats.max != 104) || (dstats.min != 100)) err = 1;
+
+  /* spikes on a steep ramp (steps of 4.0 degree, deviation is below outlier limit) */
+  ref_rand_dtemper (&dtemper);
+  for (i = 0; i < dtemper.tlen; i++) dtemper.val[i] = -2000 + 40 * (int32_t) i;
+  dtemper.val[20] += 400;
+  dtemper.val[80] -= 400;
+  if ((slg_dtemper_despike (&dtemper) != 2) || (dtemper.qflag[0] != ((uint32_t) 1 << 20)) ||
+      (dtemper.qflag[1] != 0) || (dtemper.qflag[2] != ((uint32_t) 1 << 16))) err = 1;
+
+  /* two neighboured outliers of 8.0 degree (no spike, deviation from rolling median) and
+   * a deviation of 4.0 degree */
+  ref_rand_dtemper (&dtemper);
+  for (i = 0; i < dtemper.tlen; i++) dtemper.val[i] = 100 + (int32_t) (i % 5);
+  dtemper.val[30] += 80;
+  dtemper.val[31] += 80;
+  dtemper.val[60] += 40;
+  if ((slg_dtemper_despike (&dtemper) != 2) || (dtemper.qflag[0] != ((uint32_t) 3 << 30)) ||
+      (dtemper.qflag[1] != 0)) err = 1;
+
+  /* step change of 20.0 degree is not flagged */
+  for (i = 0; i < dtemper.tlen; i++) dtemper.val[i] = ((i < 48) ? 100 : 300) + (int32_t) (i % 5);
+  memset (dtemper.qflag, 0, sizeof(dtemper.qflag));
+  if ((slg_dtemper_despike (&dtemper) != 0) || (dtemper.qflag[1] != 0)) err = 1;
+
+  /* month: spike at midnight (first value of day 3), step change on day 4, day 5 missing */
+  memset (&mtemper, 0, sizeof(slg_mtemper));
+  for (d = 0; d < 6; d++) {
+    ref_rand_dtemper (&mtemper.dtemper[d]);
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      mtemper.dtemper[d].val[i] = ((d < 3) || ((d == 3) && (i < 40)) ? 100 : 300) + (int32_t) (i % 5);
+    }
+    mtemper.dvalid[d] = (d == 4) ? 0 : 1;
   }
+  mtemper.dtemper[2].val[0] += 400;
+  for (d = 0; d < 6; d++) slg_dtemper_stats (&mtemper.dtemper[d], &mtemper.dstats[d]);
+  memcpy (&mtemper2, &mtemper, sizeof(slg_mtemper));
+
+  if (slg_mtemper_despike (&mtemper) != 1) err = 1;
+  if ((mtemper.dtemper[2].qflag[0] != 1) || (mtemper.dstats[2].max != 104)) err = 1;
+  mtemper2.dtemper[2].qflag[0] = 1;
+  slg_dtemper_stats (&mtemper2.dtemper[2], &mtemper2.dstats[2]);
+  if (memcmp (&mtemper, &mtemper2, sizeof(slg_mtemper)) != 0) err = 1;
+
+  /* same day alone: spike has no previous value, outlier from values after it */
+  memcpy (&dtemper, &mtemper2.dtemper[2], sizeof(slg_dtemper));
+  memset (dtemper.qflag, 0, sizeof(dtemper.qflag));
+  if ((slg_dtemper_despike (&dtemper) != 1) || (dtemper.qflag[0] != 1)) err = 1;
+
+  return (ref_result ("slg_despike", err));
 }
 
 
+/* checks filling of gaps against a reference: random days with gaps around max. gap
+ * length, leading and trailing gaps, negated days (symmetric rounding) and a month with
+ * a gap over midnight and a missing day
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_interpolate (void)
+{
+  static slg_dtemper dtemper, dtemper2;
+  static slg_mtemper mtemper, mtemper2;
+  static int32_t     val[IPL_MAX_LEN], out[IPL_MAX_LEN];
+  uint32_t           ipol[IPL_MAX_LEN / 32 + 1];
+  uint32_t           run, maxgap, num, i, k, n, d, err;
+  slg_dstats         dstats;
+
+  err = 0;
+
+  /* invalid max. gap length */
+  ref_rand_dtemper (&dtemper);
+  memcpy (&dtemper2, &dtemper, sizeof(slg_dtemper));
+  if ((slg_dtemper_interpolate (&dtemper, 0) != CNERR) ||
+      (slg_dtemper_interpolate (&dtemper, IPL_MAX_GAP + 1) != CNERR) ||
+      (memcmp (&dtemper, &dtemper2, sizeof(slg_dtemper)) != 0)) err = 1;
 
+  for (run = 0; run < 500; run++) {
+    /* random day with gaps of maxgap - 1 .. maxgap + 1 values, leading and trailing gap */
+    maxgap = 1 + rand () % IPL_MAX_GAP;
+    if ((run % 3) == 0) maxgap = 1 + rand () % 6;
+    ref_rand_dtemper (&dtemper);
+    for (i = 0; i < dtemper.tlen; i += n + 1 + rand () % 8) {
+      n = maxgap - 1 + rand () % 3;
+      for (k = i; (k < i + n) && (k < dtemper.tlen); k++) dtemper.val[k] = CNERR;
+    }
+    if (run % 2) {
+      for (i = 0; i < dtemper.tlen; i++) {
+        if (dtemper.val[i] != CNERR) dtemper.val[i] = - dtemper.val[i];
+      }
+    }
 
-/* reference: increases a date by one day
+    memcpy (&dtemper2, &dtemper, sizeof(slg_dtemper));
+    num = ref_interpolate (dtemper.val, out, dtemper.tlen, maxgap, ipol);
+    if (slg_dtemper_interpolate (&dtemper, maxgap) != num) err = 1;
+    if ((memcmp (dtemper.val, out, dtemper.tlen * sizeof(int32_t)) != 0) ||
+        (memcmp (dtemper.ipol, ipol, sizeof(dtemper.ipol)) != 0)) err = 1;
+    for (i = 0; i < dtemper.tlen; i++) {
+      if (slg_dtemper_is_ipol (&dtemper, i) != ((ipol[i / 32] >> (i % 32)) & 1)) err = 1;
+    }
+
+    /* negated day gives negated values */
+    for (i = 0; i < dtemper2.tlen; i++) {
+      if (dtemper2.val[i] != CNERR) dtemper2.val[i] = - dtemper2.val[i];
+    }
+    slg_dtemper_interpolate (&dtemper2, maxgap);
+    for (i = 0; i < dtemper.tlen; i++) {
+      if ((dtemper.val[i] != CNERR) && (dtemper2.val[i] != - dtemper.val[i])) err = 1;
+      if ((dtemper.val[i] == CNERR) && (dtemper2.val[i] != CNERR)) err = 1;
+    }
+  }
+
+  /* exact max. gap, one more, leading and trailing gaps, rounding of a falling slope */
+  ref_rand_dtemper (&dtemper);
+  for (i = 0; i < dtemper.tlen; i++) dtemper.val[i] = CNERR;
+  dtemper.val[3] = 100;
+  dtemper.val[8] = 97;      /* gap of 4: 99.4 98.8 98.2 97.6 -> 99 99 98 98 */
+  dtemper.val[14] = 50;     /* gap of 5 */
+  dtemper.val[86] = -100;
+  dtemper.val[91] = -97;    /* gap of 4 (negated values of the first one), trailing gap */
+  if (slg_dtemper_interpolate (&dtemper, 4) != 8) err = 1;
+  if ((dtemper.val[4] != 99) || (dtemper.val[5] != 99) || (dtemper.val[6] != 98) ||
+      (dtemper.val[7] != 98)) err = 1;
+  if ((dtemper.val[87] != -99) || (dtemper.val[88] != -99) || (dtemper.val[89] != -98) ||
+      (dtemper.val[90] != -98)) err = 1;
+  for (i = 0; i < dtemper.tlen; i++) {
+    if (((i < 3) || ((i > 8) && (i < 14)) || (i > 91)) && (dtemper.val[i] != CNERR)) err = 1;
+  }
+  if ((dtemper.ipol[0] != 0xf0) || (dtemper.ipol[1] != 0) || (dtemper.ipol[2] != ((uint32_t) 0xf << 23))) err = 1;
+
+  /* month: gap over midnight of days 1 and 2, short gaps at the end of day 3 and the
+   * start of day 5 around missing day 4 (its old values must not be used) */
+  memset (&mtemper, 0, sizeof(slg_mtemper));
+  for (d = 0; d < 6; d++) {
+    ref_rand_dtemper (&mtemper.dtemper[d]);
+    for (i = 0; i < MAX_MLN_NUM; i++) mtemper.dtemper[d].val[i] = 100 + (int32_t) (i % 5);
+    mtemper.dvalid[d] = (d == 4) ? 0 : 1;
+  }
+  for (i = 93; i < 96; i++) mtemper.dtemper[1].val[i] = CNERR;
+  for (i = 0; i < 2; i++) mtemper.dtemper[2].val[i] = CNERR;
+  mtemper.dtemper[1].val[92] = 100;
+  mtemper.dtemper[2].val[2] = 160;
+  mtemper.dtemper[3].val[94] = CNERR;
+  mtemper.dtemper[3].val[95] = CNERR;
+  mtemper.dtemper[5].val[0] = CNERR;
+  for (d = 0; d < 6; d++) slg_dtemper_stats (&mtemper.dtemper[d], &mtemper.dstats[d]);
+  memcpy (&mtemper2, &mtemper, sizeof(slg_mtemper));
+
+  for (d = 0; d < 31; d++) {
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      val[d * MAX_MLN_NUM + i] = ((d < 6) && (d != 4)) ? mtemper.dtemper[d].val[i] : CNERR;
+    }
+  }
+  num = ref_interpolate (val, out, IPL_MAX_LEN, IPL_MAX_GAP, ipol);
+  if (slg_mtemper_interpolate (&mtemper, IPL_MAX_GAP) != num) err = 1;
+  for (d = 0; d < 6; d++) {
+    if (d == 4) continue;
+    if (memcmp (mtemper.dtemper[d].val, &out[d * MAX_MLN_NUM], sizeof(mtemper.dtemper[d].val)) != 0) err = 1;
+    slg_dtemper_stats (&mtemper.dtemper[d], &dstats);
+    if (ref_dstats_cmp (&mtemper.dstats[d], &dstats) != 0) err = 1;
+  }
+  if ((mtemper.dtemper[1].val[93] != 110) || (mtemper.dtemper[1].val[95] != 130) ||
+      (mtemper.dtemper[2].val[1] != 150) || (mtemper.dtemper[1].ipol[2] != ((uint32_t) 7 << 29)) ||
+      (mtemper.dtemper[2].ipol[0] != 3)) err = 1;
+  if ((memcmp (&mtemper.dtemper[4], &mtemper2.dtemper[4], sizeof(slg_dtemper)) != 0) ||
+      (mtemper.dtemper[5].ipol[0] != 0) || (mtemper.dtemper[3].ipol[2] != 0) ||
+      (mtemper.dtemper[3].val[95] != CNERR) || (mtemper.dtemper[5].val[0] != CNERR)) err = 1;
+
+  return (ref_result ("slg_interpolate", err));
+}
+
+
+/* checks a normals table of random dayfiles of three years incl. the leap year 2020
+ * (days around 29.02. and in July) against averages and nearest rank percentiles of the
+ * day summaries in the window of 29.02. and of an ordinary day, and the identity of the
+ * tables of 1 and more threads
  *
- * parameters:
- *   *date:      pointer to date to be increased
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_normals (void)
+{
+  static slg_daydata daydata;
+  static slg_normals normals, normals2;
+  static int32_t     val[MAX_MLN_NUM], inv[MAX_MLN_NUM];
+  int32_t            davg[200], dmin[200], dmax[200], sv[3][200];
+  uint32_t           ddoy[200], doy[2] = {59, 200}, tnum[3] = {2, 5, NRM_MAX_THREADS};
+  uint32_t           y, i, k, n, num, dist, rank, err;
+  int64_t            sum[3];
+  slg_date           date;
+  slg_dstats         dstats;
+  slg_nrment         *nent;
+  char               fname[300], temp[20];
+
+  err = 0;
+  mkdir ("slg_test_nrm", 0755);
+
+  /* random days 20.02. .. 10.03. and 10.07. .. 25.07. of 2019 .. 2021 */
+  for (i = 0; i < MAX_MLN_NUM; i++) inv[i] = CNERR;
+  num = 0;
+  for (y = 2019; y <= 2021; y++) {
+    slg_date_set_int (&date, 20, 2, y);
+    while ((date.m < 7) || ((date.m == 7) && (date.d <= 25))) {
+      if ((date.m == 3) && (date.d > 10)) {
+        slg_date_set_int (&date, 10, 7, y);
+      }
+      for (i = 0; i < MAX_MLN_NUM; i++) {
+        val[i] = ((rand () % 1000) < TST_INVPM) ? CNERR : (rand () % 300) - 100 + (int32_t) (date.m * 20);
+      }
+      ref_dstats (&dstats, val, MAX_MLN_NUM);
+      ddoy[num] = slg_normals_doy (&date);
+      davg[num] = slg_dstats_average (&dstats);
+      dmin[num] = dstats.min;
+      dmax[num] = dstats.max;
+      num++;
+
+      ref_daydata (&daydata, &date, val, inv, inv);
+      slg_date_to_fstring (temp, &date);
+      sprintf (fname, "slg_test_nrm/%s.txt", temp);
+      slg_writedayfile (fname, &daydata, 0);
+      slg_date_inc (&date);
+    }
+  }
+
+  /* leap year calendar */
+  slg_date_set_int (&date, 29, 2, 2020);
+  if (slg_normals_doy (&date) != 59) err = 1;
+  slg_date_set_int (&date, 1, 3, 2019);
+  if (slg_normals_doy (&date) != 60) err = 1;
+  slg_date_set_int (&date, 29, 2, 2019);
+  if (slg_normals_doy (&date) != CNERR) err = 1;
+
+  if (slg_normals_build (&normals, &daydata, "slg_test_nrm/", 2019, 2021, 0, 3, 1, NULL) != 0) err = 1;
+
+  /* window of 29.02. and of 19.07. against day summaries */
+  for (k = 0; k < 2; k++) {
+    n = 0;
+    sum[0] = 0;
+    sum[1] = 0;
+    sum[2] = 0;
+    for (i = 0; i < num; i++) {
+      dist = (ddoy[i] > doy[k]) ? ddoy[i] - doy[k] : doy[k] - ddoy[i];
+      if (dist > 3) continue;
+      sv[0][n] = davg[i];
+      sv[1][n] = dmin[i];
+      sv[2][n] = dmax[i];
+      sum[0] += davg[i];
+      sum[1] += dmin[i];
+      sum[2] += dmax[i];
+      n++;
+    }
+    for (i = 0; i < 3; i++) qsort (sv[i], n, sizeof(int32_t), ref_cmp_int32);
+    if (n != ((k == 0) ? 19 : 21)) err = 1;
+
+    slg_date_set_int (&date, (k == 0) ? 29 : 19, (k == 0) ? 2 : 7, 2020);
+    nent = slg_normals_get (&normals, 0, &date);
+    if (nent == NULL) return (ref_result ("slg_normals", 1));
+    rank = (100 * n + 999) / 1000;
+    if ((nent->count != n) || (nent->avg != (int32_t) (sum[0] / n)) ||
+        (nent->avgmin != (int32_t) (sum[1] / n)) || (nent->avgmax != (int32_t) (sum[2] / n))) err = 1;
+    if ((nent->p10 != sv[0][rank-1]) || (nent->p10min != sv[1][rank-1])) err = 1;
+    rank = (900 * n + 999) / 1000;
+    if ((nent->p90 != sv[0][rank-1]) || (nent->p90max != sv[2][rank-1])) err = 1;
+  }
+
+  /* day of year without days in window, 1 and more threads */
+  slg_date_set_int (&date, 1, 5, 2020);
+  if (slg_normals_get (&normals, 0, &date) != NULL) err = 1;
+  for (i = 0; i < 3; i++) {
+    if (slg_normals_build (&normals2, &daydata, "slg_test_nrm/", 2019, 2021, 0, 3, tnum[i], NULL) != 0) err = 1;
+    if (memcmp (&normals2, &normals, sizeof(slg_normals)) != 0) err = 1;
+  }
+
+  /* remove files */
+  for (y = 2019; y <= 2021; y++) {
+    slg_date_set_int (&date, 1, 1, y);
+    while (date.y == y) {
+      slg_date_to_fstring (temp, &date);
+      sprintf (fname, "slg_test_nrm/%s.txt", temp);
+      remove (fname);
+      slg_date_inc (&date);
+    }
+  }
+  rmdir ("slg_test_nrm");
+
+  return (ref_result ("slg_normals", err));
+}
+
+
+/* checks anomaly summaries of fixed series (sum, truncated average, newest min. and max.,
+ * warm and cold days, invalid anomalies) and cumulative anomalies
  *
  * return value:
- *   -
+ *   0 :  all checks passed
+ *   1 :  check failed
  *
  ****************************************************************************************/
-void ref_date_inc (slg_date *date)
+uint32_t test_anomaly (void)
 {
-  uint32_t dpm[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  static const struct {
+    uint32_t len;
+    int32_t  anom[8];
+    uint32_t ret;
+    slg_nrmanom nanom;      /* dnum, sum, avg, min, max, imin, imax, nwarm, ncold */
+    int32_t  cum[8];
+  } tab[] = {
+    {0, {0}, 1, {0, 0, CNERR, CNERR, CNERR, 0, 0, 0, 0}, {0}},
+    {3, {CNERR, CNERR, CNERR}, 1, {0, 0, CNERR, CNERR, CNERR, 0, 0, 0, 0}, {0, 0, 0}},
+    {1, {5}, 0, {1, 5, 5, 5, 5, 0, 0, 1, 0}, {5}},
+    {5, {3, -2, 3, -2, 0}, 0, {5, 2, 0, -2, 3, 3, 2, 2, 2}, {3, 1, 4, 2, 2}},
+    {5, {-7, CNERR, -3, -7, CNERR}, 0, {3, -17, -5, -7, -3, 3, 2, 0, 3}, {-7, -7, -10, -17, -17}},
+    {3, {0, 0, 0}, 0, {3, 0, 0, 0, 0, 2, 2, 0, 0}, {0, 0, 0}},
+    {7, {CNERR, 10, -10, 10, -10, CNERR, 4}, 0, {5, 4, 0, -10, 10, 4, 3, 3, 2}, {0, 10, 0, 10, 0, 0, 4}},
+    {2, {-1, -2}, 0, {2, -3, -1, -2, -1, 1, 0, 0, 2}, {-1, -3}},
+    {8, {CNERR, 1, 2, 3, 4, 5, 6, CNERR}, 0, {6, 21, 3, 1, 6, 1, 6, 6, 0}, {0, 1, 3, 6, 10, 15, 21, 21}}
+  };
+  int32_t     anom[8], cum[8];
+  uint32_t    i, err;
+  slg_nrmanom nanom;
 
-  if (slg_year_is_leap_t(date->y)) dpm[1] = 29;
+  err = 0;
 
-  date->d += 1;
-  if (date->d > dpm[date->m -1]) {
-    date->d = 1;
-    date->m += 1;
-    if (date->m > 12) {
-      date->m = 1;
-      date->y += 1;
+  for (i = 0; i < sizeof(tab) / sizeof(tab[0]); i++) {
+    memcpy (anom, tab[i].anom, sizeof(anom));
+    if (slg_normals_anomaly_stats (anom, tab[i].len, &nanom) != tab[i].ret) err = 1;
+    if (memcmp (&nanom, &tab[i].nanom, sizeof(slg_nrmanom)) != 0) err = 1;
+
+    /* separate and in place */
+    slg_normals_cumulate (anom, tab[i].len, cum);
+    if (memcmp (cum, tab[i].cum, tab[i].len * sizeof(int32_t)) != 0) err = 1;
+    slg_normals_cumulate (anom, tab[i].len, anom);
+    if (memcmp (anom, tab[i].cum, tab[i].len * sizeof(int32_t)) != 0) err = 1;
+  }
+
+  return (ref_result ("slg_anomaly", err));
+}
+
+
+/* checks approximate quantiles of sketches against sorted random arrays of unbounded
+ * values (relative error max. 1/(2*SKT_SUB), CNERR values), the buckets of single
+ * values and the order of merges
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_sketch (void)
+{
+  static int32_t    val[3000], sval[3000], pval[3000];
+  static slg_sketch sketch, sketchm[2], sketchp[4];
+  uint32_t          pm[8] = {0, 1, 50, 500, 950, 999, 1000, 0};
+  uint32_t          run, len, n, np, num, i, k, b, rank, part[5], err;
+  int32_t           ref, v;
+  int64_t           d;
+
+  err = 0;
+
+  /* buckets: exact small values, representative value in its own bucket, order */
+  for (v = - 2 * SKT_SUB; v <= 2 * SKT_SUB; v++) {
+    if (slg_sketch_value (slg_sketch_bin (v)) != v) err = 1;
+  }
+  if ((slg_sketch_bin (0) != SKT_ZERO) || (slg_sketch_bin (INT32_MIN) != 0) ||
+      (slg_sketch_bin (INT32_MAX) >= SKT_BINS)) err = 1;
+  for (b = 0; b < SKT_BINS - 1; b++) {
+    if (slg_sketch_bin (slg_sketch_value (b)) != b) err = 1;
+    if ((b > 0) && (slg_sketch_value (b) <= slg_sketch_value (b - 1))) err = 1;
+  }
+
+  /* empty sketch and invalid quantile */
+  slg_sketch_clear (&sketch);
+  if ((slg_sketch_quantile (&sketch, 500) != CNERR) ||
+      (slg_sketch_quantile_pos (&sketch, 500) != CNERR)) err = 1;
+
+  for (run = 0; run < 200; run++) {
+    len = 1 + rand () % 3000;
+    n = 0;
+    np = 0;
+    for (i = 0; i < len; i++) {
+      /* magnitudes of all powers of 2, both signs */
+      val[i] = (int32_t) (((uint32_t) rand () & 0x7fffffff) >> (rand () % 31));
+      if (rand () % 2) val[i] = - val[i];
+      if ((run % 4) == 0) val[i] = (rand () % 201) - 100;  /* many ties, exact buckets */
+      if (((run % 4) == 1) && (i < 2)) val[i] = (i == 0) ? INT32_MIN : INT32_MAX;   /* limits */
+      if ((rand () % 1000) < TST_INVPM) val[i] = CNERR;
+      if (val[i] == CNERR) continue;
+      sval[n++] = val[i];
+      if (val[i] > 0) pval[np++] = val[i];
+    }
+    qsort (sval, n, sizeof(int32_t), ref_cmp_int32);
+    qsort (pval, np, sizeof(int32_t), ref_cmp_int32);
+
+    slg_sketch_clear (&sketch);
+    slg_sketch_add (&sketch, val, len);
+    if (sketch.count != n) err = 1;
+    if ((slg_sketch_quantile (&sketch, 1001) != CNERR) ||
+        (slg_sketch_quantile_pos (&sketch, 1001) != CNERR)) err = 1;
+
+    /* quantiles against rank in sorted arrays (all and positive values) */
+    pm[7] = rand () % 1001;
+    for (k = 0; k < 16; k++) {
+      num = (k < 8) ? n : np;
+      v = (k < 8) ? slg_sketch_quantile (&sketch, pm[k%8]) : slg_sketch_quantile_pos (&sketch, pm[k%8]);
+      if (num == 0) {
+        if (v != CNERR) err = 1;
+        continue;
+      }
+      rank = (pm[k%8] * num + 999) / 1000;
+      if (rank == 0) rank = 1;
+      ref = (k < 8) ? sval[rank-1] : pval[rank-1];
+      d = (int64_t) v - ref;
+      if (d < 0) d = - d;
+      if (d * 2 * SKT_SUB > ((ref < 0) ? - (int64_t) ref : ref)) err = 1;
+      if (v != slg_sketch_value (slg_sketch_bin (ref))) err = 1;
+    }
+
+    /* four parts merged in forward and reverse order */
+    part[0] = 0;
+    part[4] = n;
+    for (k = 1; k < 4; k++) part[k] = part[k-1] + rand () % (n - part[k-1] + 1);
+    for (k = 0; k < 4; k++) {
+      slg_sketch_clear (&sketchp[k]);
+      slg_sketch_add (&sketchp[k], &sval[part[k]], part[k+1] - part[k]);
+    }
+    slg_sketch_clear (&sketchm[0]);
+    slg_sketch_clear (&sketchm[1]);
+    for (k = 0; k < 4; k++) {
+      slg_sketch_merge (&sketchm[0], &sketchp[k]);
+      slg_sketch_merge (&sketchm[1], &sketchp[3-k]);
+    }
+    if ((memcmp (&sketchm[0], &sketch, sizeof(slg_sketch)) != 0) ||
+        (memcmp (&sketchm[1], &sketch, sizeof(slg_sketch)) != 0)) err = 1;
+  }
+
+  return (ref_result ("slg_sketch", err));
+}
+
+
+/* checks day types at their thresholds (frost and ice day: -0.1 / 0.0 degree, summer and
+ * hot day: 25.0 / 30.0 degree, rain day: 0.09 / 0.10 mm) and the day type counters
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_daytype (void)
+{
+  static const struct {
+    uint32_t typ;
+    int32_t  val[4];        /* values of day (CNERR: invalid value) */
+    uint32_t dtype;         /* expected bit mask of day types */
+  } tab[] = {
+    {DF_TEMP, {CNERR, CNERR, CNERR, CNERR}, 0},
+    {DF_TEMP, {0, 100, CNERR, 50}, 0},
+    {DF_TEMP, {-1, 100, CNERR, 50}, 1 << CLM_FROST},
+    {DF_TEMP, {-50, CNERR, 0, -20}, 1 << CLM_FROST},
+    {DF_TEMP, {-50, CNERR, -1, -20}, (1 << CLM_FROST) | (1 << CLM_ICE)},
+    {DF_TEMP, {100, 249, 180, CNERR}, 0},
+    {DF_TEMP, {100, 250, 180, CNERR}, 1 << CLM_SUMMER},
+    {DF_TEMP, {100, 299, 180, CNERR}, 1 << CLM_SUMMER},
+    {DF_TEMP, {100, 300, 180, CNERR}, (1 << CLM_SUMMER) | (1 << CLM_HOT)},
+    {DF_TEMP, {-1, 300, CNERR, CNERR}, (1 << CLM_FROST) | (1 << CLM_SUMMER) | (1 << CLM_HOT)},
+    {DF_TEMP, {10, 20, 30, 40}, 0},
+    {DF_RAIN, {CNERR, CNERR, CNERR, CNERR}, 0},
+    {DF_RAIN, {0, 0, 0, 0}, 0},
+    {DF_RAIN, {9, CNERR, 0, 0}, 0},
+    {DF_RAIN, {10, CNERR, 0, 0}, 1 << CLM_RAIN},
+    {DF_RAIN, {4, 0, 5, CNERR}, 0},
+    {DF_RAIN, {4, 0, 6, CNERR}, 1 << CLM_RAIN},
+    {DF_RAIN, {300, 0, 0, 0}, 1 << CLM_RAIN},
+    {DF_EVNT, {-1, 300, 10, 0}, 0}
+  };
+  uint32_t   cnt[CLM_NUM], ref[CLM_NUM];
+  uint32_t   i, k, err;
+  int32_t    val[4];
+  slg_dstats dstats;
+
+  err = 0;
+  memset (cnt, 0, sizeof(cnt));
+  memset (ref, 0, sizeof(ref));
+
+  for (i = 0; i < sizeof(tab) / sizeof(tab[0]); i++) {
+    memcpy (val, tab[i].val, sizeof(val));
+    slg_dstats_calc (&dstats, val, 4);
+    if (slg_climate_daytype (tab[i].typ, &dstats) != tab[i].dtype) err = 1;
+
+    slg_climate_count (cnt, tab[i].dtype);
+    for (k = 0; k < CLM_NUM; k++) {
+      if (tab[i].dtype & (1 << k)) ref[k]++;
+    }
+  }
+  if (memcmp (cnt, ref, sizeof(cnt)) != 0) err = 1;
+
+  return (ref_result ("slg_daytype", err));
+}
+
+
+/* checks heating and cooling degree days of both methods on fixed days (truncated day
+ * average, rounded slot average), then degree day sums of a rollup index against the
+ * sums of the month objects read from the same random dayfiles and against the days
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_dd (void)
+{
+  static const struct {
+    int32_t  val[4];        /* values of day (CNERR: invalid value) */
+    int32_t  base;
+    uint32_t ret;
+    int32_t  dd[4];         /* hdd and cdd of CLM_DD_MEAN, hdd and cdd of CLM_DD_SLOT */
+  } tab[] = {
+    {{CNERR, CNERR, CNERR, CNERR}, 180, 1, {0, 0, 0, 0}},
+    {{100, 200, CNERR, 300}, 180, 0, {0, 20, 27, 47}},
+    {{100, 200, 300, 180}, 180, 0, {0, 15, 20, 35}},
+    {{100, 120, CNERR, CNERR}, 180, 0, {70, 0, 70, 0}},
+    {{-55, -45, CNERR, CNERR}, 150, 0, {200, 0, 200, 0}},
+    {{181, 181, 180, 180}, 180, 0, {0, 0, 0, 1}},
+    {{-1, -2, CNERR, CNERR}, 0, 0, {1, 0, 2, 0}},
+    {{150, 150, 150, 150}, 150, 0, {0, 0, 0, 0}}
+  };
+  static int32_t       tv[60 * MAX_MLN_NUM], rv[60 * MAX_MLN_NUM], ev[60 * MAX_MLN_NUM];
+  static slg_daydata   daydata;
+  static slg_monthdata monthdata;
+  static slg_mtemper   mtemper;
+  static slg_rollup    rollup;
+  uint32_t             exist[60];
+  uint32_t             d, i, m, n, method, dnum, rdnum, nupd, err;
+  int32_t              val[4], hdd, cdd, h, c, rhdd, rcdd, mhdd[2], mcdd[2], base;
+  slg_date             date0, date, date_b, date_e;
+  char                 fname[300], temp[20];
+
+  err = 0;
+
+  /* fixed days */
+  for (i = 0; i < sizeof(tab) / sizeof(tab[0]); i++) {
+    for (method = CLM_DD_MEAN; method <= CLM_DD_SLOT; method++) {
+      memcpy (val, tab[i].val, sizeof(val));
+      if (slg_climate_dd (val, 4, tab[i].base, method, &hdd, &cdd) != tab[i].ret) err = 1;
+      if ((hdd != tab[i].dd[2 * method]) || (cdd != tab[i].dd[2 * method + 1])) err = 1;
+    }
+    if ((slg_climate_dd (val, 4, tab[i].base, 2, &hdd, &cdd) != 2) || (hdd != 0) || (cdd != 0)) err = 1;
+  }
+
+  /* random days 01.01.2024 .. 29.02.2024, every 11th day is missing, one day without
+     valid temperatures */
+  mkdir ("slg_test_dd", 0755);
+  slg_date_set_int (&date0, 1, 1, 2024);
+  slg_date_copy (&date, &date0);
+  for (d = 0; d < 60; d++) {
+    exist[d] = ((d % 11) == 4) ? 0 : 1;
+    base = (rand () % 350) - 100;
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      n = d * MAX_MLN_NUM + i;
+      tv[n] = ((rand () % 1000) < TST_INVPM) ? CNERR : base + rand () % 101;
+      rv[n] = ((rand () % 5) == 0) ? rand () % 300 : 0;
+      ev[n] = rand () % 2;
+      if (d == 33) tv[n] = CNERR;
+    }
+    if (exist[d]) {
+      ref_daydata (&daydata, &date, &tv[d * MAX_MLN_NUM], &rv[d * MAX_MLN_NUM], &ev[d * MAX_MLN_NUM]);
+      slg_date_to_fstring (temp, &date);
+      sprintf (fname, "slg_test_dd/%s.txt", temp);
+      slg_writedayfile (fname, &daydata, 0);
+    }
+    slg_date_inc (&date);
+  }
+
+  if (slg_rollup_create ("slg_test_dd/rollup.idx", &daydata, 2024, 2024) != 0) err = 1;
+  if (slg_rollup_open (&rollup, "slg_test_dd/rollup.idx", 1) != 0) {
+    return (ref_result ("slg_dd", 1));
+  }
+  slg_date_set_int (&date_e, 29, 2, 2024);
+  if (slg_rollup_update_range (&rollup, "slg_test_dd/", &date0, &date_e, 0, &nupd) != 0) err = 1;
+
+  for (method = CLM_DD_MEAN; method <= CLM_DD_SLOT; method++) {
+    /* months: rollup against month objects */
+    mhdd[0] = 0;
+    mcdd[0] = 0;
+    n = 0;
+    for (m = 1; m <= 2; m++) {
+      if ((slg_readmonth (&monthdata, "slg_test_dd/", 2024, m, 0) != 0) ||
+          (slg_mtemper_read (&mtemper, &monthdata, 1) != 0)) err = 1;
+      dnum = slg_climate_mtemper_dd (&mtemper, 150, method, &mhdd[1], &mcdd[1]);
+
+      slg_date_set_int (&date_b, 1, m, 2024);
+      slg_date_set_int (&date_e, (m == 1) ? 31 : 29, m, 2024);
+      if (slg_rollup_dd (&rollup, 0, &date_b, &date_e, 150, method, &hdd, &cdd, &rdnum) != 0) err = 1;
+      if ((hdd != mhdd[1]) || (cdd != mcdd[1]) || (rdnum != dnum)) err = 1;
+      mhdd[0] += mhdd[1];
+      mcdd[0] += mcdd[1];
+      n += dnum;
+    }
+    slg_date_set_int (&date_e, 29, 2, 2024);
+    if (slg_rollup_dd (&rollup, 0, &date0, &date_e, 150, method, &hdd, &cdd, &rdnum) != 0) err = 1;
+    if ((hdd != mhdd[0]) || (cdd != mcdd[0]) || (rdnum != n) || (n != 60 - 6 - 1)) err = 1;
+
+    /* range over a month change: rollup against days */
+    rhdd = 0;
+    rcdd = 0;
+    n = 0;
+    for (d = 14; d <= 40; d++) {
+      if (exist[d] && (slg_climate_dd (&tv[d * MAX_MLN_NUM], MAX_MLN_NUM, 150, method, &h, &c) == 0)) {
+        rhdd += h;
+        rcdd += c;
+        n++;
+      }
+    }
+    slg_date_set_int (&date_b, 15, 1, 2024);
+    slg_date_set_int (&date_e, 10, 2, 2024);
+    if (slg_rollup_dd (&rollup, 0, &date_b, &date_e, 150, method, &hdd, &cdd, &rdnum) != 0) err = 1;
+    if ((hdd != rhdd) || (cdd != rcdd) || (rdnum != n)) err = 1;
+  }
+
+  /* rain column, invalid method and range */
+  if (slg_rollup_dd (&rollup, 1, &date_b, &date_e, 150, CLM_DD_MEAN, &hdd, &cdd, &rdnum) != 1) err = 1;
+  if (slg_rollup_dd (&rollup, 0, &date_b, &date_e, 150, 2, &hdd, &cdd, &rdnum) != 1) err = 1;
+  if (slg_rollup_dd (&rollup, 0, &date_e, &date_b, 150, CLM_DD_MEAN, &hdd, &cdd, &rdnum) != 1) err = 1;
+  slg_rollup_close (&rollup);
+
+  /* remove files */
+  slg_date_copy (&date, &date0);
+  for (d = 0; d < 60; d++) {
+    slg_date_to_fstring (temp, &date);
+    sprintf (fname, "slg_test_dd/%s.txt", temp);
+    if (exist[d]) remove (fname);
+    slg_date_inc (&date);
+  }
+  remove ("slg_test_dd/rollup.idx");
+  remove ("slg_test_dd/rollup.idx" RLP_SEXT);
+  rmdir ("slg_test_dd");
+
+  return (ref_result ("slg_dd", err));
+}
+
+
+/* checks correlation of random series with shifted copies of themselves (best lag and its
+ * sign, invalid pairs masked), the coefficient of lag 0 and the difference statistics
+ * against references, and constant or too short series
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_correl (void)
+{
+  static int32_t a[400], b[400], diff[400];
+  uint32_t       run, len, i, n, err;
+  int32_t        k, j, rref;
+  int64_t        sa, sb, saa, sbb, sab;
+  double         d;
+  slg_dstats     dstats;
+  slg_correl     correl;
+
+  err = 0;
+
+  for (run = 0; run < 50; run++) {
+    len = 100 + rand () % 301;
+    k = 1 + rand () % 20;
+    if (run % 2) k = - k;
+
+    /* b[i+k] = a[i], b is valid where a is invalid (pair must be masked) and some values of
+       b are invalid */
+    for (i = 0; i < len; i++) {
+      a[i] = ((rand () % 1000) < TST_INVPM) ? CNERR : (rand () % 2001) - 1000;
+      b[i] = (rand () % 2001) - 1000;
+    }
+    for (i = 0; i < len; i++) {
+      j = (int32_t) i + k;
+      if ((j >= 0) && (j < (int32_t) len) && (a[i] != CNERR)) b[j] = a[i];
+    }
+    for (i = 0; i < len; i++) {
+      if ((rand () % 1000) < TST_INVPM) b[i] = CNERR;
+    }
+
+    if (slg_correl_series (a, b, len, 20, &correl) != 0) err = 1;
+    if ((correl.lag != k) || (correl.rlag != 1000)) err = 1;
+
+    /* lag 0 against sums of valid pairs */
+    n = 0;
+    sa = 0;
+    sb = 0;
+    saa = 0;
+    sbb = 0;
+    sab = 0;
+    for (i = 0; i < len; i++) {
+      if ((a[i] == CNERR) || (b[i] == CNERR)) continue;
+      n++;
+      sa += a[i];
+      sb += b[i];
+      saa += (int64_t) a[i] * a[i];
+      sbb += (int64_t) b[i] * b[i];
+      sab += (int64_t) a[i] * b[i];
+    }
+    d = ((double) n * sab - (double) sa * sb) /
+        sqrt (((double) n * saa - (double) sa * sa) * ((double) n * sbb - (double) sb * sb));
+    rref = (int32_t) floor (d * 1000.0 + 0.5);
+    if ((correl.count != n) || (correl.r == CNERR) || (abs (correl.r - rref) > 1)) err = 1;
+
+    /* difference statistics */
+    if (slg_correl_diff (a, b, len, diff) != n) err = 1;
+    slg_dstats_calc (&dstats, diff, len);
+    if (memcmp (&dstats, &correl.diff, sizeof(slg_dstats)) != 0) err = 1;
+  }
+
+  /* constant series and less than 2 pairs */
+  for (i = 0; i < 100; i++) {
+    a[i] = 150;
+    b[i] = (rand () % 2001) - 1000;
+  }
+  if ((slg_correl_series (a, b, 100, 10, &correl) != 0) || (correl.count != 100) ||
+      (correl.r != CNERR) || (correl.rlag != CNERR) || (correl.lag != 0)) err = 1;
+  if ((slg_correl_series (b, a, 100, 10, &correl) != 0) || (correl.r != CNERR) ||
+      (correl.rlag != CNERR)) err = 1;
+  for (i = 1; i < 100; i++) a[i] = CNERR;
+  a[0] = 10;
+  if ((slg_correl_series (b, a, 100, 0, &correl) != 0) || (correl.count != 1) || (correl.r != CNERR)) err = 1;
+
+  /* invalid max. lag */
+  if (slg_correl_series (a, b, 100, COR_MAX_LAG + 1, &correl) != 1) err = 1;
+
+  return (ref_result ("slg_correl", err));
+}
+
+
+/* checks the result cache: hits and misses of stored results in memory and in a cache
+ * file, misses after a touched, added or removed dayfile (fingerprint changes), LRU
+ * replacement of in-memory entries, a damaged entry of the cache file and an invalid
+ * cache file
+ *
+ * return value:
+ *   0 :  all checks passed
+ *   1 :  check failed
+ *
+ ****************************************************************************************/
+uint32_t test_cache (void)
+{
+  static int32_t     tv[5 * MAX_MLN_NUM], rv[5 * MAX_MLN_NUM], ev[5 * MAX_MLN_NUM];
+  static slg_daydata daydata;
+  static slg_cache   cache;
+  slg_cchkey         key[2];
+  slg_cchres         res[2], rres;
+  slg_cchent         ent;
+  slg_cchhead        head;
+  slg_date           date_b, date_e, date_s, date;
+  uint64_t           fp, fp2, fps;
+  uint32_t           d, i, k, err;
+  struct stat        st;
+  struct utimbuf     ut;
+  FILE               *f;
+  char               fname[300], temp[20];
+
+  err = 0;
+  mkdir ("slg_test_cch", 0755);
+
+  /* dayfiles 01.03.2024 .. 05.03.2024, 04.03.2024 is missing */
+  slg_date_set_int (&date_b, 1, 3, 2024);
+  slg_date_set_int (&date_e, 5, 3, 2024);
+  slg_date_copy (&date, &date_b);
+  for (d = 0; d < 5; d++) {
+    for (i = 0; i < MAX_MLN_NUM; i++) {
+      tv[d * MAX_MLN_NUM + i] = ref_rand_temper ();
+      rv[d * MAX_MLN_NUM + i] = rand () % 300;
+      ev[d * MAX_MLN_NUM + i] = rand () % 2;
+    }
+    ref_daydata (&daydata, &date, &tv[d * MAX_MLN_NUM], &rv[d * MAX_MLN_NUM], &ev[d * MAX_MLN_NUM]);
+    slg_date_to_fstring (temp, &date);
+    sprintf (fname, "slg_test_cch/%s.txt", temp);
+    if (d != 3) slg_writedayfile (fname, &daydata, 0);
+    slg_date_inc (&date);
+  }
+
+  /* two keys of range and results */
+  for (k = 0; k < 2; k++) {
+    memset (&key[k], 0, sizeof(slg_cchkey));
+    key[k].locid = 1;
+    key[k].typ = DF_TEMP;
+    key[k].colid = 1 + k;
+    key[k].op = CCH_OP_USER;
+    slg_date_copy (&key[k].date_b, &date_b);
+    slg_date_copy (&key[k].date_e, &date_e);
+    for (i = 0; i < CCH_VALNUM; i++) res[k].val[i] = ((int64_t) rand () << 20) - (int64_t) rand ();
+  }
+
+  /* fingerprints of range and of sub range 03.03.2024 .. 05.03.2024, invalid range */
+  fp = slg_cache_fingerprint ("slg_test_cch/", &date_b, &date_e);
+  slg_date_set_int (&date_s, 3, 3, 2024);
+  fps = slg_cache_fingerprint ("slg_test_cch/", &date_s, &date_e);
+  if ((fp == 0) || (fps == 0) || (fps == fp)) err = 1;
+  if ((slg_cache_fingerprint ("slg_test_cch/", &date_b, &date_e) != fp) ||
+      (slg_cache_fingerprint ("slg_test_cch/", &date_e, &date_b) != 0)) err = 1;
+
+  /* cache file: miss, put, hits */
+  remove ("slg_test_cch/cache.cch");
+  if (slg_cache_open (&cache, "slg_test_cch/cache.cch") != 0) err = 1;
+  if (slg_cache_get (&cache, &key[0], fp, &rres) != 1) err = 1;
+  slg_cache_put (&cache, &key[0], fp, &res[0]);
+  slg_cache_put (&cache, &key[1], fp, &res[1]);
+  for (k = 0; k < 2; k++) {
+    memset (&rres, 0, sizeof(slg_cchres));
+    if ((slg_cache_get (&cache, &key[k], fp, &rres) != 0) ||
+        (memcmp (&rres, &res[k], sizeof(slg_cchres)) != 0)) err = 1;
+  }
+  if (slg_cache_get (&cache, &key[0], fp + 1, &rres) != 1) err = 1;
+  if ((cache.nhit != 2) || (cache.nmiss != 2)) err = 1;
+  slg_cache_close (&cache);
+
+  /* reopened cache file: hits of file entries */
+  if (slg_cache_open (&cache, "slg_test_cch/cache.cch") != 0) err = 1;
+  for (k = 0; k < 2; k++) {
+    memset (&rres, 0, sizeof(slg_cchres));
+    if ((slg_cache_get (&cache, &key[k], fp, &rres) != 0) ||
+        (memcmp (&rres, &res[k], sizeof(slg_cchres)) != 0)) err = 1;
+  }
+
+  /* touched dayfile 02.03.2024: miss, sub range unchanged, result of key 0 is stored again */
+  if (stat ("slg_test_cch/2024-03-02.txt", &st) != 0) err = 1;
+  ut.actime = st.st_mtime + 100;
+  ut.modtime = st.st_mtime + 100;
+  utime ("slg_test_cch/2024-03-02.txt", &ut);
+  fp2 = slg_cache_fingerprint ("slg_test_cch/", &date_b, &date_e);
+  if ((fp2 == fp) || (slg_cache_get (&cache, &key[0], fp2, &rres) != 1)) err = 1;
+  if (slg_cache_fingerprint ("slg_test_cch/", &date_s, &date_e) != fps) err = 1;
+  slg_cache_put (&cache, &key[0], fp2, &res[0]);
+  if (slg_cache_get (&cache, &key[0], fp2, &rres) != 0) err = 1;
+  slg_cache_close (&cache);
+
+  /* added dayfile 04.03.2024 and removed dayfile 05.03.2024 */
+  slg_date_set_int (&date, 4, 3, 2024);
+  ref_daydata (&daydata, &date, &tv[3 * MAX_MLN_NUM], &rv[3 * MAX_MLN_NUM], &ev[3 * MAX_MLN_NUM]);
+  slg_writedayfile ("slg_test_cch/2024-03-04.txt", &daydata, 0);
+  if ((slg_cache_fingerprint ("slg_test_cch/", &date_s, &date_e) == fps) ||
+      (slg_cache_fingerprint ("slg_test_cch/", &date_b, &date_e) == fp2)) err = 1;
+  fps = slg_cache_fingerprint ("slg_test_cch/", &date_s, &date_e);
+  remove ("slg_test_cch/2024-03-05.txt");
+  if (slg_cache_fingerprint ("slg_test_cch/", &date_s, &date_e) == fps) err = 1;
+
+  /* damaged entry of key 0 in cache file: miss, entry of key 1 is still a hit */
+  f = fopen ("slg_test_cch/cache.cch", "r+b");
+  if (f == NULL) {
+    err = 1;
+  }
+  else {
+    fseek (f, (long) sizeof(slg_cchhead), SEEK_SET);
+    for (i = 0; i < CCH_FILENUM; i++) {
+      if (fread (&ent, sizeof(slg_cchent), 1, f) != 1) break;
+      if (memcmp (&ent.key, &key[0], sizeof(slg_cchkey)) == 0) break;
     }
+    if ((i < CCH_FILENUM) && (ent.fp == fp2)) {
+      ent.res.val[3] ^= 1;
+      fseek (f, (long) sizeof(slg_cchhead) + (long) i * (long) sizeof(slg_cchent), SEEK_SET);
+      fwrite (&ent, sizeof(slg_cchent), 1, f);
+    }
+    else {
+      err = 1;
+    }
+    fclose (f);
+  }
+  if (slg_cache_open (&cache, "slg_test_cch/cache.cch") != 0) err = 1;
+  if (slg_cache_get (&cache, &key[0], fp2, &rres) != 1) err = 1;
+  if ((slg_cache_get (&cache, &key[1], fp, &rres) != 0) ||
+      (memcmp (&rres, &res[1], sizeof(slg_cchres)) != 0)) err = 1;
+  slg_cache_close (&cache);
+
+  /* invalid cache file (version, magic): memory only */
+  for (k = 0; k < 2; k++) {
+    f = fopen ("slg_test_cch/cache.cch", "r+b");
+    if ((f == NULL) || (fread (&head, sizeof(slg_cchhead), 1, f) != 1)) {
+      err = 1;
+      if (f != NULL) fclose (f);
+      continue;
+    }
+    if (k == 0) head.version++;
+    if (k == 1) {
+      head.version--;
+      head.magic[0] = 'X';
+    }
+    fseek (f, 0, SEEK_SET);
+    fwrite (&head, sizeof(slg_cchhead), 1, f);
+    fclose (f);
+    if ((slg_cache_open (&cache, "slg_test_cch/cache.cch") != 2) || (cache.fd != -1)) err = 1;
+    slg_cache_close (&cache);
+  }
+
+  /* memory only: least recently used entry is replaced */
+  if (slg_cache_open (&cache, "") != 0) err = 1;
+  for (i = 0; i <= CCH_MEMNUM; i++) {
+    key[1].colid = 100 + i;
+    slg_cache_put (&cache, &key[1], fp, &res[1]);
+    if (i == CCH_MEMNUM - 1) {
+      key[1].colid = 100;
+      if (slg_cache_get (&cache, &key[1], fp, &rres) != 0) err = 1;
+    }
+  }
+  for (i = 0; i <= CCH_MEMNUM; i++) {
+    key[1].colid = 100 + i;
+    if (slg_cache_get (&cache, &key[1], fp, &rres) != ((i == 1) ? 1 : 0)) err = 1;
+  }
+  slg_cache_close (&cache);
+
+  /* remove files */
+  slg_date_copy (&date, &date_b);
+  for (d = 0; d < 5; d++) {
+    slg_date_to_fstring (temp, &date);
+    sprintf (fname, "slg_test_cch/%s.txt", temp);
+    remove (fname);
+    slg_date_inc (&date);
   }
+  remove ("slg_test_cch/cache.cch");
+  rmdir ("slg_test_cch");
+
+  return (ref_result ("slg_cache", err));
 }
 
 
@@ -95,6 +3194,7 @@ int main (int argc, char *argv[])
   char tempstr[20];
   slg_daydata wurst;
   slg_drain raini;
+  uint32_t err;
 
 
   /* help menu ************************************************************************************/
@@ -110,6 +3210,34 @@ int main (int argc, char *argv[])
   /***************************************************************************/
 
 
+  err = 0;
+  srand (TST_SEED);
+
+  err |= test_dtemper_stats ();
+  err |= test_merge ();
+  err |= test_rolling ();
+  err |= test_rainps ();
+  err |= test_event ();
+  err |= test_downsample ();
+  err |= test_metday ();
+  err |= test_resample ();
+  err |= test_simd ();
+  err |= test_live ();
+  err |= test_dnum ();
+  err |= test_rollup ();
+  err |= test_hist ();
+  err |= test_records ();
+  err |= test_aggr ();
+  err |= test_despike ();
+  err |= test_interpolate ();
+  err |= test_normals ();
+  err |= test_anomaly ();
+  err |= test_sketch ();
+  err |= test_daytype ();
+  err |= test_dd ();
+  err |= test_correl ();
+  err |= test_cache ();
+
 
 
 //  /***************************************************************************/
@@ -181,7 +3309,7 @@ int main (int argc, char *argv[])
 
 
 
-  return (0);
+  return ((err != 0) ? 1 : 0);
 }
 
 
@@ -0,0 +1,227 @@
+/***************************************************************************************************
+ *
+ * file     : slg_aggrgen.c (command line tool "senslog multi-year aggregation")
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../lib/options.h"
+#include "../../lib/slg_date.h"
+#include "../../lib/slg_values.h"
+#include "../../lib/slg_dayfile.h"
+#include "../../lib/slg_hist.h"
+#include "../../lib/slg_aggr.h"
+
+
+#define VERSION "senslog multi-year aggregation tool (version 0.1.0)"
+
+#define DEF_THREADS  4   /* default number of threads */
+
+
+/* global aggregation object (too large for stack) */
+slg_aggr aggr;
+
+
+
+/***************************************************************************************************
+ * print function
+ **************************************************************************************************/
+
+/* prints a partial aggregate
+ *
+ * parameters:
+ *   *part:  partial aggregate
+ *   tmode:  time_mode of dayfiles
+ *
+ ****************************************************************************************/
+void print_part (slg_aggrpart *part, uint32_t tmode)
+{
+  char s1[20], s2[20], s3[20];
+
+  printf ("%lu days", (unsigned long) part->dnum);
+  if (part->count == 0) {
+    printf (", no valid values\n");
+    return;
+  }
+
+  slg_temper2str (s1, 0, slg_aggr_average (part));
+  slg_temper2str (s2, 0, slg_aggr_daverage (part));
+  printf ("   avg %s (days %s)", s1, s2);
+
+  slg_temper2str (s1, 0, part->min);
+  slg_date_to_string (s2, &part->dmin);
+  slg_timeindex2str (s3, tmode, 0, part->imin);
+  printf ("   min %s (%s %s)", s1, s2, s3);
+
+  slg_temper2str (s1, 0, part->max);
+  slg_date_to_string (s2, &part->dmax);
+  slg_timeindex2str (s3, tmode, 0, part->imax);
+  printf ("   max %s (%s %s)", s1, s2, s3);
+
+  slg_temper2str (s1, 0, slg_hist_percentile (&part->hist, 100));
+  slg_temper2str (s2, 0, slg_hist_percentile (&part->hist, 500));
+  slg_temper2str (s3, 0, slg_hist_percentile (&part->hist, 900));
+  printf ("   p10 %s   median %s   p90 %s   (%lu values)\n", s1, s2, s3, (unsigned long) part->count);
+}
+
+
+
+/***************************************************************************************************
+ * main function
+ **************************************************************************************************/
+
+int main (int argc, char *argv[])
+{
+  uint32_t     res, hm, yb, ye, t, id, y;
+  char         tstr[256], pstr[256], fname[300];
+  slg_date     date;
+  slg_daydata  dayf;
+
+  /* help menu ************************************************************************************/
+  if ((parArgTypExists (argc, argv, 'h')) || (argc == 1)) {
+    printf (VERSION "\n");
+    printf ("  -> parameters:\n");
+    printf ("     -h        :  prints this help menu\n");
+    printf ("     -c <uint> :  temperature column id\n");
+    printf ("     -b <uint> :  first year\n");
+    printf ("     -e <uint> :  optional last year (default: first year)\n");
+    printf ("     -p <str>  :  optional dayfile path\n");
+    printf ("     -d <uint> :  optional no header mode (1: Bretnig, 2: Dresden)\n");
+    printf ("     -t <uint> :  optional number of threads (default: %d)\n", DEF_THREADS);
+
+    return (0);
+  }
+
+
+  /* read parameters ******************************************************************************/
+  if (!(parArgTypExists (argc, argv, 'c'))) {
+    printf ("slg_aggrgen: error: missing parameter \'-c\'\n");
+    return (1);
+  }
+  res = parGetUint32 (argc, argv, 'c', &id);
+  if (res == 0) {
+    printf ("slg_aggrgen: error: can not read value of parameter \'-c\'\n");
+    return (1);
+  }
+
+  if (!(parArgTypExists (argc, argv, 'b'))) {
+    printf ("slg_aggrgen: error: missing parameter \'-b\'\n");
+    return (1);
+  }
+  res = parGetUint32 (argc, argv, 'b', &yb);
+  if (res == 0) {
+    printf ("slg_aggrgen: error: can not read value of parameter \'-b\'\n");
+    return (1);
+  }
+
+  if (parArgTypExists (argc, argv, 'e')) {
+    res = parGetUint32 (argc, argv, 'e', &ye);
+    if (res == 0) {
+      printf ("slg_aggrgen: error: can not read value of parameter \'-e\'\n");
+      return (1);
+    }
+  }
+  else {
+    ye = yb;
+  }
+
+  if (parArgTypExists (argc, argv, 'p')) {
+    res = parGetString (argc, argv, 'p', pstr);
+    if (res == 0) {
+      printf ("slg_aggrgen: error: can not read value of parameter \'-p\'\n");
+      return (1);
+    }
+    if ((strlen(pstr) != 0) && (strlen(pstr) < 255)) strcat (pstr, "/");
+  }
+  else {
+    pstr[0] = 0;  /* set empty string */
+  }
+
+  if (parArgTypExists (argc, argv, 'd')) {
+    res = parGetUint32 (argc, argv, 'd', &hm);
+    if (res == 0) {
+      printf ("slg_aggrgen: error: can not read value of parameter \'-d\'\n");
+      return (1);
+    }
+    if ((hm < 1) || (hm > 2)) {
+      printf ("slg_aggrgen: error: invalid no header mode\n");
+      return (1);
+    }
+  }
+  else {
+    hm = 0;
+  }
+
+  if (parArgTypExists (argc, argv, 't')) {
+    res = parGetUint32 (argc, argv, 't', &t);
+    if (res == 0) {
+      printf ("slg_aggrgen: error: can not read value of parameter \'-t\'\n");
+      return (1);
+    }
+    if ((t < 1) || (t > AGR_MAX_THREADS)) {
+      printf ("slg_aggrgen: error: invalid number of threads\n");
+      return (1);
+    }
+  }
+  else {
+    t = DEF_THREADS;
+  }
+
+  if (ye < yb) {
+    printf ("slg_aggrgen: error: last year is before first year\n");
+    return (1);
+  }
+  if (ye - yb >= AGR_MAX_YEARS) {
+    printf ("slg_aggrgen: error: too many years\n");
+    return (1);
+  }
+
+
+  /* aggregate all years **************************************************************************/
+  /* use first readable dayfile of range as template */
+  slg_date_set_int (&date, 1, 1, yb);
+  res = 1;
+  while ((res != 0) && (date.y <= ye)) {
+    slg_date_to_fstring (tstr, &date);
+    strcpy (fname, pstr);
+    strcat (fname, tstr);
+    strcat (fname, ".txt");
+    res = slg_readdayfile (&dayf, fname, hm);
+    if (slg_date_inc (&date) == 0) break;
+  }
+  if (res != 0) {
+    printf ("slg_aggrgen: error: no dayfile found in range of years\n");
+    return (1);
+  }
+  if (slg_colexist (&dayf, DF_TEMP, id) == 0) {
+    printf ("slg_aggrgen: error: column is not a temperature column\n");
+    return (1);
+  }
+
+  res = slg_aggr_build (&aggr, &dayf, pstr, id, yb, ye, hm, t);
+  if (res != 0) {
+    printf ("slg_aggrgen: error: aggregation failed (%lu)\n", (unsigned long) res);
+    return (1);
+  }
+
+
+  /* print year partials and total ****************************************************************/
+  printf ("column %lu (TEMP), %lu dayfiles read:\n", (unsigned long) id, (unsigned long) aggr.fnum);
+  for (y = yb; y <= ye; y++) {
+    printf ("  %lu: ", (unsigned long) y);
+    print_part (slg_aggr_year (&aggr, y), aggr.tmode);
+  }
+  printf ("  %lu..%lu: ", (unsigned long) yb, (unsigned long) ye);
+  print_part (&aggr.total, aggr.tmode);
+
+  return (0);
+}
+
@@ -5,7 +5,7 @@
  * author   : Jochen Ertel
  *
  * created  : 15.01.2022
- * updated  : 21.08.2024
+ * updated  : 18.10.2026
  *
  **************************************************************************************************/
 
@@ -19,9 +19,16 @@
 #include "../../lib/slg_dayfile.h"
 #include "../../lib/slg_temper.h"
 #include "../../lib/slg_rain.h"
+#include "../../lib/slg_live.h"
+#include "../../lib/slg_records.h"
 
 
 #define VERSION "legacy senslog html page generation tool (version 0.3.5)"
+#define FLT_MAXGAP 4   /* max. gap length filled by filter 2 (values) */
+
+
+/* global live state object (see parameter -s) */
+slg_live live;
 
 
 /***************************************************************************************************
@@ -56,6 +63,7 @@ void gen_error (char *fname, uint32_t e)
   if (e == 13) strcpy (estr, "(measurement lines: invalid date or time value)");
   if (e == 14) strcpy (estr, "(measurement lines: invalid line order)");
   if (e == 15) strcpy (estr, "(to many lines)");
+  if (e == 16) strcpy (estr, "(file was changed while reading)");
   if (e == 20) strcpy (estr, "(expected column ids not found)");
 
   /* write output html file *************************************************************/
@@ -158,9 +166,10 @@ void gen_error (char *fname, uint32_t e)
  *   t     :  0: no monthfile link
  *            1: include monthfile link
  *   coul  :  colour string (e.g. "#FFC78F")
+ *   *live :  live state of dayfile (statistics are taken from it) or NULL
  *
  ****************************************************************************************/
-void gen_bretnig (char *fname, slg_daydata *df, uint32_t m, uint32_t t, char *coul)
+void gen_bretnig (char *fname, slg_daydata *df, uint32_t m, uint32_t t, char *coul, slg_live *live)
 {
   FILE         *fpw;
   char         c, sdate[20], sdow[20], stavar[20], stcur[20], stmax[20], stmin[20], srsum[20], sday[20],
@@ -169,6 +178,7 @@ void gen_bretnig (char *fname, slg_daydata *df, uint32_t m, uint32_t t, char *co
   int32_t      diamax;
   slg_date     date;
   slg_dtemper  temper;
+  slg_dstats   dstats, rstats;
   slg_drain    rain;
 
 
@@ -181,11 +191,20 @@ void gen_bretnig (char *fname, slg_daydata *df, uint32_t m, uint32_t t, char *co
   slg_dtemper_read (&temper, df, 1);
   slg_drain_read (&rain, df, 2);
 
-  ind = slg_dtemper_indmax (&temper);
+  /* statistics of live state are updated per appended line, no need to scan the day */
+  if (live == NULL) {
+    slg_dtemper_stats (&temper, &dstats);
+  }
+  else {
+    slg_live_dstats (live, DF_TEMP, 1, &dstats);
+    slg_live_dstats (live, DF_RAIN, 2, &rstats);
+  }
+
+  ind = dstats.indmax;
   slg_timeindex2str (stimmax, temper.tmode, summer, ind);
   slg_temper2str (stmax, 0, temper.val[ind]);
 
-  ind = slg_dtemper_indmin (&temper);
+  ind = dstats.indmin;
   slg_timeindex2str (stimmin, temper.tmode, summer, ind);
   slg_temper2str (stmin, 0, temper.val[ind]);
 
@@ -193,9 +212,10 @@ void gen_bretnig (char *fname, slg_daydata *df, uint32_t m, uint32_t t, char *co
   slg_timeindex2str (stimcur, temper.tmode, summer, ind);
   slg_temper2str (stcur, 0, temper.val[ind]);
 
-  slg_temper2str (stavar, 0, slg_dtemper_average (&temper));
+  slg_temper2str (stavar, 0, slg_dstats_average (&dstats));
 
-  slg_rain2str (srsum, 0, slg_drain_sum (&rain));
+  if (live == NULL) slg_rain2str (srsum, 0, slg_drain_sum (&rain));
+  else slg_rain2str (srsum, 0, (uint32_t) rstats.sum);
 
   diamax = slg_dtemper_maxindayout30 (&temper, &date) / 10;
 
@@ -770,6 +790,7 @@ void gen_dresden (char *fname, slg_daydata *df, uint32_t m, uint32_t t)
   int32_t      diamax;
   slg_date     date;
   slg_dtemper  temper1, temper2, temper;
+  slg_dstats   dstats;
 
 
   /* read relevant values from dayfile ****************************************/
@@ -783,11 +804,13 @@ void gen_dresden (char *fname, slg_daydata *df, uint32_t m, uint32_t t)
   slg_dtemper_read (&temper2, df, 2);
   slg_dtemper_merge_2 (&temper, "Aussen", &temper1, 20, 42, &temper2, 39, 79);
 
-  ind = slg_dtemper_indmax (&temper);
+  slg_dtemper_stats (&temper, &dstats);
+
+  ind = dstats.indmax;
   slg_timeindex2str (stimmax, temper.tmode, summer, ind);
   slg_temper2str (stmax, 0, temper.val[ind]);
 
-  ind = slg_dtemper_indmin (&temper);
+  ind = dstats.indmin;
   slg_timeindex2str (stimmin, temper.tmode, summer, ind);
   slg_temper2str (stmin, 0, temper.val[ind]);
 
@@ -795,7 +818,7 @@ void gen_dresden (char *fname, slg_daydata *df, uint32_t m, uint32_t t)
   slg_timeindex2str (stimcur, temper.tmode, summer, ind);
   slg_temper2str (stcur, 0, temper.val[ind]);
 
-  slg_temper2str (stavar, 0, slg_dtemper_average (&temper));
+  slg_temper2str (stavar, 0, slg_dstats_average (&dstats));
 
   diamax = slg_dtemper_maxindayout30 (&temper, &date) / 10;
 
@@ -1284,9 +1307,10 @@ void gen_dresden (char *fname, slg_daydata *df, uint32_t m, uint32_t t)
 
 int main (int argc, char *argv[])
 {
-  uint32_t     res, l, m, n, hm, t;
-  char         namer[256], namew[256], coul[20];
+  uint32_t     res, l, m, n, hm, t, s, f, x;
+  char         namer[256], namew[256], names[256], namex[256], coul[20];
   slg_daydata  dayf;
+  slg_records  records;
 
   /* help menu ************************************************************************************/
   if ((parArgTypExists (argc, argv, 'h')) || (argc == 1)) {
@@ -1303,6 +1327,11 @@ int main (int argc, char *argv[])
     printf ("                         2: older day\n");
     printf ("     -t        :  include a monthfile link (optional)\n");
     printf ("     -n        :  dayfile does not have a header yet (optional)\n");
+    printf ("     -s <str>  :  live state file, only appended lines are read (optional, mode 0 only)\n");
+    printf ("     -x <str>  :  all-time records file, updated by live state (optional, with -s only)\n");
+    printf ("     -f <uint> :  filter of temperatures (optional):  1: flag spikes and outliers\n");
+    printf ("                                                      2: fill gaps up to %d values\n", FLT_MAXGAP);
+    printf ("                                                      3: both\n");
 
     return (0);
   }
@@ -1363,12 +1392,85 @@ int main (int argc, char *argv[])
   if (parArgTypExists (argc, argv, 'n')) n = 1;
   else n = 0;
 
+  if (parArgTypExists (argc, argv, 'f')) {
+    res = parGetUint32 (argc, argv, 'f', &f);
+    if (res == 0) {
+      printf ("slg_legacy_htmlgen: error: can not read value of parameter \'-f\'\n");
+      return (1);
+    }
+    if (f > 3) {
+      printf ("slg_legacy_htmlgen: error: invalid filter\n");
+      return (1);
+    }
+  }
+  else {
+    f = 0;
+  }
+
+  if (parArgTypExists (argc, argv, 's')) {
+    res = parGetString (argc, argv, 's', names);
+    if (res == 0) {
+      printf ("slg_legacy_htmlgen: error: can not read value of parameter \'-s\'\n");
+      return (1);
+    }
+    if (m != 0) {
+      printf ("slg_legacy_htmlgen: error: live state file is supported in mode 0 only\n");
+      return (1);
+    }
+    s = 1;
+  }
+  else {
+    s = 0;
+  }
+
+  if (parArgTypExists (argc, argv, 'x')) {
+    res = parGetString (argc, argv, 'x', namex);
+    if (res == 0) {
+      printf ("slg_legacy_htmlgen: error: can not read value of parameter \'-x\'\n");
+      return (1);
+    }
+    if (s == 0) {
+      printf ("slg_legacy_htmlgen: error: records file is supported with live state file only\n");
+      return (1);
+    }
+    x = 1;
+  }
+  else {
+    x = 0;
+  }
+
 
   /* read dayfile *********************************************************************************/
+  slg_temper_setload (f, FLT_MAXGAP);
+
   if (n == 0) hm = 0;
   else hm = l + 1;
 
-  res = slg_readdayfile (&dayf, namer, hm);
+  if (s == 0) {
+    res = slg_readdayfile (&dayf, namer, hm);
+  }
+  else {
+    /* a new records file takes its columns from the dayfile */
+    res = 0;
+    if (x && (slg_records_load (&records, namex) != 0)) {
+      res = slg_readdayfile (&dayf, namer, hm);
+      if (res == 0) slg_records_init (&records, &dayf);
+    }
+
+    if (res == 0) {
+      slg_live_load (&live, names);
+      res = slg_live_update (&live, namer, hm, (x) ? &records : NULL);
+    }
+    if (res == 0) {
+      memcpy (&dayf, &live.daydata, sizeof(slg_daydata));
+      if (slg_live_save (&live, names) != 0) {
+        printf ("slg_legacy_htmlgen: error: can not write live state file\n");
+      }
+      if (x && (slg_records_save (&records, namex) != 0)) {
+        printf ("slg_legacy_htmlgen: error: can not write records file\n");
+      }
+    }
+  }
 
   if (res != 0) {
     gen_error (namew, res);
@@ -1382,7 +1484,9 @@ int main (int argc, char *argv[])
     else {
       if (l == 0) strcpy (coul, "#FFC78F");
       if (l == 2) strcpy (coul, "#DED1FF");
-      gen_bretnig (namew, &dayf, m, t, coul);
+      /* statistics of live state are unfiltered, filtered ones are taken from the day */
+      if ((s == 0) || (f != 0)) gen_bretnig (namew, &dayf, m, t, coul, NULL);
+      else gen_bretnig (namew, &dayf, m, t, coul, &live);
     }
   }
 
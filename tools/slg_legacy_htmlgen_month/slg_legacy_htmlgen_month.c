@@ -5,7 +5,7 @@
  * author   : Jochen Ertel
  *
  * created  : 31.10.2023
- * updated  : 21.08.2024
+ * updated  : 18.10.2026
  *
  **************************************************************************************************/
 
@@ -22,6 +22,7 @@
 
 
 #define VERSION "legacy senslog html month page generation tool (version 0.3.5)"
+#define FLT_MAXGAP 4   /* max. gap length filled by filter 2 (values) */
 
 
 /***************************************************************************************************
@@ -181,7 +182,7 @@ void gen_bretnig (char *fname, slg_monthdata *month, uint32_t z, uint32_t t, cha
 {
   FILE         *fpw;
   char         c, smonth[20], srmsum[20], smont[20], smonthdec[20], smonthinc[20], slastd[20], stavar[20], stmin[20], stmax[20], tstr[20];
-  uint32_t     i, ind, day;
+  uint32_t     i, day;
   slg_date     tdate;
   slg_mtemper  mtemper;
   slg_mrain    mrain;
@@ -207,7 +208,7 @@ void gen_bretnig (char *fname, slg_monthdata *month, uint32_t z, uint32_t t, cha
   slg_date_dec (&tdate);
   slg_date_to_fstring (smonthdec, &tdate);
   smonthdec[7] = 0;  /* cut day */
-  for (i=0; i < 35; i++) slg_date_inc (&tdate);
+  slg_date_add (&tdate, 35);
   slg_date_to_fstring (smonthinc, &tdate);
   smonthinc[7] = 0;  /* cut day */
 
@@ -222,8 +223,7 @@ void gen_bretnig (char *fname, slg_monthdata *month, uint32_t z, uint32_t t, cha
     slg_temper2str (stmin, 0, CNERR);
   }
   else {
-    ind = slg_dtemper_indmin (&mtemper.dtemper[day-1]);
-    slg_temper2str (stmin, 0, mtemper.dtemper[day-1].val[ind]);
+    slg_temper2str (stmin, 0, mtemper.dstats[day-1].min);
   }
 
   day = slg_mtemper_daymax (&mtemper);
@@ -231,8 +231,7 @@ void gen_bretnig (char *fname, slg_monthdata *month, uint32_t z, uint32_t t, cha
     slg_temper2str (stmax, 0, CNERR);
   }
   else {
-    ind = slg_dtemper_indmax (&mtemper.dtemper[day-1]);
-    slg_temper2str (stmax, 0, mtemper.dtemper[day-1].val[ind]);
+    slg_temper2str (stmax, 0, mtemper.dstats[day-1].max);
   }
 
   /* calculate rain sum *********************************************/
@@ -729,7 +728,7 @@ void gen_bretnig (char *fname, slg_monthdata *month, uint32_t z, uint32_t t, cha
   fprintf (fpw, "      var grafzeit = ");
   c = '[';
   for (i = 0; i < 31; i++) {
-    if ((mtemper.dvalid[i] == 1) && (slg_dtemper_checkvalid(&mtemper.dtemper[i]) == 0)) {
+    if ((mtemper.dvalid[i] == 1) && (mtemper.dstats[i].count > 0)) {
       fprintf (fpw, "%c", c);
       fprintf (fpw, "%lu", (unsigned long) (i+1));
       c = ',';
@@ -740,9 +739,8 @@ void gen_bretnig (char *fname, slg_monthdata *month, uint32_t z, uint32_t t, cha
   fprintf (fpw, "      var graftmin = ");
   c = '[';
   for (i = 0; i < 31; i++) {
-    if ((mtemper.dvalid[i] == 1) && (slg_dtemper_checkvalid(&mtemper.dtemper[i]) == 0)) {
-      ind = slg_dtemper_indmin (&mtemper.dtemper[i]);
-      slg_temper2str (tstr, 0, mtemper.dtemper[i].val[ind]);
+    if ((mtemper.dvalid[i] == 1) && (mtemper.dstats[i].count > 0)) {
+      slg_temper2str (tstr, 0, mtemper.dstats[i].min);
       fprintf (fpw, "%c", c);
       fprintf (fpw, "%s", tstr);
       c = ',';
@@ -753,9 +751,8 @@ void gen_bretnig (char *fname, slg_monthdata *month, uint32_t z, uint32_t t, cha
   fprintf (fpw, "      var graftmax = ");
   c = '[';
   for (i = 0; i < 31; i++) {
-    if ((mtemper.dvalid[i] == 1) && (slg_dtemper_checkvalid(&mtemper.dtemper[i]) == 0)) {
-      ind = slg_dtemper_indmax (&mtemper.dtemper[i]);
-      slg_temper2str (tstr, 0, mtemper.dtemper[i].val[ind]);
+    if ((mtemper.dvalid[i] == 1) && (mtemper.dstats[i].count > 0)) {
+      slg_temper2str (tstr, 0, mtemper.dstats[i].max);
       fprintf (fpw, "%c", c);
       fprintf (fpw, "%s", tstr);
       c = ',';
@@ -766,8 +763,8 @@ void gen_bretnig (char *fname, slg_monthdata *month, uint32_t z, uint32_t t, cha
   fprintf (fpw, "      var graftmid = ");
   c = '[';
   for (i = 0; i < 31; i++) {
-    if ((mtemper.dvalid[i] == 1) && (slg_dtemper_checkvalid(&mtemper.dtemper[i]) == 0)) {
-      slg_temper2str (tstr, 0, slg_dtemper_average(&mtemper.dtemper[i]));
+    if ((mtemper.dvalid[i] == 1) && (mtemper.dstats[i].count > 0)) {
+      slg_temper2str (tstr, 0, slg_dstats_average(&mtemper.dstats[i]));
       fprintf (fpw, "%c", c);
       fprintf (fpw, "%s", tstr);
       c = ',';
@@ -778,8 +775,8 @@ void gen_bretnig (char *fname, slg_monthdata *month, uint32_t z, uint32_t t, cha
   fprintf (fpw, "      var grafns   = ");
   c = '[';
   for (i = 0; i < 31; i++) {
-    if ((mtemper.dvalid[i] == 1) && (slg_dtemper_checkvalid(&mtemper.dtemper[i]) == 0)) {
-      slg_temper2str (tstr, 0, slg_dtemper_average(&mtemper.dtemper[i]));
+    if ((mtemper.dvalid[i] == 1) && (mtemper.dstats[i].count > 0)) {
+      slg_temper2str (tstr, 0, slg_dstats_average(&mtemper.dstats[i]));
       slg_rain2str (tstr, 0, slg_drain_sum (&mrain.drain[i]));
       fprintf (fpw, "%c", c);
       fprintf (fpw, "%s", tstr);
@@ -819,7 +816,7 @@ void gen_dresden (char *fname, slg_monthdata *month, uint32_t z, uint32_t t)
 {
   FILE         *fpw;
   char         c, smonth[20], smont[20], smonthdec[20], smonthinc[20], slastd[20], stavar[20], stmin[20], stmax[20], tstr[20];
-  uint32_t     i, ind, day;
+  uint32_t     i, day;
   slg_date     tdate;
   slg_mtemper  mtemper, mtemper1, mtemper2;
 
@@ -844,7 +841,7 @@ void gen_dresden (char *fname, slg_monthdata *month, uint32_t z, uint32_t t)
   slg_date_dec (&tdate);
   slg_date_to_fstring (smonthdec, &tdate);
   smonthdec[7] = 0;  /* cut day */
-  for (i=0; i < 35; i++) slg_date_inc (&tdate);
+  slg_date_add (&tdate, 35);
   slg_date_to_fstring (smonthinc, &tdate);
   smonthinc[7] = 0;  /* cut day */
 
@@ -861,8 +858,7 @@ void gen_dresden (char *fname, slg_monthdata *month, uint32_t z, uint32_t t)
     slg_temper2str (stmin, 0, CNERR);
   }
   else {
-    ind = slg_dtemper_indmin (&mtemper.dtemper[day-1]);
-    slg_temper2str (stmin, 0, mtemper.dtemper[day-1].val[ind]);
+    slg_temper2str (stmin, 0, mtemper.dstats[day-1].min);
   }
 
   day = slg_mtemper_daymax (&mtemper);
@@ -870,8 +866,7 @@ void gen_dresden (char *fname, slg_monthdata *month, uint32_t z, uint32_t t)
     slg_temper2str (stmax, 0, CNERR);
   }
   else {
-    ind = slg_dtemper_indmax (&mtemper.dtemper[day-1]);
-    slg_temper2str (stmax, 0, mtemper.dtemper[day-1].val[ind]);
+    slg_temper2str (stmax, 0, mtemper.dstats[day-1].max);
   }
 
   /* search last valid day in month *********************************/
@@ -1313,7 +1308,7 @@ void gen_dresden (char *fname, slg_monthdata *month, uint32_t z, uint32_t t)
   fprintf (fpw, "      var grafzeit = ");
   c = '[';
   for (i = 0; i < 31; i++) {
-    if ((mtemper.dvalid[i] == 1) && (slg_dtemper_checkvalid(&mtemper.dtemper[i]) == 0)) {
+    if ((mtemper.dvalid[i] == 1) && (mtemper.dstats[i].count > 0)) {
       fprintf (fpw, "%c", c);
       fprintf (fpw, "%lu", (unsigned long) (i+1));
       c = ',';
@@ -1324,9 +1319,8 @@ void gen_dresden (char *fname, slg_monthdata *month, uint32_t z, uint32_t t)
   fprintf (fpw, "      var graftmin = ");
   c = '[';
   for (i = 0; i < 31; i++) {
-    if ((mtemper.dvalid[i] == 1) && (slg_dtemper_checkvalid(&mtemper.dtemper[i]) == 0)) {
-      ind = slg_dtemper_indmin (&mtemper.dtemper[i]);
-      slg_temper2str (tstr, 0, mtemper.dtemper[i].val[ind]);
+    if ((mtemper.dvalid[i] == 1) && (mtemper.dstats[i].count > 0)) {
+      slg_temper2str (tstr, 0, mtemper.dstats[i].min);
       fprintf (fpw, "%c", c);
       fprintf (fpw, "%s", tstr);
       c = ',';
@@ -1337,9 +1331,8 @@ void gen_dresden (char *fname, slg_monthdata *month, uint32_t z, uint32_t t)
   fprintf (fpw, "      var graftmax = ");
   c = '[';
   for (i = 0; i < 31; i++) {
-    if ((mtemper.dvalid[i] == 1) && (slg_dtemper_checkvalid(&mtemper.dtemper[i]) == 0)) {
-      ind = slg_dtemper_indmax (&mtemper.dtemper[i]);
-      slg_temper2str (tstr, 0, mtemper.dtemper[i].val[ind]);
+    if ((mtemper.dvalid[i] == 1) && (mtemper.dstats[i].count > 0)) {
+      slg_temper2str (tstr, 0, mtemper.dstats[i].max);
       fprintf (fpw, "%c", c);
       fprintf (fpw, "%s", tstr);
       c = ',';
@@ -1350,8 +1343,8 @@ void gen_dresden (char *fname, slg_monthdata *month, uint32_t z, uint32_t t)
   fprintf (fpw, "      var graftmid = ");
   c = '[';
   for (i = 0; i < 31; i++) {
-    if ((mtemper.dvalid[i] == 1) && (slg_dtemper_checkvalid(&mtemper.dtemper[i]) == 0)) {
-      slg_temper2str (tstr, 0, slg_dtemper_average(&mtemper.dtemper[i]));
+    if ((mtemper.dvalid[i] == 1) && (mtemper.dstats[i].count > 0)) {
+      slg_temper2str (tstr, 0, slg_dstats_average(&mtemper.dstats[i]));
       fprintf (fpw, "%c", c);
       fprintf (fpw, "%s", tstr);
       c = ',';
@@ -1383,7 +1376,7 @@ void gen_dresden (char *fname, slg_monthdata *month, uint32_t z, uint32_t t)
 
 int main (int argc, char *argv[])
 {
-  uint32_t       res, l, m, y, z, n, t, hm;
+  uint32_t       res, l, m, y, z, n, t, hm, f;
   char           namer[256], namew[256], coul[20];
   slg_monthdata  month;
 
@@ -1403,6 +1396,9 @@ int main (int argc, char *argv[])
     printf ("                         1: older month\n");
     printf ("     -t        :  include a dayfile link (optional)\n");
     printf ("     -n        :  dayfile does not have a header yet (optional)\n");
+    printf ("     -f <uint> :  filter of temperatures (optional):  1: flag spikes and outliers\n");
+    printf ("                                                      2: fill gaps up to %d values\n", FLT_MAXGAP);
+    printf ("                                                      3: both\n");
 
     return (0);
   }
@@ -1483,8 +1479,25 @@ int main (int argc, char *argv[])
   if (parArgTypExists (argc, argv, 'n')) n = 1;
   else n = 0;
 
+  if (parArgTypExists (argc, argv, 'f')) {
+    res = parGetUint32 (argc, argv, 'f', &f);
+    if (res == 0) {
+      printf ("slg_legacy_htmlgen_month: error: can not read value of parameter \'-f\'\n");
+      return (1);
+    }
+    if (f > 3) {
+      printf ("slg_legacy_htmlgen_month: error: invalid filter\n");
+      return (1);
+    }
+  }
+  else {
+    f = 0;
+  }
+
 
   /* read dayfiles of month ***********************************************************************/
+  slg_temper_setload (f, FLT_MAXGAP);
+
   if (n == 0) hm = 0;
   else hm = l + 1;
 
@@ -0,0 +1,267 @@
+/***************************************************************************************************
+ *
+ * file     : slg_normalsgen.c (command line tool "senslog normals table generation")
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../lib/options.h"
+#include "../../lib/slg_date.h"
+#include "../../lib/slg_values.h"
+#include "../../lib/slg_dayfile.h"
+#include "../../lib/slg_normals.h"
+#include "../../lib/slg_cache.h"
+
+
+#define VERSION "senslog normals table generation tool (version 0.1.0)"
+
+#define DEF_WIN      7   /* default smoothing half window */
+#define DEF_THREADS  4   /* default number of threads */
+
+
+/* global normals object (too large for stack) */
+slg_normals normals;
+
+
+
+/***************************************************************************************************
+ * main function
+ **************************************************************************************************/
+
+int main (int argc, char *argv[])
+{
+  uint32_t     res, hm, yb, ye, w, t, c, build;
+  char         tstr[256], pstr[256], ostr[256], kstr[256], fname[300];
+  char         s1[20], s2[20], s3[20], s4[20], s5[20];
+  slg_date     date, qdate;
+  slg_daydata  dayf;
+  slg_nrment   *nent;
+  slg_cache    cache;
+
+  /* help menu ************************************************************************************/
+  if ((parArgTypExists (argc, argv, 'h')) || (argc == 1)) {
+    printf (VERSION "\n");
+    printf ("  -> parameters:\n");
+    printf ("     -h        :  prints this help menu\n");
+    printf ("     -o <str>  :  normals table file\n");
+    printf ("     -b <uint> :  optional first year of reference period (builds new table)\n");
+    printf ("     -e <uint> :  optional last year of reference period (default: first year)\n");
+    printf ("     -p <str>  :  optional dayfile path\n");
+    printf ("     -d <uint> :  optional no header mode (1: Bretnig, 2: Dresden)\n");
+    printf ("     -w <uint> :  optional smoothing half window in days (default: %d)\n", DEF_WIN);
+    printf ("     -t <uint> :  optional number of threads (default: %d)\n", DEF_THREADS);
+    printf ("     -k <str>  :  optional cache file of day summaries (build)\n");
+    printf ("     -q <str>  :  optional print normals of a date\n");
+
+    return (0);
+  }
+
+
+  /* read parameters ******************************************************************************/
+  if (!(parArgTypExists (argc, argv, 'o'))) {
+    printf ("slg_normalsgen: error: missing parameter \'-o\'\n");
+    return (1);
+  }
+  res = parGetString (argc, argv, 'o', ostr);
+  if (res == 0) {
+    printf ("slg_normalsgen: error: can not read value of parameter \'-o\'\n");
+    return (1);
+  }
+
+  if (parArgTypExists (argc, argv, 'b')) {
+    res = parGetUint32 (argc, argv, 'b', &yb);
+    if (res == 0) {
+      printf ("slg_normalsgen: error: can not read value of parameter \'-b\'\n");
+      return (1);
+    }
+    build = 1;
+  }
+  else {
+    build = 0;
+  }
+
+  if (parArgTypExists (argc, argv, 'e')) {
+    res = parGetUint32 (argc, argv, 'e', &ye);
+    if (res == 0) {
+      printf ("slg_normalsgen: error: can not read value of parameter \'-e\'\n");
+      return (1);
+    }
+  }
+  else {
+    ye = (build) ? yb : 0;
+  }
+
+  if (parArgTypExists (argc, argv, 'p')) {
+    res = parGetString (argc, argv, 'p', pstr);
+    if (res == 0) {
+      printf ("slg_normalsgen: error: can not read value of parameter \'-p\'\n");
+      return (1);
+    }
+    if ((strlen(pstr) != 0) && (strlen(pstr) < 255)) strcat (pstr, "/");
+  }
+  else {
+    pstr[0] = 0;  /* set empty string */
+  }
+
+  if (parArgTypExists (argc, argv, 'd')) {
+    res = parGetUint32 (argc, argv, 'd', &hm);
+    if (res == 0) {
+      printf ("slg_normalsgen: error: can not read value of parameter \'-d\'\n");
+      return (1);
+    }
+    if ((hm < 1) || (hm > 2)) {
+      printf ("slg_normalsgen: error: invalid no header mode\n");
+      return (1);
+    }
+  }
+  else {
+    hm = 0;
+  }
+
+  if (parArgTypExists (argc, argv, 'w')) {
+    res = parGetUint32 (argc, argv, 'w', &w);
+    if (res == 0) {
+      printf ("slg_normalsgen: error: can not read value of parameter \'-w\'\n");
+      return (1);
+    }
+    if (w > NRM_MAX_WIN) {
+      printf ("slg_normalsgen: error: invalid smoothing window\n");
+      return (1);
+    }
+  }
+  else {
+    w = DEF_WIN;
+  }
+
+  if (parArgTypExists (argc, argv, 't')) {
+    res = parGetUint32 (argc, argv, 't', &t);
+    if (res == 0) {
+      printf ("slg_normalsgen: error: can not read value of parameter \'-t\'\n");
+      return (1);
+    }
+    if ((t < 1) || (t > NRM_MAX_THREADS)) {
+      printf ("slg_normalsgen: error: invalid number of threads\n");
+      return (1);
+    }
+  }
+  else {
+    t = DEF_THREADS;
+  }
+
+  if (parArgTypExists (argc, argv, 'k')) {
+    res = parGetString (argc, argv, 'k', kstr);
+    if (res == 0) {
+      printf ("slg_normalsgen: error: can not read value of parameter \'-k\'\n");
+      return (1);
+    }
+  }
+  else {
+    kstr[0] = 0;  /* set empty string */
+  }
+
+  if (parArgTypExists (argc, argv, 'q')) {
+    res = parGetString (argc, argv, 'q', tstr);
+    if (res == 0) {
+      printf ("slg_normalsgen: error: can not read value of parameter \'-q\'\n");
+      return (1);
+    }
+    res = slg_date_set_str (&qdate, tstr);
+    if (res == 0) {
+      printf ("slg_normalsgen: error: invalid query date\n");
+      return (1);
+    }
+  }
+  else {
+    qdate.y = 0;
+  }
+
+  if (build && (ye < yb)) {
+    printf ("slg_normalsgen: error: last year is before first year\n");
+    return (1);
+  }
+
+
+  /* build or load normals table ******************************************************************/
+  if (build) {
+    /* use first readable dayfile of reference period as template */
+    slg_date_set_int (&date, 1, 1, yb);
+    res = 1;
+    while ((res != 0) && (date.y <= ye)) {
+      slg_date_to_fstring (tstr, &date);
+      strcpy (fname, pstr);
+      strcat (fname, tstr);
+      strcat (fname, ".txt");
+      res = slg_readdayfile (&dayf, fname, hm);
+      if (slg_date_inc (&date) == 0) break;
+    }
+    if (res != 0) {
+      printf ("slg_normalsgen: error: no dayfile found in reference period\n");
+      return (1);
+    }
+
+    if (kstr[0] != 0) {
+      if (slg_cache_open (&cache, kstr) != 0) {
+        printf ("slg_normalsgen: warning: cache file can not be used, cache is memory only\n");
+      }
+      res = slg_normals_build (&normals, &dayf, pstr, yb, ye, hm, w, t, &cache);
+      printf ("-> cache: %lu hits, %lu misses\n", (unsigned long) cache.nhit, (unsigned long) cache.nmiss);
+      slg_cache_close (&cache);
+    }
+    else {
+      res = slg_normals_build (&normals, &dayf, pstr, yb, ye, hm, w, t, NULL);
+    }
+    if (res != 0) {
+      printf ("slg_normalsgen: error: building normals table failed (%lu)\n", (unsigned long) res);
+      return (1);
+    }
+
+    res = slg_normals_save (&normals, ostr);
+    if (res != 0) {
+      printf ("slg_normalsgen: error: writing normals table failed\n");
+      return (1);
+    }
+    printf ("-> normals table %lu..%lu created\n", (unsigned long) yb, (unsigned long) ye);
+  }
+  else {
+    res = slg_normals_load (&normals, ostr);
+    if (res != 0) {
+      printf ("slg_normalsgen: error: reading normals table failed (%lu)\n", (unsigned long) res);
+      return (1);
+    }
+  }
+
+
+  /* print normals of query date ******************************************************************/
+  if (qdate.y != 0) {
+    slg_date_to_string (tstr, &qdate);
+    printf ("normals %s (reference period %lu..%lu, window +-%lu days):\n", tstr,
+            (unsigned long) normals.yfirst, (unsigned long) normals.ylast, (unsigned long) normals.win);
+
+    for (c = 0; c < normals.colnum; c++) {
+      nent = slg_normals_get (&normals, c, &qdate);
+      if (nent == NULL) continue;
+
+      slg_temper2str (s1, 0, nent->avg);
+      slg_temper2str (s2, 0, nent->p10);
+      slg_temper2str (s3, 0, nent->p90);
+      slg_temper2str (s4, 0, nent->avgmin);
+      slg_temper2str (s5, 0, nent->avgmax);
+      printf ("  column %lu (TEMP): avg %s (p10 %s, p90 %s)   min %s   max %s",
+              (unsigned long) normals.colid[c], s1, s2, s3, s4, s5);
+
+      slg_temper2str (s1, 0, nent->p10min);
+      slg_temper2str (s2, 0, nent->p90max);
+      printf ("   p10 min %s   p90 max %s   (%lu days)\n", s1, s2, (unsigned long) nent->count);
+    }
+  }
+
+  return (0);
+}
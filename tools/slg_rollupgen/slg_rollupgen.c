@@ -0,0 +1,477 @@
+/***************************************************************************************************
+ *
+ * file     : slg_rollupgen.c (command line tool "senslog rollup index generation")
+ *
+ * author   : Jochen Ertel
+ *
+ * created  : 18.10.2026
+ * updated  : 18.10.2026
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../lib/options.h"
+#include "../../lib/slg_date.h"
+#include "../../lib/slg_values.h"
+#include "../../lib/slg_dayfile.h"
+#include "../../lib/slg_hist.h"
+#include "../../lib/slg_climate.h"
+#include "../../lib/slg_normals.h"
+#include "../../lib/slg_sketch.h"
+#include "../../lib/slg_rollup.h"
+#include "../../lib/slg_records.h"
+
+
+#define VERSION "senslog rollup index generation tool (version 0.1.0)"
+
+#define REC_THREADS  4   /* number of threads of records rebuild */
+
+
+/* global normals object (too large for stack) */
+slg_normals normals;
+
+
+
+/***************************************************************************************************
+ * functions
+ **************************************************************************************************/
+
+/* prints a column summary
+ *
+ * parameters:
+ *   *rollup:  rollup object
+ *   *rent  :  rollup entry
+ *   year   :  year of entry
+ *   month  :  month of entry (0: year entry)
+ *   *nrm   :  normals table (anomalies are printed) or NULL
+ *
+ ****************************************************************************************/
+void print_entry (slg_rollup *rollup, slg_rlpent *rent, uint32_t year, uint32_t month, slg_normals *nrm)
+{
+  uint32_t    c;
+  char        tstr[20], dstr[20], istr[20];
+  slg_date    date;
+  slg_rlpsum  *rsum;
+  slg_hist    hist;
+  slg_sketch  sketch;
+  slg_nrmanom nanom;
+
+  printf ("  valid days: %lu\n", (unsigned long) rent->valid);
+
+  for (c = 0; c < rollup->head->colnum; c++) {
+    rsum = &rent->col[c];
+
+    if (rollup->head->coltyp[c] == DF_TEMP) printf ("  column %lu (TEMP): ", (unsigned long) rollup->head->colid[c]);
+    if (rollup->head->coltyp[c] == DF_RAIN) printf ("  column %lu (RAIN): ", (unsigned long) rollup->head->colid[c]);
+    if (rollup->head->coltyp[c] == DF_EVNT) printf ("  column %lu (EVNT): ", (unsigned long) rollup->head->colid[c]);
+
+    if (rsum->count == 0) {
+      printf ("no valid values\n");
+      continue;
+    }
+
+    if (rollup->head->coltyp[c] == DF_TEMP) {
+      slg_temper2str (tstr, 0, slg_rlpsum_average (rsum));
+      printf ("avg %s", tstr);
+
+      slg_temper2str (tstr, 0, rsum->min);
+      slg_rollup_doy2date (&date, year, rsum->dmin);
+      slg_date_to_string (dstr, &date);
+      slg_timeindex2str (istr, rollup->head->tmode, 0, rsum->imin);
+      printf ("   min %s (%s %s)", tstr, dstr, istr);
+
+      slg_temper2str (tstr, 0, rsum->max);
+      slg_rollup_doy2date (&date, year, rsum->dmax);
+      slg_date_to_string (dstr, &date);
+      slg_timeindex2str (istr, rollup->head->tmode, 0, rsum->imax);
+      printf ("   max %s (%s %s)", tstr, dstr, istr);
+
+      if (slg_rollup_hist (rollup, c, year, month, &hist) == 0) {
+        slg_temper2str (tstr, 0, slg_hist_percentile (&hist, 50));
+        printf ("   p5 %s", tstr);
+        slg_temper2str (tstr, 0, slg_hist_percentile (&hist, 500));
+        printf ("   median %s", tstr);
+        slg_temper2str (tstr, 0, slg_hist_percentile (&hist, 950));
+        printf ("   p95 %s", tstr);
+      }
+
+      printf ("   frost/ice/summer/hot days %lu/%lu/%lu/%lu", (unsigned long) rsum->ntype[CLM_FROST],
+              (unsigned long) rsum->ntype[CLM_ICE], (unsigned long) rsum->ntype[CLM_SUMMER],
+              (unsigned long) rsum->ntype[CLM_HOT]);
+
+      if ((nrm != NULL) && (slg_rollup_anomaly (rollup, c, nrm, year, month, NULL, &nanom) == 0) &&
+          (nanom.dnum != 0)) {
+        slg_temper2str (tstr, 0, nanom.avg);
+        slg_temper2str (dstr, 0, nanom.sum);
+        printf ("   anomaly %s (cumulative %s, warm/cold days %lu/%lu)", tstr, dstr,
+                (unsigned long) nanom.nwarm, (unsigned long) nanom.ncold);
+      }
+    }
+
+    if (rollup->head->coltyp[c] == DF_RAIN) {
+      slg_rain2str (tstr, 0, (uint32_t) rsum->sum);
+      printf ("sum %s   rain days %lu", tstr, (unsigned long) rsum->ntype[CLM_RAIN]);
+
+      /* rain intensity of slots with rain */
+      if ((slg_rollup_sketch (rollup, c, year, year, month, &sketch) == 0) &&
+          (slg_sketch_quantile_pos (&sketch, 500) != CNERR)) {
+        slg_rain2str (tstr, 0, (uint32_t) slg_sketch_quantile_pos (&sketch, 500));
+        printf ("   intensity median %s", tstr);
+        slg_rain2str (tstr, 0, (uint32_t) slg_sketch_quantile_pos (&sketch, 950));
+        printf ("   p95 %s", tstr);
+      }
+    }
+
+    if (rollup->head->coltyp[c] == DF_EVNT) {
+      printf ("on %lu of %lu values", (unsigned long) rsum->sum, (unsigned long) rsum->count);
+    }
+
+    printf ("   (%lu values", (unsigned long) rsum->count);
+    if (rsum->novfl) printf (", %lu days without slot values", (unsigned long) rsum->novfl);
+    printf (")\n");
+  }
+}
+
+
+/* prints all-time records
+ *
+ * parameters:
+ *   *records:  records object
+ *
+ ****************************************************************************************/
+void print_records (slg_records *records)
+{
+  uint32_t   c;
+  char       tstr[20], dstr[20], istr[20];
+  slg_record *rec;
+
+  for (c = 0; c < records->colnum; c++) {
+    rec = records->col[c].rec;
+
+    if (records->coltyp[c] == DF_TEMP) {
+      printf ("  column %lu (TEMP): ", (unsigned long) records->colid[c]);
+      if (rec[REC_MAX].val == CNERR) {
+        printf ("no records\n");
+        continue;
+      }
+
+      slg_temper2str (tstr, 0, rec[REC_MAX].val);
+      slg_date_to_string (dstr, &rec[REC_MAX].date);
+      slg_timeindex2str (istr, records->tmode, 0, rec[REC_MAX].ind);
+      printf ("max %s (%s %s)", tstr, dstr, istr);
+
+      slg_temper2str (tstr, 0, rec[REC_MIN].val);
+      slg_date_to_string (dstr, &rec[REC_MIN].date);
+      slg_timeindex2str (istr, records->tmode, 0, rec[REC_MIN].ind);
+      printf ("   min %s (%s %s)", tstr, dstr, istr);
+
+      if (rec[REC_NIGHTMAX].val != CNERR) {
+        slg_temper2str (tstr, 0, rec[REC_NIGHTMAX].val);
+        slg_date_to_string (dstr, &rec[REC_NIGHTMAX].date);
+        printf ("   warmest night %s (%s)", tstr, dstr);
+
+        slg_temper2str (tstr, 0, rec[REC_DAYMIN].val);
+        slg_date_to_string (dstr, &rec[REC_DAYMIN].date);
+        printf ("   coldest day %s (%s)", tstr, dstr);
+      }
+      printf ("\n");
+    }
+
+    if (records->coltyp[c] == DF_RAIN) {
+      printf ("  column %lu (RAIN): ", (unsigned long) records->colid[c]);
+      if (rec[REC_MAX].val == CNERR) {
+        printf ("no records\n");
+        continue;
+      }
+
+      slg_rain2str (tstr, 0, (uint32_t) rec[REC_MAX].val);
+      slg_date_to_string (dstr, &rec[REC_MAX].date);
+      slg_timeindex2str (istr, records->tmode, 0, rec[REC_MAX].ind);
+      printf ("max %s (%s %s)", tstr, dstr, istr);
+
+      slg_rain2str (tstr, 0, (uint32_t) rec[REC_RAINDAY].val);
+      slg_date_to_string (dstr, &rec[REC_RAINDAY].date);
+      printf ("   day sum %s (%s)", tstr, dstr);
+
+      if (rec[REC_DRYSPELL].val != CNERR) {
+        slg_date_to_string (dstr, &rec[REC_DRYSPELL].date);
+        printf ("   dry spell %lu days (until %s)", (unsigned long) rec[REC_DRYSPELL].val, dstr);
+      }
+      printf ("\n");
+    }
+  }
+}
+
+
+
+/***************************************************************************************************
+ * main function
+ **************************************************************************************************/
+
+int main (int argc, char *argv[])
+{
+  uint32_t     res, hm, y, q, m, c, nupd, upd, x;
+  char         tstr[256], pstr[256], rstr[256], nstr[256], xstr[256], fname[300];
+  slg_date     date, edate, tdate;
+  slg_daydata  dayf;
+  slg_rollup   rollup;
+  slg_rlpent   *rent;
+  slg_normals  *nrm;
+  slg_records  records;
+
+  /* help menu ************************************************************************************/
+  if ((parArgTypExists (argc, argv, 'h')) || (argc == 1)) {
+    printf (VERSION "\n");
+    printf ("  -> parameters:\n");
+    printf ("     -h        :  prints this help menu\n");
+    printf ("     -r <str>  :  rollup index file (is created with its slot file <str>.slots if it does not exist)\n");
+    printf ("     -s <str>  :  optional start date of update\n");
+    printf ("     -e <str>  :  optional end date of update\n");
+    printf ("     -p <str>  :  optional dayfile path\n");
+    printf ("     -d <uint> :  optional no header mode (1: Bretnig, 2: Dresden)\n");
+    printf ("     -y <uint> :  optional last year of a new index (default: year of end date)\n");
+    printf ("     -q <uint> :  optional print year and month summaries of a year\n");
+    printf ("     -n <str>  :  optional normals table file (prints anomalies of summaries)\n");
+    printf ("     -x <str>  :  optional all-time records file (rebuilt with an update up to end date, printed)\n");
+
+    return (0);
+  }
+
+
+  /* read parameters ******************************************************************************/
+  if (!(parArgTypExists (argc, argv, 'r'))) {
+    printf ("slg_rollupgen: error: missing parameter \'-r\'\n");
+    return (1);
+  }
+  res = parGetString (argc, argv, 'r', rstr);
+  if (res == 0) {
+    printf ("slg_rollupgen: error: can not read value of parameter \'-r\'\n");
+    return (1);
+  }
+
+  if (parArgTypExists (argc, argv, 's')) {
+    res = parGetString (argc, argv, 's', tstr);
+    if (res == 0) {
+      printf ("slg_rollupgen: error: can not read value of parameter \'-s\'\n");
+      return (1);
+    }
+    res = slg_date_set_str (&date, tstr);
+    if (res == 0) {
+      printf ("slg_rollupgen: error: invalid start date\n");
+      return (1);
+    }
+    upd = 1;
+  }
+  else {
+    upd = 0;
+  }
+
+  if (parArgTypExists (argc, argv, 'e')) {
+    res = parGetString (argc, argv, 'e', tstr);
+    if (res == 0) {
+      printf ("slg_rollupgen: error: can not read value of parameter \'-e\'\n");
+      return (1);
+    }
+    res = slg_date_set_str (&edate, tstr);
+    if (res == 0) {
+      printf ("slg_rollupgen: error: invalid end date\n");
+      return (1);
+    }
+  }
+  else {
+    if (upd) slg_date_copy (&edate, &date);
+  }
+
+  if (parArgTypExists (argc, argv, 'p')) {
+    res = parGetString (argc, argv, 'p', pstr);
+    if (res == 0) {
+      printf ("slg_rollupgen: error: can not read value of parameter \'-p\'\n");
+      return (1);
+    }
+    if ((strlen(pstr) != 0) && (strlen(pstr) < 255)) strcat (pstr, "/");
+  }
+  else {
+    pstr[0] = 0;  /* set empty string */
+  }
+
+  if (parArgTypExists (argc, argv, 'd')) {
+    res = parGetUint32 (argc, argv, 'd', &hm);
+    if (res == 0) {
+      printf ("slg_rollupgen: error: can not read value of parameter \'-d\'\n");
+      return (1);
+    }
+    if ((hm < 1) || (hm > 2)) {
+      printf ("slg_rollupgen: error: invalid no header mode\n");
+      return (1);
+    }
+  }
+  else {
+    hm = 0;
+  }
+
+  if (parArgTypExists (argc, argv, 'y')) {
+    res = parGetUint32 (argc, argv, 'y', &y);
+    if (res == 0) {
+      printf ("slg_rollupgen: error: can not read value of parameter \'-y\'\n");
+      return (1);
+    }
+  }
+  else {
+    y = (upd) ? edate.y : 0;
+  }
+
+  if (parArgTypExists (argc, argv, 'q')) {
+    res = parGetUint32 (argc, argv, 'q', &q);
+    if (res == 0) {
+      printf ("slg_rollupgen: error: can not read value of parameter \'-q\'\n");
+      return (1);
+    }
+  }
+  else {
+    q = 0;
+  }
+
+  if (parArgTypExists (argc, argv, 'n')) {
+    res = parGetString (argc, argv, 'n', nstr);
+    if (res == 0) {
+      printf ("slg_rollupgen: error: can not read value of parameter \'-n\'\n");
+      return (1);
+    }
+    res = slg_normals_load (&normals, nstr);
+    if (res != 0) {
+      printf ("slg_rollupgen: error: reading normals table failed (%lu)\n", (unsigned long) res);
+      return (1);
+    }
+    nrm = &normals;
+  }
+  else {
+    nrm = NULL;
+  }
+
+  if (parArgTypExists (argc, argv, 'x')) {
+    res = parGetString (argc, argv, 'x', xstr);
+    if (res == 0) {
+      printf ("slg_rollupgen: error: can not read value of parameter \'-x\'\n");
+      return (1);
+    }
+    x = 1;
+  }
+  else {
+    x = 0;
+  }
+
+  if (upd && (slg_date_compare (&edate, &date) == 2)) {
+    printf ("slg_rollupgen: error: end date is before start date\n");
+    return (1);
+  }
+
+
+  /* open or create rollup index ******************************************************************/
+  res = slg_rollup_open (&rollup, rstr, upd);
+
+  if ((res == 1) && upd) {
+    /* use first readable dayfile of update range as template */
+    slg_date_copy (&tdate, &date);
+    res = 1;
+    while ((res != 0) && (slg_date_compare (&tdate, &edate) < 3)) {
+      slg_date_to_fstring (tstr, &tdate);
+      strcpy (fname, pstr);
+      strcat (fname, tstr);
+      strcat (fname, ".txt");
+      res = slg_readdayfile (&dayf, fname, hm);
+      if (slg_date_inc (&tdate) == 0) break;
+    }
+    if (res != 0) {
+      printf ("slg_rollupgen: error: no dayfile found to create rollup index\n");
+      return (1);
+    }
+
+    res = slg_rollup_create (rstr, &dayf, date.y, (y > date.y) ? y : date.y);
+    if (res != 0) {
+      printf ("slg_rollupgen: error: creating rollup index failed (%lu)\n", (unsigned long) res);
+      return (1);
+    }
+    printf ("-> rollup index created\n");
+    res = slg_rollup_open (&rollup, rstr, upd);
+  }
+
+  if (res != 0) {
+    printf ("slg_rollupgen: error: opening rollup index failed (%lu)\n", (unsigned long) res);
+    return (1);
+  }
+
+
+  /* update rollup index **************************************************************************/
+  if (upd) {
+    res = slg_rollup_update_range (&rollup, pstr, &date, &edate, hm, &nupd);
+    printf ("-> %lu day summaries updated\n", (unsigned long) nupd);
+    if (res != 0) {
+      printf ("slg_rollupgen: warning: update error (%lu)\n", (unsigned long) res);
+    }
+  }
+
+
+  /* rebuild or load all-time records (columns are taken from index) ****************************/
+  if (x && upd) {
+    dayf.locid = rollup.head->locid;
+    dayf.tmode = rollup.head->tmode;
+    dayf.colnum = rollup.head->colnum;
+    for (c = 0; c < rollup.head->colnum; c++) {
+      dayf.coltyp[c] = rollup.head->coltyp[c];
+      dayf.colid[c] = rollup.head->colid[c];
+    }
+    slg_records_init (&records, &dayf);
+
+    slg_date_set_int (&tdate, 1, 1, rollup.head->yfirst);
+    res = slg_records_rebuild (&records, pstr, &tdate, &edate, hm, REC_THREADS);
+    if (res == 0) res = slg_records_save (&records, xstr);
+    if (res != 0) {
+      printf ("slg_rollupgen: error: rebuilding records failed (%lu)\n", (unsigned long) res);
+      slg_rollup_close (&rollup);
+      return (1);
+    }
+    printf ("-> all-time records rebuilt\n");
+  }
+
+  if (x && (upd == 0)) {
+    res = slg_records_load (&records, xstr);
+    if (res != 0) {
+      printf ("slg_rollupgen: error: reading records file failed (%lu)\n", (unsigned long) res);
+      slg_rollup_close (&rollup);
+      return (1);
+    }
+  }
+
+  if (x) {
+    printf ("all-time records:\n");
+    print_records (&records);
+  }
+
+
+  /* print year summary ***************************************************************************/
+  if (q != 0) {
+    rent = slg_rollup_year (&rollup, q);
+    if (rent == NULL) {
+      printf ("slg_rollupgen: error: year is not in rollup index\n");
+      slg_rollup_close (&rollup);
+      return (1);
+    }
+
+    printf ("year %lu:\n", (unsigned long) q);
+    print_entry (&rollup, rent, q, 0, nrm);
+
+    for (m = 1; m <= 12; m++) {
+      rent = slg_rollup_month (&rollup, q, m);
+      if (rent->valid == 0) continue;
+      printf ("month %lu/%lu:\n", (unsigned long) m, (unsigned long) q);
+      print_entry (&rollup, rent, q, m, nrm);
+    }
+  }
+
+  slg_rollup_close (&rollup);
+
+  return (0);
+}